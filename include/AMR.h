@@ -23,11 +23,159 @@ void Aux_Error( const char *File, const int Line, const char *Func, const char *
 
 
 
+//-------------------------------------------------------------------------------------------------------
+// Structure   :  PatchTable_t
+// Description :  Growable table of the patch pointers at one refinement level and one sandglass
+//
+// Note        :  1. Patch pointers are stored in chunks of PATCH_CHUNK_SIZE entries
+//                   --> Each chunk is allocated once and never moved, so the address of each entry remains
+//                       valid when the table grows
+//                   --> Only the list of chunk addresses is reallocated (with its size doubled)
+//                2. Newly allocated entries are initialized as NULL
+//                3. The table is accessed by the same syntax as a plain array (e.g., patch->ptr[Sg][lv][PID])
+//
+// Data Member :  Chunk     : List of the chunk addresses
+//                NChunk    : Number of allocated chunks
+//                NChunkMax : Size of the list "Chunk"
+//
+// Method      :  PatchTable_t : Constructor
+//               ~PatchTable_t : Destructor
+//                operator[]   : Return the pointer of the targeted patch
+//                Capacity     : Return the number of patches that can be stored without allocating new chunks
+//                Reserve      : Allocate chunks to store at least the given number of patches
+//-------------------------------------------------------------------------------------------------------
+struct PatchTable_t
+{
+
+// data members
+// ===================================================================================
+   patch_t ***Chunk;
+   int        NChunk;
+   int        NChunkMax;
+
+
+
+   //===================================================================================
+   // Constructor :  PatchTable_t
+   // Description :  Constructor of the structure "PatchTable_t"
+   //
+   // Note        :  No chunk is allocated until the first call to "Reserve"
+   //===================================================================================
+   PatchTable_t()
+   {
+      Chunk     = NULL;
+      NChunk    = 0;
+      NChunkMax = 0;
+   } // METHOD : PatchTable_t
+
+
+
+   //===================================================================================
+   // Destructor  :  ~PatchTable_t
+   // Description :  Destructor of the structure "PatchTable_t"
+   //
+   // Note        :  Only the table is deallocated (the patches must be deallocated by AMR_t)
+   //===================================================================================
+   ~PatchTable_t()
+   {
+      for (int c=0; c<NChunk; c++)  delete [] Chunk[c];
+
+      free( Chunk );
+
+      Chunk     = NULL;
+      NChunk    = 0;
+      NChunkMax = 0;
+   } // METHOD : ~PatchTable_t
+
+
+
+   //===================================================================================
+   // Method      :  operator[]
+   // Description :  Return the reference to the pointer of the targeted patch
+   //
+   // Note        :  The targeted patch ID must be smaller than Capacity()
+   //
+   // Parameter   :  PID : Targeted patch ID
+   //===================================================================================
+   patch_t* &operator[]( const int PID )
+   {
+#     ifdef DAINO_DEBUG
+      if ( PID < 0  ||  PID >= Capacity() )
+         Aux_Error( ERROR_INFO, "PID (%d) is outside the patch table (capacity = %d) !!\n", PID, Capacity() );
+#     endif
+
+      return Chunk[ PID >> PATCH_CHUNK_LOG2 ][ PID & (PATCH_CHUNK_SIZE-1) ];
+   } // METHOD : operator[]
+
+   patch_t* operator[]( const int PID ) const
+   {
+#     ifdef DAINO_DEBUG
+      if ( PID < 0  ||  PID >= Capacity() )
+         Aux_Error( ERROR_INFO, "PID (%d) is outside the patch table (capacity = %d) !!\n", PID, Capacity() );
+#     endif
+
+      return Chunk[ PID >> PATCH_CHUNK_LOG2 ][ PID & (PATCH_CHUNK_SIZE-1) ];
+   } // METHOD : operator[] (const)
+
+
+
+   //===================================================================================
+   // Method      :  Capacity
+   // Description :  Return the number of patches that can be stored without allocating new chunks
+   //===================================================================================
+   int Capacity() const
+   {
+      return NChunk*PATCH_CHUNK_SIZE;
+   } // METHOD : Capacity
+
+
+
+   //===================================================================================
+   // Method      :  Reserve
+   // Description :  Allocate new chunks to store at least "NPatch" patches
+   //
+   // Note        :  Do nothing if the current capacity is already large enough
+   //
+   // Parameter   :  NPatch : Targeted number of patches
+   //===================================================================================
+   void Reserve( const int NPatch )
+   {
+      const int NChunkNew = ( NPatch + PATCH_CHUNK_SIZE - 1 ) / PATCH_CHUNK_SIZE;
+
+      if ( NChunkNew <= NChunk )    return;
+
+//    grow the list of chunk addresses
+      if ( NChunkNew > NChunkMax )
+      {
+         NChunkMax = MAX( NChunkNew, 2*NChunkMax );
+         Chunk     = (patch_t***)realloc( Chunk, NChunkMax*sizeof(patch_t**) );
+
+         if ( Chunk == NULL )
+            Aux_Error( ERROR_INFO, "cannot allocate the patch table for %d patches !!\n", NPatch );
+      }
+
+//    allocate the new chunks
+      for (int c=NChunk; c<NChunkNew; c++)
+      {
+         Chunk[c] = new patch_t* [PATCH_CHUNK_SIZE];
+
+         for (int t=0; t<PATCH_CHUNK_SIZE; t++)    Chunk[c][t] = NULL;
+      }
+
+      NChunk = NChunkNew;
+   } // METHOD : Reserve
+
+
+}; // struct PatchTable_t
+
+
+
+
 //-------------------------------------------------------------------------------------------------------
 // Structure   :  AMR_t
 // Description :  Data structure of the AMR implementation
 //
-// Data Member :  ptr         : Pointers of all patches
+// Data Member :  ptr         : Pointers of all patches (stored in growable tables --> see PatchTable_t)
 //                num         : Number of patches (real patch + buffer patch) at each level
 //                scale       : Grid scale at each level (grid size normalized to that at the finest level)
 //                FluSg       : Sandglass of the current fluid data
@@ -38,10 +186,12 @@ void Aux_Error( const char *File, const int Line, const char *Func, const char *
 //                BoxSize     : Simulation box physical size
 //                BoxScale    : Simulation box scale
 //                WithFlux    : Whether of not to allocate the flux arrays at all coarse-fine boundaries
+//                FluxPool    : Pool of the flux arrays at each level
 //
 // Method      :  AMR_t    : Constructor 
 //               ~AMR_t    : Destructor
-//                pnew     : Allocate one patch
+//                Reserve  : Reserve the patch tables in the given level
+//                pnew     : Allocate one patch (appended to the patch list or with a given patch ID)
 //                pdelete  : Deallocate one patch
 //                Lvdelete : Deallocate all patches in the given level
 //-------------------------------------------------------------------------------------------------------
@@ -50,7 +200,7 @@ struct AMR_t
 
 // data members
 // ===================================================================================
-   patch_t   *ptr[2][NLEVEL][MAX_PATCH];
+   PatchTable_t ptr[2][NLEVEL];
 
 #  ifndef SERIAL
    ParaVar_t *ParaVar;
@@ -70,6 +220,7 @@ struct AMR_t
    double BoxSize     [3];
    int    BoxScale    [3];
    bool   WithFlux;
+   FluxPool_t FluxPool[NLEVEL];
    
 
 
@@ -91,11 +242,6 @@ struct AMR_t
 #        endif
       }
 
-      for (int Sg=0; Sg<2; Sg++)
-      for (int lv=0; lv<NLEVEL; lv++)
-      for (int PID=0; PID<MAX_PATCH; PID++)
-         ptr[Sg][lv][PID] = NULL;
-
       for (int lv=0; lv<NLEVEL; lv++)  
       for (int m=0; m<28; m++)
          NPatchComma[lv][m] = 0;
@@ -142,6 +288,26 @@ struct AMR_t
 
 
 
+   //===================================================================================
+   // Method      :  Reserve
+   // Description :  Reserve the patch tables (of both sandglasses) in the targeted level to store
+   //                at least "NPatch" patches
+   //
+   // Note        :  a. Invoked in advance when the number of patches to be allocated is known in order to
+   //                   reduce the number of reallocations of the tables
+   //                b. The tables also grow automatically in "pnew"
+   //
+   // Parameter   :  lv     : Targeted refinement level
+   //                NPatch : Targeted number of patches
+   //===================================================================================
+   void Reserve( const int lv, const int NPatch )
+   {
+      ptr[0][lv].Reserve( NPatch );
+      ptr[1][lv].Reserve( NPatch );
+   } // METHOD : Reserve
+
+
+
    //===================================================================================
    // Method      :  pnew
    // Description :  allocate a single patch 
@@ -149,6 +315,7 @@ struct AMR_t
    // Note        :  a. Each patch contains two patch pointers --> SANDGLASS (Sg) = 0 / 1 
    //                b. Sg = 0 : Store both data and relation (father,son.sibling,corner,flag,flux)
    //                   Sg = 1 : Store only data 
+   //                c. The patch tables grow automatically if they are full
    //
    // Parameter   :  lv       : Targeted refinement level
    //                x,y,z    : Physical coordinates of the patch corner
@@ -159,8 +326,7 @@ struct AMR_t
    void pnew( const int lv, const int x, const int y, const int z, const int FaPID, const bool FluData,
               const bool PotData )
    {
-      if ( num[lv]+1 > MAX_PATCH )
-         Aux_Error( ERROR_INFO, "exceed the MAX_PATCH (%d) !!\n", MAX_PATCH );
+      if ( num[lv]+1 > ptr[0][lv].Capacity() )   Reserve( lv, num[lv]+1 );
 
 #     ifdef DAINO_DEBUG
       if ( ptr[0][lv][num[lv]] != NULL  ||  ptr[1][lv][num[lv]] != NULL )
@@ -176,6 +342,35 @@ struct AMR_t
 
 
 
+   //===================================================================================
+   // Method      :  pnew (with the targeted patch ID)
+   // Description :  allocate a single patch with the patch ID "PID"
+   //
+   // Note        :  a. The patch tables must be reserved in advance and the slot "PID" must be empty
+   //                b. "num[lv]" is NOT modified --> it must be reset by the caller afterward
+   //                c. Thread-safe for different PIDs
+   //
+   // Parameter   :  lv       : Targeted refinement level
+   //                x,y,z    : Physical coordinates of the patch corner
+   //                FaPID    : Patch ID of the parent patch at level "lv-1"
+   //                FluData  : true --> Allocate hydrodynamic array "fluid"
+   //                PotData  : true --> Allocate potential array "pot"
+   //                PID      : Patch ID of the new patch
+   //===================================================================================
+   void pnew( const int lv, const int x, const int y, const int z, const int FaPID, const bool FluData,
+              const bool PotData, const int PID )
+   {
+#     ifdef DAINO_DEBUG
+      if ( ptr[0][lv][PID] != NULL  ||  ptr[1][lv][PID] != NULL )
+         Aux_Error( ERROR_INFO, "allocate an existing patch (Lv %d, PID %d, FaPID %d) !!\n", lv, PID, FaPID );
+#     endif
+
+      ptr[0][lv][PID] = new patch_t( x, y, z, FaPID, FluData, PotData, lv, BoxScale );
+      ptr[1][lv][PID] = new patch_t( 0, 0, 0,    -1, FluData, PotData, lv, BoxScale );
+   } // METHOD : pnew
+
+
+
    //===================================================================================
    // Method      :  pdelete
    // Description :  Deallocate a single patch 
@@ -183,7 +378,7 @@ struct AMR_t
    // Note        :  a. This function should NOT be applied to the base-level patches (unless
    //                   the option "LOAD_BALANCE" is turned on, in which the base-level patches need
    //                   to be redistributed)
-   //                b. This function will also deallocate the flux arrays of the targeted patch
+   //                b. This function will also return the flux arrays of the targeted patch to the flux pool
    //                c. Delete a patch with son is forbidden
    //
    // Parameter   :  lv  : The targeted refinement level
@@ -205,6 +400,8 @@ struct AMR_t
                                  lv, PID, ptr[0][lv][PID]->son );
 #     endif
 
+      ptr[0][lv][PID]->fdelete( &FluxPool[lv] );
+
       delete ptr[0][lv][PID];
       delete ptr[1][lv][PID];
 
@@ -229,6 +426,7 @@ struct AMR_t
    // Note        :  a. This function will delete a patch even if it has sons
    //                b. This function will scan over patch->num[lv] patches
    //                c. The variables "scale, FluSg, PotSg, and dh" will NOT be modified
+   //                d. The patch tables and the flux pool are kept for reuse
    //
    // Parameter   :  lv : Targeted refinement level
    //===================================================================================
@@ -247,6 +445,8 @@ struct AMR_t
             Aux_Error( ERROR_INFO, "patch->ptr[%d][%d][%d] does not exist (==NULL) !!\n", Sg, lv, PID );
 #        endif
 
+         if ( Sg == 0 )    ptr[Sg][lv][PID]->fdelete( &FluxPool[lv] );
+
          delete ptr[Sg][lv][PID];
          ptr[Sg][lv][PID] = NULL;
       }
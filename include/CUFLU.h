@@ -74,7 +74,8 @@ struct FluVar { real Rho, Px, Py, Pz, Egy; };
 
 // Verify that the density and pressure in the intermediate states of Roe's Riemann solver are positive.
 // If either the density of pressure is negative, we switch to other Riemann solvers (EXACT/HLLE/HLLC)
-#if (  ( FLU_SCHEME == MHM || FLU_SCHEME == MHM_RP || FLU_SCHEME == CTU )  &&  RSOLVER == ROE  )
+#if (  ( FLU_SCHEME == MHM || FLU_SCHEME == MHM_RP || FLU_SCHEME == CTU )  &&  \
+      ( RSOLVER == ROE || defined RUNTIME_FLU_SCHEME )  )
 #  define CHECK_INTERMEDIATE    HLLC
 #endif
 
@@ -98,8 +99,19 @@ struct FluVar { real Rho, Px, Py, Pz, Egy; };
 #endif
 
 
+// thresholds of the shock/contact sensor in the hybrid Riemann solver (RSOLVER == HYBRID)
+// --> relative jump/compression <  HYBRID_SMOOTH_JUMP : HLLE
+//     relative jump/compression >= HYBRID_SHOCK_JUMP  : exact
+//     otherwise                                       : HLLC
+#if ( FLU_SCHEME != RTVD  &&  ( RSOLVER == HYBRID || defined RUNTIME_FLU_SCHEME ) )
+#  define HYBRID_SMOOTH_JUMP     0.1
+#  define HYBRID_SHOCK_JUMP      1.0
+#endif
+
+
 // maximum allowed error for the exact Riemann solver and the WAF scheme
-#if ( FLU_SCHEME == WAF  ||  ( FLU_SCHEME != RTVD && RSOLVER == EXACT )  ||  CHECK_INTERMEDIATE == EXACT )
+#if ( FLU_SCHEME == WAF  ||  ( FLU_SCHEME != RTVD && ( RSOLVER == EXACT || RSOLVER == HYBRID ) )  ||  \
+      CHECK_INTERMEDIATE == EXACT  ||  defined RUNTIME_FLU_SCHEME )
 #  ifdef FLOAT8
 #     define MAX_ERROR    1.e-15
 #  else
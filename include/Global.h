@@ -52,24 +52,29 @@ extern int        Flu_ParaBuf;                        // number of parallel buff
 
 extern double     BOX_SIZE, DT__FLUID, END_T, OUTPUT_DT;
 extern long int   END_STEP;
-extern int        NX0_TOT[3], OUTPUT_STEP, REGRID_COUNT, FLU_GPU_NPGROUP, OMP_NTHREAD;
+extern int        NX0_TOT[3], OUTPUT_STEP, REGRID_COUNT, FLU_GPU_NPGROUP, OMP_NTHREAD, OPT__TUNE_NPGROUP;
 extern int        MPI_NRank, MPI_NRank_X[3], GPU_NSTREAM, FLAG_BUFFER_SIZE, MAX_LEVEL;
 
 extern int        OPT__UM_START_LEVEL, OPT__UM_START_NVAR, OPT__GPUID_SELECT, OPT__PATCH_COUNT;
-extern int        OPT__OUTPUT_TOTAL, OPT__CK_CONSERVATION, INIT_DUMPID, OPT__FLAG_LOHNER;
+extern int        OPT__OUTPUT_TOTAL, OPT__OUTPUT_DELTA, OPT__OUTPUT_CRC, OPT__CK_CONSERVATION, INIT_DUMPID, OPT__FLAG_LOHNER, OUTPUT_PART_LV;
 extern real       OPT__CK_MEMFREE, OUTPUT_PART_X, OUTPUT_PART_Y, OUTPUT_PART_Z;
 extern bool       OPT__FLAG_RHO, OPT__FLAG_RHO_GRADIENT, OPT__FLAG_USER;
 extern bool       OPT__DT_USER, OPT__RECORD_DT, OPT__RECORD_MEMORY, OPT__ADAPTIVE_DT;
-extern bool       OPT__FIXUP_RESTRICT, OPT__INIT_RESTRICT, OPT__VERBOSE;
+extern bool       OPT__FIXUP_RESTRICT, OPT__INIT_RESTRICT, OPT__VERBOSE, OPT__RESTART_REGRID, OPT__RESTART_CRC;
 extern bool       OPT__INT_TIME, OPT__OUTPUT_ERROR, OPT__OUTPUT_BASE, OPT__OVERLAP_MPI, OPT__TIMING_BARRIER;
 extern bool       OPT__OUTPUT_BASEPS, OPT__CK_REFINE, OPT__CK_PROPER_NESTING, OPT__CK_FINITE;
 extern bool       OPT__CK_RESTRICT, OPT__CK_PATCH_ALLOCATE, OPT__FIXUP_FLUX, OPT__CK_FLUX_ALLOCATE;
+extern bool       OPT__OUTPUT_PART_BIN, OPT__SPHERE_MAXRHO_CEN, OPT__NUMA_FIRST_TOUCH;
+extern int        OPT__SPHERE_ANALYSIS, SPHERE_NSHELL, OPT__RECORD_BASEPS;
+extern double     SPHERE_MAX_RADIUS;
 
 extern OptInit_t        OPT__INIT;
 extern OptRestartH_t    OPT__RESTART_HEADER;
 extern IntScheme_t      OPT__FLU_INT_SCHEME, OPT__REF_FLU_INT_SCHEME;
 extern OptOutputMode_t  OPT__OUTPUT_MODE;
 extern OptOutputPart_t  OPT__OUTPUT_PART;
+extern OptPatchOrder_t  OPT__PATCH_ORDER;
+extern OptAffinity_t    OPT__THREAD_AFFINITY;
 
 
 
@@ -81,8 +86,16 @@ extern double     FlagTable_PresGradient[NLEVEL-1];   // refinement criterion of
 extern real       GAMMA, MINMOD_COEFF, EP_COEFF; 
 extern LR_Limiter_t  OPT__LR_LIMITER;
 extern WAF_Limiter_t OPT__WAF_LIMITER;
-extern bool       OPT__FLAG_PRES_GRADIENT;
+extern bool       OPT__FLAG_PRES_GRADIENT, OPT__FLU_SCHEME_LV;
 extern int        OPT__CK_NEGATIVE;
+#ifdef RUNTIME_FLU_SCHEME
+extern int        FluSchemeTable_LR     [NLEVEL];     // data reconstruction scheme at each level
+extern int        FluSchemeTable_RSolver[NLEVEL];     // Riemann solver at each level
+extern LR_Limiter_t FluSchemeTable_Limiter[NLEVEL];   // slope limiter at each level
+#endif
+#if ( RSOLVER == HYBRID  ||  defined RUNTIME_FLU_SCHEME )
+extern long int   RSolver_HybridCounter[3];           // number of interfaces evaluated by HLLE/HLLC/exact solvers
+#endif
 
 #elif ( MODEL == MHD )
 #warning WAIT MHD !!!
@@ -113,8 +126,11 @@ extern int        POT_GPU_NPGROUP;
 extern bool       OPT__OUTPUT_POT, OPT__GRA_P5_GRADIENT;
 extern real       SOR_OMEGA;
 extern int        SOR_MAX_ITER, SOR_MIN_ITER;
+extern real       SOR_TOLERATED_ERROR;                // relative residual to terminate the SOR iterations
 extern real       MG_TOLERATED_ERROR;
 extern int        MG_MAX_ITER, MG_NPRE_SMOOTH, MG_NPOST_SMOOTH;
+extern bool       OPT__POT_WARM_START;
+extern long int   Poi_IterCounter[NLEVEL][2];         // number of patches/iterations of the Poisson solver
 
 extern IntScheme_t   OPT__POT_INT_SCHEME, OPT__RHO_INT_SCHEME, OPT__GRA_INT_SCHEME, OPT__REF_POT_INT_SCHEME;
 #endif
@@ -141,12 +157,18 @@ extern real       (*h_Flu_Array_F_In [2])[FLU_NIN ][  FLU_NXT   *FLU_NXT   *FLU_
 extern real       (*h_Flu_Array_F_Out[2])[FLU_NOUT][8*PATCH_SIZE*PATCH_SIZE*PATCH_SIZE];
 extern real       (*h_Flux_Array[2])[9][NCOMP][4*PATCH_SIZE*PATCH_SIZE];
 extern real       *h_MinDtInfo_Fluid_Array[2];
+#ifdef TIMING_PATCH
+extern double     *h_Flu_Cost_Array[2];               // cost of each patch group in the fluid solver
+#endif
 
 #ifdef GRAVITY
 extern real       (*h_Rho_Array_P    [2])[RHO_NXT][RHO_NXT][RHO_NXT];
 extern real       (*h_Pot_Array_P_In [2])[POT_NXT][POT_NXT][POT_NXT];
 extern real       (*h_Pot_Array_P_Out[2])[GRA_NXT][GRA_NXT][GRA_NXT];
 extern real       (*h_Flu_Array_G    [2])[GRA_NIN][PATCH_SIZE][PATCH_SIZE][PATCH_SIZE];
+#ifdef TIMING_PATCH
+extern double     *h_Pot_Cost_Array[2];               // cost of each patch in the Poisson solver
+#endif
 #endif
 
 
@@ -43,6 +43,7 @@
 #define ROE       2
 #define HLLE      3
 #define HLLC      4
+#define HYBRID    5
 
 
 // Poisson solvers
@@ -170,6 +171,16 @@
 #endif // MODEL
 
 
+// RUNTIME_FLU_SCHEME : the CPU MHM/MHM_RP/CTU solvers compile in all Riemann solvers and both the PLM and PPM
+//                      (if LR_SCHEME == PPM) data reconstructions so that they can be selected for each level at
+//                      runtime (see "Input__FluScheme")
+// --> FLU_GHOST_SIZE is still set by LR_SCHEME, which therefore should be the most demanding scheme in use
+#if (  defined RUNTIME_FLU_SCHEME  &&  \
+       ( MODEL != HYDRO  ||  defined GPU  ||  ( FLU_SCHEME != MHM && FLU_SCHEME != MHM_RP && FLU_SCHEME != CTU ) )  )
+#  error : ERROR : RUNTIME_FLU_SCHEME only works with the CPU MHM/MHM_RP/CTU schemes in HYDRO !!
+#endif
+
+
 // self-gravity constants
 #ifdef GRAVITY
 
@@ -221,11 +232,22 @@
 
 
 // patch size (number of cells of a single patch in the x/y/z directions)
-#define PATCH_SIZE                   8
+// --> set by the Makefile (8/16/32), default = 8
+#ifndef PATCH_SIZE
+#  define PATCH_SIZE                 8
+#endif
 #define PS1             ( 1*PATCH_SIZE )
 #define PS2             ( 2*PATCH_SIZE )
 
 
+// number of patch pointers allocated at a time in the growable patch tables (must be a power of two)
+#define PATCH_CHUNK_LOG2   10
+#define PATCH_CHUNK_SIZE   ( 1<<PATCH_CHUNK_LOG2 )
+
+// number of flux arrays allocated at a time by the flux pool
+#define FLUX_POOL_BLOCK    64
+
+
 // the size of arrays (in one dimension) sending into GPU
 //###REVISE: support interpolation schemes requiring 2 ghost cells in each side for POT_NXT
 #define FLU_NXT         ( 2*(PATCH_SIZE+FLU_GHOST_SIZE)   )
@@ -282,6 +304,15 @@
 #endif
 
 
+// stages recorded in the cost of each patch (for the option "TIMING_PATCH")
+#ifdef TIMING_PATCH
+#  define NCOST            3
+#  define COST_FLU         0
+#  define COST_POI         1
+#  define COST_REF         2
+#endif
+
+
 // macro for the function "Aux_Error"
 #define ERROR_INFO         __FILE__, __LINE__, __FUNCTION__
 
@@ -345,6 +376,10 @@
 #define IDX321( i, j, k, Ni, Nj )   (  ( (k)*(Nj) + (j) )*(Ni) + (i)  )
 
 
+// pointers which are guaranteed not to alias any other pointer in the same scope (helps vectorization)
+#define RESTRICT        __restrict
+
+
 
 // ################################
 // ## Remove useless definitions ##
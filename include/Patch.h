@@ -16,6 +16,165 @@ long Mis_Idx3D2Idx1D( const int Size[], const int Idx3D[] );
 
 
 
+//-------------------------------------------------------------------------------------------------------
+// Structure   :  FluxPool_t
+// Description :  Pool of the flux arrays at one refinement level
+//
+// Note        :  1. Flux arrays are allocated in blocks of FLUX_POOL_BLOCK arrays, which are not deallocated
+//                   until the pool is destroyed
+//                2. Flux arrays returned by "Put" are recorded in a free list and reused by "Get"
+//                   --> no allocation is required unless the number of flux arrays exceeds the historical maximum
+//                3. "Get" and "Put" are thread-safe
+//
+// Data Member :  Block       : List of the allocated blocks
+//                NBlock      : Number of allocated blocks
+//                FreeList    : List of the flux arrays currently not in use
+//                NFree       : Number of flux arrays currently not in use
+//
+// Method      :  FluxPool_t  : Constructor
+//               ~FluxPool_t  : Destructor
+//                Get         : Take one flux array from the pool
+//                Put         : Return one flux array to the pool
+//                NTotal      : Return the total number of flux arrays allocated by the pool
+//                MemSize     : Return the memory footprint of the pool in bytes
+//-------------------------------------------------------------------------------------------------------
+struct FluxPool_t
+{
+
+// data members
+// ===================================================================================
+   real **Block;
+   int    NBlock;
+   real **FreeList;
+   int    NFree;
+
+
+
+   //===================================================================================
+   // Constructor :  FluxPool_t
+   // Description :  Constructor of the structure "FluxPool_t"
+   //
+   // Note        :  No flux array is allocated until the first call to "Get"
+   //===================================================================================
+   FluxPool_t()
+   {
+      Block    = NULL;
+      NBlock   = 0;
+      FreeList = NULL;
+      NFree    = 0;
+   } // METHOD : FluxPool_t
+
+
+
+   //===================================================================================
+   // Destructor  :  ~FluxPool_t
+   // Description :  Destructor of the structure "FluxPool_t"
+   //
+   // Note        :  All flux arrays should be returned to the pool in advance
+   //===================================================================================
+   ~FluxPool_t()
+   {
+#     ifdef DAINO_DEBUG
+      if ( NFree != NTotal() )
+         Aux_Message( stderr, "WARNING : %d flux arrays are not returned to the pool !!\n", NTotal()-NFree );
+#     endif
+
+      for (int b=0; b<NBlock; b++)  delete [] Block[b];
+
+      free( Block    );
+      free( FreeList );
+
+      Block    = NULL;
+      NBlock   = 0;
+      FreeList = NULL;
+      NFree    = 0;
+   } // METHOD : ~FluxPool_t
+
+
+
+   //===================================================================================
+   // Method      :  Get
+   // Description :  Take one flux array from the pool
+   //
+   // Note        :  Allocate a new block if the free list is empty
+   //===================================================================================
+   real (*Get())[PATCH_SIZE][PATCH_SIZE]
+   {
+      const int Size = NCOMP*PATCH_SIZE*PATCH_SIZE;
+      real *Flux;
+
+#     pragma omp critical( FluxPool )
+      {
+         if ( NFree == 0 )
+         {
+            Block    = (real**)realloc( Block,    (NBlock+1)*sizeof(real*) );
+            FreeList = (real**)realloc( FreeList, (NBlock+1)*FLUX_POOL_BLOCK*sizeof(real*) );
+
+            if ( Block == NULL  ||  FreeList == NULL )
+               Aux_Error( ERROR_INFO, "cannot allocate a new block of the flux pool !!\n" );
+
+            Block[NBlock] = new real [FLUX_POOL_BLOCK*Size];
+
+            for (int t=0; t<FLUX_POOL_BLOCK; t++)  FreeList[ NFree ++ ] = Block[NBlock] + t*Size;
+
+            NBlock ++;
+         }
+
+         Flux = FreeList[ -- NFree ];
+      }
+
+      return ( real (*)[PATCH_SIZE][PATCH_SIZE] )Flux;
+   } // METHOD : Get
+
+
+
+   //===================================================================================
+   // Method      :  Put
+   // Description :  Return one flux array to the pool
+   //
+   // Parameter   :  Flux : Flux array previously taken from the same pool by "Get"
+   //===================================================================================
+   void Put( real (*Flux)[PATCH_SIZE][PATCH_SIZE] )
+   {
+#     pragma omp critical( FluxPool )
+      {
+#        ifdef DAINO_DEBUG
+         if ( NFree >= NTotal() )
+            Aux_Error( ERROR_INFO, "return more flux arrays than allocated (%d) !!\n", NTotal() );
+#        endif
+
+         FreeList[ NFree ++ ] = (real*)Flux;
+      }
+   } // METHOD : Put
+
+
+
+   //===================================================================================
+   // Method      :  NTotal
+   // Description :  Return the total number of flux arrays allocated by the pool (including those in use)
+   //===================================================================================
+   int NTotal() const
+   {
+      return NBlock*FLUX_POOL_BLOCK;
+   } // METHOD : NTotal
+
+
+
+   //===================================================================================
+   // Method      :  MemSize
+   // Description :  Return the memory footprint of the pool in bytes
+   //===================================================================================
+   long MemSize() const
+   {
+      return (long)NTotal()*NCOMP*PATCH_SIZE*PATCH_SIZE*sizeof(real);
+   } // METHOD : MemSize
+
+
+}; // struct FluxPool_t
+
+
+
+
 //-------------------------------------------------------------------------------------------------------
 // Structure   :  patch_t 
 // Description :  Data structure of a single patch 
@@ -36,10 +195,17 @@ long Mis_Idx3D2Idx1D( const int Size[], const int Idx3D[] );
 //                                 --> each PaddedCr1D defines a unique 3D position
 //                                 --> patches at different levels with the same PaddedCr1D have the same 
 //                                     3D corner coordinates
+//                cost[NCOST]    : Cost (in CPU cycles) of this patch in the fluid, Poisson, and refinement stages
+//                                 accumulated since the last data dump (for the option "TIMING_PATCH")
+//                DumpDataID     : ID of the data dump storing the latest output data of this patch (-1 if none)
+//                                 --> used by the delta dumps (for the option "OPT__OUTPUT_DELTA")
+//                DumpHash       : Hash of the data of this patch at the data dump "DumpDataID"
+//                NUMA_Placed    : true --> the data arrays have been re-allocated by the thread which processes
+//                                 them (for the option "OPT__NUMA_FIRST_TOUCH")
 // Method      :  patch_t        : Constructor 
 //               ~patch_t        : Destructor
 //                fnew           : Allocate one flux array 
-//                fdelete        : Deallocate one flux array
+//                fdelete        : Deallocate one or all flux arrays
 //                hnew           : Allocate hydrodynamic array
 //                hdelete        : Deallocate hydrodynamic array
 //                gnew           : Allocate potential array
@@ -69,6 +235,12 @@ struct patch_t
    long LB_Idx;
    long PaddedCr1D;
 #  endif
+#  ifdef TIMING_PATCH
+   double cost[NCOST];
+#  endif
+   int   DumpDataID;
+   ulong DumpHash;
+   bool  NUMA_Placed;
 
 
 
@@ -118,8 +290,14 @@ struct patch_t
       
       for (int s=0; s<26; s++ )  sibling[s] = -1;     // -1 <--> NO sibling
 
-      flag  = false;
-      fluid = NULL;
+      flag       = false;
+      fluid      = NULL;
+      DumpDataID = -1;
+      DumpHash   = 0;
+      NUMA_Placed = false;
+#     ifdef TIMING_PATCH
+      for (int c=0; c<NCOST; c++)   cost[c] = 0.0;
+#     endif
 #     ifdef GRAVITY
       pot   = NULL;
 #     endif
@@ -144,11 +322,16 @@ struct patch_t
    // Destructor  :  ~patch_t 
    // Description :  Destructor of the structure "patch_t"
    //
-   // Note        :  Deallocate flux and data arrays
+   // Note        :  1. Deallocate data arrays
+   //                2. Flux arrays must be returned to the flux pool in advance (by AMR_t::pdelete/Lvdelete)
    //===================================================================================
    ~patch_t()
    {
-      fdelete();
+#     ifdef DAINO_DEBUG
+      for (int s=0; s<6; s++)
+         if ( flux[s] != NULL )  Aux_Error( ERROR_INFO, "flux array (sibling = %d) is not deallocated !!\n", s );
+#     endif
+
       hdelete();
 #     ifdef GRAVITY
       gdelete();
@@ -161,24 +344,20 @@ struct patch_t
    // Method      :  fnew 
    // Description :  Allocate flux array in the given direction
    //
-   // Note        :  Flux array is initialized as zero
+   // Note        :  1. Flux array is taken from the flux pool and initialized as zero
+   //                2. If the flux array has already been allocated, it is reused and reset to zero
    //
    // Parameter   :  SibID : Targeted ID of the flux array (0,1,2,3,4,5) <--> (-x,+x,-y,+y,-z,+z) 
+   //                Pool  : Flux pool of the level of this patch
    //===================================================================================
-   void fnew( const int SibID )
+   void fnew( const int SibID, FluxPool_t *Pool )
    {
 #     ifdef DAINO_DEBUG
       if ( SibID < 0  ||  SibID > 5 )
          Aux_Error( ERROR_INFO, "incorrect input in the member function \"fnew\" !!\n" );
-
-      if ( flux[SibID] != NULL )
-         Aux_Error( ERROR_INFO, "allocate an existing flux array (sibling = %d) !!\n", SibID );
-
-      if ( flux_debug[SibID] != NULL )
-         Aux_Error( ERROR_INFO, "allocate an existing flux_debug array (sibling = %d) !!\n", SibID );
 #     endif
 
-      flux[SibID] = new real [NCOMP][PATCH_SIZE][PATCH_SIZE];
+      if ( flux[SibID] == NULL )    flux[SibID] = Pool->Get();
             
       for(int v=0; v<NCOMP; v++)
       for(int m=0; m<PATCH_SIZE; m++)
@@ -186,7 +365,7 @@ struct patch_t
          flux[SibID][v][m][n] = 0.0;
 
 #     ifdef DAINO_DEBUG
-      flux_debug[SibID] = new real [NCOMP][PATCH_SIZE][PATCH_SIZE];
+      if ( flux_debug[SibID] == NULL )    flux_debug[SibID] = Pool->Get();
             
       for(int v=0; v<NCOMP; v++)
       for(int m=0; m<PATCH_SIZE; m++)
@@ -199,27 +378,40 @@ struct patch_t
 
    //===================================================================================
    // Method      :  fdelete
-   // Description :  Deallocate all flux arrays allocated previously 
+   // Description :  Return the flux array in the given direction to the flux pool
+   //
+   // Parameter   :  SibID : Targeted ID of the flux array (0,1,2,3,4,5) <--> (-x,+x,-y,+y,-z,+z) 
+   //                Pool  : Flux pool of the level of this patch
    //===================================================================================
-   void fdelete()
+   void fdelete( const int SibID, FluxPool_t *Pool )
    {
-      for (int s=0; s<6; s++)
+      if ( flux[SibID] != NULL )
       {
-         if ( flux[s] != NULL )
-         {
-            delete [] flux[s];
-            flux[s] = NULL;
+         Pool->Put( flux[SibID] );
+         flux[SibID] = NULL;
 
-#           ifdef DAINO_DEBUG
-            delete [] flux_debug[s];
-            flux_debug[s] = NULL;
-#           endif
-         }
+#        ifdef DAINO_DEBUG
+         Pool->Put( flux_debug[SibID] );
+         flux_debug[SibID] = NULL;
+#        endif
       }
    } // METHOD : fdelete
 
 
 
+   //===================================================================================
+   // Method      :  fdelete
+   // Description :  Return all flux arrays allocated previously to the flux pool
+   //
+   // Parameter   :  Pool : Flux pool of the level of this patch
+   //===================================================================================
+   void fdelete( FluxPool_t *Pool )
+   {
+      for (int s=0; s<6; s++)    fdelete( s, Pool );
+   } // METHOD : fdelete
+
+
+
    //===================================================================================
    // Method      :  hnew 
    // Description :  Allocate hydrodynamic array
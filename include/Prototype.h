@@ -16,6 +16,7 @@
 // Auxiliary
 void Aux_Check_MemFree( const real MinMemFree_Total, const char *comment );
 void Aux_Check_Conservation( const bool Output2File, const char *comment );
+int  Aux_Check_DumpChecksum( const char *DumpName, const char *CRCName );
 void Aux_Check();
 void Aux_Check_Finite( const int lv, const char *comment );
 void Aux_Check_FluxAllocate( const int lv, const char *comment );
@@ -24,16 +25,28 @@ void Aux_Check_PatchAllocate( const int lv, const char *comment );
 void Aux_Check_ProperNesting( const int lv, const char *comment );
 void Aux_Check_Refinement( const int lv, const char *comment );
 void Aux_Check_Restrict( const int lv, const char *comment );
+uint Aux_CRC32C( const uint CRC, const void *Data, const long Size );
 void Aux_Error( const char *File, const int Line, const char *Func, const char *Format, ... );
 void Aux_GetCPUInfo( const char *FileName );
 void Aux_GetMemInfo();
 void Aux_Message( FILE *Type, const char *Format, ... );
+void Aux_NUMA_Init();
+void Aux_NUMA_RecordInfo( FILE *Note );
+void Aux_NUMA_FirstTouch( const int lv );
 void Aux_PatchCount();
+void Aux_SphereAnalysis();
 void Aux_TakeNote();
+int  Aux_TuneNPGroup_Get( const Solver_t TSolver, const int lv );
+int  Aux_TuneNPGroup_Begin( const Solver_t TSolver, const int lv );
+void Aux_TuneNPGroup_End( const Solver_t TSolver, const int lv, const int NTotal );
 void Aux_RecordTiming();
 void Aux_CreateTimer();
 void Aux_DeleteTimer();
 void Aux_ResetTimer();
+#ifdef TIMING_PATCH
+void Aux_AddPatchCost( const int lv, const int Stage, const int NPG, const int *PID0_List, const double Cost[],
+                       const bool PerPatch );
+#endif
 #ifndef SERIAL
 void Aux_RecordBoundaryPatch( const int lv, int *NList, int **IDList, int **PosList );
 #endif
@@ -61,8 +74,9 @@ void CPU_FluidSolver( real h_Flu_Array_In [][FLU_NIN ][ FLU_NXT*FLU_NXT*FLU_NXT
                       real h_Flux_Array[][9][NCOMP   ][ PS2*PS2 ], 
                       real h_MinDtInfo_Array[],
                       const int NPatchGroup, const real dt, const real dh, const real Gamma, const bool StoreFlux,
-                      const bool XYZ, const LR_Limiter_t LR_Limiter, const real MinMod_Coeff, const real EP_Coeff,
-                      const WAF_Limiter_t WAF_Limiter, const real Eta, const bool GetMinDtInfo );
+                      const bool XYZ, const int LR_Scheme, const int RSolver, const LR_Limiter_t LR_Limiter,
+                      const real MinMod_Coeff, const real EP_Coeff, const WAF_Limiter_t WAF_Limiter, const real Eta,
+                      const bool GetMinDtInfo, double h_Cost_Array[] );
 void Flu_AdvanceDt( const int lv, const double PrepTime, const double dt, const int SaveSg,
                     const bool OverlapMPI, const bool Overlap_Sync );
 void Flu_AllocateFluxArray( const int lv );
@@ -74,6 +88,9 @@ void Flu_Prepare( const int lv, const double PrepTime, real h_Flu_Array_F_In[][F
                   const int NPG, const int *PID0_List );
 void Flu_Restrict( const int FaLv, const int SonFluSg, const int FaFluSg, const int SonPotSg, const int FaPotSg,
                    const int TVar );
+void Flu_Restrict_Patch( const int FaLv, const int FaPID, const int SonFluSg, const int FaFluSg,
+                         const int SonPotSg, const int FaPotSg, const int NVar_Flu, const int TFluVarIdxList[],
+                         const bool ResPot );
 #ifndef SERIAL
 void Flu_AllocateFluxArray_Buffer( const int lv );
 #endif
@@ -97,6 +114,9 @@ void Init_BaseLevel();
 void Init_DAINO( int *argc, char ***argv );
 void Init_Load_DumpTable();
 void Init_Load_FlagCriteria();
+#ifdef RUNTIME_FLU_SCHEME
+void Init_Load_FluScheme();
+#endif
 void Init_Load_Parameter();
 void Init_MemAllocate();
 void Init_MemAllocate_Fluid( const int Flu_NPatchGroup );
@@ -104,6 +124,7 @@ void Init_Parallelization();
 void Init_RecordBasePatch();
 void Init_Refine( const int lv );
 void Init_Reload();
+void Init_Reload_Regrid();
 void Init_Reload_OldFormat();
 void Init_StartOver();
 void Init_TestProb();
@@ -115,7 +136,8 @@ void Int_Table( const IntScheme_t IntScheme, int &NSide, int &NGhost );
 void Interpolate( real CData [], const int CSize[3], const int CStart[3], const int CRange[3],
                   real FData [], const int FSize[3], const int FStart[3], 
                   const int NComp, const IntScheme_t IntScheme, const bool UnwrapPhase, 
-                  const bool EnsurePositivity );
+                  const bool EnsurePositivity[], real *Scratch );
+int  Int_ScratchSize( const IntScheme_t IntScheme, const int CRange[3] );
 
 
 // Miscellaneous
@@ -153,6 +175,8 @@ void MPI_Exit();
 void Output_DumpData( const int Stage );
 void Output_DumpData_Part( const OptOutputPart_t Part, const bool BaseOnly, const real x, const real y, 
                            const real z, const char *FileName );
+void Output_DumpData_PartBin( const OptOutputPart_t Part, const bool BaseOnly, const int TargetLv, const real x,
+                              const real y, const real z, const char *FileName );
 void Output_DumpData_Total( const char *FileName );
 void Output_DumpManually( int &Dump_global );
 void Output_FlagMap( const int lv, const int xyz, const char *comment );
@@ -165,6 +189,11 @@ void Output_PreparedPatch_Fluid( const int TLv, const int TPID,
                                  const int NPG, const int *PID0_List, const int CLv, const char *comment );
 void Output_TestProbErr( const bool BaseOnly );
 void Output_BasePowerSpectrum( const char *FileName );
+void Output_RecordBasePowerSpectrum();
+void StoreBasePowerSpectrum( const real *RhoK, const int j_start, const int dj, const double PrepTime );
+#ifdef TIMING_PATCH
+void Output_PatchCost( const char *FileName );
+#endif
 #ifndef SERIAL
 void Output_ExchangePatchMap( const int lv, const int xyz, const char *comment );
 void Output_ExchangeFluxPatchList( const int option, const int lv, const char *comment );
@@ -176,15 +205,16 @@ void Output_BoundaryFlagList( const int option, const int lv, const char *commen
 // Refine
 void FindFather( const int lv, const int Mode );
 void Flag_Real( const int lv, const UseLBFunc_t UseLBFunc );
-bool Flag_Check( const int lv, const int PID, const int i, const int j, const int k, 
-                 const real Fluid[][PS1][PS1][PS1], const real Pot[][PS1][PS1], const real Pres[][PS1][PS1],
-                 const real *Lohner_Var, const real *Lohner_Slope, const int Lohner_NCell, const int Lohner_NVar );
+bool Flag_Check( const int lv, const int PID, const real Fluid[][PS1][PS1][PS1], const real Pot[][PS1][PS1],
+                 real Pres[][PS1][PS1], const real *Lohner_Var, const real *Lohner_Slope, const int Lohner_NCell,
+                 const int Lohner_NVar, uint FlagMask[][PS1] );
 bool Flag_UserCriteria( const int i, const int j, const int k, const int lv, const int PID, const real Threshold);
-bool Flag_Lohner( const int i, const int j, const int k, const real *Var1D, const real *Slope1D, const int NCell, 
-                  const int NVar, const double Threshold, const double Filter, const double Soften );
+void Flag_Lohner( const real *Var1D, const real *Slope1D, const int NCell, const int NVar, const double Threshold,
+                  const double Filter, const double Soften, bool Flag[][PS1][PS1] );
 void Refine( const int lv );
 void SiblingSearch( const int lv );
 void SiblingSearch_Base();
+void SortPatch( const int lv );
 #ifndef SERIAL
 void Flag_Buffer( const int lv );
 void Refine_Buffer( const int lv, const int *SonTable, const int *GrandTable );
@@ -198,11 +228,13 @@ void CPU_PoissonGravitySolver( const real h_Rho_Array    [][RHO_NXT][RHO_NXT][RH
                                      real h_Pot_Array_Out[][GRA_NXT][GRA_NXT][GRA_NXT],
                                      real h_Flu_Array    [][GRA_NIN][PATCH_SIZE][PATCH_SIZE][PATCH_SIZE], 
                                const int NPatchGroup, const real dt, const real dh, const int SOR_Min_Iter, 
-                               const int SOR_Max_Iter, const real SOR_Omega, const int MG_Max_Iter,
-                               const int MG_NPre_Smooth, const int MG_NPost_Smooth, const real MG_Tolerated_Error,
-                               const real Poi_Coeff, const IntScheme_t IntScheme, const bool P5_Gradient,
-                               const real Eta, const bool Poisson, const bool GraAcc );
-void CPU_PoissonSolver_FFT( const real Poi_Coeff, const int SaveSg );
+                               const int SOR_Max_Iter, const real SOR_Omega, const real SOR_Tolerated_Error,
+                               const int MG_Max_Iter, const int MG_NPre_Smooth, const int MG_NPost_Smooth,
+                               const real MG_Tolerated_Error, const real Poi_Coeff, const IntScheme_t IntScheme,
+                               const bool P5_Gradient, const real Eta, const bool Poisson, const bool GraAcc,
+                               const bool Poi_WarmStart, long Poi_IterCounter[], double Poi_Cost[],
+                               real *Gra_MaxAcc );
+void CPU_PoissonSolver_FFT( const real Poi_Coeff, const int SaveSg, const double PrepTime );
 void Cube_to_Slice( real *RhoK, real *SendBuf, real *RecvBuf );
 void Slice_to_Cube( real *RhoK, real *SendBuf, real *RecvBuf, const int SaveSg );
 void End_MemFree_PoissonGravity();
@@ -229,6 +261,11 @@ void Poi_Close( const int lv, const int SaveSg, const real h_Pot_Array_P_Out[][G
 void Poi_GetAverageDensity();
 void Poi_Prepare_Pot( const int lv, const double PrepTime, real h_Pot_Array_P_In[][POT_NXT][POT_NXT][POT_NXT], 
                       const int NPG, const int *PID0_List );
+void Poi_Prepare_PotGuess( const int lv, const double PrepTime,
+                           const real h_Pot_Array_P_In[][POT_NXT][POT_NXT][POT_NXT],
+                           real h_Pot_Array_P_Out[][GRA_NXT][GRA_NXT][GRA_NXT], const int NPG,
+                           const int *PID0_List );
+void Poi_Record_Iteration();
 void Poi_Prepare_Rho( const int lv, const double PrepTime, real h_Rho_Array_P[][RHO_NXT][RHO_NXT][RHO_NXT], 
                       const int NPG, const int *PID0_List );
 #ifndef SERIAL
@@ -287,9 +324,12 @@ void Hydro_Aux_Check_Negative( const int lv, const int Mode, const char *comment
 void Hydro_GetTimeStep_Fluid( double &dt, double &dTime, int &MinDtLv, real MinDtVar[], const double dt_dTime );
 void Hydro_GetTimeStep_Gravity( double &dt, double &dTime, int &MinDtLv, real &MinDtVar, const double dt_dTime );
 void Hydro_GetMaxCFL( real MaxCFL[], real MinDtVar_AllLv[][NCOMP] );
-void Hydro_GetMaxAcc( real MaxAcc[] );
+void Hydro_GetMaxAcc( const int lv, real MaxAcc[] );
 void Hydro_Init_StartOver_AssignData( const int lv );
 void Hydro_Init_UM_AssignData( const int lv, const real *UM_Data, const int NVar );
+#if ( RSOLVER == HYBRID  ||  defined RUNTIME_FLU_SCHEME )
+void Hydro_Record_RSolverHybrid();
+#endif
 
 
 // MHD model
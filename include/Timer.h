@@ -224,5 +224,25 @@ struct Timer_t
 #endif
 
 
+// cycle counter for measuring the cost of each patch (works in each OpenMP thread independently)
+// --> use the time-stamp counter for x86 processors and the wall-clock time in microseconds otherwise
+#ifdef TIMING_PATCH
+
+#  if ( defined __x86_64__  ||  defined __i386__ )
+#     include <x86intrin.h>
+#     define TIMER_CYCLE()   ( (double)__rdtsc() )
+#  else
+inline double TIMER_CYCLE()
+{
+   timeval tv;
+   gettimeofday( &tv, NULL );
+
+   return (double)tv.tv_sec*1.0e6 + (double)tv.tv_usec;
+}
+#  endif
+
+#endif // #ifdef TIMING_PATCH
+
+
 
 #endif // #ifndef __TIMER_H__
@@ -50,7 +50,15 @@ enum OptOutputMode_t { OUTPUT_CONST_STEP=1, OUTPUT_CONST_DT=2, OUTPUT_USE_TABLE=
 
 // options of output part
 enum OptOutputPart_t { OUTPUT_NONE=0, OUTPUT_XY=1, OUTPUT_YZ=2, OUTPUT_XZ=3, OUTPUT_X=4, OUTPUT_Y=5, OUTPUT_Z=6,
-                       OUTPUT_DIAG=7 };
+                       OUTPUT_DIAG=7, OUTPUT_PROJ_X=8, OUTPUT_PROJ_Y=9, OUTPUT_PROJ_Z=10 };
+
+
+// options of patch ordering
+enum OptPatchOrder_t { PATCH_ORDER_NONE=0, PATCH_ORDER_MORTON=1, PATCH_ORDER_HILBERT=2 };
+
+
+// options of the OpenMP thread affinity
+enum OptAffinity_t { AFFINITY_NONE=0, AFFINITY_COMPACT=1, AFFINITY_SCATTER=2 };
 
 
 // options in "Prepare_PatchGroupData"
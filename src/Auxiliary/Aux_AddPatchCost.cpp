@@ -0,0 +1,50 @@
+#include "DAINO.h"
+
+#ifdef TIMING_PATCH
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Aux_AddPatchCost
+// Description :  Add the cost measured by the CPU solvers into the cost field of each patch
+//
+// Note        :  1. Invoked by the closing step of "InvokeSolver"
+//                2. The cost of a patch group is evenly distributed among the eight patches if PerPatch == false
+//                3. The cost is stored in the patch pointer of sandglass 0 and is accumulated until the
+//                   next data dump (see "Output_PatchCost")
+//
+// Parameter   :  lv        : Targeted refinement level
+//                Stage     : Targeted stage (COST_FLU/COST_POI/COST_REF)
+//                NPG       : Number of patch groups evaluated at a time
+//                PID0_List : List recording the patch indicies with LocalID==0 to be udpated
+//                Cost      : Array storing the cost of each patch group or each patch
+//                PerPatch  : true  --> Cost[8*NPG] stores the cost of each patch
+//                            false --> Cost[  NPG] stores the cost of each patch group
+//-------------------------------------------------------------------------------------------------------
+void Aux_AddPatchCost( const int lv, const int Stage, const int NPG, const int *PID0_List, const double Cost[],
+                       const bool PerPatch )
+{
+
+// check
+#  ifdef DAINO_DEBUG
+   if ( Stage < 0  ||  Stage >= NCOST )   Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "Stage", Stage );
+#  endif
+
+
+   for (int TID=0; TID<NPG; TID++)
+   {
+      const int PID0 = PID0_List[TID];
+
+      for (int LocalID=0; LocalID<8; LocalID++)
+      {
+         if ( PerPatch )   patch->ptr[0][lv][PID0+LocalID]->cost[Stage] += Cost[ 8*TID + LocalID ];
+         else              patch->ptr[0][lv][PID0+LocalID]->cost[Stage] += 0.125*Cost[TID];
+      }
+   }
+
+} // FUNCTION : Aux_AddPatchCost
+
+
+
+#endif // #ifdef TIMING_PATCH
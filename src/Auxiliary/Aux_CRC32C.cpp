@@ -0,0 +1,136 @@
+
+#include "DAINO.h"
+
+// use the SSE4.2 "crc32" instruction if it is enabled at compile time, or if the CPU supports it at run time
+#if   ( defined __SSE4_2__  &&  defined __x86_64__ )
+#  define CRC32C_HW_NATIVE
+#elif ( defined __GNUC__  &&  !defined __INTEL_COMPILER  &&  defined __x86_64__ )
+#  define CRC32C_HW_DISPATCH
+#endif
+
+#if ( defined CRC32C_HW_NATIVE  ||  defined CRC32C_HW_DISPATCH )
+#include <nmmintrin.h>
+static uint CRC32C_Hardware( uint CRC, const unsigned char *Ptr, long Size );
+#endif
+
+static uint CRC32C_Software( uint CRC, const unsigned char *Ptr, long Size );
+
+
+// lookup tables of the software version (slicing-by-8) and the run-time CPU check, set before "main"
+struct CRC32C_Init_t
+{
+   uint Table[8][256];
+   bool Hardware;
+
+   CRC32C_Init_t()
+   {
+      const uint Poly = 0x82F63B78;    // reflected Castagnoli polynomial
+
+      for (int n=0; n<256; n++)
+      {
+         uint CRC = n;
+         for (int b=0; b<8; b++)    CRC = ( CRC & 1 ) ? ( CRC >> 1 ) ^ Poly : ( CRC >> 1 );
+         Table[0][n] = CRC;
+      }
+
+      for (int n=0; n<256; n++)
+      for (int t=1; t<8; t++)    Table[t][n] = ( Table[t-1][n] >> 8 ) ^ Table[0][ Table[t-1][n] & 0xff ];
+
+#     if   ( defined CRC32C_HW_NATIVE )
+      Hardware = true;
+#     elif ( defined CRC32C_HW_DISPATCH )
+      __builtin_cpu_init();
+      Hardware = __builtin_cpu_supports( "sse4.2" );
+#     else
+      Hardware = false;
+#     endif
+   }
+}; // struct CRC32C_Init_t
+
+static const CRC32C_Init_t CRC32C_Init;
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Aux_CRC32C
+// Description :  Update the CRC32C (Castagnoli) checksum "CRC" with the input data
+//
+// Note        :  1. Use CRC = 0 for the first data block, and the returned value for the successive blocks
+//                   --> Aux_CRC32C( Aux_CRC32C(0,A,SizeA), B, SizeB ) is the checksum of A+B
+//                2. The SSE4.2 "crc32" instruction is adopted if available, and otherwise a table-driven
+//                   (slicing-by-8) version is used. Both versions return the same result.
+//                3. Thread-safe
+//
+// Parameter   :  CRC  : Checksum of the previous data (0 for none)
+//                Data : Input data
+//                Size : Size of the input data in bytes
+//
+// Return      :  Updated checksum
+//-------------------------------------------------------------------------------------------------------
+uint Aux_CRC32C( const uint CRC, const void *Data, const long Size )
+{
+
+   const unsigned char *Ptr = (const unsigned char*)Data;
+
+#  if ( defined CRC32C_HW_NATIVE  ||  defined CRC32C_HW_DISPATCH )
+   if ( CRC32C_Init.Hardware )   return ~CRC32C_Hardware( ~CRC, Ptr, Size );
+#  endif
+
+   return ~CRC32C_Software( ~CRC, Ptr, Size );
+
+} // FUNCTION : Aux_CRC32C
+
+
+
+#if ( defined CRC32C_HW_NATIVE  ||  defined CRC32C_HW_DISPATCH )
+//-------------------------------------------------------------------------------------------------------
+// Function    :  CRC32C_Hardware
+// Description :  CRC32C kernel using the SSE4.2 "crc32" instruction (eight bytes at a time)
+//-------------------------------------------------------------------------------------------------------
+__attribute__(( target("sse4.2") ))
+uint CRC32C_Hardware( uint CRC, const unsigned char *Ptr, long Size )
+{
+
+   ulong CRC64 = CRC, Word;
+
+// align the pointer to eight bytes
+   for (; Size>0 && ( (ulong)Ptr & 7 ); Size--, Ptr++)   CRC64 = _mm_crc32_u8( (uint)CRC64, *Ptr );
+
+   for (; Size>=8; Size-=8, Ptr+=8)
+   {
+      memcpy( &Word, Ptr, 8 );
+      CRC64 = _mm_crc32_u64( CRC64, Word );
+   }
+
+   for (; Size>0; Size--, Ptr++)    CRC64 = _mm_crc32_u8( (uint)CRC64, *Ptr );
+
+   return (uint)CRC64;
+
+} // FUNCTION : CRC32C_Hardware
+#endif
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  CRC32C_Software
+// Description :  Table-driven CRC32C kernel (slicing-by-8, independent of the byte order)
+//-------------------------------------------------------------------------------------------------------
+uint CRC32C_Software( uint CRC, const unsigned char *Ptr, long Size )
+{
+
+   const uint (*T)[256] = CRC32C_Init.Table;
+
+   for (; Size>=8; Size-=8, Ptr+=8)
+   {
+      const uint Lo = CRC ^ (  (uint)Ptr[0] | ( (uint)Ptr[1] << 8 ) | ( (uint)Ptr[2] << 16 ) | ( (uint)Ptr[3] << 24 )  );
+
+      CRC = T[7][ Lo & 0xff ] ^ T[6][ ( Lo >> 8 ) & 0xff ] ^ T[5][ ( Lo >> 16 ) & 0xff ] ^ T[4][ Lo >> 24 ] ^
+            T[3][ Ptr[4] ]    ^ T[2][ Ptr[5] ]            ^ T[1][ Ptr[6] ]             ^ T[0][ Ptr[7] ];
+   }
+
+   for (; Size>0; Size--, Ptr++)    CRC = T[0][ ( CRC ^ *Ptr ) & 0xff ] ^ ( CRC >> 8 );
+
+   return CRC;
+
+} // FUNCTION : CRC32C_Software
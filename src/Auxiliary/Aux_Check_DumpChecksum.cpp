@@ -0,0 +1,145 @@
+
+#include "DAINO.h"
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Aux_Check_DumpChecksum
+// Description :  Verify the block checksums of a file output by "Output_DumpData_Total"
+//
+// Note        :  1. The checksum file (named "DumpName.crc") is composed of one record [size, CRC32C] per
+//                   block (both are uint), in the order the blocks are stored in the dump file:
+//                      block 0          : header (HeaderSize bytes)
+//                      block 1          : simulation information (1024 bytes)
+//                      block 2, 3, ...  : one block per patch record (patch information + patch data)
+//                   --> The block offsets are given by the block sizes, and hence the dump file is verified
+//                       without decoding its content
+//                2. The blocks are evenly distributed to all MPI ranks, and each OpenMP thread reads a
+//                   contiguous range of blocks with its own file handle
+//                3. Must be invoked by all MPI ranks
+//
+// Parameter   :  DumpName : Name of the dump file
+//                CRCName  : Name of the checksum file
+//
+// Return      :  Number of corrupted blocks (including a size mismatch between the dump and checksum files),
+//                or -1 if either file does not exist
+//-------------------------------------------------------------------------------------------------------
+int Aux_Check_DumpChecksum( const char *DumpName, const char *CRCName )
+{
+
+   if ( MPI_Rank == 0 )    Aux_Message( stdout, "%s (%s) ...\n", __FUNCTION__, DumpName );
+
+
+   const int MaxReport = 10;     // maximum number of corrupted blocks reported by each thread
+
+   int NBad_Local = 0, NBad_Total;
+
+
+// 1. load the sizes and checksums of all blocks
+   FILE *File_Dump = fopen( DumpName, "rb" );
+   FILE *File_CRC  = fopen( CRCName,  "rb" );
+
+   if ( File_Dump == NULL  ||  File_CRC == NULL )
+   {
+      if ( MPI_Rank == 0 )
+         Aux_Message( stderr, "WARNING : file \"%s\" does not exist !!\n", ( File_Dump == NULL ) ? DumpName : CRCName );
+
+      if ( File_Dump != NULL )   fclose( File_Dump );
+      if ( File_CRC  != NULL )   fclose( File_CRC  );
+
+      return -1;
+   }
+
+   fseek( File_Dump, 0, SEEK_END );
+   fseek( File_CRC,  0, SEEK_END );
+
+   const long DumpSize = ftell( File_Dump );
+   const long CRCSize  = ftell( File_CRC  );
+   const long NBlock   = CRCSize / ( 2*sizeof(uint) );
+
+   uint (*Block)[2] = new uint [NBlock][2];    // [0/1] = size/checksum of each block
+   long  *Offset    = new long [NBlock+1];
+   uint   MaxSize   = 0;
+
+   fseek( File_CRC, 0, SEEK_SET );
+   fread( Block, sizeof(uint), 2*NBlock, File_CRC );
+
+   fclose( File_Dump );
+   fclose( File_CRC  );
+
+   Offset[0] = 0;
+   for (long b=0; b<NBlock; b++)    Offset[b+1] = Offset[b] + Block[b][0];
+
+
+// 2. compare the file size
+   if ( CRCSize % ( 2*sizeof(uint) ) != 0  ||  DumpSize != Offset[NBlock] )
+   {
+      if ( MPI_Rank == 0 )
+      {
+         Aux_Message( stderr, "WARNING : size of \"%s\" (%ld bytes) != size recorded in \"%s\" (%ld bytes) !!\n",
+                      DumpName, DumpSize, CRCName, Offset[NBlock] );
+         NBad_Local ++;
+      }
+   }
+
+
+// 3. verify the blocks assigned to this rank
+   const long Block_Start = NBlock*(MPI_Rank  )/MPI_NRank;
+   const long Block_End   = NBlock*(MPI_Rank+1)/MPI_NRank;
+
+   for (long b=Block_Start; b<Block_End; b++)   MaxSize = ( Block[b][0] > MaxSize ) ? Block[b][0] : MaxSize;
+
+#  pragma omp parallel reduction( +:NBad_Local )
+   {
+#     ifdef OPENMP
+      const int TID = omp_get_thread_num();
+      const int NT  = omp_get_num_threads();
+#     else
+      const int TID = 0;
+      const int NT  = 1;
+#     endif
+
+      const long B0 = Block_Start + (Block_End-Block_Start)*(TID  )/NT;
+      const long B1 = Block_Start + (Block_End-Block_Start)*(TID+1)/NT;
+
+      unsigned char *Buf = new unsigned char [MaxSize];
+      FILE *File = fopen( DumpName, "rb" );
+
+      if ( File == NULL )  Aux_Error( ERROR_INFO, "cannot open the file \"%s\" !!\n", DumpName );
+
+      fseek( File, Offset[B0], SEEK_SET );
+
+      for (long b=B0; b<B1; b++)
+      {
+         const bool Complete = (  fread( Buf, 1, Block[b][0], File ) == Block[b][0]  );
+
+         if ( !Complete  ||  Aux_CRC32C( 0, Buf, Block[b][0] ) != Block[b][1] )
+         {
+            if ( NBad_Local < MaxReport )
+               Aux_Message( stderr, "WARNING : block %ld (%s, offset %ld, size %u) of \"%s\" is %s !!\n",
+                            b, ( b == 0 ) ? "header" : ( b == 1 ) ? "simulation information" : "patch record",
+                            Offset[b], Block[b][0], DumpName, ( Complete ) ? "corrupted" : "incomplete" );
+
+            NBad_Local ++;
+         }
+      }
+
+      fclose( File );
+      delete [] Buf;
+   } // OpenMP parallel region
+
+
+// 4. sum over all ranks
+   MPI_Allreduce( &NBad_Local, &NBad_Total, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD );
+
+   delete [] Block;
+   delete [] Offset;
+
+   if ( MPI_Rank == 0 )
+      Aux_Message( stdout, "%s (%s) ... done (%ld blocks, %d corrupted)\n", __FUNCTION__, DumpName, NBlock,
+                   NBad_Total );
+
+   return NBad_Total;
+
+} // FUNCTION : Aux_Check_DumpChecksum
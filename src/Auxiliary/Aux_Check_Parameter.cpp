@@ -20,14 +20,18 @@ void Aux_Check_Parameter()
 
 // general errors
 // =======================================================================================
-#  if ( PATCH_SIZE%2 != 0 )
-#     error : ERROR : PATCH_SIZE must be an even number !!
+#  if ( PATCH_SIZE != 8  &&  PATCH_SIZE != 16  &&  PATCH_SIZE != 32 )
+#     error : ERROR : unsupported PATCH_SIZE (only 8/16/32 are supported) !!
 #  endif
 
 #  if ( defined TIMING_SOLVER  &&  !defined TIMING )
 #     error : ERROR : option TIMING_SOLVER must work with the option TIMING !!
 #  endif 
 
+#  if ( defined TIMING_PATCH  &&  ( defined GPU  ||  defined OOC  ||  MODEL == ELBDM )  )
+#     error : ERROR : option TIMING_PATCH does not support GPU, OOC, and ELBDM !!
+#  endif
+
 #  if ( defined OPENMP  &&  !defined _OPENMP )
 #     error : ERROR : something is wrong in OpenMP, the macro "_OPENMP" is NOT defined !!
 #  endif
@@ -85,6 +89,14 @@ void Aux_Check_Parameter()
 
    if ( REGRID_COUNT <= 0 )   Aux_Error( ERROR_INFO, "REGRID_COUNT <= 0 !!\n" );
 
+   if ( OPT__PATCH_ORDER != PATCH_ORDER_NONE  &&  OPT__PATCH_ORDER != PATCH_ORDER_MORTON  &&
+        OPT__PATCH_ORDER != PATCH_ORDER_HILBERT )
+      Aux_Error( ERROR_INFO, "unsupported option \"OPT__PATCH_ORDER = %d\" [0/1/2] !!\n", OPT__PATCH_ORDER );
+
+   if ( OPT__THREAD_AFFINITY != AFFINITY_NONE  &&  OPT__THREAD_AFFINITY != AFFINITY_COMPACT  &&
+        OPT__THREAD_AFFINITY != AFFINITY_SCATTER )
+      Aux_Error( ERROR_INFO, "unsupported option \"OPT__THREAD_AFFINITY = %d\" [0/1/2] !!\n", OPT__THREAD_AFFINITY );
+
    if ( OPT__OUTPUT_MODE != OUTPUT_CONST_STEP  &&  OPT__OUTPUT_MODE != OUTPUT_CONST_DT  &&
         OPT__OUTPUT_MODE != OUTPUT_USE_TABLE )
       Aux_Error( ERROR_INFO, "unsupported option \"OPT__OUTPUT_MODE = %d\" [1/2/3] !!\n", OPT__OUTPUT_MODE );
@@ -102,10 +114,44 @@ void Aux_Check_Parameter()
    if ( OPT__OUTPUT_TOTAL < 0  ||  OPT__OUTPUT_TOTAL > 2 ) 
       Aux_Error( ERROR_INFO, "unsupported option \"OPT__OUTPUT_TOTAL = %d\" [0/1/2] !!\n", OPT__OUTPUT_TOTAL );
 
+   if ( OPT__OUTPUT_DELTA < 0 )
+      Aux_Error( ERROR_INFO, "incorrect parameter %s = %d (must >= 0) !!\n", "OPT__OUTPUT_DELTA", OPT__OUTPUT_DELTA );
+
+   if ( OPT__OUTPUT_CRC < 0  ||  OPT__OUTPUT_CRC > 2 ) 
+      Aux_Error( ERROR_INFO, "unsupported option \"OPT__OUTPUT_CRC = %d\" [0/1/2] !!\n", OPT__OUTPUT_CRC );
+
+   if ( OPT__TUNE_NPGROUP < 0 )
+      Aux_Error( ERROR_INFO, "incorrect parameter %s = %d (must >= 0) !!\n", "OPT__TUNE_NPGROUP", OPT__TUNE_NPGROUP );
+
    if ( OPT__OUTPUT_PART != OUTPUT_NONE  &&  OPT__OUTPUT_PART != OUTPUT_DIAG  &&  
         OPT__OUTPUT_PART != OUTPUT_XY  &&  OPT__OUTPUT_PART != OUTPUT_YZ  &&  OPT__OUTPUT_PART != OUTPUT_XZ  &&  
-        OPT__OUTPUT_PART != OUTPUT_X   &&  OPT__OUTPUT_PART != OUTPUT_Y   &&  OPT__OUTPUT_PART != OUTPUT_Z )
-      Aux_Error( ERROR_INFO, "unsupported option \"OPT__OUTPUT_PART = %d\" [0 ~ 6] !!\n", OPT__OUTPUT_PART );
+        OPT__OUTPUT_PART != OUTPUT_X   &&  OPT__OUTPUT_PART != OUTPUT_Y   &&  OPT__OUTPUT_PART != OUTPUT_Z   &&
+        OPT__OUTPUT_PART != OUTPUT_PROJ_X  &&  OPT__OUTPUT_PART != OUTPUT_PROJ_Y  &&  OPT__OUTPUT_PART != OUTPUT_PROJ_Z )
+      Aux_Error( ERROR_INFO, "unsupported option \"OPT__OUTPUT_PART = %d\" [0 ~ 10] !!\n", OPT__OUTPUT_PART );
+
+   if ( OPT__OUTPUT_PART_BIN  &&  ( OUTPUT_PART_LV < 0  ||  OUTPUT_PART_LV > NLEVEL-1 ) )
+      Aux_Error( ERROR_INFO, "incorrect OUTPUT_PART_LV (%d) --> must be in the range [0 ... NLEVEL-1] !!\n",
+                 OUTPUT_PART_LV );
+
+   if ( OPT__RECORD_BASEPS < 0 )
+      Aux_Error( ERROR_INFO, "incorrect parameter %s = %d (must >= 0) !!\n", "OPT__RECORD_BASEPS",
+                 OPT__RECORD_BASEPS );
+
+   if ( OPT__SPHERE_ANALYSIS < 0 )
+      Aux_Error( ERROR_INFO, "incorrect parameter %s = %d (must >= 0) !!\n", "OPT__SPHERE_ANALYSIS",
+                 OPT__SPHERE_ANALYSIS );
+
+   if ( OPT__SPHERE_ANALYSIS > 0  &&  SPHERE_NSHELL <= 0 )
+      Aux_Error( ERROR_INFO, "incorrect parameter %s = %d (must > 0) !!\n", "SPHERE_NSHELL", SPHERE_NSHELL );
+
+   if ( OPT__SPHERE_ANALYSIS > 0  &&  SPHERE_MAX_RADIUS <= 0.0 )
+      Aux_Error( ERROR_INFO, "incorrect parameter %s = %14.7e (must > 0.0) !!\n", "SPHERE_MAX_RADIUS",
+                 SPHERE_MAX_RADIUS );
+
+#  ifdef OOC
+   if ( OPT__OUTPUT_PART_BIN )
+      Aux_Error( ERROR_INFO, "option \"%s\" is not supported in OOC yet !!\n", "OPT__OUTPUT_PART_BIN" );
+#  endif
 
    if (  ( OPT__OUTPUT_PART == OUTPUT_YZ  ||  OPT__OUTPUT_PART == OUTPUT_Y  ||  OPT__OUTPUT_PART == OUTPUT_Z )  &&
          ( OUTPUT_PART_X < 0.0  ||  OUTPUT_PART_X >= patch->BoxSize[0] )  )
@@ -126,6 +172,9 @@ void Aux_Check_Parameter()
    if (  OPT__OUTPUT_BASEPS  &&  ( NX0_TOT[0] != NX0_TOT[1] || NX0_TOT[0] != NX0_TOT[2] )  )
       Aux_Error( ERROR_INFO, "option \"%s\" only works with CUBIC domain !!\n", "OPT__OUTPUT_BASEPS" );
 
+   if (  OPT__RECORD_BASEPS > 0  &&  ( NX0_TOT[0] != NX0_TOT[1] || NX0_TOT[0] != NX0_TOT[2] )  )
+      Aux_Error( ERROR_INFO, "option \"%s\" only works with CUBIC domain !!\n", "OPT__RECORD_BASEPS" );
+
    if (  OPT__INIT == INIT_UM  &&  ( OPT__UM_START_LEVEL < 0 || OPT__UM_START_LEVEL > NLEVEL-1 )  )
       Aux_Error( ERROR_INFO, "incorrect option \"OPT__UM_START_LEVEL = %d\" [0 ... NLEVEL-1] !!\n", 
                  OPT__UM_START_LEVEL );
@@ -201,6 +250,17 @@ void Aux_Check_Parameter()
       Aux_Message( stderr, "WARNING : both %s, %s, %s, and %s are off --> no data will be output !!\n",
                    "OPT__OUTPUT_TOTAL", "OPT__OUTPUT_PART", "OPT__OUTPUT_ERROR", "OPT__OUTPUT_BASEPS" );
 
+   if ( OPT__OUTPUT_DELTA > 0  &&  OPT__OUTPUT_TOTAL == 0 )
+      Aux_Message( stderr, "WARNING : option \"%s\" has no effect when \"%s\" is off !!\n",
+                   "OPT__OUTPUT_DELTA", "OPT__OUTPUT_TOTAL" );
+
+   if ( OPT__OUTPUT_CRC > 0  &&  OPT__OUTPUT_TOTAL == 0 )
+      Aux_Message( stderr, "WARNING : option \"%s\" has no effect when \"%s\" is off !!\n",
+                   "OPT__OUTPUT_CRC", "OPT__OUTPUT_TOTAL" );
+
+   if ( OPT__OUTPUT_DELTA > 0 )
+      Aux_Message( stderr, "WARNING : restarting from a delta dump requires all dumps back to its full dump !!\n" );
+
    if ( OPT__CK_REFINE )
       Aux_Message( stderr, "WARNING : \"%s\" check may fail due to the proper-nesting constraint !!\n",
                    "OPT__CK_REFINE" );
@@ -492,8 +552,13 @@ void Aux_Check_Parameter()
 #     error : ERROR : unsupported data reconstruction scheme (PLM/PPM) !!
 #  endif
 
-#  if ( defined RSOLVER  &&  RSOLVER != EXACT  &&  RSOLVER != ROE  &&  RSOLVER != HLLE  &&  RSOLVER != HLLC )
-#     error : ERROR : unsupported Riemann solver (EXACT/ROE/HLLE/HLLC) !!
+#  if ( defined RSOLVER  &&  RSOLVER != EXACT  &&  RSOLVER != ROE  &&  RSOLVER != HLLE  &&  RSOLVER != HLLC  &&  \
+        RSOLVER != HYBRID )
+#     error : ERROR : unsupported Riemann solver (EXACT/ROE/HLLE/HLLC/HYBRID) !!
+#  endif
+
+#  if ( defined GPU  &&  RSOLVER == HYBRID )
+#     error : ERROR : currently the hybrid Riemann solver is only supported in the CPU solvers !!
 #  endif
 
 #  if ( defined CHECK_INTERMEDIATE  &&  CHECK_INTERMEDIATE != EXACT  &&  CHECK_INTERMEDIATE != HLLE  &&  \
@@ -677,8 +742,8 @@ void Aux_Check_Parameter()
 // ------------------------------
 #  if ( FLU_SCHEME == WAF )
 
-#  if ( RSOLVER == HLLE  ||  RSOLVER == HLLC )
-#     error : ERROR : currently the WAF scheme does not support HLLE/HLLC Riemann solvers
+#  if ( RSOLVER == HLLE  ||  RSOLVER == HLLC  ||  RSOLVER == HYBRID )
+#     error : ERROR : currently the WAF scheme does not support HLLE/HLLC/HYBRID Riemann solvers
 #  endif
 
 #  if ( FLU_GHOST_SIZE != 2 )
@@ -825,6 +890,12 @@ void Aux_Check_Parameter()
    if ( SOR_MIN_ITER < 3 )    Aux_Error( ERROR_INFO, "SOR_MIN_ITER < 3 !!\n" );
 #  endif
 
+#  ifdef GPU
+   if ( OPT__POT_WARM_START )
+      Aux_Error( ERROR_INFO, "option \"%s\" is not supported by the GPU Poisson solver !!\n",
+                 "OPT__POT_WARM_START" );
+#  endif
+
    if ( POT_GPU_NPGROUP % GPU_NSTREAM != 0 )    
       Aux_Error( ERROR_INFO, "POT_GPU_NPGROUP %% GPU_NSTREAM != 0 !!\n" );
 
@@ -878,6 +949,12 @@ void Aux_Check_Parameter()
       Aux_Message( stderr, "WARNING : DT__GRAVITY (%14.7e) is not within the normal range [0...1] !!\n", 
                    DT__GRAVITY );
 
+#  if ( POT_SCHEME == SOR  &&  defined GPU )
+   if ( SOR_TOLERATED_ERROR > 0.0 )
+      Aux_Message( stderr, "WARNING : \"%s\" is ignored by the GPU Poisson solver !!\n",
+                   "SOR_TOLERATED_ERROR" );
+#  endif
+
    } // if ( MPI_Rank == 0 )
 
 
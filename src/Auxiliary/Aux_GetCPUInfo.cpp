@@ -96,6 +96,11 @@ void Aux_GetCPUInfo( const char *FileName )
    }
 
    fclose( MemInfo );
+
+
+// 3. get the NUMA topology and the CPU of each OpenMP thread
+   Aux_NUMA_RecordInfo( Note );
+
    fclose( Note );
 
 } // FUNCTION : Aux_GetCPUInfo
@@ -11,7 +11,8 @@
 // Note        :  1. This function will record the following information from the file "/proc/[pid]/status"
 //                   (1) VmSize : current virtual memory size
 //                   (2) VmRSS  : current resident set size
-//                2. Only the maximum values among all MPI ranks will be recorded
+//                2. The memory footprint of the flux pools (summed over all levels) is also recorded
+//                3. Both the maximum values and the sum over all MPI ranks are recorded
 // 
 // Parameter   :  FileName : Name of the output file
 //-------------------------------------------------------------------------------------------------------
@@ -26,7 +27,7 @@ void Aux_GetMemInfo()
    char   FileName_Status[StrSize], Useless[2][StrSize], *line=NULL;
    char   VmSize[StrSize], VmRSS[StrSize];
    bool   GetVmSize=false, GetVmRSS=false;
-   double Vm_float[2], Vm_max[2], Vm_sum[2];
+   double Vm_float[3], Vm_max[3], Vm_sum[3];
    size_t len=0;
 
 
@@ -71,9 +72,12 @@ void Aux_GetMemInfo()
 // 2. gather information from all ranks
    Vm_float[0] = atof( VmSize );
    Vm_float[1] = atof( VmRSS  );
+   Vm_float[2] = 0.0;
 
-   MPI_Reduce( Vm_float, Vm_max, 2, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD );
-   MPI_Reduce( Vm_float, Vm_sum, 2, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
+   for (int lv=0; lv<NLEVEL; lv++)  Vm_float[2] += patch->FluxPool[lv].MemSize()/1024.0;   // in kB
+
+   MPI_Reduce( Vm_float, Vm_max, 3, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD );
+   MPI_Reduce( Vm_float, Vm_sum, 3, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
 
 
 // 3. record memory information
@@ -90,14 +94,16 @@ void Aux_GetMemInfo()
          FirstTime = false;
 
          FILE *File_Record = fopen( FileName_Record, "a" );
-         fprintf( File_Record, "%14s%14s%s%20s%20s%20s%20s\n", "Time", "Step", " ", "Virtual_Max (MB)", 
-                  "Virtual_Sum (MB)", "Resident_Max (MB)", "Resident_Sum (MB)" );
+         fprintf( File_Record, "%14s%14s%s%20s%20s%20s%20s%20s%20s\n", "Time", "Step", " ", "Virtual_Max (MB)", 
+                  "Virtual_Sum (MB)", "Resident_Max (MB)", "Resident_Sum (MB)", "FluxPool_Max (MB)",
+                  "FluxPool_Sum (MB)" );
          fclose( File_Record );
       }
 
       FILE *File_Record = fopen( FileName_Record, "a" );
-      fprintf( File_Record, "%14.7e%14ld%20.2f%20.2f%20.2f%20.2f\n", 
-               Time[0], Step, Vm_max[0]/1024.0, Vm_sum[0]/1024.0, Vm_max[1]/1024.0, Vm_sum[1]/1024.0 );
+      fprintf( File_Record, "%14.7e%14ld%20.2f%20.2f%20.2f%20.2f%20.2f%20.2f\n", 
+               Time[0], Step, Vm_max[0]/1024.0, Vm_sum[0]/1024.0, Vm_max[1]/1024.0, Vm_sum[1]/1024.0,
+               Vm_max[2]/1024.0, Vm_sum[2]/1024.0 );
       fclose( File_Record );
 
    } // if ( MPI_Rank == 0 )
@@ -0,0 +1,364 @@
+
+#include "DAINO.h"
+#include <sched.h>
+
+#define NUMA_MAX_NODE   64
+
+static int NUMA_NNode = 0;                   // number of NUMA nodes (0 --> no topology information)
+static int NUMA_NodeOfCPU[CPU_SETSIZE];      // NUMA node of each logical CPU (-1 --> unknown)
+
+static void GetTopology();
+#ifdef OPENMP
+static int  GetLocalRank( int &NLocalRank );
+#endif
+static void RelocatePatchData( const int lv, const int NPG_Max, const bool Flu, const bool Pot );
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Aux_NUMA_Init
+// Description :  Detect the NUMA topology and pin the OpenMP threads to logical CPUs if requested
+//
+// Note        :  1. Must be invoked after setting the number of OpenMP threads and before allocating any
+//                   data which are supposed to be first touched by the worker threads
+//                2. The NUMA topology is loaded from "/sys/devices/system/node/nodeX/cpulist"
+//                3. Only the logical CPUs in the affinity mask inherited from the MPI launcher are used
+//                   --> OPT__THREAD_AFFINITY == AFFINITY_COMPACT : threads fill one NUMA node after another
+//                       OPT__THREAD_AFFINITY == AFFINITY_SCATTER : threads are distributed round-robin over
+//                                                                  all NUMA nodes
+//                4. If the inherited mask is large enough to host the threads of all MPI ranks on the same
+//                   host (i.e., the ranks are not bound by the launcher), different ranks adopt disjoint
+//                   sets of CPUs
+//-------------------------------------------------------------------------------------------------------
+void Aux_NUMA_Init()
+{
+
+   GetTopology();
+
+#  ifdef OPENMP
+   if ( OPT__THREAD_AFFINITY == AFFINITY_NONE )    return;
+
+
+// 1. get the logical CPUs allowed for this process
+   cpu_set_t Allowed;
+   CPU_ZERO( &Allowed );
+
+   if (  sched_getaffinity( 0, sizeof(cpu_set_t), &Allowed ) != 0  )
+   {
+      Aux_Message( stderr, "WARNING : sched_getaffinity failed --> \"%s\" is ignored (rank %d) !!\n",
+                   "OPT__THREAD_AFFINITY", MPI_Rank );
+      return;
+   }
+
+
+// 2. sort the allowed CPUs according to the affinity policy
+   int *CPUList = new int [CPU_SETSIZE];
+   int *RankInNode = new int [CPU_SETSIZE];
+   int  NCPUInNode[NUMA_MAX_NODE], NCPU = 0, MaxRankInNode = 0, Node;
+
+   for (int n=0; n<NUMA_MAX_NODE; n++)    NCPUInNode[n] = 0;
+
+   for (int c=0; c<CPU_SETSIZE; c++)
+   {
+      if ( !CPU_ISSET( c, &Allowed ) )    continue;
+
+      Node          = ( NUMA_NodeOfCPU[c] < 0 ) ? 0 : NUMA_NodeOfCPU[c];
+      RankInNode[c] = NCPUInNode[Node] ++;
+      MaxRankInNode = MAX( MaxRankInNode, NCPUInNode[Node] );
+   }
+
+   switch ( OPT__THREAD_AFFINITY )
+   {
+      case AFFINITY_COMPACT :
+         for (int c=0; c<CPU_SETSIZE; c++)
+            if ( CPU_ISSET( c, &Allowed ) )  CPUList[ NCPU ++ ] = c;
+      break;
+
+      case AFFINITY_SCATTER :
+         for (int r=0; r<MaxRankInNode; r++)
+         for (int c=0; c<CPU_SETSIZE; c++)
+            if ( CPU_ISSET( c, &Allowed )  &&  RankInNode[c] == r )  CPUList[ NCPU ++ ] = c;
+      break;
+
+      default :
+         Aux_Error( ERROR_INFO, "unsupported option \"%s = %d\" !!\n",
+                    "OPT__THREAD_AFFINITY", OPT__THREAD_AFFINITY );
+   }
+
+   delete [] RankInNode;
+
+   if ( NCPU < OMP_NTHREAD  &&  MPI_Rank == 0 )
+      Aux_Message( stderr, "WARNING : OMP_NTHREAD (%d) > number of allowed CPUs (%d) !!\n", OMP_NTHREAD, NCPU );
+
+
+// 3. set the starting CPU of this rank (in case that all ranks on the same host share the same mask)
+   int NLocalRank;
+   const int LocalRank = GetLocalRank( NLocalRank );
+   const int CPU_Start = ( NCPU >= NLocalRank*OMP_NTHREAD ) ? LocalRank*OMP_NTHREAD : 0;
+
+
+// 4. pin each thread to a single CPU
+#  pragma omp parallel
+   {
+      const int TID = omp_get_thread_num();
+      cpu_set_t Mask;
+
+      CPU_ZERO( &Mask );
+      CPU_SET( CPUList[ (CPU_Start+TID)%NCPU ], &Mask );
+
+      if (  sched_setaffinity( 0, sizeof(cpu_set_t), &Mask ) != 0  )
+         Aux_Message( stderr, "WARNING : sched_setaffinity failed (rank %d, thread %d) !!\n", MPI_Rank, TID );
+   }
+
+   delete [] CPUList;
+#  endif // #ifdef OPENMP
+
+} // FUNCTION : Aux_NUMA_Init
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Aux_NUMA_RecordInfo
+// Description :  Record the NUMA topology and the logical CPU on which each OpenMP thread is running
+//
+// Note        :  Invoked by the function "Aux_GetCPUInfo"
+//
+// Parameter   :  Note : Targeted file pointer
+//-------------------------------------------------------------------------------------------------------
+void Aux_NUMA_RecordInfo( FILE *Note )
+{
+
+   if ( NUMA_NNode > 0 )   fprintf( Note, "NUMA Nodes      : %d\n", NUMA_NNode );
+   else                    fprintf( Note, "NUMA Nodes      : unknown\n" );
+
+   int *CPU = new int [OMP_NTHREAD];
+
+#  pragma omp parallel
+   {
+#     ifdef OPENMP
+      const int TID = omp_get_thread_num();
+#     else
+      const int TID = 0;
+#     endif
+
+      CPU[TID] = sched_getcpu();
+   }
+
+   for (int t=0; t<OMP_NTHREAD; t++)
+   {
+      fprintf( Note, "Thread %3d      : CPU %4d", t, CPU[t] );
+
+      if ( CPU[t] >= 0  &&  CPU[t] < CPU_SETSIZE  &&  NUMA_NodeOfCPU[ CPU[t] ] >= 0 )
+         fprintf( Note, ", NUMA node %2d", NUMA_NodeOfCPU[ CPU[t] ] );
+
+      fprintf( Note, "\n" );
+   }
+
+   delete [] CPU;
+
+} // FUNCTION : Aux_NUMA_RecordInfo
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Aux_NUMA_FirstTouch
+// Description :  Re-allocate the fluid and potential arrays of the newly created real patches at level "lv" by
+//                the OpenMP threads which will advance them
+//
+// Note        :  1. Invoked after creating patches at level "lv" if OPT__NUMA_FIRST_TOUCH is on
+//                2. Memory pages are placed on the NUMA node of the thread which touches them first. Patches
+//                   are usually allocated and filled by the master thread, while they are later processed
+//                   by all threads in the preparation/closing steps of the solvers.
+//                3. Patch groups are visited in the same order and with the same (default) loop schedule as
+//                   the function "InvokeSolver", so that each patch group is touched by the thread which
+//                   prepares and closes it in a full batch of FLU_GPU_NPGROUP (POT_GPU_NPGROUP) patch groups
+//                   --> the batch sizes currently adopted at level "lv" are used if OPT__TUNE_NPGROUP is on
+//                4. Only the patches not relocated yet (i.e., patch_t::NUMA_Placed == false) are re-allocated
+//                   --> the existing patches keep their pages even if they are moved to a different position in
+//                       the patch list by "Refine" or "SortPatch", which is only an approximation of the ideal
+//                       placement but avoids copying the data of all patches at every regrid
+//                5. Nothing is done if there is only one NUMA node
+//
+// Parameter   :  lv : Targeted refinement level
+//-------------------------------------------------------------------------------------------------------
+void Aux_NUMA_FirstTouch( const int lv )
+{
+
+   if ( NUMA_NNode == 1 )  return;
+
+
+   const int Flu_NPG = Aux_TuneNPGroup_Get( FLUID_SOLVER, lv );
+
+#  ifdef GRAVITY
+   const int Pot_NPG = Aux_TuneNPGroup_Get( ( lv == 0 ) ? GRAVITY_SOLVER : POISSON_AND_GRAVITY_SOLVER, lv );
+
+   if ( Flu_NPG == Pot_NPG )
+      RelocatePatchData( lv, Flu_NPG, true,  true  );
+
+   else
+   {
+      RelocatePatchData( lv, Flu_NPG, true,  false );
+      RelocatePatchData( lv, Pot_NPG, false, true  );
+   }
+#  else
+   RelocatePatchData( lv, Flu_NPG, true,  false );
+#  endif
+
+
+// mark all real patches as relocated after both the fluid and potential arrays have been processed
+   for (int PID=0; PID<patch->NPatchComma[lv][1]; PID++)
+   for (int Sg=0; Sg<2; Sg++)
+      patch->ptr[Sg][lv][PID]->NUMA_Placed = true;
+
+} // FUNCTION : Aux_NUMA_FirstTouch
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  RelocatePatchData
+// Description :  Copy the data of the patches at level "lv" which have not been relocated yet to the arrays
+//                allocated by the threads which will process them
+//
+// Parameter   :  lv      : Targeted refinement level
+//                NPG_Max : Maximum number of patch groups processed by the solver at a time
+//                Flu     : true --> relocate the fluid arrays
+//                Pot     : true --> relocate the potential arrays
+//-------------------------------------------------------------------------------------------------------
+void RelocatePatchData( const int lv, const int NPG_Max, const bool Flu, const bool Pot )
+{
+
+   const int NTotal = patch->NPatchComma[lv][1] / 8;
+   int NPG;
+
+   for (int Disp=0; Disp<NTotal; Disp+=NPG_Max)
+   {
+      NPG = ( NPG_Max < NTotal-Disp ) ? NPG_Max : NTotal-Disp;
+
+#     pragma omp parallel for
+      for (int TID=0; TID<NPG; TID++)
+      {
+         const int PID0 = 8*( Disp + TID );
+
+         for (int PID=PID0; PID<PID0+8; PID++)
+         for (int Sg=0; Sg<2; Sg++)
+         {
+            patch_t *Patch = patch->ptr[Sg][lv][PID];
+
+            if ( Patch->NUMA_Placed )  continue;
+
+            if ( Flu  &&  Patch->fluid != NULL )
+            {
+               real (*NewFluid)[PATCH_SIZE][PATCH_SIZE][PATCH_SIZE]
+                  = new real [NCOMP][PATCH_SIZE][PATCH_SIZE][PATCH_SIZE];
+
+               memcpy( NewFluid, Patch->fluid, NCOMP*PATCH_SIZE*PATCH_SIZE*PATCH_SIZE*sizeof(real) );
+               delete [] Patch->fluid;
+               Patch->fluid = NewFluid;
+            }
+
+#           ifdef GRAVITY
+            if ( Pot  &&  Patch->pot != NULL )
+            {
+               real (*NewPot)[PATCH_SIZE][PATCH_SIZE] = new real [PATCH_SIZE][PATCH_SIZE][PATCH_SIZE];
+
+               memcpy( NewPot, Patch->pot, PATCH_SIZE*PATCH_SIZE*PATCH_SIZE*sizeof(real) );
+               delete [] Patch->pot;
+               Patch->pot = NewPot;
+            }
+#           endif
+         } // for PID, Sg
+      } // for (int TID=0; TID<NPG; TID++)
+   } // for (int Disp=0; Disp<NTotal; Disp+=NPG_Max)
+
+} // FUNCTION : RelocatePatchData
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  GetTopology
+// Description :  Load the logical CPUs of each NUMA node from "/sys/devices/system/node/nodeX/cpulist"
+//
+// Note        :  The cpulist format is a comma-separated list of CPU indices and ranges (e.g., "0-7,16-23")
+//-------------------------------------------------------------------------------------------------------
+void GetTopology()
+{
+
+   char FileName[100];
+   int  Start, End, Sep;
+
+   NUMA_NNode = 0;
+
+   for (int c=0; c<CPU_SETSIZE; c++)   NUMA_NodeOfCPU[c] = -1;
+
+   for (int Node=0; Node<NUMA_MAX_NODE; Node++)
+   {
+      sprintf( FileName, "/sys/devices/system/node/node%d/cpulist", Node );
+
+      FILE *File = fopen( FileName, "r" );
+
+      if ( File == NULL )  continue;
+
+      while ( fscanf( File, "%d", &Start ) == 1 )
+      {
+         End = Start;
+         Sep = fgetc( File );
+
+         if ( Sep == '-' )
+         {
+            if ( fscanf( File, "%d", &End ) != 1 )    break;
+            Sep = fgetc( File );
+         }
+
+         for (int c=Start; c<=End && c<CPU_SETSIZE; c++)    NUMA_NodeOfCPU[c] = Node;
+
+         if ( Sep != ',' )    break;
+      }
+
+      fclose( File );
+
+      NUMA_NNode = Node + 1;
+   } // for (int Node=0; Node<NUMA_MAX_NODE; Node++)
+
+} // FUNCTION : GetTopology
+
+
+
+#ifdef OPENMP
+//-------------------------------------------------------------------------------------------------------
+// Function    :  GetLocalRank
+// Description :  Return the index of this MPI rank among all ranks running on the same host
+//
+// Parameter   :  NLocalRank : Number of MPI ranks running on the same host
+//-------------------------------------------------------------------------------------------------------
+int GetLocalRank( int &NLocalRank )
+{
+
+   const int NameSize = 256;
+   char  MyHost[NameSize];
+   char *AllHost = new char [ MPI_NRank*NameSize ];
+   int   LocalRank = 0;
+
+   memset( MyHost, 0, NameSize );
+   gethostname( MyHost, NameSize-1 );
+
+   MPI_Gather( MyHost, NameSize, MPI_CHAR, AllHost, NameSize, MPI_CHAR, 0, MPI_COMM_WORLD );
+   MPI_Bcast( AllHost, MPI_NRank*NameSize, MPI_CHAR, 0, MPI_COMM_WORLD );
+
+   NLocalRank = 0;
+
+   for (int r=0; r<MPI_NRank; r++)
+   {
+      if (  strcmp( AllHost+r*NameSize, MyHost ) == 0  )
+      {
+         if ( r < MPI_Rank )  LocalRank ++;
+         NLocalRank ++;
+      }
+   }
+
+   delete [] AllHost;
+
+   return LocalRank;
+
+} // FUNCTION : GetLocalRank
+#endif // #ifdef OPENMP
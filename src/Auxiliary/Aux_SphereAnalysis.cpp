@@ -0,0 +1,586 @@
+
+#include "DAINO.h"
+
+#if ( MODEL == MHD )
+#warning : WAIT MHD !!!
+#endif
+
+static const int NMaxRho = 8;    // number of the highest-density cells for determining the sphere center
+static const int NRec    = 5;    // record format of each candidate cell : [density, mass, x, y, z]
+
+static void   GetMaxRhoCenter( double Center[], double &MaxRho );
+static void   MergeMaxRhoCand( double (*Cand_TH)[NMaxRho][NRec], double Center[], double &MaxRho );
+static double MinImageDist( const double dr, const double Box );
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Aux_SphereAnalysis
+// Description :  Evaluate the shell averages, RMS, maximum, and minimum values of the fluid variables
+//                around the maximum-density center during the simulation
+//                --> In-situ version of the shell-average and maximum-density modes in the analysis tool
+//                    "DAINO_SphereAnalysis", which avoids dumping the total data only for the profiles
+//
+// Note        :  1. Invoked by "main" every OPT__SPHERE_ANALYSIS steps
+//                2. Only the leaf patches are included. The periodic B.C. is assumed (minimum-image distance).
+//                3. Sphere center is set to the mass-weighted center of the NMaxRho highest-density cells if
+//                   OPT__SPHERE_MAXRHO_CEN is on, and to the box center otherwise
+//                   --> The highest-density cells are searched in the same pass as the shell accumulation, and
+//                       the center thus obtained is adopted by the next invocation. Only the first invocation
+//                       performs a separate search (by "GetMaxRhoCenter") since no center is available yet.
+//                   --> "MaxDens" in the record is the maximum density of all leaf cells if OPT__SPHERE_MAXRHO_CEN
+//                       is on, and the maximum density within the sphere otherwise
+//                4. Each OpenMP thread accumulates its own histograms, which are then summed over all threads
+//                   and all MPI ranks. Patches entirely outside the sphere are skipped in the shell accumulation
+//                   (but still searched for the highest-density cells if OPT__SPHERE_MAXRHO_CEN is on).
+//                5. HYDRO : Dens, V_R, V_T, Engy, Pres (velocities are weighted by mass, the others by volume)
+//                   ELBDM : Dens, Real, Imag
+//                   --> RMS is the weighted standard deviation around the shell average
+//                6. Results are appended to the file "Record__SphereAnalysis"
+//-------------------------------------------------------------------------------------------------------
+void Aux_SphereAnalysis()
+{
+
+   const char  FileName[] = "Record__SphereAnalysis";
+   static bool FirstTime  = true;
+
+   if ( MPI_Rank == 0  &&  FirstTime )
+   {
+      FILE *File_Check = fopen( FileName, "r" );
+      if ( File_Check != NULL )
+      {
+         Aux_Message( stderr, "WARNING : the file \"%s\" already exists !!\n", FileName );
+         fclose( File_Check );
+      }
+      FirstTime = false;
+   }
+
+
+#  if   ( MODEL == HYDRO )
+   const int  NVar = 5;
+   const char VarName[NVar][8] = { "Dens", "V_R", "V_T", "Engy", "Pres" };
+
+#  elif ( MODEL == MHD )
+#  warning : WAIT MHD !!!
+
+#  elif ( MODEL == ELBDM )
+   const int  NVar = 3;
+   const char VarName[NVar][8] = { "Dens", "Real", "Imag" };
+
+#  else
+#  error : ERROR : unsupported MODEL !!
+#  endif // MODEL
+
+   const int    NShell     = SPHERE_NSHELL;
+   const double MaxRadius  = SPHERE_MAX_RADIUS;
+   const double ShellWidth = MaxRadius / NShell;
+   const double dh_min     = patch->dh[NLEVEL-1];
+   const int    NHis       = NShell*NVar;
+
+
+// 1. set the sphere center
+// ===========================================================================================
+   static bool   NextCenter_Ready = false;
+   static double NextCenter[3];
+
+   double Center[3], MaxRho;
+
+   if ( OPT__SPHERE_MAXRHO_CEN )
+   {
+      if ( NextCenter_Ready )
+         for (int d=0; d<3; d++)    Center[d] = NextCenter[d];
+      else
+         GetMaxRhoCenter( Center, MaxRho );
+   }
+
+   else
+      for (int d=0; d<3; d++)    Center[d] = 0.5*patch->BoxSize[d];
+
+
+// 2. accumulate the histograms of all shells (one set of histograms per thread)
+// ===========================================================================================
+   double *Volume_TH = new double [ OMP_NTHREAD*NShell ];
+   long   *NCount_TH = new long   [ OMP_NTHREAD*NShell ];
+   double *W_TH      = new double [ OMP_NTHREAD*NHis   ];   // sum of weights
+   double *WQ_TH     = new double [ OMP_NTHREAD*NHis   ];   // sum of weight*value
+   double *WQQ_TH    = new double [ OMP_NTHREAD*NHis   ];   // sum of weight*value^2
+   double *Max_TH    = new double [ OMP_NTHREAD*NHis   ];
+   double *Min_TH    = new double [ OMP_NTHREAD*NHis   ];
+
+   double (*Cand_TH)[NMaxRho][NRec] = ( OPT__SPHERE_MAXRHO_CEN ) ? new double [OMP_NTHREAD][NMaxRho][NRec] : NULL;
+
+   if ( OPT__SPHERE_MAXRHO_CEN )
+   for (int TID=0; TID<OMP_NTHREAD; TID++)
+   for (int t=0; t<NMaxRho; t++)
+   {
+      Cand_TH[TID][t][0] = -__DBL_MAX__;
+      for (int r=1; r<NRec; r++)    Cand_TH[TID][t][r] = 0.0;
+   }
+
+   for (int t=0; t<OMP_NTHREAD*NShell; t++)
+   {
+      Volume_TH[t] = 0.0;
+      NCount_TH[t] = 0;
+   }
+
+   for (int t=0; t<OMP_NTHREAD*NHis; t++)
+   {
+      W_TH  [t] = 0.0;
+      WQ_TH [t] = 0.0;
+      WQQ_TH[t] = 0.0;
+      Max_TH[t] = -__DBL_MAX__;
+      Min_TH[t] = +__DBL_MAX__;
+   }
+
+   for (int lv=0; lv<NLEVEL; lv++)
+   {
+      const int    Scale = patch->scale[lv];
+      const int    FluSg = patch->FluSg[lv];
+      const double dh    = patch->dh[lv];
+      const double dv    = dh*dh*dh;
+
+#     pragma omp parallel
+      {
+#        ifdef OPENMP
+         const int TID = omp_get_thread_num();
+#        else
+         const int TID = 0;
+#        endif
+
+         double *Volume = Volume_TH + TID*NShell;
+         long   *NCount = NCount_TH + TID*NShell;
+         double *W      = W_TH      + TID*NHis;
+         double *WQ     = WQ_TH     + TID*NHis;
+         double *WQQ    = WQQ_TH    + TID*NHis;
+         double *Max    = Max_TH    + TID*NHis;
+         double *Min    = Min_TH    + TID*NHis;
+
+         double (*Cand)[NRec] = ( OPT__SPHERE_MAXRHO_CEN ) ? Cand_TH[TID] : NULL;
+         int    MinID = 0;
+
+         if ( OPT__SPHERE_MAXRHO_CEN )
+         for (int t=1; t<NMaxRho; t++)    if ( Cand[t][0] < Cand[MinID][0] )  MinID = t;
+
+         double dr[3], Radius, Half, Dist2, Weight[NVar], Var[NVar];
+         int    ShellID;
+         bool   InSphere;
+
+#        pragma omp for schedule( dynamic )
+         for (int PID=0; PID<patch->NPatchComma[lv][1]; PID++)
+         {
+            if ( patch->ptr[0][lv][PID]->son != -1 )  continue;
+
+            const int *Corner = patch->ptr[0][lv][PID]->corner;
+
+//          skip the patches entirely outside the sphere (unless they must be searched for the highest-density cells)
+            Half  = 0.5*PATCH_SIZE*dh;
+            Dist2 = 0.0;
+
+            for (int d=0; d<3; d++)
+            {
+               dr[d]  = fabs( MinImageDist( Corner[d]*dh_min + Half - Center[d], patch->BoxSize[d] ) ) - Half;
+               Dist2 += ( dr[d] > 0.0 ) ? dr[d]*dr[d] : 0.0;
+            }
+
+            InSphere = ( Dist2 < MaxRadius*MaxRadius );
+
+            if ( !InSphere  &&  !OPT__SPHERE_MAXRHO_CEN )   continue;
+
+
+            const real (*Fluid)[PS1][PS1][PS1] = patch->ptr[FluSg][lv][PID]->fluid;
+
+            for (int k=0; k<PS1; k++)  {  dr[2] = MinImageDist( ( Corner[2] + (k+0.5)*Scale )*dh_min - Center[2],
+                                                                patch->BoxSize[2] );
+            for (int j=0; j<PS1; j++)  {  dr[1] = MinImageDist( ( Corner[1] + (j+0.5)*Scale )*dh_min - Center[1],
+                                                                patch->BoxSize[1] );
+            for (int i=0; i<PS1; i++)  {  dr[0] = MinImageDist( ( Corner[0] + (i+0.5)*Scale )*dh_min - Center[0],
+                                                                patch->BoxSize[0] );
+
+//             record the highest-density cells for the center of the next invocation
+               if ( OPT__SPHERE_MAXRHO_CEN  &&  Fluid[DENS][k][j][i] > Cand[MinID][0] )
+               {
+                  Cand[MinID][0] = Fluid[DENS][k][j][i];
+                  Cand[MinID][1] = Fluid[DENS][k][j][i]*dv;
+                  Cand[MinID][2] = ( Corner[0] + (i+0.5)*Scale )*dh_min;
+                  Cand[MinID][3] = ( Corner[1] + (j+0.5)*Scale )*dh_min;
+                  Cand[MinID][4] = ( Corner[2] + (k+0.5)*Scale )*dh_min;
+
+                  MinID = 0;
+                  for (int t=1; t<NMaxRho; t++)    if ( Cand[t][0] < Cand[MinID][0] )  MinID = t;
+               }
+
+               if ( !InSphere )  continue;
+
+               Radius = sqrt( dr[0]*dr[0] + dr[1]*dr[1] + dr[2]*dr[2] );
+
+               if ( Radius >= MaxRadius )    continue;
+
+               ShellID = MIN( (int)( Radius/ShellWidth ), NShell-1 );
+
+#              if   ( MODEL == HYDRO )
+               const double Rho  = Fluid[DENS][k][j][i];
+               const double Px   = Fluid[MOMX][k][j][i];
+               const double Py   = Fluid[MOMY][k][j][i];
+               const double Pz   = Fluid[MOMZ][k][j][i];
+               const double P2   = Px*Px + Py*Py + Pz*Pz;
+               const double Pr   = ( Radius > 0.0 ) ? ( dr[0]*Px + dr[1]*Py + dr[2]*Pz )/Radius : 0.0;
+               const double Pt   = sqrt( fabs(P2 - Pr*Pr) );
+
+               Var   [0] = Rho;
+               Var   [1] = Pr/Rho;
+               Var   [2] = Pt/Rho;
+               Var   [3] = Fluid[ENGY][k][j][i];
+               Var   [4] = ( GAMMA - 1.0 )*( Var[3] - 0.5*P2/Rho );
+
+               Weight[0] = dv;
+               Weight[1] = dv*Rho;
+               Weight[2] = dv*Rho;
+               Weight[3] = dv;
+               Weight[4] = dv;
+
+#              elif ( MODEL == MHD )
+#              warning : WAIT MHD !!!
+
+#              elif ( MODEL == ELBDM )
+               for (int v=0; v<NVar; v++)
+               {
+                  Var   [v] = Fluid[v][k][j][i];
+                  Weight[v] = dv;
+               }
+
+#              else
+#              error : ERROR : unsupported MODEL !!
+#              endif // MODEL
+
+               for (int v=0; v<NVar; v++)
+               {
+                  const int Idx = ShellID*NVar + v;
+
+                  W  [Idx] += Weight[v];
+                  WQ [Idx] += Weight[v]*Var[v];
+                  WQQ[Idx] += Weight[v]*Var[v]*Var[v];
+                  Max[Idx]  = MAX( Max[Idx], Var[v] );
+                  Min[Idx]  = MIN( Min[Idx], Var[v] );
+               }
+
+               Volume[ShellID] += dv;
+               NCount[ShellID] ++;
+
+            }}} // k, j, i
+         } // for (int PID=0; PID<patch->NPatchComma[lv][1]; PID++)
+      } // OpenMP parallel region
+   } // for (int lv=0; lv<NLEVEL; lv++)
+
+
+// 3. sum over all threads (stored in the histograms of thread 0) and all ranks
+// ===========================================================================================
+   for (int TID=1; TID<OMP_NTHREAD; TID++)
+   {
+      for (int t=0; t<NShell; t++)
+      {
+         Volume_TH[t] += Volume_TH[ TID*NShell + t ];
+         NCount_TH[t] += NCount_TH[ TID*NShell + t ];
+      }
+
+      for (int t=0; t<NHis; t++)
+      {
+         W_TH  [t] += W_TH  [ TID*NHis + t ];
+         WQ_TH [t] += WQ_TH [ TID*NHis + t ];
+         WQQ_TH[t] += WQQ_TH[ TID*NHis + t ];
+         Max_TH[t]  = MAX( Max_TH[t], Max_TH[ TID*NHis + t ] );
+         Min_TH[t]  = MIN( Min_TH[t], Min_TH[ TID*NHis + t ] );
+      }
+   }
+
+   double *Volume = new double [NShell];
+   long   *NCount = new long   [NShell];
+   double *W      = new double [NHis];
+   double *WQ     = new double [NHis];
+   double *WQQ    = new double [NHis];
+   double *Max    = new double [NHis];
+   double *Min    = new double [NHis];
+
+   MPI_Reduce( Volume_TH, Volume, NShell, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
+   MPI_Reduce( NCount_TH, NCount, NShell, MPI_LONG,   MPI_SUM, 0, MPI_COMM_WORLD );
+   MPI_Reduce( W_TH,      W,      NHis,   MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
+   MPI_Reduce( WQ_TH,     WQ,     NHis,   MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
+   MPI_Reduce( WQQ_TH,    WQQ,    NHis,   MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
+   MPI_Reduce( Max_TH,    Max,    NHis,   MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD );
+   MPI_Reduce( Min_TH,    Min,    NHis,   MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD );
+
+   if ( OPT__SPHERE_MAXRHO_CEN )
+   {
+      MergeMaxRhoCand( Cand_TH, NextCenter, MaxRho );
+      NextCenter_Ready = true;
+   }
+
+   else if ( MPI_Rank == 0 )
+   {
+      MaxRho = -__DBL_MAX__;
+      for (int n=0; n<NShell; n++)  if ( NCount[n] > 0 )    MaxRho = MAX( MaxRho, Max[ n*NVar + 0 ] );
+   }
+
+
+// 4. output the profiles
+// ===========================================================================================
+   if ( MPI_Rank == 0 )
+   {
+      FILE *File = fopen( FileName, "a" );
+
+      fprintf( File, "# Step %ld  Time %20.14e  Center ( %13.7e, %13.7e, %13.7e )  MaxDens %13.7e\n",
+               Step, Time[0], Center[0], Center[1], Center[2], MaxRho );
+      fprintf( File, "# %11s  %10s  %13s", "Radius", "NCount", "Volume" );
+      for (int v=0; v<NVar; v++)
+         fprintf( File, "  %8s_Ave  %8s_RMS  %8s_Max  %8s_Min", VarName[v], VarName[v], VarName[v], VarName[v] );
+#     ifdef DENS
+      fprintf( File, "  %13s", "AccMass" );
+#     endif
+      fprintf( File, "\n" );
+
+      double AccMass = 0.0, Ave, RMS;
+
+      for (int n=0; n<NShell; n++)
+      {
+         fprintf( File, "  %11.5e  %10ld  %13.6e", (n+0.5)*ShellWidth, NCount[n], Volume[n] );
+
+         for (int v=0; v<NVar; v++)
+         {
+            const int Idx = n*NVar + v;
+
+            if ( NCount[n] > 0 )
+            {
+               Ave = WQ[Idx]/W[Idx];
+               RMS = sqrt(  fabs( WQQ[Idx]/W[Idx] - Ave*Ave )  );
+
+               fprintf( File, "  %13.6e  %13.6e  %13.6e  %13.6e", Ave, RMS, Max[Idx], Min[Idx] );
+            }
+
+            else
+               fprintf( File, "  %13.6e  %13.6e  %13.6e  %13.6e", 0.0, 0.0, 0.0, 0.0 );
+         }
+
+#        ifdef DENS
+         AccMass += WQ[ n*NVar + DENS ];
+         fprintf( File, "  %13.6e", AccMass );
+#        endif
+
+         fprintf( File, "\n" );
+      }
+
+      fprintf( File, "\n" );
+      fclose( File );
+   } // if ( MPI_Rank == 0 )
+
+
+   delete [] Volume_TH;
+   delete [] NCount_TH;
+   delete [] W_TH;
+   delete [] WQ_TH;
+   delete [] WQQ_TH;
+   delete [] Max_TH;
+   delete [] Min_TH;
+   delete [] Cand_TH;
+   delete [] Volume;
+   delete [] NCount;
+   delete [] W;
+   delete [] WQ;
+   delete [] WQQ;
+   delete [] Max;
+   delete [] Min;
+
+} // FUNCTION : Aux_SphereAnalysis
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  GetMaxRhoCenter
+// Description :  Get the mass-weighted center of the NMaxRho highest-density leaf cells among all ranks
+//
+// Note        :  Invoked by "Aux_SphereAnalysis" only for the first analysis, for which no center has been
+//                obtained from the previous shell accumulation
+//
+// Parameter   :  Center : Coordinates of the center to be returned
+//                MaxRho : Maximum density to be returned
+//-------------------------------------------------------------------------------------------------------
+void GetMaxRhoCenter( double Center[], double &MaxRho )
+{
+
+   double (*Cand_TH)[NMaxRho][NRec] = new double [OMP_NTHREAD][NMaxRho][NRec];
+
+   for (int TID=0; TID<OMP_NTHREAD; TID++)
+   for (int t=0; t<NMaxRho; t++)
+   {
+      Cand_TH[TID][t][0] = -__DBL_MAX__;
+      for (int r=1; r<NRec; r++)    Cand_TH[TID][t][r] = 0.0;
+   }
+
+
+// 1. get the NMaxRho highest-density cells in each thread
+   const double dh_min = patch->dh[NLEVEL-1];
+
+   for (int lv=0; lv<NLEVEL; lv++)
+   {
+      const int    Scale = patch->scale[lv];
+      const int    FluSg = patch->FluSg[lv];
+      const double dv    = patch->dh[lv]*patch->dh[lv]*patch->dh[lv];
+
+#     pragma omp parallel
+      {
+#        ifdef OPENMP
+         const int TID = omp_get_thread_num();
+#        else
+         const int TID = 0;
+#        endif
+
+         double (*Cand)[NRec] = Cand_TH[TID];
+         int    MinID = 0;
+         double Rho;
+
+         for (int t=1; t<NMaxRho; t++)    if ( Cand[t][0] < Cand[MinID][0] )  MinID = t;
+
+#        pragma omp for schedule( dynamic )
+         for (int PID=0; PID<patch->NPatchComma[lv][1]; PID++)
+         {
+            if ( patch->ptr[0][lv][PID]->son != -1 )  continue;
+
+            const int *Corner = patch->ptr[0][lv][PID]->corner;
+
+            for (int k=0; k<PS1; k++)
+            for (int j=0; j<PS1; j++)
+            for (int i=0; i<PS1; i++)
+            {
+               Rho = patch->ptr[FluSg][lv][PID]->fluid[DENS][k][j][i];
+
+               if ( Rho <= Cand[MinID][0] )  continue;
+
+               Cand[MinID][0] = Rho;
+               Cand[MinID][1] = Rho*dv;
+               Cand[MinID][2] = ( Corner[0] + (i+0.5)*Scale )*dh_min;
+               Cand[MinID][3] = ( Corner[1] + (j+0.5)*Scale )*dh_min;
+               Cand[MinID][4] = ( Corner[2] + (k+0.5)*Scale )*dh_min;
+
+               MinID = 0;
+               for (int t=1; t<NMaxRho; t++)    if ( Cand[t][0] < Cand[MinID][0] )  MinID = t;
+            }
+         }
+      } // OpenMP parallel region
+   } // for (int lv=0; lv<NLEVEL; lv++)
+
+
+// 2. get the center from the candidates of all threads and ranks
+   MergeMaxRhoCand( Cand_TH, Center, MaxRho );
+
+   delete [] Cand_TH;
+
+} // FUNCTION : GetMaxRhoCenter
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  MergeMaxRhoCand
+// Description :  Get the mass-weighted center of the NMaxRho highest-density cells from the candidates
+//                recorded by all OpenMP threads in all ranks
+//
+// Note        :  The candidates of thread 0 are overwritten by the merged candidates of this rank
+//
+// Parameter   :  Cand_TH : Candidates recorded by each thread (see "NRec" for the record format)
+//                Center  : Coordinates of the center to be returned
+//                MaxRho  : Maximum density to be returned
+//-------------------------------------------------------------------------------------------------------
+void MergeMaxRhoCand( double (*Cand_TH)[NMaxRho][NRec], double Center[], double &MaxRho )
+{
+
+   const int NAll = NMaxRho*MPI_NRank;
+
+   double (*Cand_All)[NRec] = new double [NAll][NRec];
+
+
+// 1. merge the candidates of all threads (into thread 0) and gather the candidates of all ranks
+   for (int TID=1; TID<OMP_NTHREAD; TID++)
+   for (int t=0; t<NMaxRho; t++)
+   {
+      int MinID = 0;
+      for (int s=1; s<NMaxRho; s++)    if ( Cand_TH[0][s][0] < Cand_TH[0][MinID][0] )   MinID = s;
+
+      if ( Cand_TH[TID][t][0] > Cand_TH[0][MinID][0] )
+         for (int r=0; r<NRec; r++)    Cand_TH[0][MinID][r] = Cand_TH[TID][t][r];
+   }
+
+   MPI_Gather( (double*)Cand_TH, NMaxRho*NRec, MPI_DOUBLE, (double*)Cand_All, NMaxRho*NRec, MPI_DOUBLE, 0,
+               MPI_COMM_WORLD );
+
+
+// 2. get the mass-weighted center of the NMaxRho highest-density cells of all ranks
+   double Info[4] = { 0.0, 0.0, 0.0, 0.0 };     // [Center(x,y,z), MaxRho]
+
+   if ( MPI_Rank == 0 )
+   {
+//    select the NMaxRho highest-density cells (NAll is small --> simple selection)
+      bool   *Used = new bool [NAll];
+      int    Sel[NMaxRho], NSel = 0;
+
+      for (int t=0; t<NAll; t++)    Used[t] = ( Cand_All[t][0] == -__DBL_MAX__ );
+
+      for (int n=0; n<NMaxRho; n++)
+      {
+         int MaxID = -1;
+
+         for (int t=0; t<NAll; t++)
+            if (  !Used[t]  &&  ( MaxID == -1  ||  Cand_All[t][0] > Cand_All[MaxID][0] )  )   MaxID = t;
+
+         if ( MaxID == -1 )   break;
+
+         Used[MaxID] = true;
+         Sel[ NSel ++ ] = MaxID;
+      }
+
+      if ( NSel == 0 )  Aux_Error( ERROR_INFO, "no leaf cell is found !!\n" );
+
+//    measure the positions relative to the densest cell to handle the periodic B.C.
+      const double *Ref = Cand_All[ Sel[0] ] + 2;
+      double Mass, MassSum = 0.0, PosSum[3] = { 0.0, 0.0, 0.0 };
+
+      for (int n=0; n<NSel; n++)
+      {
+         const double *Rec = Cand_All[ Sel[n] ];
+
+         Mass     = Rec[1];
+         MassSum += Mass;
+
+         for (int d=0; d<3; d++)    PosSum[d] += Mass*MinImageDist( Rec[2+d] - Ref[d], patch->BoxSize[d] );
+      }
+
+      for (int d=0; d<3; d++)
+      {
+         Info[d] = Ref[d] + PosSum[d]/MassSum;
+         Info[d] = Info[d] - patch->BoxSize[d]*floor( Info[d]/patch->BoxSize[d] );
+      }
+
+      Info[3] = Cand_All[ Sel[0] ][0];
+
+      delete [] Used;
+   }
+
+   MPI_Bcast( Info, 4, MPI_DOUBLE, 0, MPI_COMM_WORLD );
+
+   for (int d=0; d<3; d++)    Center[d] = Info[d];
+   MaxRho = Info[3];
+
+
+   delete [] Cand_All;
+
+} // FUNCTION : MergeMaxRhoCand
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  MinImageDist
+// Description :  Return the minimum-image displacement of "dr" for the periodic box of size "Box"
+//-------------------------------------------------------------------------------------------------------
+double MinImageDist( const double dr, const double Box )
+{
+
+   return dr - Box*floor( dr/Box + 0.5 );
+
+} // FUNCTION : MinImageDist
@@ -127,6 +127,8 @@ void Aux_TakeNote()
       fprintf( Note, "RSOLVER                   HLLE\n" );
 #     elif ( RSOLVER == HLLC )            
       fprintf( Note, "RSOLVER                   HLLC\n" );
+#     elif ( RSOLVER == HYBRID )
+      fprintf( Note, "RSOLVER                   HYBRID\n" );
 #     elif ( RSOLVER == NONE )            
       fprintf( Note, "RSOLVER                   NONE\n" );
 #     else
@@ -181,6 +183,12 @@ void Aux_TakeNote()
 #     else
       fprintf( Note, "TIMING_SOLVER             OFF\n" );
 #     endif
+
+#     ifdef TIMING_PATCH
+      fprintf( Note, "TIMING_PATCH              ON\n" );
+#     else
+      fprintf( Note, "TIMING_PATCH              OFF\n" );
+#     endif
    
 #     ifdef INTEL
       fprintf( Note, "Compiler                  Intel\n" );
@@ -314,7 +322,7 @@ void Aux_TakeNote()
       fprintf( Note, "#define GRA_NIN           %d\n",      GRA_NIN                 );
 #     endif
       fprintf( Note, "#define PATCH_SIZE        %d\n",      PATCH_SIZE              );
-      fprintf( Note, "#define MAX_PATCH         %d\n",      MAX_PATCH               );
+      fprintf( Note, "#define PATCH_CHUNK_SIZE  %d\n",      PATCH_CHUNK_SIZE        );
       fprintf( Note, "#define NLEVEL            %d\n",      NLEVEL                  );
       fprintf( Note, "\n" );
       fprintf( Note, "#define FLU_GHOST_SIZE    %d\n",      FLU_GHOST_SIZE          );
@@ -373,6 +381,8 @@ void Aux_TakeNote()
       fprintf( Note, "MPI_NRank_X[1]            %d\n",      MPI_NRank_X[1]          );
       fprintf( Note, "MPI_NRank_X[2]            %d\n",      MPI_NRank_X[2]          );
       fprintf( Note, "OMP_NTHREAD               %d\n",      OMP_NTHREAD             );
+      fprintf( Note, "OPT__THREAD_AFFINITY      %d\n",      OPT__THREAD_AFFINITY    );
+      fprintf( Note, "OPT__NUMA_FIRST_TOUCH     %d\n",      OPT__NUMA_FIRST_TOUCH   );
       fprintf( Note, "END_T                     %13.7e\n",  END_T                   );
       fprintf( Note, "END_STEP                  %ld\n",     END_STEP                );
       fprintf( Note, "***********************************************************************************\n" );
@@ -442,6 +452,7 @@ void Aux_TakeNote()
       fprintf( Note, "OPT__FLAG_LOHNER          %d\n",      OPT__FLAG_LOHNER        );
       fprintf( Note, "OPT__FLAG_USER            %d\n",      OPT__FLAG_USER          );
       fprintf( Note, "OPT__PATCH_COUNT          %d\n",      OPT__PATCH_COUNT        );
+      fprintf( Note, "OPT__PATCH_ORDER          %d\n",      OPT__PATCH_ORDER        );
       fprintf( Note, "***********************************************************************************\n" );
       fprintf( Note, "\n\n");
    
@@ -483,6 +494,7 @@ void Aux_TakeNote()
                                                             ( OPT__WAF_LIMITER == WAF_MINBEE   ) ? "WAF_MINBEE"  :
                                                             ( OPT__WAF_LIMITER == WAF_LIMITER_NONE ) ? "NONE"    :
                                                                                                    "UNKNOWN" );
+      fprintf( Note, "OPT__FLU_SCHEME_LV        %d\n",      OPT__FLU_SCHEME_LV      );
 #     elif ( MODEL == MHD )
 #     warning : WAIT MHD !!!
 
@@ -503,6 +515,7 @@ void Aux_TakeNote()
       fprintf( Note, "***********************************************************************************\n" );
       fprintf( Note, "FLU_GPU_NPGROUP           %d\n",      FLU_GPU_NPGROUP         );
       fprintf( Note, "GPU_NSTREAM               %d\n",      GPU_NSTREAM             );
+      fprintf( Note, "OPT__TUNE_NPGROUP         %d\n",      OPT__TUNE_NPGROUP       );
       fprintf( Note, "OPT__FIXUP_FLUX           %d\n",      OPT__FIXUP_FLUX         );
       fprintf( Note, "OPT__FIXUP_RESTRICT       %d\n",      OPT__FIXUP_RESTRICT     );
       fprintf( Note, "OPT__OVERLAP_MPI          %d\n",      OPT__OVERLAP_MPI        );     
@@ -534,6 +547,7 @@ void Aux_TakeNote()
       fprintf( Note, "SOR_OMEGA                 %13.7e\n",  SOR_OMEGA               );
       fprintf( Note, "SOR_MAX_ITER              %d\n",      SOR_MAX_ITER            );
       fprintf( Note, "SOR_MIN_ITER              %d\n",      SOR_MIN_ITER            );
+      fprintf( Note, "SOR_TOLERATED_ERROR       %13.7e\n",  SOR_TOLERATED_ERROR     );
 #     elif ( POT_SCHEME == MG )
       fprintf( Note, "MG_MAX_ITER               %d\n",      MG_MAX_ITER             );
       fprintf( Note, "MG_NPRE_SMOOTH            %d\n",      MG_NPRE_SMOOTH          );
@@ -542,6 +556,7 @@ void Aux_TakeNote()
 #     endif
       fprintf( Note, "POT_GPU_NPGROUP           %d\n",      POT_GPU_NPGROUP         );
       fprintf( Note, "OPT__GRA_P5_GRADIENT      %d\n",      OPT__GRA_P5_GRADIENT    );
+      fprintf( Note, "OPT__POT_WARM_START       %d\n",      OPT__POT_WARM_START     );
       fprintf( Note, "Average Density           %13.7e\n",  AveDensity              );
       fprintf( Note, "***********************************************************************************\n" );
       fprintf( Note, "\n\n");
@@ -553,6 +568,8 @@ void Aux_TakeNote()
       fprintf( Note, "***********************************************************************************\n" );
       fprintf( Note, "OPT__INIT                 %d\n",      OPT__INIT               );
       fprintf( Note, "OPT__RESTART_HEADER       %d\n",      OPT__RESTART_HEADER     );
+      fprintf( Note, "OPT__RESTART_REGRID       %d\n",      OPT__RESTART_REGRID     );
+      fprintf( Note, "OPT__RESTART_CRC          %d\n",      OPT__RESTART_CRC        );
       fprintf( Note, "OPT__UM_START_LEVEL       %d\n",      OPT__UM_START_LEVEL     );
       fprintf( Note, "OPT__UM_START_NVAR        %d\n",      OPT__UM_START_NVAR      );
       fprintf( Note, "OPT__INIT_RESTRICT        %d\n",      OPT__INIT_RESTRICT      );
@@ -628,9 +645,13 @@ void Aux_TakeNote()
       fprintf( Note, "Parameters of Data Dump\n" );
       fprintf( Note, "***********************************************************************************\n" );
       fprintf( Note, "OPT__OUTPUT_TOTAL         %d\n",      OPT__OUTPUT_TOTAL       );
+      fprintf( Note, "OPT__OUTPUT_DELTA         %d\n",      OPT__OUTPUT_DELTA       );
+      fprintf( Note, "OPT__OUTPUT_CRC           %d\n",      OPT__OUTPUT_CRC         );
       fprintf( Note, "OPT__OUTPUT_PART          %d\n",      OPT__OUTPUT_PART        );
+      fprintf( Note, "OPT__OUTPUT_PART_BIN      %d\n",      OPT__OUTPUT_PART_BIN    );
       fprintf( Note, "OPT__OUTPUT_ERROR         %d\n",      OPT__OUTPUT_ERROR       );
       fprintf( Note, "OPT__OUTPUT_BASEPS        %d\n",      OPT__OUTPUT_BASEPS      );
+      fprintf( Note, "OPT__RECORD_BASEPS        %d\n",      OPT__RECORD_BASEPS      );
       fprintf( Note, "OPT__OUTPUT_BASE          %d\n",      OPT__OUTPUT_BASE        );
 #     ifdef GRAVITY
       fprintf( Note, "OPT__OUTPUT_POT           %d\n",      OPT__OUTPUT_POT         );
@@ -641,7 +662,12 @@ void Aux_TakeNote()
       fprintf( Note, "OUTPUT_PART_X             %13.7e\n",  OUTPUT_PART_X           );
       fprintf( Note, "OUTPUT_PART_Y             %13.7e\n",  OUTPUT_PART_Y           );
       fprintf( Note, "OUTPUT_PART_Z             %13.7e\n",  OUTPUT_PART_Z           );
+      fprintf( Note, "OUTPUT_PART_LV            %d\n",      OUTPUT_PART_LV          );
       fprintf( Note, "INIT_DUMPID               %d\n",      INIT_DUMPID             );
+      fprintf( Note, "OPT__SPHERE_ANALYSIS      %d\n",      OPT__SPHERE_ANALYSIS    );
+      fprintf( Note, "SPHERE_NSHELL             %d\n",      SPHERE_NSHELL           );
+      fprintf( Note, "SPHERE_MAX_RADIUS         %13.7e\n",  SPHERE_MAX_RADIUS       );
+      fprintf( Note, "OPT__SPHERE_MAXRHO_CEN    %d\n",      OPT__SPHERE_MAXRHO_CEN  );
       fprintf( Note, "***********************************************************************************\n" );
       fprintf( Note, "\n\n");
 
@@ -676,6 +702,26 @@ void Aux_TakeNote()
       fprintf( Note, "\n\n");
    
    
+//    record the data reconstruction, Riemann solver, and slope limiter at each level
+#     ifdef RUNTIME_FLU_SCHEME
+      if ( OPT__FLU_SCHEME_LV )
+      {
+         const char LR_Name [][ 4] = { "", "PLM", "PPM" };
+         const char RS_Name [][ 7] = { "", "EXACT", "ROE", "HLLE", "HLLC", "HYBRID" };
+         const char Lim_Name[][11] = { "NONE", "VANLEER", "GMINMOD", "ALBADA", "VL_GMINMOD", "EXTPRE" };
+
+         fprintf( Note, "Fluid Scheme at Each Level (Input__FluScheme)\n" );
+         fprintf( Note, "***********************************************************************************\n" );
+         fprintf( Note, "  Level       LR_Scheme         RSolver      LR_Limiter\n" );
+         for (int lv=0; lv<NLEVEL; lv++)
+            fprintf( Note, "%7d%16s%16s%16s\n", lv, LR_Name[ FluSchemeTable_LR[lv] ],
+                     RS_Name[ FluSchemeTable_RSolver[lv] ], Lim_Name[ FluSchemeTable_Limiter[lv] ] );
+         fprintf( Note, "***********************************************************************************\n" );
+         fprintf( Note, "\n\n");
+      }
+#     endif
+
+
 //    record the flag criterion (density/density gradient/pressure gradient/user-defined)
       if ( OPT__FLAG_RHO )   
       {
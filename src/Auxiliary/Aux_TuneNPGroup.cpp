@@ -0,0 +1,364 @@
+
+#include "DAINO.h"
+
+#define TUNE_MAX_NCAND  16
+
+// solver arrays : [0/1] = fluid/Poisson-gravity solvers
+static bool    Initialized = false;
+static int     NCand   [2];                          // number of candidate batch sizes
+static int     Cand    [2][TUNE_MAX_NCAND];          // candidate batch sizes
+static int     Capacity[2];                          // number of patch groups allocated in the solver arrays
+
+// tuning state of each level and solver
+static int     Stage   [NLEVEL][4];                  // index of the candidate being measured (NCand --> done)
+static int     NCall   [NLEVEL][4];                  // number of calls measured for the current candidate
+static double  Cost    [NLEVEL][4][TUNE_MAX_NCAND];  // accumulated elapsed time per patch group of each candidate
+static int     Best    [NLEVEL][4];                  // selected batch size (-1 --> not determined yet)
+static int     Demand  [NLEVEL][4];                  // batch size of the last call (0 --> never invoked)
+static int     Retune  [NLEVEL][4];                  // number of patch groups to trigger re-tuning (0 --> never)
+
+static Timer_t Timer_Tune( 1 );
+
+static void Init();
+static void Finalize( const Solver_t TSolver, const int lv );
+static void Resize( const int Type, const bool AllowShrink );
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Aux_TuneNPGroup_Get
+// Description :  Return the number of patch groups to be sent into the CPU solver "TSolver" at a time at
+//                level "lv"
+//
+// Note        :  1. Return FLU_GPU_NPGROUP/POT_GPU_NPGROUP if OPT__TUNE_NPGROUP is off (always off for GPU)
+//                2. Otherwise return the candidate being measured, or the selected value once the tuning of
+//                   the targeted level and solver is done
+//
+// Parameter   :  TSolver : Targeted solver
+//                lv      : Targeted refinement level
+//-------------------------------------------------------------------------------------------------------
+int Aux_TuneNPGroup_Get( const Solver_t TSolver, const int lv )
+{
+
+   const int Type = ( TSolver == FLUID_SOLVER ) ? 0 : 1;
+
+   if ( OPT__TUNE_NPGROUP <= 0 )
+   {
+#     ifdef GRAVITY
+      return ( Type == 0 ) ? FLU_GPU_NPGROUP : POT_GPU_NPGROUP;
+#     else
+      return FLU_GPU_NPGROUP;
+#     endif
+   }
+
+   if ( !Initialized )  Init();
+
+   return ( Best[lv][TSolver] > 0 ) ? Best[lv][TSolver] : Cand[Type][ Stage[lv][TSolver] ];
+
+} // FUNCTION : Aux_TuneNPGroup_Get
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Aux_TuneNPGroup_Begin
+// Description :  Get the batch size of the CPU solver "TSolver" at level "lv" and start timing the solver
+//
+// Note        :  1. Invoked by "InvokeSolver" before preparing the first batch
+//                2. The solver arrays are enlarged here if the batch size exceeds their current size
+//                   --> the reallocation is excluded from the measured time
+//
+// Parameter   :  TSolver : Targeted solver
+//                lv      : Targeted refinement level
+//
+// Return      :  Number of patch groups to be sent into the solver at a time
+//-------------------------------------------------------------------------------------------------------
+int Aux_TuneNPGroup_Begin( const Solver_t TSolver, const int lv )
+{
+
+   const int NPG = Aux_TuneNPGroup_Get( TSolver, lv );
+
+   if ( OPT__TUNE_NPGROUP > 0 )
+   {
+      Demand[lv][TSolver] = NPG;
+
+      Resize( ( TSolver == FLUID_SOLVER ) ? 0 : 1, false );
+
+      Timer_Tune.Reset();
+      Timer_Tune.Start();
+   }
+
+   return NPG;
+
+} // FUNCTION : Aux_TuneNPGroup_Begin
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Aux_TuneNPGroup_End
+// Description :  Stop timing the CPU solver "TSolver" at level "lv" and move on to the next candidate
+//                batch size after OPT__TUNE_NPGROUP measurements
+//
+// Note        :  1. Invoked by "InvokeSolver" after the last closing step
+//                2. The first call of each candidate is a warm-up call and is not measured, since it may
+//                   touch the newly-allocated solver arrays for the first time
+//                3. Must be invoked by all MPI ranks (the measurements of all ranks are compared once the
+//                   last candidate is measured)
+//                4. A candidate larger than the number of patch groups of this level (maximum over all ranks)
+//                   cannot be measured since the solver never receives a full batch
+//                   --> The tuning is completed with the candidates measured so far, and is restarted once
+//                       the level has grown to the smallest skipped candidate
+//
+// Parameter   :  TSolver : Targeted solver
+//                lv      : Targeted refinement level
+//                NTotal  : Total number of patch groups updated in this call
+//-------------------------------------------------------------------------------------------------------
+void Aux_TuneNPGroup_End( const Solver_t TSolver, const int lv, const int NTotal )
+{
+
+   if ( OPT__TUNE_NPGROUP <= 0 )    return;
+   if ( Best[lv][TSolver] > 0  &&  Retune[lv][TSolver] == 0 )  return;
+
+   Timer_Tune.Stop( false );
+
+   const int Type = ( TSolver == FLUID_SOLVER ) ? 0 : 1;
+
+
+// get the maximum number of patch groups over all ranks so that all ranks take the same branch
+   int NTotal_Max;
+   MPI_Allreduce( (int*)&NTotal, &NTotal_Max, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD );
+
+
+// restart the tuning if the level has grown enough to measure the candidates skipped last time
+   if ( Best[lv][TSolver] > 0 )
+   {
+      if ( NTotal_Max >= Retune[lv][TSolver] )
+      {
+         Stage [lv][TSolver] = 0;
+         NCall [lv][TSolver] = 0;
+         Best  [lv][TSolver] = -1;
+         Retune[lv][TSolver] = 0;
+
+         for (int c=0; c<TUNE_MAX_NCAND; c++)   Cost[lv][TSolver][c] = 0.0;
+      }
+
+      return;
+   }
+
+
+// skip the measurement of any candidate larger than the level
+   if ( NTotal_Max == 0 )  return;
+
+   if ( Cand[Type][ Stage[lv][TSolver] ] > NTotal_Max )
+   {
+      Finalize( TSolver, lv );
+      return;
+   }
+
+   if ( NCall[lv][TSolver] > 0 )
+      Cost[lv][TSolver][ Stage[lv][TSolver] ] += Timer_Tune.GetValue( 0 ) / NTotal;
+
+   if ( ++NCall[lv][TSolver] > OPT__TUNE_NPGROUP )
+   {
+      NCall[lv][TSolver] = 0;
+      Stage[lv][TSolver] ++;
+   }
+
+   if ( Stage[lv][TSolver] == NCand[Type] )  Finalize( TSolver, lv );
+
+} // FUNCTION : Aux_TuneNPGroup_End
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Init
+// Description :  Set the candidate batch sizes and initialize the tuning state
+//
+// Note        :  1. Candidates = OMP_NTHREAD*2^n up to twice the input batch size, plus the input batch size
+//                   (FLU_GPU_NPGROUP/POT_GPU_NPGROUP) itself
+//                2. The solver arrays have been allocated with the input batch sizes by "Init_MemAllocate"
+//-------------------------------------------------------------------------------------------------------
+void Init()
+{
+
+#  ifdef OPENMP
+   const int Base = OMP_NTHREAD;
+#  else
+   const int Base = 1;
+#  endif
+
+   for (int Type=0; Type<2; Type++)
+   {
+#     ifdef GRAVITY
+      const int NPG_Input = ( Type == 0 ) ? FLU_GPU_NPGROUP : POT_GPU_NPGROUP;
+#     else
+      const int NPG_Input = FLU_GPU_NPGROUP;
+#     endif
+
+      int *TCand = Cand[Type];
+      int  c     = 0;
+
+      NCand[Type] = 0;
+
+      for (int NPG=Base; NPG<=2*NPG_Input  &&  NCand[Type]<TUNE_MAX_NCAND-1; NPG*=2)
+         TCand[ NCand[Type] ++ ] = NPG;
+
+//    insert the input batch size in order
+      while ( c < NCand[Type]  &&  TCand[c] < NPG_Input )   c ++;
+
+      if ( c == NCand[Type]  ||  TCand[c] != NPG_Input )
+      {
+         for (int t=NCand[Type]; t>c; t--)   TCand[t] = TCand[t-1];
+
+         TCand[c] = NPG_Input;
+         NCand[Type] ++;
+      }
+
+      Capacity[Type] = NPG_Input;
+   }
+
+   for (int lv=0; lv<NLEVEL; lv++)
+   for (int s=0; s<4; s++)
+   {
+      Stage [lv][s] = 0;
+      NCall [lv][s] = 0;
+      Best  [lv][s] = -1;
+      Demand[lv][s] = 0;
+      Retune[lv][s] = 0;
+
+      for (int c=0; c<TUNE_MAX_NCAND; c++)   Cost[lv][s][c] = 0.0;
+   }
+
+   Initialized = true;
+
+} // FUNCTION : Init
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Finalize
+// Description :  Select the batch size of the CPU solver "TSolver" at level "lv", record it in the file
+//                "Record__NPGroup", and shrink the solver arrays if possible
+//
+// Note        :  1. The cost of each candidate is taken as the maximum over all MPI ranks
+//                2. The smallest candidate whose cost is within 2% of the minimum is selected, which
+//                   minimizes the memory footprint among the equally efficient candidates
+//                3. Only the candidates before the current stage have been measured (see "Aux_TuneNPGroup_End")
+//                   --> The smallest candidate is selected if none of them has been measured
+//-------------------------------------------------------------------------------------------------------
+void Finalize( const Solver_t TSolver, const int lv )
+{
+
+   const char  FileName[]   = "Record__NPGroup";
+   const char *SolverName[] = { "FLUID", "POISSON", "GRAVITY", "POISSON_AND_GRAVITY" };
+   const int   Type         = ( TSolver == FLUID_SOLVER ) ? 0 : 1;
+   const int   NMeasured    = Stage[lv][TSolver];
+
+   static bool FirstTime = true;
+
+   double Cost_Max[TUNE_MAX_NCAND], Cost_Min = __DBL_MAX__;
+
+   if ( NMeasured > 0 )
+   MPI_Allreduce( Cost[lv][TSolver], Cost_Max, NMeasured, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD );
+
+   for (int c=0; c<NMeasured; c++)     Cost_Min = ( Cost_Max[c] < Cost_Min ) ? Cost_Max[c] : Cost_Min;
+
+   Best  [lv][TSolver] = Cand[Type][0];
+   Retune[lv][TSolver] = ( NMeasured < NCand[Type] ) ? Cand[Type][NMeasured] : 0;
+
+   for (int c=0; c<NMeasured; c++)
+   {
+      if ( Cost_Max[c] <= 1.02*Cost_Min )
+      {
+         Best[lv][TSolver] = Cand[Type][c];
+         break;
+      }
+   }
+
+   Demand[lv][TSolver] = Best[lv][TSolver];
+
+   Resize( Type, true );
+
+
+// record the measured cost (in microseconds per patch group per call) of all candidates
+   if ( MPI_Rank == 0 )
+   {
+      if ( FirstTime )
+      {
+         FILE *File_Check = fopen( FileName, "r" );
+         if ( File_Check != NULL )
+         {
+            Aux_Message( stderr, "WARNING : the file \"%s\" already exists !!\n", FileName );
+            fclose( File_Check );
+         }
+
+         FILE *File = fopen( FileName, "a" );
+         fprintf( File, "#%8s  %3s  %-20s  %8s  %s\n", "Step", "Lv", "Solver", "NPGroup",
+                  "Candidate:Cost (us per patch group)" );
+         fclose( File );
+
+         FirstTime = false;
+      }
+
+      FILE *File = fopen( FileName, "a" );
+      fprintf( File, "%9ld  %3d  %-20s  %8d ", Step, lv, SolverName[TSolver], Best[lv][TSolver] );
+      for (int c=0; c<NMeasured; c++)
+      fprintf( File, "  %d:%.3e", Cand[Type][c], Cost_Max[c]*1.0e6/OPT__TUNE_NPGROUP );
+      for (int c=NMeasured; c<NCand[Type]; c++)
+      fprintf( File, "  %d:%s", Cand[Type][c], "skipped" );
+      fprintf( File, "\n" );
+      fclose( File );
+
+      Aux_Message( stdout, "   NPGroup of the %s solver at level %d is tuned to %d\n", SolverName[TSolver], lv,
+                   Best[lv][TSolver] );
+   }
+
+} // FUNCTION : Finalize
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Resize
+// Description :  Reallocate the solver arrays to the largest batch size adopted by any level and solver
+//                sharing these arrays
+//
+// Parameter   :  Type        : 0/1 --> fluid/Poisson-gravity solver arrays
+//                AllowShrink : true  --> also reduce the size of the solver arrays
+//                              false --> only enlarge the solver arrays
+//-------------------------------------------------------------------------------------------------------
+void Resize( const int Type, const bool AllowShrink )
+{
+
+   int Required = 0;
+
+   for (int lv=0; lv<NLEVEL; lv++)
+   for (int s=0; s<4; s++)
+   {
+      if (  ( Type == 0 ) == ( s == FLUID_SOLVER )  )
+         Required = ( Demand[lv][s] > Required ) ? Demand[lv][s] : Required;
+   }
+
+#  ifndef GPU
+   if ( Required > Capacity[Type]  ||  ( AllowShrink && Required < Capacity[Type] ) )
+   {
+      if ( Type == 0 )
+      {
+         End_MemFree_Fluid();
+         Init_MemAllocate_Fluid( Required );
+      }
+
+#     ifdef GRAVITY
+      else
+      {
+         End_MemFree_PoissonGravity();
+         Init_MemAllocate_PoissonGravity( Required );
+      }
+#     endif
+
+      Capacity[Type] = Required;
+   }
+#  endif
+
+} // FUNCTION : Resize
+
+
@@ -39,12 +39,14 @@ static int Table_01( const int SibID, const int Side, const char dim, const int
 //                TFluVarIdxList : List recording the targeted fluid variable indices ( = [0 ... NCOMP-1] )
 //                PrepPot        : true --> Prepare the potential data (always == false if GRAVITY is off)
 //                IntPhase       : true --> Perform interpolation on rho/phase instead of real/imag parts in ELBDM
+//                IntScratch     : Temporary array passed to the function "Interpolate" (or NULL)
+//                                 --> Must be able to store at least "Int_ScratchSize( IntScheme, CRange )" elements
 //-------------------------------------------------------------------------------------------------------
 void InterpolateGhostZone( const int lv, const int PID, real IntData[], const int SibID, const bool IntTime, 
                            const int GhostSize, const int FluSg, const int PotSg, 
                            const IntScheme_t IntScheme, const int NTSib[], int *TSib[],
                            const int NVar_Flu, const int TFluVarIdxList[], const bool PrepPot,
-                           const bool IntPhase )
+                           const bool IntPhase, real *IntScratch )
 {
 
 // check
@@ -70,7 +72,7 @@ void InterpolateGhostZone( const int lv, const int PID, real IntData[], const in
 
 // set up parameters for the adopted interpolation scheme
    const int NVar_Tot = ( PrepPot ) ? NVar_Flu+1 : NVar_Flu;
-   int NSide, CGhost, CSize[3], FSize[3], CSize3D, FSize3D;
+   int NSide, CGhost, CSize[3], FSize[3], CSize3D;
 
    Int_Table( IntScheme, NSide, CGhost );
 
@@ -89,7 +91,11 @@ void InterpolateGhostZone( const int lv, const int PID, real IntData[], const in
    }
 
    CSize3D = CSize[0]*CSize[1]*CSize[2];
-   FSize3D = FSize[0]*FSize[1]*FSize[2];
+
+// FSize3D is only required for interpolating individual components
+#  if ( MODEL == ELBDM  ||  defined GRAVITY )
+   const int FSize3D = FSize[0]*FSize[1]*FSize[2];
+#  endif
 
 
 // we assume that we only need ONE coarse-grid patch in each sibling direction
@@ -319,19 +325,18 @@ void InterpolateGhostZone( const int lv, const int PID, real IntData[], const in
 
 //    interpolate density 
       Interpolate( CData_Dens, CSize, CStart, CRange, FData_Dens, FSize, FStart, 1, IntScheme, 
-                   PhaseUnwrapping_No, EnsurePositivity_Yes );
+                   PhaseUnwrapping_No, &EnsurePositivity_Yes, IntScratch );
 
 //    interpolate phase
       Interpolate( CData_Real, CSize, CStart, CRange, FData_Real, FSize, FStart, 1, IntScheme, 
-                   PhaseUnwrapping_Yes, EnsurePositivity_No );
+                   PhaseUnwrapping_Yes, &EnsurePositivity_No, IntScratch );
    }
 
 // c2. interpolation on real/imag parts in ELBDM
    else // if ( IntPhase )
    {
-      for (int v=0; v<NVar_Flu; v++)
-      Interpolate( CData+CSize3D*v, CSize, CStart, CRange, IntData+FSize3D*v, FSize, FStart, 1, 
-                   IntScheme, PhaseUnwrapping_No, Positivity[v] );
+      Interpolate( CData, CSize, CStart, CRange, IntData, FSize, FStart, NVar_Flu, 
+                   IntScheme, PhaseUnwrapping_No, Positivity, IntScratch );
    } // if ( IntPhase ) ... else ...
 
 // retrieve real and imaginary parts when phase interpolation is adopted
@@ -355,10 +360,9 @@ void InterpolateGhostZone( const int lv, const int PID, real IntData[], const in
 
 #  else // #if ( MODEL == ELBDM )
 
-// c3. interpolation on original variables
-   for (int v=0; v<NVar_Flu; v++)
-   Interpolate( CData+CSize3D*v, CSize, CStart, CRange, IntData+FSize3D*v, FSize, FStart, 1, 
-                IntScheme, PhaseUnwrapping_No, Positivity[v] );
+// c3. interpolation on original variables (all components at once)
+   Interpolate( CData, CSize, CStart, CRange, IntData, FSize, FStart, NVar_Flu, 
+                IntScheme, PhaseUnwrapping_No, Positivity, IntScratch );
 
 #  endif // #if ( MODEL == ELBDM ) ... else 
 
@@ -366,7 +370,7 @@ void InterpolateGhostZone( const int lv, const int PID, real IntData[], const in
 #  ifdef GRAVITY
    if ( PrepPot )
    Interpolate( CData+CSize3D*NVar_Flu, CSize, CStart, CRange, IntData+FSize3D*NVar_Flu, FSize, FStart, 1, 
-                IntScheme, PhaseUnwrapping_No, EnsurePositivity_No );
+                IntScheme, PhaseUnwrapping_No, &EnsurePositivity_No, IntScratch );
 #  endif
 
    delete [] CData;
@@ -66,11 +66,8 @@ void InvokeSolver( const Solver_t TSolver, const int lv, const double PrepTime,
 
 
 // maximum number of patch groups to be updated at a time
-#  ifdef GRAVITY
-   const int NPG_Max = ( TSolver == FLUID_SOLVER ) ? FLU_GPU_NPGROUP : POT_GPU_NPGROUP;
-#  else
-   const int NPG_Max = FLU_GPU_NPGROUP;
-#  endif
+// --> FLU_GPU_NPGROUP/POT_GPU_NPGROUP, or the value tuned for this level and solver if OPT__TUNE_NPGROUP is on
+   const int NPG_Max = Aux_TuneNPGroup_Begin( TSolver, lv );
 
    int *PID0_List    = NULL;  // list recording the patch indicies with LocalID==0 to be udpated
    bool AllocateList = false; // whether to allocate PID0_List or not
@@ -189,6 +186,8 @@ void InvokeSolver( const Solver_t TSolver, const int lv, const double PrepTime,
 //-------------------------------------------------------------------------------------------------------------
      
 
+   Aux_TuneNPGroup_End( TSolver, lv, NTotal );
+
    if ( AllocateList )  delete [] PID0_List;
 
 } // FUNCTION : InvokeSolver
@@ -246,6 +245,11 @@ void Preparation_Step( const Solver_t TSolver, const int lv, const double PrepTi
          TIMING_SYNC(   Poi_Prepare_Pot( lv, PrepTime, h_Pot_Array_P_In [ArrayID], NPG, PID0_List ),
                         Timer_Poi_PrePot_C[lv]   );
 
+         if ( OPT__POT_WARM_START )
+         TIMING_SYNC(   Poi_Prepare_PotGuess( lv, PrepTime, h_Pot_Array_P_In[ArrayID], h_Pot_Array_P_Out[ArrayID],
+                                              NPG, PID0_List ),
+                        Timer_Poi_PrePot_F[lv]   );
+
          TIMING_SYNC(   Gra_Prepare_Flu( lv,           h_Flu_Array_G    [ArrayID], NPG, PID0_List ),
                         Timer_Poi_PreFlu[lv]   );
          break;
@@ -311,6 +315,42 @@ void Solver( const Solver_t TSolver, const int lv, const int NPG, const int Arra
 #  error : ERROR : ADD THE MODEL-DEPENDENT USELESS VARIABLES FOR THE NEW MODELS HERE
 #  endif
 
+// data reconstruction, Riemann solver, and slope limiter adopted at this level (CPU MHM/MHM_RP/CTU only)
+#  ifdef RUNTIME_FLU_SCHEME
+   const int          Flu_LR_Scheme  = FluSchemeTable_LR     [lv];
+   const int          Flu_RSolver    = FluSchemeTable_RSolver[lv];
+   const LR_Limiter_t Flu_LR_Limiter = FluSchemeTable_Limiter[lv];
+#  elif (  !defined GPU  &&  MODEL == HYDRO  &&  \
+          ( FLU_SCHEME == MHM || FLU_SCHEME == MHM_RP || FLU_SCHEME == CTU )  )
+   const int          Flu_LR_Scheme  = LR_SCHEME;
+   const int          Flu_RSolver    = RSOLVER;
+   const LR_Limiter_t Flu_LR_Limiter = OPT__LR_LIMITER;
+#  elif ( !defined GPU )
+   const int          Flu_LR_Scheme  = NULL_INT;
+   const int          Flu_RSolver    = NULL_INT;
+   const LR_Limiter_t Flu_LR_Limiter = OPT__LR_LIMITER;
+#  endif
+
+// arrays to store the cost of each patch group (fluid solver) and each patch (Poisson solver)
+#  ifdef TIMING_PATCH
+   double *Flu_Cost = h_Flu_Cost_Array[ArrayID];
+#  ifdef GRAVITY
+   double *Poi_Cost = h_Pot_Cost_Array[ArrayID];
+#  endif
+#  else
+   double *Flu_Cost = NULL;
+#  ifdef GRAVITY
+   double *Poi_Cost = NULL;
+#  endif
+#  endif
+
+// maximum gravitational acceleration recorded by the CPU gravity solver for the time-step estimation
+#  if ( MODEL == HYDRO  &&  defined GRAVITY  &&  !defined GPU )
+   real *Gra_MaxAcc = MinDtInfo_Gravity + lv;
+#  elif ( defined GRAVITY  &&  !defined GPU )
+   real *Gra_MaxAcc = NULL;
+#  endif
+
 
    switch ( TSolver )
    {
@@ -324,8 +364,8 @@ void Solver( const Solver_t TSolver, const int lv, const int NPG, const int Arra
 #        else
          CPU_FluidSolver       ( h_Flu_Array_F_In[ArrayID], h_Flu_Array_F_Out[ArrayID], h_Flux_Array[ArrayID], 
                                  h_MinDtInfo_Fluid_Array[ArrayID], NPG, dt, dh, GAMMA, OPT__FIXUP_FLUX, Flu_XYZ, 
-                                 OPT__LR_LIMITER, MINMOD_COEFF, EP_COEFF, OPT__WAF_LIMITER, ETA, 
-                                 OPT__ADAPTIVE_DT );
+                                 Flu_LR_Scheme, Flu_RSolver, Flu_LR_Limiter, MINMOD_COEFF, EP_COEFF, 
+                                 OPT__WAF_LIMITER, ETA, OPT__ADAPTIVE_DT, Flu_Cost );
 #        endif
          break;
 
@@ -345,9 +385,10 @@ void Solver( const Solver_t TSolver, const int lv, const int NPG, const int Arra
          CPU_PoissonGravitySolver       ( h_Rho_Array_P[ArrayID], h_Pot_Array_P_In[ArrayID], 
                                           h_Pot_Array_P_Out[ArrayID], NULL, 
                                           NPG, dt, dh, SOR_MIN_ITER, SOR_MAX_ITER, 
-                                          SOR_OMEGA, MG_MAX_ITER, MG_NPRE_SMOOTH, MG_NPOST_SMOOTH, 
-                                          MG_TOLERATED_ERROR, Poi_Coeff, OPT__POT_INT_SCHEME, 
-                                          NULL_BOOL, ETA, POISSON_ON, GRAVITY_OFF ); 
+                                          SOR_OMEGA, SOR_TOLERATED_ERROR, MG_MAX_ITER, MG_NPRE_SMOOTH,
+                                          MG_NPOST_SMOOTH, MG_TOLERATED_ERROR, Poi_Coeff, OPT__POT_INT_SCHEME, 
+                                          NULL_BOOL, ETA, POISSON_ON, GRAVITY_OFF, false, Poi_IterCounter[lv],
+                                          Poi_Cost, NULL ); 
 #        endif
          break;
 
@@ -365,9 +406,10 @@ void Solver( const Solver_t TSolver, const int lv, const int NPG, const int Arra
          CPU_PoissonGravitySolver       ( NULL, NULL, 
                                           h_Pot_Array_P_Out[ArrayID], h_Flu_Array_G[ArrayID], 
                                           NPG, dt, dh, NULL_INT, NULL_INT, 
-                                          NULL_REAL, NULL_INT, NULL_INT, NULL_INT, 
+                                          NULL_REAL, NULL_REAL, NULL_INT, NULL_INT, NULL_INT, 
                                           NULL_REAL, NULL_REAL, (IntScheme_t)NULL_INT, 
-                                          OPT__GRA_P5_GRADIENT, ETA, POISSON_OFF, GRAVITY_ON ); 
+                                          OPT__GRA_P5_GRADIENT, ETA, POISSON_OFF, GRAVITY_ON, false, NULL, NULL,
+                                          Gra_MaxAcc ); 
 #        endif
          break;
 
@@ -385,9 +427,10 @@ void Solver( const Solver_t TSolver, const int lv, const int NPG, const int Arra
          CPU_PoissonGravitySolver       ( h_Rho_Array_P[ArrayID], h_Pot_Array_P_In[ArrayID], 
                                           h_Pot_Array_P_Out[ArrayID], h_Flu_Array_G[ArrayID], 
                                           NPG, dt, dh, SOR_MIN_ITER, SOR_MAX_ITER, 
-                                          SOR_OMEGA, MG_MAX_ITER, MG_NPRE_SMOOTH, MG_NPOST_SMOOTH, 
-                                          MG_TOLERATED_ERROR, Poi_Coeff, OPT__POT_INT_SCHEME, 
-                                          OPT__GRA_P5_GRADIENT, ETA, POISSON_ON, GRAVITY_ON ); 
+                                          SOR_OMEGA, SOR_TOLERATED_ERROR, MG_MAX_ITER, MG_NPRE_SMOOTH,
+                                          MG_NPOST_SMOOTH, MG_TOLERATED_ERROR, Poi_Coeff, OPT__POT_INT_SCHEME, 
+                                          OPT__GRA_P5_GRADIENT, ETA, POISSON_ON, GRAVITY_ON, OPT__POT_WARM_START,
+                                          Poi_IterCounter[lv], Poi_Cost, Gra_MaxAcc ); 
 #        endif
          break;
 
@@ -429,11 +472,17 @@ void Closing_Step( const Solver_t TSolver, const int lv, const int SaveSg, const
       case FLUID_SOLVER :   
          Flu_Close( lv, SaveSg, h_Flux_Array[ArrayID], h_Flu_Array_F_Out[ArrayID], 
                     h_MinDtInfo_Fluid_Array[ArrayID], NPG, PID0_List, OPT__ADAPTIVE_DT );
+#        ifdef TIMING_PATCH
+         Aux_AddPatchCost( lv, COST_FLU, NPG, PID0_List, h_Flu_Cost_Array[ArrayID], false );
+#        endif
          break;
 
 #     ifdef GRAVITY
       case POISSON_SOLVER : 
          Poi_Close( lv, SaveSg, h_Pot_Array_P_Out[ArrayID], NPG, PID0_List ); 
+#        ifdef TIMING_PATCH
+         Aux_AddPatchCost( lv, COST_POI, NPG, PID0_List, h_Pot_Cost_Array[ArrayID], true );
+#        endif
          break;
 
       case GRAVITY_SOLVER :  
@@ -443,6 +492,9 @@ void Closing_Step( const Solver_t TSolver, const int lv, const int SaveSg, const
       case POISSON_AND_GRAVITY_SOLVER :  
          Poi_Close( lv, SaveSg, h_Pot_Array_P_Out[ArrayID], NPG, PID0_List ); 
          Gra_Close( lv, SaveSg, h_Flu_Array_G    [ArrayID], NPG, PID0_List );
+#        ifdef TIMING_PATCH
+         Aux_AddPatchCost( lv, COST_POI, NPG, PID0_List, h_Pot_Cost_Array[ArrayID], true );
+#        endif
          break;
 #     endif
 
@@ -37,23 +37,28 @@ int               Flu_ParaBuf;
 
 double            BOX_SIZE, DT__FLUID, END_T, OUTPUT_DT;
 long              END_STEP;
-int               NX0_TOT[3], OUTPUT_STEP, REGRID_COUNT, FLU_GPU_NPGROUP, OMP_NTHREAD;
+int               NX0_TOT[3], OUTPUT_STEP, REGRID_COUNT, FLU_GPU_NPGROUP, OMP_NTHREAD, OPT__TUNE_NPGROUP;
 int               MPI_NRank, MPI_NRank_X[3], GPU_NSTREAM, FLAG_BUFFER_SIZE, MAX_LEVEL;
 
 IntScheme_t       OPT__FLU_INT_SCHEME, OPT__REF_FLU_INT_SCHEME;
 int               OPT__UM_START_LEVEL, OPT__UM_START_NVAR, OPT__GPUID_SELECT, OPT__PATCH_COUNT;
-int               OPT__OUTPUT_TOTAL, OPT__CK_CONSERVATION, INIT_DUMPID, OPT__FLAG_LOHNER;
+int               OPT__OUTPUT_TOTAL, OPT__OUTPUT_DELTA, OPT__OUTPUT_CRC, OPT__CK_CONSERVATION, INIT_DUMPID, OPT__FLAG_LOHNER, OUTPUT_PART_LV;
 real              OPT__CK_MEMFREE, OUTPUT_PART_X, OUTPUT_PART_Y, OUTPUT_PART_Z;
 bool              OPT__FLAG_RHO, OPT__FLAG_RHO_GRADIENT, OPT__FLAG_USER;
 bool              OPT__DT_USER, OPT__RECORD_DT, OPT__RECORD_MEMORY, OPT__ADAPTIVE_DT;
-bool              OPT__FIXUP_RESTRICT, OPT__INIT_RESTRICT, OPT__VERBOSE;
+bool              OPT__FIXUP_RESTRICT, OPT__INIT_RESTRICT, OPT__VERBOSE, OPT__RESTART_REGRID, OPT__RESTART_CRC;
 bool              OPT__INT_TIME, OPT__OUTPUT_ERROR, OPT__OUTPUT_BASE, OPT__OVERLAP_MPI, OPT__TIMING_BARRIER;
 bool              OPT__OUTPUT_BASEPS, OPT__CK_REFINE, OPT__CK_PROPER_NESTING, OPT__CK_FINITE;
 bool              OPT__CK_RESTRICT, OPT__CK_PATCH_ALLOCATE, OPT__FIXUP_FLUX, OPT__CK_FLUX_ALLOCATE;
+bool              OPT__OUTPUT_PART_BIN, OPT__SPHERE_MAXRHO_CEN, OPT__NUMA_FIRST_TOUCH;
+int               OPT__SPHERE_ANALYSIS, SPHERE_NSHELL, OPT__RECORD_BASEPS;
+double            SPHERE_MAX_RADIUS;
 OptInit_t         OPT__INIT;
 OptRestartH_t     OPT__RESTART_HEADER;
 OptOutputMode_t   OPT__OUTPUT_MODE;
 OptOutputPart_t   OPT__OUTPUT_PART;
+OptPatchOrder_t   OPT__PATCH_ORDER;
+OptAffinity_t     OPT__THREAD_AFFINITY;
 
 
 // 2. global variables for different applications
@@ -64,8 +69,15 @@ double         FlagTable_PresGradient[NLEVEL-1];
 real           GAMMA, MINMOD_COEFF, EP_COEFF;
 LR_Limiter_t   OPT__LR_LIMITER;
 WAF_Limiter_t  OPT__WAF_LIMITER;
-bool           OPT__FLAG_PRES_GRADIENT;
+bool           OPT__FLAG_PRES_GRADIENT, OPT__FLU_SCHEME_LV;
 int            OPT__CK_NEGATIVE;
+#ifdef RUNTIME_FLU_SCHEME
+int            FluSchemeTable_LR[NLEVEL], FluSchemeTable_RSolver[NLEVEL];
+LR_Limiter_t   FluSchemeTable_Limiter[NLEVEL];
+#endif
+#if ( RSOLVER == HYBRID  ||  defined RUNTIME_FLU_SCHEME )
+long int       RSolver_HybridCounter[3];
+#endif
 
 #elif ( MODEL == MHD )
 #warning : WAIT MHD !!!
@@ -93,8 +105,11 @@ IntScheme_t    OPT__POT_INT_SCHEME, OPT__RHO_INT_SCHEME, OPT__GRA_INT_SCHEME, OP
 bool           OPT__OUTPUT_POT, OPT__GRA_P5_GRADIENT;
 real           SOR_OMEGA;
 int            SOR_MAX_ITER, SOR_MIN_ITER;
+real           SOR_TOLERATED_ERROR;
 real           MG_TOLERATED_ERROR;
 int            MG_MAX_ITER, MG_NPRE_SMOOTH, MG_NPOST_SMOOTH;
+bool           OPT__POT_WARM_START;
+long int       Poi_IterCounter[NLEVEL][2];
 #endif
 
 // (2-3) cosmological simulations
@@ -115,6 +130,9 @@ real (*h_Flu_Array_F_In [2])[FLU_NIN ][  FLU_NXT   *FLU_NXT   *FLU_NXT   ] = { N
 real (*h_Flu_Array_F_Out[2])[FLU_NOUT][8*PATCH_SIZE*PATCH_SIZE*PATCH_SIZE] = { NULL, NULL };   
 real (*h_Flux_Array[2])[9][NCOMP][4*PATCH_SIZE*PATCH_SIZE]                 = { NULL, NULL };
 real *h_MinDtInfo_Fluid_Array[2]                                           = { NULL, NULL };
+#ifdef TIMING_PATCH
+double *h_Flu_Cost_Array[2]                                                = { NULL, NULL };
+#endif
 
 // (3-2) gravity solver
 #ifdef GRAVITY
@@ -122,6 +140,9 @@ real (*h_Rho_Array_P    [2])[RHO_NXT][RHO_NXT][RHO_NXT]                    = { N
 real (*h_Pot_Array_P_In [2])[POT_NXT][POT_NXT][POT_NXT]                    = { NULL, NULL };                   
 real (*h_Pot_Array_P_Out[2])[GRA_NXT][GRA_NXT][GRA_NXT]                    = { NULL, NULL };
 real (*h_Flu_Array_G    [2])[GRA_NIN][PATCH_SIZE][PATCH_SIZE][PATCH_SIZE]  = { NULL, NULL };
+#ifdef TIMING_PATCH
+double *h_Pot_Cost_Array[2]                                                = { NULL, NULL };
+#endif
 #endif
 
 
@@ -240,6 +261,10 @@ int main( int argc, char *argv[] )
 
    if ( OPT__PATCH_COUNT > 0 )   Aux_PatchCount();
    if ( OPT__RECORD_MEMORY   )   Aux_GetMemInfo();
+   if ( OPT__SPHERE_ANALYSIS )   Aux_SphereAnalysis();
+#  ifdef GRAVITY
+   if ( OPT__RECORD_BASEPS   )   Output_RecordBasePowerSpectrum();
+#  endif
 
    Aux_Check();
 
@@ -315,7 +340,7 @@ int main( int argc, char *argv[] )
 #        endif
 
          if ( lv == 0 )    
-            CPU_PoissonSolver_FFT( Poi_Coeff, patch->PotSg[lv] );
+            CPU_PoissonSolver_FFT( Poi_Coeff, patch->PotSg[lv], Time[lv] );
 
          else              
          {
@@ -340,6 +365,14 @@ int main( int argc, char *argv[] )
       if ( OPT__RECORD_MEMORY )   
       TIMING_FUNC(   Aux_GetMemInfo(),     Timer_Main[4],   false   );
 
+      if ( OPT__SPHERE_ANALYSIS > 0  &&  Step%OPT__SPHERE_ANALYSIS == 0 )
+      TIMING_FUNC(   Aux_SphereAnalysis(), Timer_Main[4],   false   );
+
+#     ifdef GRAVITY
+      if ( OPT__RECORD_BASEPS > 0  &&  Step%OPT__RECORD_BASEPS == 0 )
+      TIMING_FUNC(   Output_RecordBasePowerSpectrum(),   Timer_Main[4],   false   );
+#     endif
+
       TIMING_FUNC(   Aux_Check(),          Timer_Main[4],   false   );
 //    ---------------------------------------------------------------------------------------------------
 
@@ -419,6 +452,14 @@ int main( int argc, char *argv[] )
       fclose( Note );
    }
 
+#  if ( MODEL == HYDRO  &&  ( RSOLVER == HYBRID || defined RUNTIME_FLU_SCHEME ) )
+   Hydro_Record_RSolverHybrid();
+#  endif
+
+#  if ( defined GRAVITY  &&  !defined GPU )
+   Poi_Record_Iteration();
+#  endif
+
 
    End_DAINO();
    return 0;
@@ -5,7 +5,7 @@ void InterpolateGhostZone( const int lv, const int PID, real IntData[], const in
                            const int GhostSize, const int FluSg, const int PotSg, 
                            const IntScheme_t IntScheme, const int NTSib[], int *TSib[],
                            const int NVar_Flu, const int TFluVarIdxList[], const bool PrepPot,
-                           const bool IntPhase );
+                           const bool IntPhase, real *IntScratch );
 void SetTargetSibling( int NTSib[], int* TSib[] );
 static int Table_01( const int SibID, const char dim, const int Count, const int GhostSize );
 static int Table_02( const int lv, const int PID, const int Side );
@@ -122,6 +122,11 @@ void Prepare_PatchGroupData( const int lv, const double PrepTime, real *h_Input_
       real *Array_Ptr = NULL;
       real *Array     = new real [ NVar_Tot*PGSize3D ];
 
+//    IntScratch : temporary array reused by all spatial interpolations performed by this thread
+//                 --> the coarse-grid range of interpolation never exceeds PATCH_SIZE in each direction
+      const int  CRange_Max[3] = { PATCH_SIZE, PATCH_SIZE, PATCH_SIZE };
+      real      *IntScratch    = new real [ Int_ScratchSize( IntScheme, CRange_Max ) ];
+
       
 //    prepare eight nearby patches (one patch group) at a time 
 #     pragma omp for
@@ -318,10 +323,12 @@ void Prepare_PatchGroupData( const int lv, const double PrepTime, real *h_Input_
 //             perform interpolation and store the results in IntData
 #              ifdef GRAVITY
                InterpolateGhostZone( lv-1, FaSibPID, IntData, Side, IntTime, GhostSize, IntFluSg, IntPotSg, 
-                                     IntScheme, NTSib, TSib, NVar_Flu, TFluVarIdxList, PrepPot, IntPhase );
+                                     IntScheme, NTSib, TSib, NVar_Flu, TFluVarIdxList, PrepPot, IntPhase,
+                                     IntScratch );
 #              else
                InterpolateGhostZone( lv-1, FaSibPID, IntData, Side, IntTime, GhostSize, IntFluSg, NULL_INT, 
-                                     IntScheme, NTSib, TSib, NVar_Flu, TFluVarIdxList, false, IntPhase );
+                                     IntScheme, NTSib, TSib, NVar_Flu, TFluVarIdxList, false, IntPhase,
+                                     IntScratch );
 #              endif
 
 
@@ -405,6 +412,7 @@ void Prepare_PatchGroupData( const int lv, const double PrepTime, real *h_Input_
       } // for (int TID=0; TID<NPG; TID++)
 
       delete [] Array;
+      delete [] IntScratch;
 
    } // OpenMP parallel region
 
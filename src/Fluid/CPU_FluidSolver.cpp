@@ -11,27 +11,30 @@ void CPU_FluidSolver_RTVD( real Flu_Array_In [][5][ FLU_NXT*FLU_NXT*FLU_NXT ],
                            real Flu_Array_Out[][5][ PS2*PS2*PS2 ], 
                            real Flux_Array[][9][5][ PS2*PS2 ], 
                            const int NPatchGroup, const real dt, const real dh, const real Gamma,
-                           const bool StoreFlux, const bool XYZ );
+                           const bool StoreFlux, const bool XYZ, double Cost[] );
 #elif ( FLU_SCHEME == WAF )
 void CPU_FluidSolver_WAF( real Flu_Array_In [][5][ FLU_NXT*FLU_NXT*FLU_NXT ], 
                           real Flu_Array_Out[][5][ PS2*PS2*PS2 ], 
                           real Flux_Array[][9][5][ PS2*PS2 ], 
                           const int NPatchGroup, const real dt, const real dh, const real Gamma, 
-                          const bool StoreFlux, const bool XYZ, const WAF_Limiter_t WAF_Limiter );
+                          const bool StoreFlux, const bool XYZ, const WAF_Limiter_t WAF_Limiter,
+                          double Cost[] );
 #elif ( FLU_SCHEME == MHM  ||  FLU_SCHEME == MHM_RP )
 void CPU_FluidSolver_MHM( const real Flu_Array_In[][5][ FLU_NXT*FLU_NXT*FLU_NXT ], 
                           real Flu_Array_Out[][5][ PS2*PS2*PS2 ], 
                           real Flux_Array[][9][5][ PS2*PS2 ], 
                           const int NPatchGroup, const real dt, const real dh, const real Gamma, 
-                          const bool StoreFlux, const LR_Limiter_t LR_Limiter, const real MinMod_Coeff, 
-                          const real EP_Coeff );
+                          const bool StoreFlux, const int LR_Scheme, const int RSolver, 
+                          const LR_Limiter_t LR_Limiter, const real MinMod_Coeff, const real EP_Coeff,
+                          double Cost[] );
 #elif ( FLU_SCHEME == CTU )
 void CPU_FluidSolver_CTU( const real Flu_Array_In[][5][ FLU_NXT*FLU_NXT*FLU_NXT ], 
                           real Flu_Array_Out[][5][ PS2*PS2*PS2 ], 
                           real Flux_Array[][9][5][ PS2*PS2 ], 
                           const int NPatchGroup, const real dt, const real dh, const real Gamma, 
-                          const bool StoreFlux, const LR_Limiter_t LR_Limiter, const real MinMod_Coeff, 
-                          const real EP_Coeff );
+                          const bool StoreFlux, const int LR_Scheme, const int RSolver, 
+                          const LR_Limiter_t LR_Limiter, const real MinMod_Coeff, const real EP_Coeff,
+                          double Cost[] );
 #endif // FLU_SCHEME
 
 #elif ( MODEL == MHD )
@@ -61,6 +64,8 @@ void CPU_ELBDMSolver( real Flu_Array_In [][FLU_NIN ][ FLU_NXT*FLU_NXT*FLU_NXT ],
 //                   4. MUSCL-Hancock scheme with Riemann prediction   (MHM_RP) --> unsplit
 //                   5. Corner-Transport-Upwind scheme                 (CTU   ) --> unsplit
 //
+//                The data reconstruction and Riemann solver of the MHM/MHM_RP/CTU schemes are selected at runtime
+//                (and can differ between levels, see "Input__FluScheme") if RUNTIME_FLU_SCHEME is on
 //
 // Parameter   :  h_Flu_Array_In    : Host array storing the input variables
 //                h_Flu_Array_Out   : Host array to store the output variables
@@ -76,6 +81,8 @@ void CPU_ELBDMSolver( real Flu_Array_In [][FLU_NIN ][ FLU_NXT*FLU_NXT*FLU_NXT ],
 //                XYZ               : true   : x->y->z ( forward sweep)
 //                                    false1 : z->y->x (backward sweep)
 //                                    --> only useful for the RTVD and WAF schemes
+//                LR_Scheme         : Data reconstruction scheme (PLM/PPM) for the MHM/MHM_RP/CTU schemes
+//                RSolver           : Riemann solver (EXACT/ROE/HLLE/HLLC/HYBRID) for the MHM/MHM_RP/CTU schemes
 //                LR_Limiter        : Slope limiter for the data reconstruction in the MHM/MHM_RP/CTU schemes
 //                                    (0/1/2/3/4) = (vanLeer/generalized MinMod/vanAlbada/
 //                                                   vanLeer + generalized MinMod/extrema-preserving) limiter
@@ -87,17 +94,21 @@ void CPU_ELBDMSolver( real Flu_Array_In [][FLU_NIN ][ FLU_NXT*FLU_NXT*FLU_NXT ],
 //                GetMinDtInfo      : true --> Gather the minimum time-step information (the CFL condition in 
 //                                             HYDRO) in each patch group
 //                                         --> NOT supported yet
+//                h_Cost_Array      : Host array to store the cost (in CPU cycles) of each patch group
+//                                    --> for the option "TIMING_PATCH" in HYDRO only (NULL --> off)
 //
 // Useless parameters in HYDRO : Eta
-// Useless parameters in ELBDM : h_Flux_Array, Gamma, StoreFlux, LR_Limiter, MinMod_Coeff, EP_Coeff, WAF_Limiter
+// Useless parameters in ELBDM : h_Flux_Array, Gamma, StoreFlux, LR_Scheme, RSolver, LR_Limiter, MinMod_Coeff,
+//                               EP_Coeff, WAF_Limiter, h_Cost_Array (TIMING_PATCH is not supported)
 //-------------------------------------------------------------------------------------------------------
 void CPU_FluidSolver( real h_Flu_Array_In [][FLU_NIN ][ FLU_NXT*FLU_NXT*FLU_NXT ], 
                       real h_Flu_Array_Out[][FLU_NOUT][ PS2*PS2*PS2 ], 
                       real h_Flux_Array[][9][NCOMP   ][ PS2*PS2 ], 
                       real h_MinDtInfo_Array[],
                       const int NPatchGroup, const real dt, const real dh, const real Gamma, const bool StoreFlux,
-                      const bool XYZ, const LR_Limiter_t LR_Limiter, const real MinMod_Coeff, const real EP_Coeff,
-                      const WAF_Limiter_t WAF_Limiter, const real Eta, const bool GetMinDtInfo )
+                      const bool XYZ, const int LR_Scheme, const int RSolver, const LR_Limiter_t LR_Limiter,
+                      const real MinMod_Coeff, const real EP_Coeff, const WAF_Limiter_t WAF_Limiter, const real Eta,
+                      const bool GetMinDtInfo, double h_Cost_Array[] )
 {
 
 #  if   ( MODEL == HYDRO )
@@ -105,22 +116,22 @@ void CPU_FluidSolver( real h_Flu_Array_In [][FLU_NIN ][ FLU_NXT*FLU_NXT*FLU_NXT
 #     if   ( FLU_SCHEME == RTVD )
 
       CPU_FluidSolver_RTVD( h_Flu_Array_In, h_Flu_Array_Out, h_Flux_Array, NPatchGroup, dt, dh, Gamma, StoreFlux,
-                            XYZ );
+                            XYZ, h_Cost_Array );
 
 #     elif ( FLU_SCHEME == WAF )
 
       CPU_FluidSolver_WAF ( h_Flu_Array_In, h_Flu_Array_Out, h_Flux_Array, NPatchGroup, dt, dh, Gamma, StoreFlux,
-                            XYZ, WAF_Limiter );
+                            XYZ, WAF_Limiter, h_Cost_Array );
 
 #     elif ( FLU_SCHEME == MHM  ||  FLU_SCHEME == MHM_RP )
 
       CPU_FluidSolver_MHM ( h_Flu_Array_In, h_Flu_Array_Out, h_Flux_Array, NPatchGroup, dt, dh, Gamma, StoreFlux,
-                            LR_Limiter, MinMod_Coeff, EP_Coeff );
+                            LR_Scheme, RSolver, LR_Limiter, MinMod_Coeff, EP_Coeff, h_Cost_Array );
 
 #     elif ( FLU_SCHEME == CTU )
 
       CPU_FluidSolver_CTU ( h_Flu_Array_In, h_Flu_Array_Out, h_Flux_Array, NPatchGroup, dt, dh, Gamma, StoreFlux,
-                            LR_Limiter, MinMod_Coeff, EP_Coeff );
+                            LR_Scheme, RSolver, LR_Limiter, MinMod_Coeff, EP_Coeff, h_Cost_Array );
 
 #     else
 
@@ -9,6 +9,13 @@
 // Description :  Allocate flux arrays for the coarse-grid patches (at level lv ) adjacent to the 
 //                coarse-fine boundaries (including the buffer patches)
 //
+// Note        :  1. Flux arrays are taken from and returned to the flux pool "patch->FluxPool[lv]"
+//                2. For the real patches, only the flux arrays of the faces that appear or disappear are
+//                   allocated or deallocated, while the flux arrays of the persistent faces are reused
+//                   (and reset to zero)
+//                3. Flux arrays of the buffer patches are always returned to the pool first and then reallocated
+//                   by "Flu_AllocateFluxArray_Buffer" since the buffer patches are reconstructed after each regrid
+//
 // Parameter   :  lv : Coarse-grid level
 //-------------------------------------------------------------------------------------------------------
 void Flu_AllocateFluxArray( const int lv )
@@ -19,34 +26,36 @@ void Flu_AllocateFluxArray( const int lv )
       Aux_Message( stderr, "WARNING : why invoking %s when patch->WithFlux is off ??\n", __FUNCTION__ );
 
 
-// deallocate the flux arrays allocated previously
+   FluxPool_t *Pool      = &patch->FluxPool[lv];
+   const bool  FineExist = ( patch->NPatchComma[lv+1][7] != 0 );
+
+
+// deallocate the flux arrays of the buffer patches allocated previously
 #  pragma omp parallel for
-   for (int PID=0; PID<patch->NPatchComma[lv][7]; PID++)     patch->ptr[0][lv][PID]->fdelete();
+   for (int PID=patch->NPatchComma[lv][1]; PID<patch->NPatchComma[lv][7]; PID++)
+      patch->ptr[0][lv][PID]->fdelete( Pool );
 
 
-// allocate flux arrays for the real patches
-   if ( patch->NPatchComma[lv+1][7] != 0 )
+// allocate/deallocate the flux arrays of the real patches at the faces that appear/disappear
+#  pragma omp parallel for
+   for (int PID=0; PID<patch->NPatchComma[lv][1]; PID++)
    {
-#     pragma omp parallel for
-      for (int PID=0; PID<patch->NPatchComma[lv][1]; PID++)
+      patch_t *Relation = patch->ptr[0][lv][PID];
+
+      for (int s=0; s<6; s++)
       {
-         if ( patch->ptr[0][lv][PID]->son == -1 )
-         {
-            for (int s=0; s<6; s++)
-            {
-               if ( patch->ptr[0][lv][PID]->sibling[s] != -1 )
-               {
-                  if ( patch->ptr[0][lv][ patch->ptr[0][lv][PID]->sibling[s] ]->son != -1 )
-                     patch->ptr[0][lv][PID]->fnew( s );
-               }
-            }
-         }
+         const int  SibPID = Relation->sibling[s];
+         const bool Need   = FineExist  &&  Relation->son == -1  &&
+                             SibPID != -1  &&  patch->ptr[0][lv][SibPID]->son != -1;
+
+         if      ( Need )                       Relation->fnew   ( s, Pool );
+         else if ( Relation->flux[s] != NULL )  Relation->fdelete( s, Pool );
       }
    }
 
 
 // allocate flux arrays for the buffer patches
-   if ( patch->NPatchComma[lv+1][7] != 0 )   Flu_AllocateFluxArray_Buffer( lv );
+   if ( FineExist )  Flu_AllocateFluxArray_Buffer( lv );
 
    
 // get the PIDs for sending/receiving fluxes to/from neighboring ranks
@@ -41,7 +41,7 @@ void Flu_AllocateFluxArray_Buffer( const int lv )
 
             if ( SibPID != -1 )
             if ( patch->ptr[0][lv][SibPID]->son != -1 )
-               patch->ptr[0][lv][PID]->fnew( MirrorSib[s] );
+               patch->ptr[0][lv][PID]->fnew( MirrorSib[s], &patch->FluxPool[lv] );
          }
       }
    } // for (int s=0; s<6; s++)
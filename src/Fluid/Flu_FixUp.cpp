@@ -1,4 +1,3 @@
-
 #include "DAINO.h"
 
 
@@ -11,6 +10,12 @@
 //
 // Note        :  1. Also include the fluxes from neighbor ranks
 //                2. The boundary fluxes must be received in advance by invoking the function "Buf_GetBufferData"
+//                3. Both corrections are applied in a single OpenMP-parallel traversal of the patches at level "lv"
+//                   --> Patches with sons are restricted by "Flu_Restrict_Patch", and the flux correction is
+//                       skipped for them since all their cells are overwritten by the restriction anyway
+//                   --> Other patches are corrected by the coarse-fine fluxes
+//                4. For LOAD_BALANCE, the buffer patches with real sons are restricted as well and the 
+//                   restricted data are sent back to their home ranks by "LB_GetBufferData"
 //
 // Parameter   :  lv : Targeted refinement level
 //                dt : Time interval to advance solution
@@ -18,95 +23,127 @@
 void Flu_FixUp( const int lv, const double dt )
 {
 
-   const real Const = dt / patch->dh[lv];
+   const real Const    = dt / patch->dh[lv];
+   const int  FluSg    = patch->FluSg[lv];
+   const int  SonLv    = lv + 1;
+   const bool Restrict = (  OPT__FIXUP_RESTRICT  &&  SonLv < NLEVEL  &&  patch->NPatchComma[SonLv][1] > 0  );
 
-   real (*FluxPtr)[PATCH_SIZE][PATCH_SIZE] = NULL;
+#  ifdef LOAD_BALANCE
+   const int NPatch    = ( Restrict ) ? patch->NPatchComma[lv][27] : patch->NPatchComma[lv][1];
+#  else
+   const int NPatch    = patch->NPatchComma[lv][1];
+#  endif
 
+   int TFluVarIdxList[NCOMP];
+   for (int v=0; v<NCOMP; v++)   TFluVarIdxList[v] = v;
 
-// a. correct the coarse-fine boundary fluxes
-   if ( OPT__FIXUP_FLUX )
+
+// check
+   if ( OPT__FIXUP_FLUX  &&  !patch->WithFlux )
+      Aux_Error( ERROR_INFO, "patch->WithFlux is off -> no flux array is allocated for OPT__FIXUP_FLUX !!\n" );
+
+   if ( Restrict )
+      Mis_Check_Synchronization( Time[lv], Time[SonLv], __FUNCTION__, true );
+
+
+#  pragma omp parallel for
+   for (int PID=0; PID<NPatch; PID++)
    {
-//    check
-      if ( !patch->WithFlux )    
-         Aux_Error( ERROR_INFO, "patch->WithFlux is off -> no flux array is allocated for OPT__FIXUP_FLUX !!\n" );
+      const int SonPID0 = patch->ptr[0][lv][PID]->son;
 
-#     pragma omp parallel for private( FluxPtr )
-      for (int PID=0; PID<patch->NPatchComma[lv][1]; PID++)
+//    a. average over the data at level "lv+1" to correct the data at level "lv"
+      if ( Restrict  &&  SonPID0 >= 0  &&  SonPID0 < patch->NPatchComma[SonLv][1] )
       {
-//       a1. sum up the coarse-grid and fine-grid fluxes for the debug mode
-#        ifdef DAINO_DEBUG
-         for (int s=0; s<6; s++)
-         {
-            FluxPtr = patch->ptr[0][lv][PID]->flux[s];
+         Flu_Restrict_Patch( lv, PID, patch->FluSg[SonLv], FluSg, NULL_INT, NULL_INT, NCOMP, TFluVarIdxList,
+                             false );
+         continue;
+      }
 
-            if ( FluxPtr != NULL )
-            {
-               for (int v=0; v<NCOMP; v++)
-               for (int m=0; m<PS1; m++)
-               for (int n=0; n<PS1; n++)
-                  FluxPtr[v][m][n] += patch->ptr[0][lv][PID]->flux_debug[s][v][m][n];
-            }
-         }
-#        endif
 
+//    b. correct the coarse-fine boundary fluxes (real patches only)
+      if ( !OPT__FIXUP_FLUX  ||  PID >= patch->NPatchComma[lv][1] )   continue;
 
-//       a2. correct fluid variables by the difference between coarse-grid and fine-grid fluxes
-         if ( NULL != (FluxPtr = patch->ptr[0][lv][PID]->flux[0]) )
-         {
-            for (int v=0; v<NCOMP; v++)
-            for (int k=0; k<PATCH_SIZE; k++)
-            for (int j=0; j<PATCH_SIZE; j++)
-               patch->ptr[ patch->FluSg[lv] ][lv][PID]->fluid[v][k][j][           0] -= FluxPtr[v][k][j] * Const;
-         }
+      real (*Fluid)[PS1][PS1][PS1] = patch->ptr[FluSg][lv][PID]->fluid;
+      real (*FluxPtr)[PS1][PS1]    = NULL;
 
-         if ( NULL != (FluxPtr = patch->ptr[0][lv][PID]->flux[1]) )
-         {
-            for (int v=0; v<NCOMP; v++)
-            for (int k=0; k<PATCH_SIZE; k++)
-            for (int j=0; j<PATCH_SIZE; j++)
-               patch->ptr[ patch->FluSg[lv] ][lv][PID]->fluid[v][k][j][PATCH_SIZE-1] += FluxPtr[v][k][j] * Const;
-         }
+//    b1. sum up the coarse-grid and fine-grid fluxes for the debug mode
+#     ifdef DAINO_DEBUG
+      for (int s=0; s<6; s++)
+      {
+         FluxPtr = patch->ptr[0][lv][PID]->flux[s];
 
-         if ( NULL != (FluxPtr = patch->ptr[0][lv][PID]->flux[2]) )
+         if ( FluxPtr != NULL )
          {
             for (int v=0; v<NCOMP; v++)
-            for (int k=0; k<PATCH_SIZE; k++)
-            for (int i=0; i<PATCH_SIZE; i++)
-               patch->ptr[ patch->FluSg[lv] ][lv][PID]->fluid[v][k][           0][i] -= FluxPtr[v][k][i] * Const;
+            for (int m=0; m<PS1; m++)
+            for (int n=0; n<PS1; n++)
+               FluxPtr[v][m][n] += patch->ptr[0][lv][PID]->flux_debug[s][v][m][n];
          }
+      }
+#     endif
 
-         if ( NULL != (FluxPtr = patch->ptr[0][lv][PID]->flux[3]) )
-         {
-            for (int v=0; v<NCOMP; v++)
-            for (int k=0; k<PATCH_SIZE; k++)
-            for (int i=0; i<PATCH_SIZE; i++)
-               patch->ptr[ patch->FluSg[lv] ][lv][PID]->fluid[v][k][PATCH_SIZE-1][i] += FluxPtr[v][k][i] * Const;
-         }
 
-         if ( NULL != (FluxPtr = patch->ptr[0][lv][PID]->flux[4]) )
-         {
-            for (int v=0; v<NCOMP; v++)
-            for (int j=0; j<PATCH_SIZE; j++)
-            for (int i=0; i<PATCH_SIZE; i++)
-               patch->ptr[ patch->FluSg[lv] ][lv][PID]->fluid[v][           0][j][i] -= FluxPtr[v][j][i] * Const;
-         }
+//    b2. correct fluid variables by the difference between coarse-grid and fine-grid fluxes
+      if ( NULL != (FluxPtr = patch->ptr[0][lv][PID]->flux[0]) )
+      {
+         for (int v=0; v<NCOMP; v++)
+         for (int k=0; k<PATCH_SIZE; k++)
+         for (int j=0; j<PATCH_SIZE; j++)
+            Fluid[v][k][j][           0] -= FluxPtr[v][k][j] * Const;
+      }
 
-         if ( NULL != (FluxPtr = patch->ptr[0][lv][PID]->flux[5]) )
-         {
-            for (int v=0; v<NCOMP; v++)
-            for (int j=0; j<PATCH_SIZE; j++)
-            for (int i=0; i<PATCH_SIZE; i++)
-               patch->ptr[ patch->FluSg[lv] ][lv][PID]->fluid[v][PATCH_SIZE-1][j][i] += FluxPtr[v][j][i] * Const;
-         }
+      if ( NULL != (FluxPtr = patch->ptr[0][lv][PID]->flux[1]) )
+      {
+         for (int v=0; v<NCOMP; v++)
+         for (int k=0; k<PATCH_SIZE; k++)
+         for (int j=0; j<PATCH_SIZE; j++)
+            Fluid[v][k][j][PATCH_SIZE-1] += FluxPtr[v][k][j] * Const;
+      }
 
-      } // for (int PID=0; PID<patch->NPatchComma[lv][1]; PID++)
+      if ( NULL != (FluxPtr = patch->ptr[0][lv][PID]->flux[2]) )
+      {
+         for (int v=0; v<NCOMP; v++)
+         for (int k=0; k<PATCH_SIZE; k++)
+         for (int i=0; i<PATCH_SIZE; i++)
+            Fluid[v][k][           0][i] -= FluxPtr[v][k][i] * Const;
+      }
 
+      if ( NULL != (FluxPtr = patch->ptr[0][lv][PID]->flux[3]) )
+      {
+         for (int v=0; v<NCOMP; v++)
+         for (int k=0; k<PATCH_SIZE; k++)
+         for (int i=0; i<PATCH_SIZE; i++)
+            Fluid[v][k][PATCH_SIZE-1][i] += FluxPtr[v][k][i] * Const;
+      }
 
-//    a3. reset all flux arrays (in both real and buffer patches) to zero for the debug mode
-#     ifdef DAINO_DEBUG
-#     pragma omp parallel for private( FluxPtr )
+      if ( NULL != (FluxPtr = patch->ptr[0][lv][PID]->flux[4]) )
+      {
+         for (int v=0; v<NCOMP; v++)
+         for (int j=0; j<PATCH_SIZE; j++)
+         for (int i=0; i<PATCH_SIZE; i++)
+            Fluid[v][           0][j][i] -= FluxPtr[v][j][i] * Const;
+      }
+
+      if ( NULL != (FluxPtr = patch->ptr[0][lv][PID]->flux[5]) )
+      {
+         for (int v=0; v<NCOMP; v++)
+         for (int j=0; j<PATCH_SIZE; j++)
+         for (int i=0; i<PATCH_SIZE; i++)
+            Fluid[v][PATCH_SIZE-1][j][i] += FluxPtr[v][j][i] * Const;
+      }
+
+   } // for (int PID=0; PID<NPatch; PID++)
+
+
+// c. reset all flux arrays (in both real and buffer patches) to zero for the debug mode
+#  ifdef DAINO_DEBUG
+   if ( OPT__FIXUP_FLUX )
+   {
+#     pragma omp parallel for
       for (int PID=0; PID<patch->NPatchComma[lv][27]; PID++)
       {
+         real (*FluxPtr)[PS1][PS1] = NULL;
+
          for (int s=0; s<6; s++)
          {
             FluxPtr = patch->ptr[0][lv][PID]->flux[s];
@@ -128,19 +165,14 @@ void Flu_FixUp( const int lv, const double dt )
             }
          }
       }
-#     endif
-
    } // if ( OPT__FIXUP_FLUX )
+#  endif
 
 
-// b. average over the data at level "lv+1" to correct the data at level "lv"
-   if ( OPT__FIXUP_RESTRICT )    
-   {
-      Flu_Restrict( lv, patch->FluSg[lv+1], patch->FluSg[lv], NULL_INT, NULL_INT, _FLU );
-
-#     ifdef LOAD_BALANCE 
-      LB_GetBufferData( lv, patch->FluSg[lv], NULL_INT, DATA_RESTRICT, _FLU, NULL_INT );
-#     endif
-   }
+// d. send the restricted data of buffer patches back to their home ranks
+#  ifdef LOAD_BALANCE 
+   if ( OPT__FIXUP_RESTRICT )
+   LB_GetBufferData( lv, FluSg, NULL_INT, DATA_RESTRICT, _FLU, NULL_INT );
+#  endif
 
 } // FUNCTION : Flu_FixUp
@@ -21,11 +21,17 @@ void End_MemFree_Fluid()
       if ( h_Flu_Array_F_Out      [t] != NULL )    delete [] h_Flu_Array_F_Out      [t];
       if ( h_Flux_Array           [t] != NULL )    delete [] h_Flux_Array           [t];
       if ( h_MinDtInfo_Fluid_Array[t] != NULL )    delete [] h_MinDtInfo_Fluid_Array[t];
+#     ifdef TIMING_PATCH
+      if ( h_Flu_Cost_Array       [t] != NULL )    delete [] h_Flu_Cost_Array       [t];
+#     endif
 
       h_Flu_Array_F_In       [t] = NULL; 
       h_Flu_Array_F_Out      [t] = NULL;
       h_Flux_Array           [t] = NULL;
       h_MinDtInfo_Fluid_Array[t] = NULL;
+#     ifdef TIMING_PATCH
+      h_Flu_Cost_Array       [t] = NULL;
+#     endif
    }
 
 } // FUNCTION : End_MemFree_Fluid
@@ -19,6 +19,8 @@ void Init_BaseLevel()
 
 
 // allocate the real base-level patches
+   patch->Reserve( 0, NPatch[0]*NPatch[1]*NPatch[2] );
+
    for (int Pz=0; Pz<NPatch[2]; Pz+=2)    {  Cr[2] = DAINO_RANK_X(2)*NX0[2]*scale0 + Pz*PATCH_SIZE*scale0;
    for (int Py=0; Py<NPatch[1]; Py+=2)    {  Cr[1] = DAINO_RANK_X(1)*NX0[1]*scale0 + Py*PATCH_SIZE*scale0;
    for (int Px=0; Px<NPatch[0]; Px+=2)    {  Cr[0] = DAINO_RANK_X(0)*NX0[0]*scale0 + Px*PATCH_SIZE*scale0;
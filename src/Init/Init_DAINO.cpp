@@ -23,6 +23,10 @@ void Init_DAINO( int *argc, char ***argv )
    Init_Load_Parameter();
 
 
+// detect the NUMA topology and set the OpenMP thread affinity
+   Aux_NUMA_Init();
+
+
 // initialize parameters for the parallelization
    Init_Parallelization();
 
@@ -91,6 +95,12 @@ void Init_DAINO( int *argc, char ***argv )
    Init_Load_FlagCriteria();
 
 
+// set the data reconstruction, Riemann solver, and slope limiter at each level (from "Input__FluScheme" if requested)
+#  ifdef RUNTIME_FLU_SCHEME
+   Init_Load_FluScheme();
+#  endif
+
+
 // load the dump table from the input file "Input__DumpTable"
    if (  ( OPT__OUTPUT_TOTAL || OPT__OUTPUT_PART || OPT__OUTPUT_ERROR || OPT__OUTPUT_BASEPS )  &&  
          OPT__OUTPUT_MODE == OUTPUT_USE_TABLE  )
@@ -137,12 +147,26 @@ void Init_DAINO( int *argc, char ***argv )
 #  endif // #ifdef LOAD_BALANCE
 
 
+// regrid all levels for a refinement configuration different from that of the RESTART file
+   if ( OPT__INIT == INIT_RESTART  &&  OPT__RESTART_REGRID )   Init_Reload_Regrid();
+
+
 // sort all patches for the out-of-core computing
 #  ifdef OOC
    OOC_Init_SortPatch();
 #  endif
 
 
+// sort all patches along the space-filling curve
+   if ( OPT__PATCH_ORDER != PATCH_ORDER_NONE )
+   for (int lv=0; lv<NLEVEL; lv++)     SortPatch( lv );
+
+
+// place the patch data on the NUMA nodes of the threads which will process them
+   if ( OPT__NUMA_FIRST_TOUCH )
+   for (int lv=0; lv<NLEVEL; lv++)     Aux_NUMA_FirstTouch( lv );
+
+
 #  ifdef GRAVITY
 // evaluate the average density if it is not set yet for the periodic Poisson solver
    if ( AveDensity <= 0.0 )   Poi_GetAverageDensity();
@@ -196,11 +220,19 @@ void Init_DAINO( int *argc, char ***argv )
    }
 
 // initialize the array "MinDtInfo_Gravity" since the kernel "XXX" will NOT work during initialization
+// --> always required by the CPU solver of HYDRO since the maximum acceleration is then recorded by
+//     "CPU_HydroGravitySolver" (see "Hydro_GetTimeStep_Gravity")
 #  ifdef GRAVITY
-   if ( OPT__ADAPTIVE_DT )     
+#  if ( MODEL == HYDRO  &&  !defined GPU )
+   const bool Init_MinDtInfo_Gravity = true;
+#  else
+   const bool Init_MinDtInfo_Gravity = OPT__ADAPTIVE_DT;
+#  endif
+
+   if ( Init_MinDtInfo_Gravity )
    {
 #     if   ( MODEL == HYDRO )
-      Hydro_GetMaxAcc( MinDtInfo_Gravity );
+      for (int lv=0; lv<NLEVEL; lv++)  Hydro_GetMaxAcc( lv, MinDtInfo_Gravity );
 
 #     elif ( MODEL == MHD )
 #     error : WAIT MHD !!!
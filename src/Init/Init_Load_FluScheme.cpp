@@ -0,0 +1,126 @@
+
+#include "DAINO.h"
+
+#ifdef RUNTIME_FLU_SCHEME
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Init_Load_FluScheme
+// Description :  Set the data reconstruction scheme, Riemann solver, and slope limiter adopted by the fluid
+//                solver at each level
+//
+// Note        :  1. All levels adopt LR_SCHEME, RSOLVER, and OPT__LR_LIMITER by default
+//                2. If OPT__FLU_SCHEME_LV is on, the per-level settings are loaded from the file
+//                   "Input__FluScheme", which has one header line followed by NLEVEL lines of
+//                      "Level  LR_Scheme  RSolver  LR_Limiter"
+//                   --> LR_Scheme  : (1/2)         = (PLM/PPM)
+//                       RSolver    : (1/2/3/4/5)   = (EXACT/ROE/HLLE/HLLC/HYBRID)
+//                       LR_Limiter : (1/2/3/4/5)   = (vanLeer/generalized MinMod/vanAlbada/
+//                                                     vanLeer + generalized MinMod/extrema-preserving)
+//                       -1         : use the default value (LR_SCHEME/RSOLVER/OPT__LR_LIMITER)
+//                3. The number of ghost zones is fixed by LR_SCHEME at compile time
+//                   --> PPM can only be adopted if LR_SCHEME == PPM, while PLM can be adopted at any level
+//                       (the extra ghost zones prepared for PPM are simply ignored)
+//                4. Only supported by the CPU MHM/MHM_RP/CTU schemes
+//-------------------------------------------------------------------------------------------------------
+void Init_Load_FluScheme()
+{
+
+   if ( MPI_Rank == 0 )    Aux_Message( stdout, "%s ... ", __FUNCTION__ );
+
+
+// 1. set the default values
+   for (int lv=0; lv<NLEVEL; lv++)
+   {
+      FluSchemeTable_LR     [lv] = LR_SCHEME;
+      FluSchemeTable_RSolver[lv] = RSOLVER;
+      FluSchemeTable_Limiter[lv] = OPT__LR_LIMITER;
+   }
+
+
+// 2. load the per-level settings
+   if ( OPT__FLU_SCHEME_LV )
+   {
+      const char FileName[] = "Input__FluScheme";
+
+      FILE *File = fopen( FileName, "r" );
+
+      if ( File == NULL )
+      {
+         Aux_Message( stderr, "\n" );
+         Aux_Error( ERROR_INFO, "the file \"%s\" does not exist for the mode \"%s\" !!\n",
+                    FileName, "OPT__FLU_SCHEME_LV" );
+      }
+
+      char  *input_line = NULL;
+      size_t len        = 0;
+      int    Trash, LR, RS, Lim, n;
+
+//    skip the header
+      getline( &input_line, &len, File );
+
+      for (int lv=0; lv<NLEVEL; lv++)
+      {
+         n = getline( &input_line, &len, File );
+
+         if ( n <= 1  ||  sscanf( input_line, "%d%d%d%d", &Trash, &LR, &RS, &Lim ) != 4 )
+         {
+            Aux_Message( stderr, "\n" );
+            Aux_Error( ERROR_INFO, "incorrect reading at level %d of the file <%s> !!\n", lv, FileName );
+         }
+
+         if ( LR  != -1 )  FluSchemeTable_LR     [lv] = LR;
+         if ( RS  != -1 )  FluSchemeTable_RSolver[lv] = RS;
+         if ( Lim != -1 )  FluSchemeTable_Limiter[lv] = (LR_Limiter_t)Lim;
+      }
+
+      fclose( File );
+
+      if ( input_line != NULL )  free( input_line );
+   } // if ( OPT__FLU_SCHEME_LV )
+
+
+// 3. check
+#  if ( FLU_SCHEME == MHM_RP )
+   const int NGhost_PLM_EP = 4;
+#  else
+   const int NGhost_PLM_EP = 3;
+#  endif
+
+   for (int lv=0; lv<NLEVEL; lv++)
+   {
+      const int          LR  = FluSchemeTable_LR     [lv];
+      const int          RS  = FluSchemeTable_RSolver[lv];
+      const LR_Limiter_t Lim = FluSchemeTable_Limiter[lv];
+
+      if ( LR != PLM  &&  LR != PPM )
+         Aux_Error( ERROR_INFO, "unsupported data reconstruction scheme (%d) at level %d !!\n", LR, lv );
+
+      if ( RS != EXACT  &&  RS != ROE  &&  RS != HLLE  &&  RS != HLLC  &&  RS != HYBRID )
+         Aux_Error( ERROR_INFO, "unsupported Riemann solver (%d) at level %d !!\n", RS, lv );
+
+      if ( Lim != VANLEER  &&  Lim != GMINMOD  &&  Lim != ALBADA  &&  Lim != EXTPRE  &&  Lim != VL_GMINMOD )
+         Aux_Error( ERROR_INFO, "unsupported data reconstruction limiter (%d) at level %d !!\n", Lim, lv );
+
+      if ( LR == PPM  &&  LR_SCHEME != PPM )
+         Aux_Error( ERROR_INFO, "PPM at level %d requires \"%s\" in the makefile !!\n", lv, "LR_SCHEME=PPM" );
+
+      if ( LR == PPM  &&  Lim == EXTPRE )
+         Aux_Error( ERROR_INFO, "currently the PPM reconstruction does not support the \"%s\" limiter (level %d)\n",
+                    "extrema-preserving", lv );
+
+      if ( LR == PLM  &&  Lim == EXTPRE  &&  FLU_GHOST_SIZE < NGhost_PLM_EP )
+         Aux_Error( ERROR_INFO, "PLM + EXTPRE limiter at level %d requires FLU_GHOST_SIZE >= %d !!\n",
+                    lv, NGhost_PLM_EP );
+   }
+
+
+   if ( MPI_Rank == 0 )    Aux_Message( stdout, "done\n" );
+
+} // FUNCTION : Init_Load_FluScheme
+
+
+
+#endif // #ifdef RUNTIME_FLU_SCHEME
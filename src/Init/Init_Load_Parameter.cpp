@@ -58,6 +58,14 @@ void Init_Load_Parameter()
    getline( &input_line, &len, File );
    sscanf( input_line, "%d%s",   &OMP_NTHREAD,              string );
 
+   getline( &input_line, &len, File );
+   sscanf( input_line, "%d%s",   &temp_int,                 string );
+   OPT__THREAD_AFFINITY = (OptAffinity_t)temp_int;
+
+   getline( &input_line, &len, File );
+   sscanf( input_line, "%d%s",   &temp_int,                 string );
+   OPT__NUMA_FIRST_TOUCH = (bool)temp_int;
+
    getline( &input_line, &len, File );
    sscanf( input_line, "%lf%s",  &END_T,                    string );
 
@@ -184,6 +192,10 @@ void Init_Load_Parameter()
    sscanf( input_line, "%d%s",   &OPT__PATCH_COUNT,         string );
 
    getline( &input_line, &len, File );
+   sscanf( input_line, "%d%s",   &temp_int,                 string );
+   OPT__PATCH_ORDER = (OptPatchOrder_t)temp_int;
+
+   getline( &input_line, &len, File );
 
 
 // load balance
@@ -237,6 +249,10 @@ void Init_Load_Parameter()
    sscanf( input_line, "%d%s",   &temp_int,                 string );
    OPT__WAF_LIMITER = (WAF_Limiter_t)temp_int;
 
+   getline( &input_line, &len, File );
+   sscanf( input_line, "%d%s",   &temp_int,                 string );
+   OPT__FLU_SCHEME_LV = (bool)temp_int;
+
 #  elif ( MODEL == MHD )
 #  warning : WAIT MHD !!!
 
@@ -248,6 +264,7 @@ void Init_Load_Parameter()
    getline( &input_line, &len, File );
    getline( &input_line, &len, File );
    getline( &input_line, &len, File );
+   getline( &input_line, &len, File );
 #  endif // MODEL
 
    getline( &input_line, &len, File );
@@ -284,6 +301,9 @@ void Init_Load_Parameter()
    getline( &input_line, &len, File );
    sscanf( input_line, "%d%s",   &GPU_NSTREAM,              string );
 
+   getline( &input_line, &len, File );
+   sscanf( input_line, "%d%s",   &OPT__TUNE_NPGROUP,        string );
+
    getline( &input_line, &len, File );
    sscanf( input_line, "%d%s",   &temp_int,                 string );
    OPT__FIXUP_FLUX = (bool)temp_int;
@@ -324,6 +344,14 @@ void Init_Load_Parameter()
    getline( &input_line, &len, File );
    sscanf( input_line, "%d%s",   &SOR_MIN_ITER,             string );
 
+#  ifdef FLOAT8
+   getline( &input_line, &len, File );
+   sscanf( input_line, "%lf%s",  &SOR_TOLERATED_ERROR,      string );
+#  else
+   getline( &input_line, &len, File );
+   sscanf( input_line, "%f%s",   &SOR_TOLERATED_ERROR,      string );
+#  endif
+
    getline( &input_line, &len, File );
    sscanf( input_line, "%d%s",   &MG_MAX_ITER,              string );
 
@@ -348,6 +376,10 @@ void Init_Load_Parameter()
    sscanf( input_line, "%d%s",   &temp_int,                 string );
    OPT__GRA_P5_GRADIENT = (bool)temp_int;
 
+   getline( &input_line, &len, File );
+   sscanf( input_line, "%d%s",   &temp_int,                 string );
+   OPT__POT_WARM_START = (bool)temp_int;
+
 #  else // #ifdef GRAVITY ... else ...
 
    getline( &input_line, &len, File );
@@ -360,6 +392,8 @@ void Init_Load_Parameter()
    getline( &input_line, &len, File );
    getline( &input_line, &len, File );
    getline( &input_line, &len, File );
+   getline( &input_line, &len, File );
+   getline( &input_line, &len, File );
 
 #  endif // #ifdef GRAVITY ... else ...
 
@@ -375,6 +409,14 @@ void Init_Load_Parameter()
    sscanf( input_line, "%d%s",   &temp_int,                 string );
    OPT__RESTART_HEADER = (OptRestartH_t)temp_int;
 
+   getline( &input_line, &len, File );
+   sscanf( input_line, "%d%s",   &temp_int,                 string );
+   OPT__RESTART_REGRID = (bool)temp_int;
+
+   getline( &input_line, &len, File );
+   sscanf( input_line, "%d%s",   &temp_int,                 string );
+   OPT__RESTART_CRC = (bool)temp_int;
+
    getline( &input_line, &len, File );
    sscanf( input_line, "%d%s",   &OPT__UM_START_LEVEL,      string );
 
@@ -445,10 +487,20 @@ void Init_Load_Parameter()
    getline( &input_line, &len, File );
    sscanf( input_line, "%d%s",   &OPT__OUTPUT_TOTAL,        string );
 
+   getline( &input_line, &len, File );
+   sscanf( input_line, "%d%s",   &OPT__OUTPUT_DELTA,        string );
+
+   getline( &input_line, &len, File );
+   sscanf( input_line, "%d%s",   &OPT__OUTPUT_CRC,          string );
+
    getline( &input_line, &len, File );
    sscanf( input_line, "%d%s",   &temp_int,                 string );
    OPT__OUTPUT_PART = (OptOutputPart_t)temp_int;
 
+   getline( &input_line, &len, File );
+   sscanf( input_line, "%d%s",   &temp_int,                 string );
+   OPT__OUTPUT_PART_BIN = (bool)temp_int;
+
    getline( &input_line, &len, File );
    sscanf( input_line, "%d%s",   &temp_int,                 string );
    OPT__OUTPUT_ERROR = (bool)temp_int;
@@ -457,6 +509,9 @@ void Init_Load_Parameter()
    sscanf( input_line, "%d%s",   &temp_int,                 string );
    OPT__OUTPUT_BASEPS = (bool)temp_int;
 
+   getline( &input_line, &len, File );
+   sscanf( input_line, "%d%s",   &OPT__RECORD_BASEPS,       string );
+
    getline( &input_line, &len, File );
    sscanf( input_line, "%d%s",   &temp_int,                 string );
    OPT__OUTPUT_BASE = (bool)temp_int;
@@ -498,10 +553,26 @@ void Init_Load_Parameter()
    sscanf( input_line, "%f%s",   &OUTPUT_PART_Z,            string );
 #  endif
 
+   getline( &input_line, &len, File );
+   sscanf( input_line, "%d%s",   &OUTPUT_PART_LV,           string );
+
    getline( &input_line, &len, File );
    sscanf( input_line, "%d%s",   &INIT_DUMPID,              string );
 
    getline( &input_line, &len, File );
+   sscanf( input_line, "%d%s",   &OPT__SPHERE_ANALYSIS,     string );
+
+   getline( &input_line, &len, File );
+   sscanf( input_line, "%d%s",   &SPHERE_NSHELL,            string );
+
+   getline( &input_line, &len, File );
+   sscanf( input_line, "%lf%s",  &SPHERE_MAX_RADIUS,        string );
+
+   getline( &input_line, &len, File );
+   sscanf( input_line, "%d%s",   &temp_int,                 string );
+   OPT__SPHERE_MAXRHO_CEN = (bool)temp_int;
+
+   getline( &input_line, &len, File );
 
 
 // miscellaneous
@@ -615,6 +686,24 @@ void ResetParameter()
                    "OMP_NTHREAD" );
 
    OMP_NTHREAD = 1;
+
+   if ( OPT__THREAD_AFFINITY != AFFINITY_NONE )
+   {
+      OPT__THREAD_AFFINITY = AFFINITY_NONE;
+
+      if ( MPI_Rank == 0 )
+         Aux_Message( stderr, "WARNING : option \"%s\" is disabled since \"OPENMP\" is not turned on !!\n", 
+                      "OPT__THREAD_AFFINITY" );
+   }
+
+   if ( OPT__NUMA_FIRST_TOUCH )
+   {
+      OPT__NUMA_FIRST_TOUCH = false;
+
+      if ( MPI_Rank == 0 )
+         Aux_Message( stderr, "WARNING : option \"%s\" is disabled since \"OPENMP\" is not turned on !!\n", 
+                      "OPT__NUMA_FIRST_TOUCH" );
+   }
 #  endif
 
 
@@ -702,10 +791,16 @@ void ResetParameter()
    if ( MPI_Rank == 0 )  Aux_Message( stdout, "NOTE : parameter \"%s\" is set to the default value = %d\n",
                                       "GPU_NSTREAM", GPU_NSTREAM );
 
+// --> the number of patch groups per thread is reduced for PATCH_SIZE > 8 so that the number of cells
+//     (and hence the memory consumption) of each batch is roughly independent of PATCH_SIZE
+#  ifdef OPENMP
+   const int NPG_PerThread = MAX( 1, 20*CUBE(8)/CUBE(PATCH_SIZE) );
+#  endif
+
    if ( FLU_GPU_NPGROUP <= 0 )  
    {
 #     ifdef OPENMP
-      FLU_GPU_NPGROUP = OMP_NTHREAD*20;
+      FLU_GPU_NPGROUP = OMP_NTHREAD*NPG_PerThread;
 #     else
       FLU_GPU_NPGROUP = 1;
 #     endif
@@ -718,7 +813,7 @@ void ResetParameter()
    if ( POT_GPU_NPGROUP <= 0 )  
    {
 #     ifdef OPENMP
-      POT_GPU_NPGROUP = OMP_NTHREAD*20;
+      POT_GPU_NPGROUP = OMP_NTHREAD*NPG_PerThread;
 #     else
       POT_GPU_NPGROUP = 1;
 #     endif
@@ -872,6 +967,14 @@ void ResetParameter()
                                          "MAX_LEVEL", MAX_LEVEL );
    }
 
+   if ( OUTPUT_PART_LV < 0 )
+   {
+      OUTPUT_PART_LV = MAX_LEVEL;
+
+      if ( MPI_Rank == 0 )  Aux_Message( stdout, "NOTE : parameter \"%s\" is set to the default value = %d\n",
+                                         "OUTPUT_PART_LV", OUTPUT_PART_LV );
+   }
+
 
 // (10) refinement frequency and the size of flag buffer
    if ( REGRID_COUNT < 0 )
@@ -918,6 +1021,16 @@ void ResetParameter()
    else                    DumpID = INIT_DUMPID;
 
 
+// (12) radius of the sphere for the in-situ sphere analysis
+   if ( SPHERE_MAX_RADIUS < 0.0 )
+   {
+      SPHERE_MAX_RADIUS = 0.5*BOX_SIZE;
+
+      if ( MPI_Rank == 0 )  Aux_Message( stdout, "NOTE : parameter \"%s\" is set to the default value = %13.7e\n",
+                                         "SPHERE_MAX_RADIUS", SPHERE_MAX_RADIUS );
+   }
+
+
 // reset parameters and options which are either unsupported or useless
 // ------------------------------------------------------------------------------------------------------
 // (1) general
@@ -943,7 +1056,18 @@ void ResetParameter()
    }
 #  endif
 
-// (1-3) disable "OPT__CK_FLUX_ALLOCATE" if no flux arrays are going to be allocated
+// (1-3) enable "OPT__OUTPUT_PART_BIN" for the projections, which are only supported in the binary form
+   if ( !OPT__OUTPUT_PART_BIN  &&
+        ( OPT__OUTPUT_PART == OUTPUT_PROJ_X || OPT__OUTPUT_PART == OUTPUT_PROJ_Y || OPT__OUTPUT_PART == OUTPUT_PROJ_Z ) )
+   {
+      OPT__OUTPUT_PART_BIN = true;
+
+      if ( MPI_Rank == 0 )    
+         Aux_Message( stderr, "WARNING : option \"%s\" is turned on since projection is only supported in binary !!\n",
+                      "OPT__OUTPUT_PART_BIN" );
+   }
+
+// (1-4) disable "OPT__CK_FLUX_ALLOCATE" if no flux arrays are going to be allocated
    if ( OPT__CK_FLUX_ALLOCATE  &&  !patch->WithFlux )
    {
       OPT__CK_FLUX_ALLOCATE = false;
@@ -1110,6 +1234,18 @@ void ResetParameter()
    }
 #  endif
 
+// (8-2) disable "OPT__PATCH_ORDER" since the buffer patches are not remapped (also for the out-of-core computing)
+#  if ( !defined SERIAL  ||  defined OOC )
+   if ( OPT__PATCH_ORDER != PATCH_ORDER_NONE )
+   {
+      OPT__PATCH_ORDER = PATCH_ORDER_NONE;
+
+      if ( MPI_Rank == 0 )    
+         Aux_Message( stderr, "WARNING : option \"%s\" is only supported in the SERIAL mode and hence is disabled !!\n",
+                      "OPT__PATCH_ORDER" );
+   }
+#  endif
+
 
 // (9) for different modes
 #  if ( MODEL != HYDRO  &&  MODEL != MHD )
@@ -1178,7 +1314,7 @@ void ResetParameter()
 #  endif
 
 
-// (9-4) set OPT__LR_LIMITER and OPT__WAF_LIMITER to NONE if they are useless (in HYDRO)
+// (9-4) reset OPT__LR_LIMITER, OPT__WAF_LIMITER, and OPT__FLU_SCHEME_LV if they are useless (in HYDRO)
 #  if ( MODEL == HYDRO )
 #  if ( FLU_SCHEME != MHM  &&  FLU_SCHEME != MHM_RP  &&  FLU_SCHEME != CTU )
    if ( OPT__LR_LIMITER != LR_LIMITER_NONE )    
@@ -1205,10 +1341,25 @@ void ResetParameter()
       }
    }
 #  endif
+
+#  ifndef RUNTIME_FLU_SCHEME
+   if ( OPT__FLU_SCHEME_LV )
+   {
+      OPT__FLU_SCHEME_LV = false;
+
+      if ( MPI_Rank == 0 )
+      {
+         Aux_Message( stderr, "WARNING : \"%s\" is only supported by the CPU MHM/MHM_RP/CTU schemes with ",
+                      "OPT__FLU_SCHEME_LV" );
+         Aux_Message( stderr, "the compilation option \"RUNTIME_FLU_SCHEME\" " );
+         Aux_Message( stderr, "and has been disabled !!\n" );
+      }
+   }
+#  endif
 #  endif // #if ( MODEL == HYDRO )
 
 
-// (10) currently OPT__OUTPUT_BASEPS is not supported if the self-gravity is disabled
+// (10) currently OPT__OUTPUT_BASEPS and OPT__RECORD_BASEPS are not supported if the self-gravity is disabled
 #  ifndef GRAVITY 
    if ( OPT__OUTPUT_BASEPS )
    {
@@ -1218,6 +1369,80 @@ void ResetParameter()
          Aux_Message( stderr, "WARNING : option \"%s\" is not supported when GRAVITY is off and hence is disabled !!\n",
                       "OPT__OUTPUT_BASEPS" );
    }
+
+   if ( OPT__RECORD_BASEPS > 0 )
+   {
+      OPT__RECORD_BASEPS = 0;
+
+      if ( MPI_Rank == 0 )    
+         Aux_Message( stderr, "WARNING : option \"%s\" is not supported when GRAVITY is off and hence is disabled !!\n",
+                      "OPT__RECORD_BASEPS" );
+   }
+#  endif
+
+
+// (11) the in-situ sphere analysis is not supported in the out-of-core computing
+#  ifdef OOC
+   if ( OPT__SPHERE_ANALYSIS > 0 )
+   {
+      OPT__SPHERE_ANALYSIS = 0;
+
+      if ( MPI_Rank == 0 )    
+         Aux_Message( stderr, "WARNING : option \"%s\" is not supported in OOC and hence is disabled !!\n",
+                      "OPT__SPHERE_ANALYSIS" );
+   }
+#  endif
+
+
+// (12) the delta dumps are not supported in the out-of-core computing
+#  ifdef OOC
+   if ( OPT__OUTPUT_DELTA > 0 )
+   {
+      OPT__OUTPUT_DELTA = 0;
+
+      if ( MPI_Rank == 0 )    
+         Aux_Message( stderr, "WARNING : option \"%s\" is not supported in OOC and hence is disabled !!\n",
+                      "OPT__OUTPUT_DELTA" );
+   }
+#  endif
+
+
+// (13) the restart regrid is not supported in the out-of-core computing
+#  ifdef OOC
+   if ( OPT__RESTART_REGRID )
+   {
+      OPT__RESTART_REGRID = false;
+
+      if ( MPI_Rank == 0 )    
+         Aux_Message( stderr, "WARNING : option \"%s\" is not supported in OOC and hence is disabled !!\n",
+                      "OPT__RESTART_REGRID" );
+   }
+#  endif
+
+
+// (14) the block checksums are not supported in the out-of-core computing
+#  ifdef OOC
+   if ( OPT__OUTPUT_CRC > 0 )
+   {
+      OPT__OUTPUT_CRC = 0;
+
+      if ( MPI_Rank == 0 )    
+         Aux_Message( stderr, "WARNING : option \"%s\" is not supported in OOC and hence is disabled !!\n",
+                      "OPT__OUTPUT_CRC" );
+   }
+#  endif
+
+
+// (15) the batch-size autotuning is supported only for the CPU solvers and not in the out-of-core computing
+#  if ( defined GPU  ||  defined OOC )
+   if ( OPT__TUNE_NPGROUP > 0 )
+   {
+      OPT__TUNE_NPGROUP = 0;
+
+      if ( MPI_Rank == 0 )    
+         Aux_Message( stderr, "WARNING : option \"%s\" is not supported in GPU/OOC and hence is disabled !!\n",
+                      "OPT__TUNE_NPGROUP" );
+   }
 #  endif
 
 } // FUNCTION : ResetParameter
@@ -24,6 +24,26 @@ void Init_MemAllocate_Fluid( const int Flu_NPatchGroup )
 
       if ( OPT__ADAPTIVE_DT )
       h_MinDtInfo_Fluid_Array[t] = new real [Flu_NPatchGroup];
+#     ifdef TIMING_PATCH
+      h_Flu_Cost_Array       [t] = new double [Flu_NPatchGroup];
+#     endif
+   }
+
+
+// first touch the arrays of each patch group by the thread which will prepare and solve it
+// --> the same (default) loop schedule as the preparation and closing steps must be adopted
+   if ( OPT__NUMA_FIRST_TOUCH )
+   {
+#     pragma omp parallel for
+      for (int TID=0; TID<Flu_NPatchGroup; TID++)
+      for (int t=0; t<2; t++)
+      {
+         memset( h_Flu_Array_F_In [t][TID], 0, sizeof(h_Flu_Array_F_In [t][TID]) );
+         memset( h_Flu_Array_F_Out[t][TID], 0, sizeof(h_Flu_Array_F_Out[t][TID]) );
+
+         if ( patch->WithFlux )
+         memset( h_Flux_Array     [t][TID], 0, sizeof(h_Flux_Array     [t][TID]) );
+      }
    }
 
 } // FUNCTION : Init_MemAllocate_Fluid
@@ -7,14 +7,27 @@
 
 void ResetParameter();
 static void Load_Parameter_Before_1200( FILE *File, const int FormatVersion, int &NLv_Restart, 
-                                        bool &DataOrder_xyzv, bool &LoadPot );
+                                        bool &DataOrder_xyzv, bool &LoadPot, int *NX0Tot_Restart );
 static void Load_Parameter_After_1200 ( FILE *File, const int FormatVersion, int &NLv_Restart, 
-                                        bool &DataOrder_xyzv, bool &LoadPot );
+                                        bool &DataOrder_xyzv, bool &LoadPot, int *NX0Tot_Restart );
 static void CompareVar( const char *VarName, const bool   RestartVar, const bool   RuntimeVar, const bool Fatal );
 static void CompareVar( const char *VarName, const int    RestartVar, const int    RuntimeVar, const bool Fatal );
 static void CompareVar( const char *VarName, const long   RestartVar, const long   RuntimeVar, const bool Fatal );
 static void CompareVar( const char *VarName, const real   RestartVar, const real   RuntimeVar, const bool Fatal );
 static void CompareVar( const char *VarName, const double RestartVar, const double RuntimeVar, const bool Fatal );
+#ifndef OOC
+static void LoadPatchData( FILE *File, const int lv, const int PID, const bool DataOrder_xyzv, const bool LoadPot,
+                           real (*InvData_Flu)[PATCH_SIZE][PATCH_SIZE][NCOMP] );
+static void Reload_DeltaChain( const int ParentDumpID, const int NLv_Restart, const int rescale, const long InfoSize,
+                               const long PatchDataSize, const bool DataOrder_xyzv, const bool LoadPot,
+                               real (*InvData_Flu)[PATCH_SIZE][PATCH_SIZE][NCOMP], const int NChain[],
+                               int *Chain_PID[], int *Chain_DataID[] );
+static void Reload_FullLevel( const int lv );
+static void Reload_CoarseLeaf( const int TLv, const int Corner[], const int RangeMin[], const int RangeMax[] );
+static void Reload_ProlongBase( const int LvShift, const int NLv_Restart, const int rescale, const long Offset0,
+                                const int NPatch_File[], const long PatchDataSize, const bool DataOrder_xyzv,
+                                const bool LoadPot, const int NPatch_Prolong );
+#endif
 
 
 
@@ -33,6 +46,27 @@ static void CompareVar( const char *VarName, const double RestartVar, const doub
 //
 //                   "OPT__RESTART_HEADER == RESTART_HEADER_SKIP"
 //                   --> skip the header information in the RESTART file
+//
+//                3. For a delta dump (format version 1202, see "Output_DumpData_Total"), the data of patches not
+//                   stored in the RESTART file are loaded from the parent dumps "Data_XXXXXX", which must be
+//                   located in the working directory
+//
+//                4. If "OPT__RESTART_CRC" is on, the block checksums of the RESTART file are verified before
+//                   loading (see "Aux_Check_DumpChecksum")
+//                   --> The checksum file is named after the target of the symbolic link "RESTART" (e.g.,
+//                       "Data_000003.crc"), or "RESTART.crc" if RESTART is a regular file
+//                   --> The parent dumps of a delta dump are not verified
+//
+//                5. If "OPT__RESTART_REGRID" is on, NX0_TOT can differ from that of the RESTART file by the same
+//                   power of two in all directions (the refinement ratio between two adjacent levels)
+//                   --> Level "lv" in the RESTART file is loaded as level "lv+LvShift", where 
+//                       2^LvShift = (NX0_TOT in the RESTART file) / (NX0_TOT at runtime)
+//                   --> LvShift > 0 : levels 0 ~ LvShift-1 are fully refined and restricted from the loaded data
+//                       LvShift < 0 : the base-level patches not loaded from level -LvShift of the RESTART file
+//                                     are prolonged from the coarser levels (see "Reload_ProlongBase")
+//                   --> The grid hierarchy is then rebuilt by "Init_Reload_Regrid"
+//                   --> NX0_TOT of the RESTART file is only known if "OPT__RESTART_HEADER == RESTART_HEADER_CHECK"
+//                   --> Not supported for delta dumps and in LOAD_BALANCE/OOC
 //-------------------------------------------------------------------------------------------------------
 void Init_Reload()
 {
@@ -42,6 +76,29 @@ void Init_Reload()
 
    const char FileName[] = "RESTART";
 
+
+// verify the block checksums
+   if ( OPT__RESTART_CRC )
+   {
+      char *Target  = realpath( FileName, NULL );
+      char *CRCName = new char [ strlen( (Target==NULL) ? FileName : Target ) + 5 ];
+
+      sprintf( CRCName, "%s.crc", (Target==NULL) ? FileName : Target );
+
+      const int NBad = Aux_Check_DumpChecksum( FileName, CRCName );
+
+      if ( NBad < 0  &&  MPI_Rank == 0 )
+         Aux_Error( ERROR_INFO, "cannot verify the restart file \"%s\" without the checksum file \"%s\" !!\n",
+                    FileName, CRCName );
+
+      if ( NBad > 0  &&  MPI_Rank == 0 )
+         Aux_Error( ERROR_INFO, "%d corrupted blocks are found in the restart file \"%s\" !!\n", NBad, FileName );
+
+      free( Target );
+      delete [] CRCName;
+   }
+
+
    FILE *File = fopen( FileName, "rb" );
 
    if ( File == NULL  &&  MPI_Rank == 0 )
@@ -132,13 +189,16 @@ void Init_Reload()
    int  NLv_Restart    = NLEVEL;
    bool DataOrder_xyzv = false;
    bool LoadPot        = false;
+   int  NX0Tot_Restart[3];
+
+   for (int d=0; d<3; d++)    NX0Tot_Restart[d] = NX0_TOT[d];
 
    if ( OPT__RESTART_HEADER != RESTART_HEADER_SKIP )
    {
       if ( FormatVersion < 1200 )   
-         Load_Parameter_Before_1200( File, FormatVersion, NLv_Restart, DataOrder_xyzv, LoadPot );
+         Load_Parameter_Before_1200( File, FormatVersion, NLv_Restart, DataOrder_xyzv, LoadPot, NX0Tot_Restart );
       else
-         Load_Parameter_After_1200 ( File, FormatVersion, NLv_Restart, DataOrder_xyzv, LoadPot );
+         Load_Parameter_After_1200 ( File, FormatVersion, NLv_Restart, DataOrder_xyzv, LoadPot, NX0Tot_Restart );
    }
 
    else
@@ -148,8 +208,48 @@ void Init_Reload()
    }
 
 
-// set the rescale factor for different NLEVEL
-   const int rescale = 1 << ( NLEVEL - NLv_Restart );
+// set the level shift for different NX0_TOT (which is allowed only if OPT__RESTART_REGRID is on)
+// --> level "lv" in the RESTART file is loaded as level "lv+LvShift"
+   int LvShift = NLEVEL;
+
+   for (int s=1-NLEVEL; s<NLEVEL; s++)
+   {
+      bool Match = true;
+
+      for (int d=0; d<3; d++)
+      {
+         if ( s >= 0 )  Match &= ( NX0Tot_Restart[d]      == NX0_TOT[d]<<s  );
+         else           Match &= ( NX0Tot_Restart[d]<<-s  == NX0_TOT[d]     );
+      }
+
+      if ( Match )
+      {
+         LvShift = s;
+         break;
+      }
+   }
+
+   if ( LvShift == NLEVEL )
+      Aux_Error( ERROR_INFO, "NX0_TOT (%d,%d,%d) != (%d,%d,%d) in the RESTART file (%s) !!\n",
+                 NX0_TOT[0], NX0_TOT[1], NX0_TOT[2], NX0Tot_Restart[0], NX0Tot_Restart[1], NX0Tot_Restart[2],
+                 "only the same power of two in all directions is supported" );
+
+#  if ( defined LOAD_BALANCE  ||  defined OOC )
+   if ( LvShift != 0 )
+      Aux_Error( ERROR_INFO, "changing NX0_TOT during restart is not supported in LOAD_BALANCE and OOC !!\n" );
+#  endif
+
+   if ( MPI_Rank == 0  &&  LvShift != 0 )
+      Aux_Message( stdout, "   NX0_TOT (%d,%d,%d) -> (%d,%d,%d) : %s the base-level data by a factor of %d\n",
+                   NX0Tot_Restart[0], NX0Tot_Restart[1], NX0Tot_Restart[2], NX0_TOT[0], NX0_TOT[1], NX0_TOT[2],
+                   ( LvShift > 0 ) ? "restricting" : "prolonging", 1<<abs(LvShift) );
+
+
+// set the rescale factor for different NLEVEL and NX0_TOT
+// --> the corner coordinates are divided by "rescale_inv" if the RESTART file has levels shifted above NLEVEL-1,
+//     which must be empty (checked after loading the number of patches)
+   const int rescale     = 1 << MAX(  NLEVEL - NLv_Restart - LvShift, 0 );
+   const int rescale_inv = 1 << MAX( -NLEVEL + NLv_Restart + LvShift, 0 );
    if ( MPI_Rank == 0  &&  rescale != 1 )    
       Aux_Message( stderr, "WARNING : the rescale factor is set to %d\n", rescale );
 
@@ -169,7 +269,8 @@ void Init_Reload()
 // =================================================================================================
    if ( MPI_Rank == 0 )    Aux_Message( stdout, "   Loading simulation information ... \n" );
 
-   int NDataPatch_Total[NLv_Restart];
+   const bool Delta = ( FormatVersion == 1202 );
+   int NDataPatch_Total[NLv_Restart], RestartDumpID, ParentDumpID=-1, BaseDumpID=-1;
 
    fread( &DumpID,          sizeof(int),              1, File );
    fread( Time,             sizeof(double), NLv_Restart, File );
@@ -183,6 +284,29 @@ void Init_Reload()
 #  else
    fseek( File, sizeof(double), SEEK_CUR );
 #  endif
+   if ( Delta )
+   {
+   fread( &ParentDumpID,    sizeof(int),              1, File );
+   fread( &BaseDumpID,      sizeof(int),              1, File );
+   }
+
+   RestartDumpID = DumpID;
+
+#  ifdef OOC
+   if ( Delta )   Aux_Error( ERROR_INFO, "restarting from a delta dump is not supported in OOC !!\n" );
+#  endif
+
+   if ( MPI_Rank == 0  &&  Delta )
+      Aux_Message( stdout, "   Delta dump %d : parent dump = %d, base dump = %d\n", RestartDumpID, ParentDumpID,
+                   BaseDumpID );
+
+   if ( Delta  &&  LvShift != 0 )
+      Aux_Error( ERROR_INFO, "changing NX0_TOT is not supported when restarting from a delta dump !!\n" );
+
+   for (int lv=NLEVEL-LvShift; lv<NLv_Restart; lv++)
+      if ( NPatchTotal[lv] != 0 )
+         Aux_Error( ERROR_INFO, "level %d in the RESTART file is shifted to level %d > NLEVEL-1 (%s) !!\n",
+                    lv, lv+LvShift, "please set NLEVEL larger" );
 
 
 // set parameters in levels that do not exist in the input file
@@ -195,7 +319,8 @@ void Init_Reload()
 
 
 // skip the buffer space
-   const int NBuf_Info_1200 = 1024 - 0*size_bool - (1+3*NLv_Restart)*size_int - 2*size_long 
+   const int NDeltaInfo     = ( Delta ) ? 2 : 0;
+   const int NBuf_Info_1200 = 1024 - 0*size_bool - (1+3*NLv_Restart+NDeltaInfo)*size_int - 2*size_long 
                                    - 0*size_real - (1+NLv_Restart)*size_double;
    const int NBuf_Info      = ( FormatVersion >= 1200 ) ? NBuf_Info_1200 : 80-size_double;
 
@@ -210,8 +335,9 @@ void Init_Reload()
 // verify the size of the RESTART file
    long InfoSize, DataSize[NLv_Restart], ExpectSize, InputSize, PatchDataSize;
    int NVar;   // number of variables ( NCOMP or NCOMP+1 -> potential )
+   const int NInfo = ( Delta ) ? 5 : 4;
 
-   InfoSize =     sizeof(int   )*( 1 + 2*NLv_Restart )
+   InfoSize =     sizeof(int   )*( 1 + 2*NLv_Restart + NDeltaInfo )
                 + sizeof(long  )*( 2                 )   // Step + checkcode
                 + sizeof(uint  )*(       NLv_Restart )
                 + sizeof(double)*( 1 +   NLv_Restart )
@@ -229,7 +355,7 @@ void Init_Reload()
    for (int lv=0; lv<NLv_Restart; lv++)
    {
       DataSize[lv]  = 0;
-      DataSize[lv] += NPatchTotal[lv]*4*sizeof(int);        // 4 = corner(3) + son(1)
+      DataSize[lv] += NPatchTotal[lv]*NInfo*sizeof(int);    // 4 = corner(3) + son(1) (+ DumpDataID(1) for delta)
       DataSize[lv] += NDataPatch_Total[lv]*PatchDataSize;
 
       ExpectSize   += DataSize[lv];
@@ -250,7 +376,8 @@ void Init_Reload()
 // d. load the simulation data
 // =================================================================================================
    const long Offset0 = HeaderSize + InfoSize;
-   int LoadCorner[3], LoadSon;
+   int LoadCorner[3], LoadSon, LoadDataID=RestartDumpID;
+   bool LoadData;
 
 // array for re-ordering the fluid data from "xyzv" to "vxyz"
    real (*InvData_Flu)[PATCH_SIZE][PATCH_SIZE][NCOMP] = NULL;
@@ -281,12 +408,13 @@ void Init_Reload()
          {
             fread(  LoadCorner, sizeof(int), 3, File );
             fread( &LoadSon,    sizeof(int), 1, File );
+            if ( Delta )   fread( &LoadDataID, sizeof(int), 1, File );
 
             for (int d=0; d<3; d++)    LoadCorner[d] *= rescale;
 
             LBIdx_AllRank[LoadPID] = LB_Corner2Index( lv, LoadCorner, CHECK_ON );
 
-            if ( LoadSon == -1 )    fseek( File, PatchDataSize, SEEK_CUR );
+            if ( LoadSon == -1  &&  LoadDataID == RestartDumpID )    fseek( File, PatchDataSize, SEEK_CUR );
          }
       } // if ( MPI_Rank == 0 )
 
@@ -301,9 +429,28 @@ void Init_Reload()
 #  endif // #ifdef LOAD_BALANCE
 
 
+// leaf patches whose data are stored in the parent dumps of a delta dump
+#  ifndef OOC
+   int  NChain[NLv_Restart], *Chain_PID[NLv_Restart], *Chain_DataID[NLv_Restart];
+
+   for (int lv=0; lv<NLv_Restart; lv++)
+   {
+      NChain      [lv] = 0;
+      Chain_PID   [lv] = ( Delta ) ? new int [ NPatchTotal[lv] ] : NULL;
+      Chain_DataID[lv] = ( Delta ) ? new int [ NPatchTotal[lv] ] : NULL;
+   }
+#  endif
+
+
+// allocate the levels coarser than the base level of the RESTART file
+#  ifndef OOC
+   for (int lv=0; lv<LvShift; lv++)    Reload_FullLevel( lv );
+#  endif
+
+
 // begin to load data
    long Offset = Offset0;
-   int  PID;
+   int  PID, NPatch_Prolong = 0;
 #  ifndef OOC
 #  ifndef LOAD_BALANCE
    int TargetRange_Min[3], TargetRange_Max[3];
@@ -312,6 +459,13 @@ void Init_Reload()
 
    for (int lv=0; lv<NLv_Restart; lv++)
    {
+//    targeted level at runtime (TLv < 0 --> coarser than the runtime base level)
+      const int TLv = lv + LvShift;
+      const int RLv = ( TLv < 0 ) ? 0 : TLv;
+
+//    levels shifted above NLEVEL-1 are empty
+      if ( TLv >= NLEVEL )    break;
+
       for (int TargetMPIRank=0; TargetMPIRank<MPI_NRank; TargetMPIRank++)
       {
          if ( MPI_Rank == 0 )    Aux_Message( stdout, "   Loading data at level %2d, MPI_Rank %3d ... ", lv, TargetMPIRank );
@@ -339,13 +493,28 @@ void Init_Reload()
 //             d2. load the patch information
                fread(  LoadCorner, sizeof(int), 3, File );
                fread( &LoadSon,    sizeof(int), 1, File );
+               if ( Delta )   fread( &LoadDataID, sizeof(int), 1, File );
 
-               for (int d=0; d<3; d++)    LoadCorner[d] *= rescale;
+               for (int d=0; d<3; d++)    LoadCorner[d] = LoadCorner[d]*rescale/rescale_inv;
+
+               LoadData = ( LoadSon == -1  &&  LoadDataID == RestartDumpID );
+
+
+//             allocate the base-level patches covered by the leaf patches coarser than the runtime base level
+#              ifndef LOAD_BALANCE
+               if ( TLv < 0 )
+               {
+                  if ( LoadSon == -1 )    Reload_CoarseLeaf( TLv, LoadCorner, TargetRange_Min, TargetRange_Max );
+                  if ( LoadData )         fseek( File, PatchDataSize, SEEK_CUR );
+
+                  continue;
+               }
+#              endif
 
 
 //             verify that the loaded patch is within the targeted range
 #              ifdef LOAD_BALANCE
-               if (  MPI_Rank == LB_Index2Rank( lv, LB_Corner2Index(lv,LoadCorner,CHECK_ON), CHECK_ON )  )
+               if (  MPI_Rank == LB_Index2Rank( TLv, LB_Corner2Index(TLv,LoadCorner,CHECK_ON), CHECK_ON )  )
 #              else
                if (  LoadCorner[0] >= TargetRange_Min[0]  &&  LoadCorner[0] < TargetRange_Max[0]  &&
                      LoadCorner[1] >= TargetRange_Min[1]  &&  LoadCorner[1] < TargetRange_Max[1]  &&
@@ -353,39 +522,24 @@ void Init_Reload()
 #              endif
                {
 
-                  patch->pnew( lv, LoadCorner[0], LoadCorner[1], LoadCorner[2], -1, true, true );
+                  patch->pnew( TLv, LoadCorner[0], LoadCorner[1], LoadCorner[2], -1, true, true );
+
+                  PID = patch->num[TLv] - 1;
 
 //                d3. load the physical data if it is a leaf patch
-                  if ( LoadSon == -1 )
+                  if ( LoadData )   LoadPatchData( File, TLv, PID, DataOrder_xyzv, LoadPot, InvData_Flu );
+
+//                record the leaf patches whose data are stored in the parent dumps
+                  else if ( LoadSon == -1 )
                   {
-                     PID = patch->num[lv] - 1;
-
-//                   d3-1. load the fluid variables
-                     if ( DataOrder_xyzv )
-                     {
-                        fread( InvData_Flu, sizeof(real), PATCH_SIZE*PATCH_SIZE*PATCH_SIZE*NCOMP, File );
-
-                        for (int v=0; v<NCOMP; v++)
-                        for (int k=0; k<PATCH_SIZE; k++)
-                        for (int j=0; j<PATCH_SIZE; j++)
-                        for (int i=0; i<PATCH_SIZE; i++)    
-                           patch->ptr[patch->FluSg[lv]][lv][PID]->fluid[v][k][j][i] = InvData_Flu[k][j][i][v];
-                     }
-
-                     else
-                        fread( patch->ptr[ patch->FluSg[lv] ][lv][PID]->fluid, sizeof(real), 
-                               PATCH_SIZE*PATCH_SIZE*PATCH_SIZE*NCOMP, File );
-
-#                    ifdef GRAVITY
-//                   d3-2. abandon the gravitational potential
-                     if ( LoadPot )
-                        fseek( File, PATCH_SIZE*PATCH_SIZE*PATCH_SIZE*sizeof(real), SEEK_CUR );
-#                    endif
-                  } // if ( DataOrder_xyzv )
+                     Chain_PID   [lv][ NChain[lv] ] = PID;
+                     Chain_DataID[lv][ NChain[lv] ] = LoadDataID;
+                     NChain[lv] ++;
+                  }
                } // within the targeted range
 
                else // for the case that the patch is NOT within the targeted range
-                  if ( LoadSon == -1 )    fseek( File, PatchDataSize, SEEK_CUR );
+                  if ( LoadData )   fseek( File, PatchDataSize, SEEK_CUR );
 
             } // for (int LoadPID=0; LoadPID<NPatchTotal[lv]; LoadPID++)
 
@@ -393,19 +547,22 @@ void Init_Reload()
 
 
 //          d4. record the number of the real patches and the LB_IdxList_real
-            for (int m=1; m<28; m++)   patch->NPatchComma[lv][m] = patch->num[lv];
+            for (int m=1; m<28; m++)   patch->NPatchComma[RLv][m] = patch->num[RLv];
+
+            if ( TLv < 0 )    NPatch_Prolong = patch->num[0];
 
 #           ifdef LOAD_BALANCE
-            if ( patch->LB->IdxList_Real         [lv] != NULL )   delete [] patch->LB->IdxList_Real         [lv];
-            if ( patch->LB->IdxList_Real_IdxTable[lv] != NULL )   delete [] patch->LB->IdxList_Real_IdxTable[lv];
+            if ( patch->LB->IdxList_Real         [RLv] != NULL )  delete [] patch->LB->IdxList_Real         [RLv];
+            if ( patch->LB->IdxList_Real_IdxTable[RLv] != NULL )  delete [] patch->LB->IdxList_Real_IdxTable[RLv];
 
-            patch->LB->IdxList_Real         [lv] = new long [ patch->NPatchComma[lv][1] ];
-            patch->LB->IdxList_Real_IdxTable[lv] = new int  [ patch->NPatchComma[lv][1] ];
+            patch->LB->IdxList_Real         [RLv] = new long [ patch->NPatchComma[RLv][1] ];
+            patch->LB->IdxList_Real_IdxTable[RLv] = new int  [ patch->NPatchComma[RLv][1] ];
 
-            for (int RPID=0; RPID<patch->NPatchComma[lv][1]; RPID++)   
-               patch->LB->IdxList_Real[lv][RPID] = patch->ptr[0][lv][RPID]->LB_Idx;
+            for (int RPID=0; RPID<patch->NPatchComma[RLv][1]; RPID++)   
+               patch->LB->IdxList_Real[RLv][RPID] = patch->ptr[0][RLv][RPID]->LB_Idx;
 
-            Mis_Heapsort( patch->NPatchComma[lv][1], patch->LB->IdxList_Real[lv], patch->LB->IdxList_Real_IdxTable[lv] );
+            Mis_Heapsort( patch->NPatchComma[RLv][1], patch->LB->IdxList_Real[RLv],
+                          patch->LB->IdxList_Real_IdxTable[RLv] );
 #           endif // #ifdef LOAD_BALANCE
 
 #else // OOC
@@ -426,9 +583,81 @@ void Init_Reload()
    } // for (int lv=0; lv<NLv_Restart; lv++)
 
 
+// e. load the data of the remaining leaf patches from the parent dumps
+#  ifndef OOC
+   if ( Delta )
+   {
+      for (int TargetMPIRank=0; TargetMPIRank<MPI_NRank; TargetMPIRank++)
+      {
+         if ( MPI_Rank == 0 )    Aux_Message( stdout, "   Loading data from the parent dumps, MPI_Rank %3d ... ", 
+                                              TargetMPIRank );
+
+         if ( MPI_Rank == TargetMPIRank )
+            Reload_DeltaChain( ParentDumpID, NLv_Restart, rescale, InfoSize, PatchDataSize, DataOrder_xyzv, LoadPot,
+                               InvData_Flu, NChain, Chain_PID, Chain_DataID );
+
+         MPI_Barrier( MPI_COMM_WORLD );
+
+         if ( MPI_Rank == 0 )    Aux_Message( stdout, "done\n" );
+      }
+   }
+
+   for (int lv=0; lv<NLv_Restart; lv++)
+   {
+      if ( Chain_PID   [lv] != NULL )  delete [] Chain_PID   [lv];
+      if ( Chain_DataID[lv] != NULL )  delete [] Chain_DataID[lv];
+   }
+#  endif // #ifndef OOC
+
+
    if ( DataOrder_xyzv )  delete [] InvData_Flu;
 
 
+// f. fill up the base-level patches prolonged from the levels coarser than the runtime base level
+#  ifndef OOC
+   if ( LvShift < 0 )
+   {
+      for (int TargetMPIRank=0; TargetMPIRank<MPI_NRank; TargetMPIRank++)
+      {
+         if ( MPI_Rank == 0 )    Aux_Message( stdout, "   Prolonging the base-level data, MPI_Rank %3d ... ", 
+                                              TargetMPIRank );
+
+         if ( MPI_Rank == TargetMPIRank )
+            Reload_ProlongBase( LvShift, NLv_Restart, rescale, Offset0, NPatchTotal, PatchDataSize,
+                                DataOrder_xyzv, LoadPot, NPatch_Prolong );
+
+         MPI_Barrier( MPI_COMM_WORLD );
+
+         if ( MPI_Rank == 0 )    Aux_Message( stdout, "done\n" );
+      }
+   }
+#  endif
+
+
+// shift the level-dependent information for different NX0_TOT
+// --> NPatchTotal will be recomputed by "Init_DAINO"
+   if ( LvShift != 0 )
+   {
+      double Time_Restart          [NLEVEL];
+      uint   AdvanceCounter_Restart[NLEVEL];
+
+      for (int lv=0; lv<NLEVEL; lv++)
+      {
+         Time_Restart          [lv] = Time          [lv];
+         AdvanceCounter_Restart[lv] = AdvanceCounter[lv];
+      }
+
+      for (int lv=0; lv<NLEVEL; lv++)
+      {
+         const int LoadLv = lv - LvShift;
+         const bool InFile = ( LoadLv >= 0  &&  LoadLv < NLv_Restart );
+
+         Time          [lv] = ( InFile ) ? Time_Restart          [LoadLv] : Time_Restart[0];
+         AdvanceCounter[lv] = ( InFile ) ? AdvanceCounter_Restart[LoadLv] : 0;
+      }
+   }
+
+
 #  ifndef LOAD_BALANCE
 // the following operations are useful only when LOAD_BALANCE is NOT enabled
 // ===================================================================================================================
@@ -503,6 +732,464 @@ void Init_Reload()
 
 
 
+#ifndef OOC
+//-------------------------------------------------------------------------------------------------------
+// Function    :  LoadPatchData
+// Description :  Load the data of one leaf patch from the current position of the input file
+//
+// Note        :  The gravitational potential, if stored, is skipped
+//
+// Parameter   :  File           : Input file
+//                lv             : Targeted refinement level
+//                PID            : Targeted patch ID
+//                DataOrder_xyzv : true --> the fluid data are stored in the order "xyzv"
+//                LoadPot        : true --> the potential is stored after the fluid data
+//                InvData_Flu    : Array for re-ordering the fluid data from "xyzv" to "vxyz"
+//-------------------------------------------------------------------------------------------------------
+void LoadPatchData( FILE *File, const int lv, const int PID, const bool DataOrder_xyzv, const bool LoadPot,
+                    real (*InvData_Flu)[PATCH_SIZE][PATCH_SIZE][NCOMP] )
+{
+
+// a. load the fluid variables
+   if ( DataOrder_xyzv )
+   {
+      fread( InvData_Flu, sizeof(real), PATCH_SIZE*PATCH_SIZE*PATCH_SIZE*NCOMP, File );
+
+      for (int v=0; v<NCOMP; v++)
+      for (int k=0; k<PATCH_SIZE; k++)
+      for (int j=0; j<PATCH_SIZE; j++)
+      for (int i=0; i<PATCH_SIZE; i++)    
+         patch->ptr[patch->FluSg[lv]][lv][PID]->fluid[v][k][j][i] = InvData_Flu[k][j][i][v];
+   }
+
+   else
+      fread( patch->ptr[ patch->FluSg[lv] ][lv][PID]->fluid, sizeof(real), 
+             PATCH_SIZE*PATCH_SIZE*PATCH_SIZE*NCOMP, File );
+
+#  ifdef GRAVITY
+// b. abandon the gravitational potential
+   if ( LoadPot )
+      fseek( File, PATCH_SIZE*PATCH_SIZE*PATCH_SIZE*sizeof(real), SEEK_CUR );
+#  endif
+
+} // FUNCTION : LoadPatchData
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Reload_DeltaChain
+// Description :  Load the data of the leaf patches not stored in the RESTART delta dump from its parent dumps
+//
+// Note        :  1. Parent dumps are loaded from the files "Data_XXXXXX" in the working directory, following
+//                   the recorded parent dump IDs until the data of all targeted patches are found
+//                   --> the chain always ends at a full dump
+//                2. Patches are matched by their corner coordinates, and only the data stored in the dump
+//                   "Chain_DataID" are loaded for each patch
+//                3. Parent dumps must be produced by the same run and hence share the same header
+//                   (NLEVEL, data order, potential output ...) as the RESTART file
+//
+// Parameter   :  ParentDumpID   : Parent dump ID of the RESTART file
+//                NLv_Restart    : NLEVEL in the RESTART file
+//                rescale        : Rescale factor of the corner coordinates
+//                InfoSize       : Size of the simulation information in each dump
+//                PatchDataSize  : Size of the data of one patch in each dump
+//                DataOrder_xyzv : true --> the fluid data are stored in the order "xyzv"
+//                LoadPot        : true --> the potential is stored after the fluid data
+//                InvData_Flu    : Array for re-ordering the fluid data from "xyzv" to "vxyz"
+//                NChain         : Number of targeted patches at each level
+//                Chain_PID      : Patch IDs of the targeted patches at each level
+//                Chain_DataID   : IDs of the dumps storing the data of the targeted patches at each level
+//-------------------------------------------------------------------------------------------------------
+void Reload_DeltaChain( const int ParentDumpID, const int NLv_Restart, const int rescale, const long InfoSize,
+                        const long PatchDataSize, const bool DataOrder_xyzv, const bool LoadPot,
+                        real (*InvData_Flu)[PATCH_SIZE][PATCH_SIZE][NCOMP], const int NChain[],
+                        int *Chain_PID[], int *Chain_DataID[] )
+{
+
+   const int *BoxScale = patch->BoxScale;
+
+   long *Chain_Key[NLv_Restart];
+   int  *Chain_Idx[NLv_Restart];
+   int   NLeft = 0;
+   int  *Cr;
+
+
+// a. sort the targeted patches at each level by their corner coordinates
+   for (int lv=0; lv<NLv_Restart; lv++)
+   {
+      Chain_Key[lv] = new long [ NChain[lv] ];
+      Chain_Idx[lv] = new int  [ NChain[lv] ];
+
+      for (int t=0; t<NChain[lv]; t++)
+      {
+         Cr = patch->ptr[0][lv][ Chain_PID[lv][t] ]->corner;
+         Chain_Key[lv][t] = ( (long)Cr[2]*BoxScale[1] + Cr[1] )*BoxScale[0] + Cr[0];
+      }
+
+      Mis_Heapsort( NChain[lv], Chain_Key[lv], Chain_Idx[lv] );
+
+      NLeft += NChain[lv];
+   }
+
+
+// b. follow the dump chain
+   int  DumpID_Chain = ParentDumpID, DumpID_File, ParentID_File, NInfo, t, Idx;
+   int  NPatch_File[NLv_Restart], NData_File[NLv_Restart], LoadCorner[3], LoadSon, LoadDataID;
+   long FormatVersion, HeaderSize, Offset, Key;
+   char FileName[50];
+   FILE *File;
+
+   while ( NLeft > 0 )
+   {
+      if ( DumpID_Chain < 0 )
+         Aux_Error( ERROR_INFO, "the dump chain ends before the data of %d patches are found !!\n", NLeft );
+
+      sprintf( FileName, "Data_%06d", DumpID_Chain );
+
+      File = fopen( FileName, "rb" );
+
+      if ( File == NULL )
+         Aux_Error( ERROR_INFO, "the parent dump \"%s\" does not exist !!\n", FileName );
+
+
+//    b1. load the simulation information
+      fread( &FormatVersion, sizeof(long), 1, File );
+      fread( &HeaderSize,    sizeof(long), 1, File );
+
+      if ( FormatVersion != 1201  &&  FormatVersion != 1202 )
+         Aux_Error( ERROR_INFO, "unsupported format version %ld of the parent dump \"%s\" !!\n", 
+                    FormatVersion, FileName );
+
+      NInfo = ( FormatVersion == 1202 ) ? 5 : 4;
+
+      fseek( File, HeaderSize+sizeof(long), SEEK_SET );                   // skip the check code
+      fread( &DumpID_File,   sizeof(int),              1, File );
+      fseek( File, NLv_Restart*sizeof(double)+sizeof(long), SEEK_CUR );   // skip Time and Step
+      fread( NPatch_File,    sizeof(int),    NLv_Restart, File );
+      fread( NData_File,     sizeof(int),    NLv_Restart, File );
+      fseek( File, NLv_Restart*sizeof(uint)+sizeof(double), SEEK_CUR );   // skip AdvanceCounter and AveDensity
+
+      if ( NInfo == 5 )    fread( &ParentID_File, sizeof(int), 1, File );
+      else                 ParentID_File = -1;
+
+      if ( DumpID_File != DumpID_Chain )
+         Aux_Error( ERROR_INFO, "incorrect dump ID in the parent dump \"%s\" (%d) !!\n", FileName, DumpID_File );
+
+
+//    b2. load the data of the targeted patches stored in this dump
+      Offset = HeaderSize + InfoSize;
+
+      for (int lv=0; lv<NLv_Restart; lv++)
+      {
+         if ( NChain[lv] > 0 )
+         {
+            fseek( File, Offset, SEEK_SET );
+
+            for (int LoadPID=0; LoadPID<NPatch_File[lv]; LoadPID++)
+            {
+               LoadDataID = DumpID_File;
+
+               fread(  LoadCorner, sizeof(int), 3, File );
+               fread( &LoadSon,    sizeof(int), 1, File );
+               if ( NInfo == 5 )    fread( &LoadDataID, sizeof(int), 1, File );
+
+               if ( LoadSon != -1  ||  LoadDataID != DumpID_File )   continue;
+
+               for (int d=0; d<3; d++)    LoadCorner[d] *= rescale;
+
+               Key = ( (long)LoadCorner[2]*BoxScale[1] + LoadCorner[1] )*BoxScale[0] + LoadCorner[0];
+               t   = Mis_BinarySearch( Chain_Key[lv], 0, NChain[lv]-1, Key );
+               Idx = ( t == -1 ) ? -1 : Chain_Idx[lv][t];
+
+               if ( Idx != -1  &&  Chain_DataID[lv][Idx] == DumpID_File )
+               {
+                  LoadPatchData( File, lv, Chain_PID[lv][Idx], DataOrder_xyzv, LoadPot, InvData_Flu );
+                  NLeft --;
+               }
+
+               else
+                  fseek( File, PatchDataSize, SEEK_CUR );
+            } // for (int LoadPID=0; LoadPID<NPatch_File[lv]; LoadPID++)
+         } // if ( NChain[lv] > 0 )
+
+         Offset += (long)NPatch_File[lv]*NInfo*sizeof(int) + (long)NData_File[lv]*PatchDataSize;
+      } // for (int lv=0; lv<NLv_Restart; lv++)
+
+      fclose( File );
+
+      DumpID_Chain = ParentID_File;
+   } // while ( NLeft > 0 )
+
+
+   for (int lv=0; lv<NLv_Restart; lv++)
+   {
+      delete [] Chain_Key[lv];
+      delete [] Chain_Idx[lv];
+   }
+
+} // FUNCTION : Reload_DeltaChain
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Reload_FullLevel
+// Description :  Allocate all real patches at level "lv" in the sub-domain of this rank
+//
+// Note        :  1. Used when the base level of the RESTART file is finer than the runtime base level
+//                   --> levels coarser than the base level of the RESTART file cover the entire domain
+//                2. Patches are allocated in the same order as "Init_BaseLevel"
+//                3. The data of these patches are filled up later by "Flu_Restrict"
+//
+// Parameter   :  lv : Targeted refinement level
+//-------------------------------------------------------------------------------------------------------
+void Reload_FullLevel( const int lv )
+{
+
+   const int NPatch[3] = { (NX0[0]/PATCH_SIZE)*(1<<lv), (NX0[1]/PATCH_SIZE)*(1<<lv), (NX0[2]/PATCH_SIZE)*(1<<lv) };
+   const int scale0    = patch->scale[0];
+   const int Width     = PATCH_SIZE*patch->scale[lv];
+
+   int Cr[3];
+
+
+   patch->Reserve( lv, NPatch[0]*NPatch[1]*NPatch[2] );
+
+   for (int Pz=0; Pz<NPatch[2]; Pz+=2)    {  Cr[2] = DAINO_RANK_X(2)*NX0[2]*scale0 + Pz*Width;
+   for (int Py=0; Py<NPatch[1]; Py+=2)    {  Cr[1] = DAINO_RANK_X(1)*NX0[1]*scale0 + Py*Width;
+   for (int Px=0; Px<NPatch[0]; Px+=2)    {  Cr[0] = DAINO_RANK_X(0)*NX0[0]*scale0 + Px*Width;
+
+      patch->pnew( lv, Cr[0],       Cr[1],       Cr[2],       -1, true, true );
+      patch->pnew( lv, Cr[0]+Width, Cr[1],       Cr[2],       -1, true, true );
+      patch->pnew( lv, Cr[0],       Cr[1]+Width, Cr[2],       -1, true, true );
+      patch->pnew( lv, Cr[0],       Cr[1],       Cr[2]+Width, -1, true, true );
+      patch->pnew( lv, Cr[0]+Width, Cr[1]+Width, Cr[2],       -1, true, true );
+      patch->pnew( lv, Cr[0],       Cr[1]+Width, Cr[2]+Width, -1, true, true );
+      patch->pnew( lv, Cr[0]+Width, Cr[1],       Cr[2]+Width, -1, true, true );
+      patch->pnew( lv, Cr[0]+Width, Cr[1]+Width, Cr[2]+Width, -1, true, true );
+
+   }}}
+
+   for (int m=1; m<28; m++)   patch->NPatchComma[lv][m] = patch->num[lv];
+
+} // FUNCTION : Reload_FullLevel
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Reload_CoarseLeaf
+// Description :  Allocate the base-level patches covered by a leaf patch coarser than the runtime base level
+//
+// Note        :  1. Used when the base level of the RESTART file is coarser than the runtime base level
+//                2. Patches are allocated in groups of eight in the same order as "Init_BaseLevel", and only the
+//                   patch groups within the targeted range are allocated
+//                3. The data of these patches are filled up later by "Reload_ProlongBase"
+//
+// Parameter   :  TLv      : Level of the leaf patch with respect to the runtime base level (< 0)
+//                Corner   : Rescaled corner of the leaf patch
+//                RangeMin : Lower bound of the targeted range
+//                RangeMax : Upper bound of the targeted range
+//-------------------------------------------------------------------------------------------------------
+void Reload_CoarseLeaf( const int TLv, const int Corner[], const int RangeMin[], const int RangeMax[] )
+{
+
+   const int NSub  = 1 << (-TLv);     // number of base-level patches covered in each direction
+   const int Width = PATCH_SIZE*patch->scale[0];
+
+   int Cr[3];
+
+
+   for (int Pz=0; Pz<NSub; Pz+=2)    {  Cr[2] = Corner[2] + Pz*Width;
+   for (int Py=0; Py<NSub; Py+=2)    {  Cr[1] = Corner[1] + Py*Width;
+   for (int Px=0; Px<NSub; Px+=2)    {  Cr[0] = Corner[0] + Px*Width;
+
+      if (  Cr[0] < RangeMin[0]  ||  Cr[0] >= RangeMax[0]  ||
+            Cr[1] < RangeMin[1]  ||  Cr[1] >= RangeMax[1]  ||
+            Cr[2] < RangeMin[2]  ||  Cr[2] >= RangeMax[2]     )    continue;
+
+      patch->pnew( 0, Cr[0],       Cr[1],       Cr[2],       -1, true, true );
+      patch->pnew( 0, Cr[0]+Width, Cr[1],       Cr[2],       -1, true, true );
+      patch->pnew( 0, Cr[0],       Cr[1]+Width, Cr[2],       -1, true, true );
+      patch->pnew( 0, Cr[0],       Cr[1],       Cr[2]+Width, -1, true, true );
+      patch->pnew( 0, Cr[0]+Width, Cr[1]+Width, Cr[2],       -1, true, true );
+      patch->pnew( 0, Cr[0],       Cr[1]+Width, Cr[2]+Width, -1, true, true );
+      patch->pnew( 0, Cr[0]+Width, Cr[1],       Cr[2]+Width, -1, true, true );
+      patch->pnew( 0, Cr[0]+Width, Cr[1]+Width, Cr[2]+Width, -1, true, true );
+
+   }}}
+
+} // FUNCTION : Reload_CoarseLeaf
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Reload_ProlongBase
+// Description :  Fill up the base-level patches allocated by "Reload_CoarseLeaf" by interpolating the data in
+//                the RESTART file
+//
+// Note        :  1. Used when the base level of the RESTART file is coarser than the runtime base level
+//                2. The data of all leaf patches in the RESTART file are first mapped to a uniform grid with a
+//                   resolution twice coarser than the runtime base level, covering the sub-domain of this rank
+//                   and the ghost zones required by "OPT__REF_FLU_INT_SCHEME"
+//                   --> data finer than the uniform grid are averaged and data coarser are injected
+//                   --> the uniform grid is then interpolated to the targeted patches as in "Refine"
+//                3. Periodic boundary condition is assumed for the ghost zones
+//                4. The targeted patches are the first "NPatch_Prolong" base-level patches
+//
+// Parameter   :  LvShift        : Level shift between the RESTART file and the runtime grid hierarchy (< 0)
+//                NLv_Restart    : NLEVEL recorded in the RESTART file
+//                rescale        : Rescale factor of the corner coordinates
+//                Offset0        : File offset of the patch information at level 0
+//                NPatch_File    : Number of patches at each level in the RESTART file
+//                PatchDataSize  : Size of the data of one patch in the RESTART file
+//                DataOrder_xyzv : true --> the fluid data are stored in the order "xyzv"
+//                LoadPot        : true --> the potential is stored after the fluid data
+//                NPatch_Prolong : Number of targeted base-level patches
+//-------------------------------------------------------------------------------------------------------
+void Reload_ProlongBase( const int LvShift, const int NLv_Restart, const int rescale, const long Offset0,
+                         const int NPatch_File[], const long PatchDataSize, const bool DataOrder_xyzv,
+                         const bool LoadPot, const int NPatch_Prolong )
+{
+
+   const IntScheme_t IntScheme = OPT__REF_FLU_INT_SCHEME;
+   const int PS3               = PATCH_SIZE*PATCH_SIZE*PATCH_SIZE;
+   const int UScale            = 2*patch->scale[0];     // cell size of the uniform grid
+
+   int NSide, NGhost;
+   Int_Table( IntScheme, NSide, NGhost );
+
+   const int  USize [3] = { NX0[0]/2 + 2*NGhost, NX0[1]/2 + 2*NGhost, NX0[2]/2 + 2*NGhost };
+   const int  UStart[3] = { DAINO_RANK_X(0)*NX0[0]/2 - NGhost,       // global index of the first uniform cell
+                            DAINO_RANK_X(1)*NX0[1]/2 - NGhost,
+                            DAINO_RANK_X(2)*NX0[2]/2 - NGhost };
+   const int  UNTot [3] = { NX0_TOT[0]/2, NX0_TOT[1]/2, NX0_TOT[2]/2 };
+   const long UNCell    = (long)USize[0]*USize[1]*USize[2];
+
+   real *UData     = new real [ NCOMP*UNCell ];
+   real *LoadData  = new real [ NCOMP*PS3 ];
+   int  *Map   [3];                      // global index --> (at most two) local indices of the uniform grid
+   int   LoadCorner[3], LoadSon, g0[3], NCover;
+   real  Weight;
+   long  Idx;
+
+
+// 1. construct the map between the global and local indices (the latter may wrap around the periodic box)
+   for (int d=0; d<3; d++)
+   {
+      Map[d] = new int [ 2*UNTot[d] ];
+
+      for (int g=0; g<2*UNTot[d]; g++)    Map[d][g] = -1;
+
+      for (int l=0; l<USize[d]; l++)
+      {
+         const int g = ( UStart[d] + l + UNTot[d] ) % UNTot[d];
+
+         if ( Map[d][2*g] == -1 )   Map[d][2*g  ] = l;
+         else                       Map[d][2*g+1] = l;
+      }
+   }
+
+   for (long t=0; t<NCOMP*UNCell; t++)    UData[t] = (real)0.0;
+
+
+// 2. map the data of all leaf patches to the uniform grid
+   FILE *File = fopen( "RESTART", "rb" );
+   fseek( File, Offset0, SEEK_SET );
+
+   for (int lv=0; lv<NLv_Restart; lv++)
+   {
+      const int CellScale = 1 << ( NLEVEL - 1 - lv - LvShift );
+
+      NCover = ( CellScale >= UScale ) ? CellScale/UScale : 1;
+      Weight = ( CellScale >= UScale ) ? (real)1.0 : (real)CellScale*CellScale*CellScale/UScale/UScale/UScale;
+
+      for (int LoadPID=0; LoadPID<NPatch_File[lv]; LoadPID++)
+      {
+         fread(  LoadCorner, sizeof(int), 3, File );
+         fread( &LoadSon,    sizeof(int), 1, File );
+
+         if ( LoadSon != -1 )    continue;
+
+         fread( LoadData, sizeof(real), NCOMP*PS3, File );
+         if ( LoadPot )    fseek( File, PatchDataSize - NCOMP*PS3*sizeof(real), SEEK_CUR );
+
+         for (int d=0; d<3; d++)    LoadCorner[d] *= rescale;
+
+         for (int k=0; k<PATCH_SIZE; k++)    {  g0[2] = ( LoadCorner[2] + k*CellScale ) / UScale;
+         for (int j=0; j<PATCH_SIZE; j++)    {  g0[1] = ( LoadCorner[1] + j*CellScale ) / UScale;
+         for (int i=0; i<PATCH_SIZE; i++)    {  g0[0] = ( LoadCorner[0] + i*CellScale ) / UScale;
+
+            for (int gk=g0[2]; gk<g0[2]+NCover; gk++)    for (int mk=0; mk<2; mk++)  {  const int K = Map[2][2*gk+mk];
+            for (int gj=g0[1]; gj<g0[1]+NCover; gj++)    for (int mj=0; mj<2; mj++)  {  const int J = Map[1][2*gj+mj];
+            for (int gi=g0[0]; gi<g0[0]+NCover; gi++)    for (int mi=0; mi<2; mi++)  {  const int I = Map[0][2*gi+mi];
+
+               if ( I == -1  ||  J == -1  ||  K == -1 )  continue;
+
+               Idx = ( (long)K*USize[1] + J )*USize[0] + I;
+
+               for (int v=0; v<NCOMP; v++)
+               {
+                  const long LoadIdx = ( DataOrder_xyzv ) ? ( (long)(k*PATCH_SIZE+j)*PATCH_SIZE + i )*NCOMP + v
+                                                          : ( (long)(v*PATCH_SIZE+k)*PATCH_SIZE + j )*PATCH_SIZE + i;
+
+                  UData[ v*UNCell + Idx ] += Weight*LoadData[LoadIdx];
+               }
+            }}}
+         }}}
+      } // for (int LoadPID=0; LoadPID<NPatch_File[lv]; LoadPID++)
+   } // for (int lv=0; lv<NLv_Restart; lv++)
+
+   fclose( File );
+
+
+// 3. interpolate the uniform grid to the targeted base-level patches
+   const int  CRange[3]            = { PATCH_SIZE/2, PATCH_SIZE/2, PATCH_SIZE/2 };
+   const int  FSize [3]            = { PATCH_SIZE, PATCH_SIZE, PATCH_SIZE };
+   const int  FStart[3]            = { 0, 0, 0 };
+   const bool PhaseUnwrapping_No   = false;
+   const bool EnsurePositivity_Yes = true;
+   const bool EnsurePositivity_No  = false;
+
+   real *IntScratch = new real [ Int_ScratchSize( IntScheme, CRange ) ];
+   bool  Positivity[NCOMP];
+   int   CStart[3];
+
+   for (int v=0; v<NCOMP; v++)
+   {
+#     if ( MODEL == HYDRO )
+      if ( v == DENS  ||  v == ENGY )  Positivity[v] = EnsurePositivity_Yes;
+      else                             Positivity[v] = EnsurePositivity_No;
+
+#     elif ( MODEL == MHD )
+#     warning : WAIT MHD !!!
+
+#     elif ( MODEL == ELBDM )
+      if ( v == DENS )                 Positivity[v] = EnsurePositivity_Yes;
+      else                             Positivity[v] = EnsurePositivity_No;
+
+#     else
+#     warning : WARNING : DO YOU WANT TO ENSURE THE POSITIVITY OF INTERPOLATION ??
+#     endif // MODEL
+   }
+
+   for (int PID=0; PID<NPatch_Prolong; PID++)
+   {
+      for (int d=0; d<3; d++)    CStart[d] = patch->ptr[0][0][PID]->corner[d]/UScale - UStart[d];
+
+      Interpolate( UData, USize, CStart, CRange, patch->ptr[ patch->FluSg[0] ][0][PID]->fluid[0][0][0],
+                   FSize, FStart, NCOMP, IntScheme, PhaseUnwrapping_No, Positivity, IntScratch );
+   }
+
+
+   delete [] UData;
+   delete [] LoadData;
+   delete [] IntScratch;
+   for (int d=0; d<3; d++)    delete [] Map[d];
+
+} // FUNCTION : Reload_ProlongBase
+#endif // #ifndef OOC
+
+
+
 //-------------------------------------------------------------------------------------------------------
 // Function    :  Load_Parameter_Before_1200
 // Description :  Load all simulation parameters from the RESTART file with format version < 1200
@@ -514,11 +1201,12 @@ void Init_Reload()
 //                NLv_Restart    : NLEVEL recorded in the RESTART file
 //                DataOrder_xyzv : Order of data stored in the RESTART file (true/false --> xyzv/vxyz)
 //                LoadPot        : Whether or not the RESTART file stores the potential data
+//                NX0Tot_Restart : NX0_TOT recorded in the RESTART file
 //
-// Return      :  NLv_Restart, DataOrder_xyzv, LoadPot
+// Return      :  NLv_Restart, DataOrder_xyzv, LoadPot, NX0Tot_Restart
 //-------------------------------------------------------------------------------------------------------
 void Load_Parameter_Before_1200( FILE *File, const int FormatVersion, int &NLv_Restart, bool &DataOrder_xyzv, 
-                                 bool &LoadPot )
+                                 bool &LoadPot, int *NX0Tot_Restart )
 {
    
 // set the size of the output buffers
@@ -653,15 +1341,15 @@ void Load_Parameter_Before_1200( FILE *File, const int FormatVersion, int &NLv_R
          Aux_Error( ERROR_INFO, "%s : RESTART file (%d) > runtime (%d) (please set NLEVEL larger) !!\n",
                     "NLEVEL", nlevel, NLEVEL );
 
-      if ( nx0_tot[0] != NX0_TOT[0] )
+      if ( nx0_tot[0] != NX0_TOT[0]  &&  !OPT__RESTART_REGRID )
          Aux_Error( ERROR_INFO, "%s : RESTART file (%d) != Input__Parameter (%d) !!\n", 
                     "NX0_TOT[0]", nx0_tot[0], NX0_TOT[0] );
 
-      if ( nx0_tot[1] != NX0_TOT[1] )
+      if ( nx0_tot[1] != NX0_TOT[1]  &&  !OPT__RESTART_REGRID )
          Aux_Error( ERROR_INFO, "%s : RESTART file (%d) != Input__Parameter (%d) !!\n", 
                     "NX0_TOT[1]", nx0_tot[1], NX0_TOT[1] );
 
-      if ( nx0_tot[2] != NX0_TOT[2] )
+      if ( nx0_tot[2] != NX0_TOT[2]  &&  !OPT__RESTART_REGRID )
          Aux_Error( ERROR_INFO, "%s : RESTART file (%d) != Input__Parameter (%d) !!\n", 
                     "NX0_TOT[2]", nx0_tot[2], NX0_TOT[2] );
 
@@ -681,10 +1369,6 @@ void Load_Parameter_Before_1200( FILE *File, const int FormatVersion, int &NLv_R
          Aux_Message( stderr, "          --> Grid scale will be rescaled\n" );
       }
 
-      if ( max_patch != MAX_PATCH )
-         Aux_Message( stderr, "WARNING : %s : RESTART file (%d) != runtime (%d) !!\n", 
-                      "MAX_PATCH", max_patch, MAX_PATCH );
-
       if ( flu_ghost_size != FLU_GHOST_SIZE )
          Aux_Message( stderr, "WARNING : %s : RESTART file (%d) != runtime (%d) !!\n", 
                       "FLU_GHOST_SIZE", flu_ghost_size, FLU_GHOST_SIZE );
@@ -790,6 +1474,8 @@ void Load_Parameter_Before_1200( FILE *File, const int FormatVersion, int &NLv_R
    LoadPot        = opt__output_pot;
    NLv_Restart    = nlevel;
 
+   for (int d=0; d<3; d++)    NX0Tot_Restart[d] = nx0_tot[d];
+
 } // FUNCTION : Load_Parameter_Before_1200
 
 
@@ -805,11 +1491,12 @@ void Load_Parameter_Before_1200( FILE *File, const int FormatVersion, int &NLv_R
 //                NLv_Restart    : NLEVEL recorded in the RESTART file
 //                DataOrder_xyzv : Order of data stored in the RESTART file (true/false --> xyzv/vxyz)
 //                LoadPot        : Whether or not the RESTART file stores the potential data
+//                NX0Tot_Restart : NX0_TOT recorded in the RESTART file
 //
-// Return      :  NLv_Restart, DataOrder_xyzv, LoadPot
+// Return      :  NLv_Restart, DataOrder_xyzv, LoadPot, NX0Tot_Restart
 //-------------------------------------------------------------------------------------------------------
 void Load_Parameter_After_1200( FILE *File, const int FormatVersion, int &NLv_Restart, bool &DataOrder_xyzv, 
-                                bool &LoadPot )
+                                bool &LoadPot, int *NX0Tot_Restart )
 {
 
    const int size_bool      = sizeof( bool   );
@@ -993,8 +1680,9 @@ void Load_Parameter_After_1200( FILE *File, const int FormatVersion, int &NLv_Re
       Aux_Message( stdout, "   Checking loaded parameters ...\n" );
 
 
-      const bool Fatal    = true;
-      const bool NonFatal = false;
+      const bool Fatal     = true;
+      const bool NonFatal  = false;
+      const bool Fatal_NX0 = !OPT__RESTART_REGRID;   // NX0_TOT can be changed by a power of two with regrid
 
 //    d-1. check the simulation options and parameters defined in the Makefile
 //    ========================================================================
@@ -1154,7 +1842,7 @@ void Load_Parameter_After_1200( FILE *File, const int FormatVersion, int &NLv_Re
          Aux_Message( stderr, "          --> Grid scale will be rescaled\n" );
       }
 
-      CompareVar( "MAX_PATCH", max_patch, MAX_PATCH, NonFatal );
+//    "max_patch" is no longer checked since the patch tables grow on demand
 
 
 
@@ -1300,9 +1988,9 @@ void Load_Parameter_After_1200( FILE *File, const int FormatVersion, int &NLv_Re
 //    errors
 //    ------------------
       CompareVar( "BOX_SIZE",                box_size,                     BOX_SIZE,                     Fatal );
-      CompareVar( "NX0_TOT[0]",              nx0_tot[0],                   NX0_TOT[0],                   Fatal );
-      CompareVar( "NX1_TOT[1]",              nx0_tot[1],                   NX0_TOT[1],                   Fatal );
-      CompareVar( "NX2_TOT[2]",              nx0_tot[2],                   NX0_TOT[2],                   Fatal );
+      CompareVar( "NX0_TOT[0]",              nx0_tot[0],                   NX0_TOT[0],             Fatal_NX0 );
+      CompareVar( "NX1_TOT[1]",              nx0_tot[1],                   NX0_TOT[1],             Fatal_NX0 );
+      CompareVar( "NX2_TOT[2]",              nx0_tot[2],                   NX0_TOT[2],             Fatal_NX0 );
 
 
 //    warnings 
@@ -1419,6 +2107,8 @@ void Load_Parameter_After_1200( FILE *File, const int FormatVersion, int &NLv_Re
    LoadPot        = opt__output_pot;
    NLv_Restart    = nlevel;
 
+   for (int d=0; d<3; d++)    NX0Tot_Restart[d] = nx0_tot[d];
+
 } // FUNCTION : Load_Parameter_After_1200
 
 
@@ -0,0 +1,196 @@
+
+#include "DAINO.h"
+
+static void Regrid( const int lv, Timer_t *Timer_Flag, Timer_t *Timer_Refine );
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Init_Reload_Regrid
+// Description :  Regrid all levels right after restart so that the run can continue with a refinement
+//                configuration (MAX_LEVEL and refinement criteria) different from that of the RESTART file
+//
+// Note        :  1. Invoked by "Init_DAINO" if "OPT__RESTART_REGRID" is on
+//                   --> data of all levels must be complete (including the restricted data of non-leaf
+//                       patches and the buffer data) in advance
+//                2. Phase 1 : truncate all levels above MAX_LEVEL, from the finest level downward
+//                             --> the data of the removed patches have already been restricted to their
+//                                 fathers by "Init_Reload"
+//                   Phase 2 : flag and refine levels 0 ~ MAX_LEVEL-1 from bottom up in one sweep, and repeat
+//                             the sweep until the number of patches at all levels no longer changes
+//                             --> a new level can be added in each sweep (instead of once per REGRID_COUNT
+//                                 steps as in the main loop), and patches no longer satisfying the refinement
+//                                 criteria are removed
+//                             --> at most NLEVEL sweeps are performed
+//                3. The elapsed time of each phase and the number of patches at each level are reported
+//                4. Flag and refine are performed by "Flag_Real" and "Refine", which are OpenMP-parallelized
+//                   within each level
+//                   --> levels are processed one after another since flagging level "lv" requires the patches
+//                       at level "lv" created by refining level "lv-1" in the same sweep
+//                5. NX0_TOT can differ from that of the RESTART file by a power of two, in which case the base-level
+//                   data have been restricted or prolonged by "Init_Reload"
+//                   --> the loaded levels are shifted accordingly and are rebuilt here like any other level
+//-------------------------------------------------------------------------------------------------------
+void Init_Reload_Regrid()
+{
+
+   if ( MPI_Rank == 0 )    Aux_Message( stdout, "%s ...\n", __FUNCTION__ );
+
+
+   const int MaxSweep = NLEVEL;
+   const int TopLv    = ( MAX_LEVEL < NLEVEL-1 ) ? MAX_LEVEL : NLEVEL-1;
+
+   int NPatch_Restart[NLEVEL], NPatch_Old[NLEVEL], NSweep = 0;
+   bool Converged = false;
+
+   Timer_t  Timer_Truncate( 1 );
+   Timer_t  Timer_Sweep( MaxSweep );
+   Timer_t *Timer_Flag  [NLEVEL];
+   Timer_t *Timer_Refine[NLEVEL];
+
+   for (int lv=0; lv<NLEVEL; lv++)
+   {
+      NPatch_Restart[lv] = NPatchTotal[lv];
+      Timer_Flag    [lv] = new Timer_t( 1 );
+      Timer_Refine  [lv] = new Timer_t( 1 );
+   }
+
+
+// 1. truncate all levels above MAX_LEVEL
+   MPI_Barrier( MPI_COMM_WORLD );
+   Timer_Truncate.Start();
+
+   for (int lv=NLEVEL-2; lv>=TopLv; lv--)
+   {
+      if ( NPatchTotal[lv+1] == 0 )    continue;
+
+      if ( MPI_Rank == 0 )    Aux_Message( stdout, "   Removing level %2d ... ", lv+1 );
+
+      Regrid( lv, Timer_Flag[lv], Timer_Refine[lv] );
+
+      if ( MPI_Rank == 0 )    Aux_Message( stdout, "done\n" );
+   }
+
+   MPI_Barrier( MPI_COMM_WORLD );
+   Timer_Truncate.Stop( false );
+
+
+// 2. flag and refine levels 0 ~ MAX_LEVEL-1 until the grid hierarchy converges
+   while ( !Converged  &&  NSweep < MaxSweep )
+   {
+      if ( MPI_Rank == 0 )    Aux_Message( stdout, "   Regrid sweep %2d ... ", NSweep );
+
+      for (int lv=0; lv<NLEVEL; lv++)  NPatch_Old[lv] = NPatchTotal[lv];
+
+      MPI_Barrier( MPI_COMM_WORLD );
+      Timer_Sweep.Start();
+
+      for (int lv=0; lv<TopLv; lv++)   Regrid( lv, Timer_Flag[lv], Timer_Refine[lv] );
+
+      MPI_Barrier( MPI_COMM_WORLD );
+      Timer_Sweep.Stop( true );
+
+      Converged = true;
+      for (int lv=0; lv<NLEVEL; lv++)
+         if ( NPatchTotal[lv] != NPatch_Old[lv] )  Converged = false;
+
+      NSweep ++;
+
+      if ( MPI_Rank == 0 )    Aux_Message( stdout, "done\n" );
+   } // while ( !Converged  &&  NSweep < MaxSweep )
+
+   if ( !Converged  &&  MPI_Rank == 0 )
+      Aux_Message( stderr, "WARNING : grid hierarchy does not converge after %d regrid sweeps !!\n", MaxSweep );
+
+
+// redistribute patches since the regrid may break the load balance
+#  ifdef LOAD_BALANCE
+   const bool DuringRestart_No = false;
+
+   patch->LB->reset();
+   LB_Init_LoadBalance( DuringRestart_No );
+#  endif
+
+
+// 3. report the cost of each phase
+   if ( MPI_Rank == 0 )
+   {
+      Aux_Message( stdout, "   Truncation (levels > %d) : %9.3f s\n", TopLv, Timer_Truncate.GetValue(0) );
+
+      for (int s=0; s<NSweep; s++)
+      Aux_Message( stdout, "   Regrid sweep %2d         : %9.3f s\n", s, Timer_Sweep.GetValue(s) );
+
+      Aux_Message( stdout, "   %3s  %10s  %10s  %12s  %12s\n", "Lv", "Flag (s)", "Refine (s)", "NPatch (old)",
+                   "NPatch (new)" );
+
+      for (int lv=0; lv<NLEVEL; lv++)
+      Aux_Message( stdout, "   %3d  %10.3f  %10.3f  %12d  %12d\n", lv, Timer_Flag[lv]->GetValue(0),
+                   Timer_Refine[lv]->GetValue(0), NPatch_Restart[lv], NPatchTotal[lv] );
+   }
+
+
+   for (int lv=0; lv<NLEVEL; lv++)
+   {
+      delete Timer_Flag  [lv];
+      delete Timer_Refine[lv];
+   }
+
+
+   if ( MPI_Rank == 0 )    Aux_Message( stdout, "%s ... done\n", __FUNCTION__ );
+
+} // FUNCTION : Init_Reload_Regrid
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Regrid
+// Description :  Flag level "lv" and reconstruct the patches at level "lv+1"
+//
+// Note        :  Same procedure as step 5 in "Integration_IndiviTimeStep"
+//
+// Parameter   :  lv           : Targeted refinement level to be flagged
+//                Timer_Flag   : Timer of the flag operation
+//                Timer_Refine : Timer of the refine operation
+//-------------------------------------------------------------------------------------------------------
+void Regrid( const int lv, Timer_t *Timer_Flag, Timer_t *Timer_Refine )
+{
+
+// flag
+   Timer_Flag->Start();
+
+#  ifdef LOAD_BALANCE
+   Flag_Real( lv, USELB_YES );
+#  else
+   Flag_Real( lv, USELB_NO );
+
+   MPI_ExchangeBoundaryFlag( lv );
+
+   Flag_Buffer( lv );
+#  endif
+
+   Timer_Flag->Stop( false );
+
+
+// refine
+   Timer_Refine->Start();
+
+   Refine( lv );
+
+#  ifdef LOAD_BALANCE
+   Buf_GetBufferData( lv,   patch->FluSg[lv  ], NULL_INT, DATA_AFTER_REFINE, _FLU,  Flu_ParaBuf, USELB_YES );
+#  ifdef GRAVITY
+   Buf_GetBufferData( lv,   NULL_INT, patch->PotSg[lv  ], POT_AFTER_REFINE,  _POTE, Pot_ParaBuf, USELB_YES );
+#  endif
+#  endif
+
+   Buf_GetBufferData( lv+1, patch->FluSg[lv+1], NULL_INT, DATA_AFTER_REFINE, _FLU,  Flu_ParaBuf, USELB_YES );
+#  ifdef GRAVITY
+   Buf_GetBufferData( lv+1, NULL_INT, patch->PotSg[lv+1], POT_AFTER_REFINE,  _POTE, Pot_ParaBuf, USELB_YES );
+#  endif
+
+   Time[lv+1] = Time[lv];
+
+   Timer_Refine->Stop( false );
+
+} // FUNCTION : Regrid
@@ -1,6 +1,11 @@
 
 #include "DAINO.h"
 
+extern void Int_Separable( real CData[], const int CSize[3], const int CStart[3], const int CRange[3],
+                           real FData[], const int FSize[3], const int FStart[3], const int NComp,
+                           const bool UnwrapPhase, const bool EnsurePositivity[], real *Scratch,
+                           const int CGhost, const real L[], const real R[] );
+
 
 
 
@@ -25,12 +30,14 @@
 //		  FStart            : (x,y,z) starting indcies to store the interpolation results
 //		  NComp	            : Number of components in the CData and FData array
 //                UnwrapPhase       : Unwrap phase when OPT__INT_PHASE is on (for ELBDM only)
-//                EnsurePositivity  : Ensure that all interpolation results are positive
+//                EnsurePositivity  : Ensure that all interpolation results are positive (for each component)
 //                                    --> The input data must be positive already
+//                Scratch           : Temporary array for the separable interpolation (or NULL)
+//                                    --> Must be able to store at least "Int_ScratchSize" elements
 //-------------------------------------------------------------------------------------------------------
 void Int_CQuartic( real CData[], const int CSize[3], const int CStart[3], const int CRange[3],
 	           real FData[], const int FSize[3], const int FStart[3], const int NComp,
-                   const bool UnwrapPhase, const bool EnsurePositivity )
+                   const bool UnwrapPhase, const bool EnsurePositivity[], real *Scratch )
 {
 
 // interpolation-scheme-dependent parameters
@@ -44,208 +51,7 @@ void Int_CQuartic( real CData[], const int CSize[3], const int CStart[3], const
 // ===============================================================================
 
 
-// check
-#  ifdef DAINO_DEBUG
-   if ( EnsurePositivity )
-   {
-      int Idx;
-
-      for (int k=CStart[2]-CGhost; k<CStart[2]+CRange[2]+CGhost; k++)
-      for (int j=CStart[1]-CGhost; j<CStart[1]+CRange[1]+CGhost; j++)
-      for (int i=CStart[0]-CGhost; i<CStart[0]+CRange[0]+CGhost; i++)
-      {
-         Idx = (k*CSize[1] + j)*CSize[0] + i;
-
-         if ( CData[Idx] < 0.0 )    
-            Aux_Error( ERROR_INFO, "input data (%14.7e) < 0.0 for the option \"EnsurePositivity\" !!\n" );
-      }
-   }
-#  endif
-
-
-// index stride of the coarse-grid input array
-   const int Cdx    = 1;
-   const int Cdy    = Cdx*CSize[0];
-   const int Cdz    = Cdy*CSize[1];
-
-// index stride of the temporary arrays storing the data after x and y interpolations
-   const int Tdx    = 1;
-   const int Tdy    = Tdx* CRange[0]*2;
-   const int TdzX   = Tdy*(CRange[1]+2*CGhost);    // array after x interpolation
-   const int TdzY   = Tdy* CRange[1]*2;            // array after y interpolation
-
-// index stride of the fine-grid output array
-   const int Fdx    = 1;
-   const int Fdy    = Fdx*FSize[0];
-   const int Fdz    = Fdy*FSize[1];
-
-// index stride of different components
-   const int CDisp  = CSize[0]*CSize[1]*CSize[2];
-   const int FDisp  = FSize[0]*FSize[1]*FSize[2];
-
-   real *CPtr   = CData;
-   real *FPtr   = FData;
-   real *TDataX = new real [ (CRange[2]+2*CGhost)*TdzX ];   // temporary array after x interpolation
-   real *TDataY = new real [ (CRange[2]+2*CGhost)*TdzY ];   // temporary array after y interpolation
-
-   int Idx_InL2, Idx_InL1, Idx_InC, Idx_InR1, Idx_InR2, Idx_Out;
-   real LSlope, RSlope, Slope;
-
-
-   for (int v=0; v<NComp; v++)
-   {
-//    unwrap phase along x direction
-#     if ( MODEL == ELBDM )
-      if ( UnwrapPhase )
-      {
-         for (int k=CStart[2]-CGhost;    k<CStart[2]+CRange[2]+CGhost;  k++)
-         for (int j=CStart[1]-CGhost;    j<CStart[1]+CRange[1]+CGhost;  j++)
-         for (int i=CStart[0]-CGhost+1;  i<CStart[0]+CRange[0]+CGhost;  i++)
-         {
-            Idx_InC       = k*Cdz + j*Cdy + i*Cdx;
-            Idx_InL1      = Idx_InC - Cdx;
-            CPtr[Idx_InC] = ELBDM_UnwrapPhase( CPtr[Idx_InL1], CPtr[Idx_InC] );
-         }
-      }
-#     endif
-
-
-//    interpolation along x direction   
-      for (int In_z=CStart[2]-CGhost, Out_z=0;  In_z<CStart[2]+CRange[2]+CGhost;  In_z++, Out_z++)
-      for (int In_y=CStart[1]-CGhost, Out_y=0;  In_y<CStart[1]+CRange[1]+CGhost;  In_y++, Out_y++)
-      for (int In_x=CStart[0],        Out_x=0;  In_x<CStart[0]+CRange[0];         In_x++, Out_x+=2)
-      {
-         Idx_Out  = Out_z*TdzX + Out_y*Tdy + Out_x*Tdx;
-         Idx_InC  =  In_z*Cdz  +  In_y*Cdy +  In_x*Cdx;
-         Idx_InL1 = Idx_InC  - Cdx;
-         Idx_InL2 = Idx_InL1 - Cdx;
-         Idx_InR1 = Idx_InC  + Cdx;
-         Idx_InR2 = Idx_InR1 + Cdx;
-
-         TDataX[ Idx_Out       ] = L[0]*CPtr[Idx_InL2] + L[1]*CPtr[Idx_InL1] + L[2]*CPtr[Idx_InC] + 
-                                   L[3]*CPtr[Idx_InR1] + L[4]*CPtr[Idx_InR2];
-         TDataX[ Idx_Out + Tdx ] = R[0]*CPtr[Idx_InL2] + R[1]*CPtr[Idx_InL1] + R[2]*CPtr[Idx_InC] + 
-                                   R[3]*CPtr[Idx_InR1] + R[4]*CPtr[Idx_InR2];
-
-//       ensure positivity
-         if ( EnsurePositivity )
-         {
-            if ( TDataX[ Idx_Out ] < (real)0.0  ||  TDataX[ Idx_Out + Tdx ] < (real)0.0 )
-            {
-               LSlope = CPtr[Idx_InC ] - CPtr[Idx_InL1];
-               RSlope = CPtr[Idx_InR1] - CPtr[Idx_InC ];
-               Slope  = (real)0.125*( SIGN(LSlope) + SIGN(RSlope) )*MIN( FABS(LSlope), FABS(RSlope) );
-
-               TDataX[ Idx_Out       ] = CPtr[Idx_InC] - Slope;
-               TDataX[ Idx_Out + Tdx ] = CPtr[Idx_InC] + Slope;
-            }
-         }
-      }
-
-
-//    unwrap phase along y direction
-#     if ( MODEL == ELBDM )
-      if ( UnwrapPhase )
-      {
-         for (int k=0;  k<CRange[2]+2*CGhost;  k++)
-         for (int j=1;  j<CRange[1]+2*CGhost;  j++)
-         for (int i=0;  i<2*CRange[0];         i++)
-         {
-            Idx_InC         = k*TdzX + j*Tdy + i*Tdx;
-            Idx_InL1        = Idx_InC - Tdy;
-            TDataX[Idx_InC] = ELBDM_UnwrapPhase( TDataX[Idx_InL1], TDataX[Idx_InC] );
-         }
-      }
-#     endif
-
-
-//    interpolation along y direction   
-      for (int InOut_z=0;             InOut_z<CRange[2]+2*CGhost;  InOut_z++)
-      for (int In_y=CGhost, Out_y=0;  In_y   <CGhost+CRange[1];    In_y++, Out_y+=2)
-      for (int InOut_x=0;             InOut_x<2*CRange[0];         InOut_x++)
-      {
-         Idx_Out  = InOut_z*TdzY + Out_y*Tdy + InOut_x*Tdx;
-         Idx_InC  = InOut_z*TdzX +  In_y*Tdy + InOut_x*Tdx;
-         Idx_InL1 = Idx_InC  - Tdy;
-         Idx_InL2 = Idx_InL1 - Tdy;
-         Idx_InR1 = Idx_InC  + Tdy;
-         Idx_InR2 = Idx_InR1 + Tdy;
-
-         TDataY[ Idx_Out       ] = L[0]*TDataX[Idx_InL2] + L[1]*TDataX[Idx_InL1] + L[2]*TDataX[Idx_InC] + 
-                                   L[3]*TDataX[Idx_InR1] + L[4]*TDataX[Idx_InR2];
-         TDataY[ Idx_Out + Tdy ] = R[0]*TDataX[Idx_InL2] + R[1]*TDataX[Idx_InL1] + R[2]*TDataX[Idx_InC] + 
-                                   R[3]*TDataX[Idx_InR1] + R[4]*TDataX[Idx_InR2];
-
-//       ensure positivity
-         if ( EnsurePositivity )
-         {
-            if ( TDataY[ Idx_Out ] < (real)0.0  ||  TDataY[ Idx_Out + Tdy ] < (real)0.0 )
-            {
-               LSlope = TDataX[Idx_InC ] - TDataX[Idx_InL1];
-               RSlope = TDataX[Idx_InR1] - TDataX[Idx_InC ];
-               Slope  = (real)0.125*( SIGN(LSlope) + SIGN(RSlope) )*MIN( FABS(LSlope), FABS(RSlope) );
-
-               TDataY[ Idx_Out       ] = TDataX[Idx_InC] - Slope;
-               TDataY[ Idx_Out + Tdy ] = TDataX[Idx_InC] + Slope;
-            }
-         }
-      }
-
-
-//    unwrap phase along z direction
-#     if ( MODEL == ELBDM )
-      if ( UnwrapPhase )
-      {
-         for (int k=1;  k<CRange[2]+2*CGhost;  k++)
-         for (int j=0;  j<2*CRange[1];         j++)
-         for (int i=0;  i<2*CRange[0];         i++)
-         {
-            Idx_InC         = k*TdzY + j*Tdy + i*Tdx;
-            Idx_InL1        = Idx_InC - TdzY;
-            TDataY[Idx_InC] = ELBDM_UnwrapPhase( TDataY[Idx_InL1], TDataY[Idx_InC] );
-         }
-      }
-#     endif
-
-
-//    interpolation along z direction   
-      for (int In_z=CGhost, Out_z=FStart[2];  In_z<CGhost+CRange[2];  In_z++, Out_z+=2)
-      for (int In_y=0,      Out_y=FStart[1];  In_y<2*CRange[1];       In_y++, Out_y++)
-      for (int In_x=0,      Out_x=FStart[0];  In_x<2*CRange[0];       In_x++, Out_x++)
-      {
-         Idx_Out  = Out_z*Fdz  + Out_y*Fdy + Out_x*Fdx;
-         Idx_InC  =  In_z*TdzY +  In_y*Tdy +  In_x*Tdx;
-         Idx_InL1 = Idx_InC  - TdzY;
-         Idx_InL2 = Idx_InL1 - TdzY;
-         Idx_InR1 = Idx_InC  + TdzY;
-         Idx_InR2 = Idx_InR1 + TdzY;
-
-         FPtr[ Idx_Out       ] = L[0]*TDataY[Idx_InL2] + L[1]*TDataY[Idx_InL1] + L[2]*TDataY[Idx_InC] + 
-                                 L[3]*TDataY[Idx_InR1] + L[4]*TDataY[Idx_InR2];
-         FPtr[ Idx_Out + Fdz ] = R[0]*TDataY[Idx_InL2] + R[1]*TDataY[Idx_InL1] + R[2]*TDataY[Idx_InC] + 
-                                 R[3]*TDataY[Idx_InR1] + R[4]*TDataY[Idx_InR2];
-
-//       ensure positivity
-         if ( EnsurePositivity )
-         {
-            if ( FPtr[ Idx_Out ] < (real)0.0  ||  FPtr[ Idx_Out + Fdz ] < (real)0.0 )
-            {
-               LSlope = TDataY[Idx_InC ] - TDataY[Idx_InL1];
-               RSlope = TDataY[Idx_InR1] - TDataY[Idx_InC ];
-               Slope  = (real)0.125*( SIGN(LSlope) + SIGN(RSlope) )*MIN( FABS(LSlope), FABS(RSlope) );
-
-               FPtr[ Idx_Out       ] = TDataY[Idx_InC] - Slope;
-               FPtr[ Idx_Out + Fdz ] = TDataY[Idx_InC] + Slope;
-            }
-         }
-      }
-
-      CPtr += CDisp;
-      FPtr += FDisp;
-
-   } // for (int v=0; v<NComp; v++)
-
-   delete [] TDataX;
-   delete [] TDataY;
+   Int_Separable( CData, CSize, CStart, CRange, FData, FSize, FStart, NComp, UnwrapPhase, EnsurePositivity,
+                  Scratch, CGhost, L, R );
 
 } // FUNCTION : Int_CQuartic
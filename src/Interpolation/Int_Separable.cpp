@@ -0,0 +1,418 @@
+#include "DAINO.h"
+
+static void Int_Separable_X( const real *In, const int InRow, real *RESTRICT Out, const int OutRow,
+                             const int NRow, const int NCell, const int CGhost, const real L[], const real R[],
+                             const bool EnsurePositivity );
+static void Int_Separable_Plane( const real *In, const int InRow, const int SStride,
+                                 real *RESTRICT OutL, real *RESTRICT OutR, const int OutRow, const int NRow,
+                                 const int NCell, const int CGhost, const real L[], const real R[],
+                                 const bool EnsurePositivity );
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Int_Separable
+// Description :  Perform spatial interpolation by applying a 1D (2*CGhost+1)-point stencil along x, y, and z
+//                directions in order
+//
+// Note        :  1. Shared by the schemes "Int_CQuadratic", "Int_Quadratic", "Int_CQuartic", and "Int_Quartic",
+//                   which differ only in the interpolation coefficients "L/R" and the stencil size "CGhost"
+//                2. Each 1D pass is evaluated one xy plane at a time by "Int_Separable_Plane", in which the
+//                   innermost loops run over the contiguous x index and are free of branches
+//                3. When EnsurePositivity is on and the interpolation results are found to be negative, we
+//                   switch to the MinMod interpolation scheme in those cells to ensure positivity
+//                   --> The check is performed once per plane after the interpolation
+//                4. The temporary arrays are taken from "Scratch", which must be able to store at least
+//                   "Int_ScratchSize( IntScheme, CRange )" elements
+//                   --> If Scratch == NULL, they are allocated and freed here
+//
+// Parameter   :  CData             : Input coarse-grid array
+//                CSize             : Size of the CData array
+//                CStart            : (x,y,z) starting indices to perform interpolation on the CData array
+//                CRange            : Number of grids in each direction to perform interpolation
+//                FData             : Output fine-grid array
+//                FStart            : (x,y,z) starting indcies to store the interpolation results
+//                NComp             : Number of components in the CData and FData array
+//                UnwrapPhase       : Unwrap phase when OPT__INT_PHASE is on (for ELBDM only)
+//                EnsurePositivity  : Ensure that all interpolation results are positive (for each component)
+//                                    --> The input data must be positive already
+//                Scratch           : Caller-provided temporary array (or NULL)
+//                CGhost            : Number of coarse-grid ghost zones on each side of the 1D stencil
+//                L/R               : Coefficients of the 1D stencil for the left/right fine-grid cells
+//-------------------------------------------------------------------------------------------------------
+void Int_Separable( real CData[], const int CSize[3], const int CStart[3], const int CRange[3],
+                    real FData[], const int FSize[3], const int FStart[3], const int NComp,
+                    const bool UnwrapPhase, const bool EnsurePositivity[], real *Scratch,
+                    const int CGhost, const real L[], const real R[] )
+{
+
+// check
+#  ifdef DAINO_DEBUG
+   for (int v=0; v<NComp; v++)
+   {
+      if ( !EnsurePositivity[v] )   continue;
+
+      int Idx;
+
+      for (int k=CStart[2]-CGhost; k<CStart[2]+CRange[2]+CGhost; k++)
+      for (int j=CStart[1]-CGhost; j<CStart[1]+CRange[1]+CGhost; j++)
+      for (int i=CStart[0]-CGhost; i<CStart[0]+CRange[0]+CGhost; i++)
+      {
+         Idx = v*CSize[0]*CSize[1]*CSize[2] + (k*CSize[1] + j)*CSize[0] + i;
+
+         if ( CData[Idx] < 0.0 )
+            Aux_Error( ERROR_INFO, "input data (%14.7e) < 0.0 for the option \"EnsurePositivity\" !!\n",
+                       CData[Idx] );
+      }
+   }
+#  endif
+
+
+// index stride of the coarse-grid input array
+   const int Cdx    = 1;
+   const int Cdy    = Cdx*CSize[0];
+   const int Cdz    = Cdy*CSize[1];
+
+// index stride of the temporary arrays storing the data after x and y interpolations
+   const int Tdx    = 1;
+   const int Tdy    = Tdx* CRange[0]*2;
+   const int TdzX   = Tdy*(CRange[1]+2*CGhost);    // array after x interpolation
+   const int TdzY   = Tdy* CRange[1]*2;            // array after y interpolation
+
+// index stride of the fine-grid output array
+   const int Fdx    = 1;
+   const int Fdy    = Fdx*FSize[0];
+   const int Fdz    = Fdy*FSize[1];
+
+// index stride of different components
+   const int CDisp  = CSize[0]*CSize[1]*CSize[2];
+   const int FDisp  = FSize[0]*FSize[1]*FSize[2];
+
+// temporary arrays
+   const bool NewScratch = ( Scratch == NULL );
+
+   if ( NewScratch )    Scratch = new real [ (CRange[2]+2*CGhost)*(TdzX+TdzY) ];
+
+   real *TDataX = Scratch;                               // temporary array after x interpolation
+   real *TDataY = TDataX + (CRange[2]+2*CGhost)*TdzX;    // temporary array after y interpolation
+
+   real *CPtr   = CData;
+   real *FPtr   = FData;
+
+   int Idx_InC, Idx_Out;
+
+
+   for (int v=0; v<NComp; v++)
+   {
+//    unwrap phase along x direction
+#     if ( MODEL == ELBDM )
+      if ( UnwrapPhase )
+      {
+         for (int k=CStart[2]-CGhost;    k<CStart[2]+CRange[2]+CGhost;  k++)
+         for (int j=CStart[1]-CGhost;    j<CStart[1]+CRange[1]+CGhost;  j++)
+         for (int i=CStart[0]-CGhost+1;  i<CStart[0]+CRange[0]+CGhost;  i++)
+         {
+            const int Idx_C = k*Cdz + j*Cdy + i*Cdx;
+            const int Idx_L = Idx_C - Cdx;
+            CPtr[Idx_C]     = ELBDM_UnwrapPhase( CPtr[Idx_L], CPtr[Idx_C] );
+         }
+      }
+#     endif
+
+
+//    interpolation along x direction
+      for (int In_z=CStart[2]-CGhost, Out_z=0;  In_z<CStart[2]+CRange[2]+CGhost;  In_z++, Out_z++)
+      {
+         Idx_Out = Out_z*TdzX;
+         Idx_InC =  In_z*Cdz + (CStart[1]-CGhost)*Cdy + CStart[0]*Cdx;
+
+         Int_Separable_X( CPtr+Idx_InC, Cdy, TDataX+Idx_Out, Tdy, CRange[1]+2*CGhost, CRange[0],
+                          CGhost, L, R, EnsurePositivity[v] );
+      }
+
+
+//    unwrap phase along y direction
+#     if ( MODEL == ELBDM )
+      if ( UnwrapPhase )
+      {
+         for (int k=0;  k<CRange[2]+2*CGhost;  k++)
+         for (int j=1;  j<CRange[1]+2*CGhost;  j++)
+         for (int i=0;  i<2*CRange[0];         i++)
+         {
+            const int Idx_C = k*TdzX + j*Tdy + i*Tdx;
+            const int Idx_L = Idx_C - Tdy;
+            TDataX[Idx_C]   = ELBDM_UnwrapPhase( TDataX[Idx_L], TDataX[Idx_C] );
+         }
+      }
+#     endif
+
+
+//    interpolation along y direction
+      for (int InOut_z=0; InOut_z<CRange[2]+2*CGhost; InOut_z++)
+      {
+         Idx_Out = InOut_z*TdzY;
+         Idx_InC = InOut_z*TdzX + CGhost*Tdy;
+
+         Int_Separable_Plane( TDataX+Idx_InC, Tdy, Tdy, TDataY+Idx_Out, TDataY+Idx_Out+Tdy, 2*Tdy,
+                              CRange[1], 2*CRange[0], CGhost, L, R, EnsurePositivity[v] );
+      }
+
+
+//    unwrap phase along z direction
+#     if ( MODEL == ELBDM )
+      if ( UnwrapPhase )
+      {
+         for (int k=1;  k<CRange[2]+2*CGhost;  k++)
+         for (int j=0;  j<2*CRange[1];         j++)
+         for (int i=0;  i<2*CRange[0];         i++)
+         {
+            const int Idx_C = k*TdzY + j*Tdy + i*Tdx;
+            const int Idx_L = Idx_C - TdzY;
+            TDataY[Idx_C]   = ELBDM_UnwrapPhase( TDataY[Idx_L], TDataY[Idx_C] );
+         }
+      }
+#     endif
+
+
+//    interpolation along z direction
+      for (int In_z=CGhost, Out_z=FStart[2];  In_z<CGhost+CRange[2];  In_z++, Out_z+=2)
+      {
+         Idx_Out = Out_z*Fdz + FStart[1]*Fdy + FStart[0]*Fdx;
+         Idx_InC =  In_z*TdzY;
+
+         Int_Separable_Plane( TDataY+Idx_InC, Tdy, TdzY, FPtr+Idx_Out, FPtr+Idx_Out+Fdz, Fdy,
+                              2*CRange[1], 2*CRange[0], CGhost, L, R, EnsurePositivity[v] );
+      }
+
+      CPtr += CDisp;
+      FPtr += FDisp;
+
+   } // for (int v=0; v<NComp; v++)
+
+   if ( NewScratch )    delete [] Scratch;
+
+} // FUNCTION : Int_Separable
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Int_Separable_X
+// Description :  Apply the 1D interpolation stencil along the contiguous (x) direction to NRow rows of NCell
+//                cells
+//
+// Note        :  1. The left/right results of In[r*InRow+i] are stored in Out[r*OutRow+2*i] and
+//                   Out[r*OutRow+2*i+1], respectively
+//                2. Same as "Int_Separable_Plane" except that the left and right results are interleaved, which
+//                   is done here directly to avoid an additional copy
+//
+// Parameter   :  In                : Pointer to the first input cell
+//                InRow             : Index stride between two input rows
+//                Out               : Output array
+//                OutRow            : Index stride between two output rows
+//                NRow              : Number of rows
+//                NCell             : Number of input cells in each row
+//                CGhost            : Number of ghost zones on each side of the stencil
+//                L/R               : Coefficients of the 1D stencil for the left/right fine-grid cells
+//                EnsurePositivity  : Ensure that all interpolation results are positive
+//-------------------------------------------------------------------------------------------------------
+void Int_Separable_X( const real *In, const int InRow, real *RESTRICT Out, const int OutRow,
+                      const int NRow, const int NCell, const int CGhost, const real L[], const real R[],
+                      const bool EnsurePositivity )
+{
+
+// copy the coefficients to local variables so that they can stay in registers within the loops
+   const real L0 = L[0], L1 = L[1], L2 = L[2];
+   const real R0 = R[0], R1 = R[1], R2 = R[2];
+
+   if ( CGhost == 1 )
+   {
+      for (int r=0; r<NRow; r++)
+      {
+         const real     *I = In  + r*InRow;
+         real *RESTRICT  O = Out + r*OutRow;
+
+         for (int i=0; i<NCell; i++)
+         {
+            const real CL1 = I[i-1], CC = I[i], CR1 = I[i+1];
+
+            O[2*i  ] = L0*CL1 + L1*CC + L2*CR1;
+            O[2*i+1] = R0*CL1 + R1*CC + R2*CR1;
+         }
+      }
+   }
+
+   else // CGhost == 2
+   {
+      const real L3 = L[3], L4 = L[4];
+      const real R3 = R[3], R4 = R[4];
+
+      for (int r=0; r<NRow; r++)
+      {
+         const real     *I = In  + r*InRow;
+         real *RESTRICT  O = Out + r*OutRow;
+
+         for (int i=0; i<NCell; i++)
+         {
+            const real CL2 = I[i-2], CL1 = I[i-1], CC = I[i], CR1 = I[i+1], CR2 = I[i+2];
+
+            O[2*i  ] = L0*CL2 + L1*CL1 + L2*CC + L3*CR1 + L4*CR2;
+            O[2*i+1] = R0*CL2 + R1*CL1 + R2*CC + R3*CR1 + R4*CR2;
+         }
+      }
+   }
+
+
+// ensure positivity
+   if ( EnsurePositivity )
+   {
+      int NNegative = 0;
+
+      for (int r=0; r<NRow;    r++)
+      for (int i=0; i<2*NCell; i++)
+         NNegative += ( Out[r*OutRow+i] < (real)0.0 );
+
+      if ( NNegative > 0 )
+      {
+         real LSlope, RSlope, Slope;
+         int  IdxIn, IdxOut;
+
+         for (int r=0; r<NRow;  r++)
+         for (int i=0; i<NCell; i++)
+         {
+            IdxIn  = r*InRow  + i;
+            IdxOut = r*OutRow + 2*i;
+
+            if ( Out[IdxOut] < (real)0.0  ||  Out[IdxOut+1] < (real)0.0 )
+            {
+               LSlope        = In[IdxIn  ] - In[IdxIn-1];
+               RSlope        = In[IdxIn+1] - In[IdxIn  ];
+               Slope         = (real)0.125*( SIGN(LSlope) + SIGN(RSlope) )*MIN( FABS(LSlope), FABS(RSlope) );
+
+               Out[IdxOut  ] = In[IdxIn] - Slope;
+               Out[IdxOut+1] = In[IdxIn] + Slope;
+            }
+         }
+      }
+   }
+
+} // FUNCTION : Int_Separable_X
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Int_Separable_Plane
+// Description :  Apply the 1D interpolation stencil to NRow rows of NCell cells
+//
+// Note        :  1. The input cells of each row are contiguous in memory, while the stencil is applied along
+//                   the direction with the index stride "SStride"
+//                   --> In[r*InRow+i+(s-CGhost)*SStride], s=0...2*CGhost, are used to compute the left/right
+//                       results OutL/OutR[r*OutRow+i]
+//                2. Only the 3-point (CGhost == 1) and 5-point (CGhost == 2) stencils are supported. They are
+//                   written out explicitly and free of branches so that the loops over the contiguous index
+//                   can be vectorized.
+//                   --> The output arrays must not overlap the input array (hence RESTRICT)
+//                3. Positivity is checked once for all rows. The MinMod fallback is only applied to the cells
+//                   with negative values.
+//
+// Parameter   :  In                : Pointer to the first input cell
+//                InRow             : Index stride between two input rows
+//                SStride           : Index stride along the interpolation direction
+//                OutL/OutR         : Output arrays for the left/right fine-grid cells
+//                OutRow            : Index stride between two output rows
+//                NRow              : Number of rows
+//                NCell             : Number of cells in each row
+//                CGhost            : Number of ghost zones on each side of the stencil
+//                L/R               : Coefficients of the 1D stencil for the left/right fine-grid cells
+//                EnsurePositivity  : Ensure that all interpolation results are positive
+//-------------------------------------------------------------------------------------------------------
+void Int_Separable_Plane( const real *In, const int InRow, const int SStride,
+                          real *RESTRICT OutL, real *RESTRICT OutR, const int OutRow, const int NRow,
+                          const int NCell, const int CGhost, const real L[], const real R[],
+                          const bool EnsurePositivity )
+{
+
+// copy the coefficients to local variables so that they can stay in registers within the loops
+   const real L0 = L[0], L1 = L[1], L2 = L[2];
+   const real R0 = R[0], R1 = R[1], R2 = R[2];
+
+   if ( CGhost == 1 )
+   {
+      for (int r=0; r<NRow; r++)
+      {
+         const real     *InC  = In   + r*InRow;
+         const real     *InL1 = InC  - SStride;
+         const real     *InR1 = InC  + SStride;
+         real *RESTRICT  OL   = OutL + r*OutRow;
+         real *RESTRICT  OR   = OutR + r*OutRow;
+
+         for (int i=0; i<NCell; i++)
+         {
+            const real CL1 = InL1[i], CC = InC[i], CR1 = InR1[i];
+
+            OL[i] = L0*CL1 + L1*CC + L2*CR1;
+            OR[i] = R0*CL1 + R1*CC + R2*CR1;
+         }
+      }
+   }
+
+   else // CGhost == 2
+   {
+      const real L3 = L[3], L4 = L[4];
+      const real R3 = R[3], R4 = R[4];
+
+      for (int r=0; r<NRow; r++)
+      {
+         const real     *InC  = In   + r*InRow;
+         const real     *InL1 = InC  -   SStride;
+         const real     *InL2 = InC  - 2*SStride;
+         const real     *InR1 = InC  +   SStride;
+         const real     *InR2 = InC  + 2*SStride;
+         real *RESTRICT  OL   = OutL + r*OutRow;
+         real *RESTRICT  OR   = OutR + r*OutRow;
+
+         for (int i=0; i<NCell; i++)
+         {
+            const real CL2 = InL2[i], CL1 = InL1[i], CC = InC[i], CR1 = InR1[i], CR2 = InR2[i];
+
+            OL[i] = L0*CL2 + L1*CL1 + L2*CC + L3*CR1 + L4*CR2;
+            OR[i] = R0*CL2 + R1*CL1 + R2*CC + R3*CR1 + R4*CR2;
+         }
+      }
+   }
+
+
+// ensure positivity
+   if ( EnsurePositivity )
+   {
+      int NNegative = 0;
+
+      for (int r=0; r<NRow;  r++)
+      for (int i=0; i<NCell; i++)
+         NNegative += ( OutL[r*OutRow+i] < (real)0.0 ) | ( OutR[r*OutRow+i] < (real)0.0 );
+
+      if ( NNegative > 0 )
+      {
+         real LSlope, RSlope, Slope;
+         int  IdxIn, IdxOut;
+
+         for (int r=0; r<NRow;  r++)
+         for (int i=0; i<NCell; i++)
+         {
+            IdxIn  = r*InRow  + i;
+            IdxOut = r*OutRow + i;
+
+            if ( OutL[IdxOut] < (real)0.0  ||  OutR[IdxOut] < (real)0.0 )
+            {
+               LSlope       = In[IdxIn        ] - In[IdxIn-SStride];
+               RSlope       = In[IdxIn+SStride] - In[IdxIn        ];
+               Slope        = (real)0.125*( SIGN(LSlope) + SIGN(RSlope) )*MIN( FABS(LSlope), FABS(RSlope) );
+
+               OutL[IdxOut] = In[IdxIn] - Slope;
+               OutR[IdxOut] = In[IdxIn] + Slope;
+            }
+         }
+      }
+   }
+
+} // FUNCTION : Int_Separable_Plane
@@ -9,16 +9,16 @@ void Int_vanLeer   ( const real CData[], const int CSize[3], const int CStart[3]
                            real FData[], const int FSize[3], const int FStart[3], const int NComp );
 void Int_CQuadratic(       real CData[], const int CSize[3], const int CStart[3], const int CRange[3],
                            real FData[], const int FSize[3], const int FStart[3], const int NComp,
-                     const bool UnwrapPhase, const bool EnsurePositivity );
+                     const bool UnwrapPhase, const bool EnsurePositivity[], real *Scratch );
 void Int_Quadratic (       real CData[], const int CSize[3], const int CStart[3], const int CRange[3],
                            real FData[], const int FSize[3], const int FStart[3], const int NComp,
-                     const bool UnwrapPhase, const bool EnsurePositivity );
+                     const bool UnwrapPhase, const bool EnsurePositivity[], real *Scratch );
 void Int_CQuartic  (       real CData[], const int CSize[3], const int CStart[3], const int CRange[3],
 	                   real FData[], const int FSize[3], const int FStart[3], const int NComp,
-                     const bool UnwrapPhase, const bool EnsurePositivity );
+                     const bool UnwrapPhase, const bool EnsurePositivity[], real *Scratch );
 void Int_Quartic   (       real CData[], const int CSize[3], const int CStart[3], const int CRange[3],
 	                   real FData[], const int FSize[3], const int FStart[3], const int NComp,
-                     const bool UnwrapPhase, const bool EnsurePositivity );
+                     const bool UnwrapPhase, const bool EnsurePositivity[], real *Scratch );
 
 
 
@@ -46,14 +46,18 @@ void Int_Quartic   (       real CData[], const int CSize[3], const int CStart[3]
 //                                        INT_CQUAR   : conservative quartic
 //                                        INT_QUAR    : quartic
 //                UnwrapPhase       : Unwrap phase when OPT__INT_PHASE is on (for ELBDM only)
-//                EnsurePositivity  : Ensure that all interpolation results are positive
+//                EnsurePositivity  : Ensure that all interpolation results are positive (one flag per component)
 //                                    --> The input data must be positive already
 //                                    --> Useful when interpolating density, energy, ... etc
+//                Scratch           : Temporary array reused by the quadratic and quartic schemes
+//                                    --> Must be able to store at least "Int_ScratchSize( IntScheme, CRange )"
+//                                        elements
+//                                    --> Set to NULL to allocate the temporary array on the fly
 //-------------------------------------------------------------------------------------------------------
 void Interpolate( real CData [], const int CSize[3], const int CStart[3], const int CRange[3],
                   real FData [], const int FSize[3], const int FStart[3], 
                   const int NComp, const IntScheme_t IntScheme, const bool UnwrapPhase, 
-                  const bool EnsurePositivity )
+                  const bool EnsurePositivity[], real *Scratch )
 {
 
 // check
@@ -102,22 +106,53 @@ void Interpolate( real CData [], const int CSize[3], const int CStart[3], const
 
       case INT_CQUAD : 
          Int_CQuadratic( CData, CSize, CStart, CRange, FData, FSize, FStart, NComp, 
-                         UnwrapPhase, EnsurePositivity );                                 break;
+                         UnwrapPhase, EnsurePositivity, Scratch );                        break;
 
       case INT_QUAD : 
          Int_Quadratic ( CData, CSize, CStart, CRange, FData, FSize, FStart, NComp,
-                         UnwrapPhase, EnsurePositivity );                                 break;
+                         UnwrapPhase, EnsurePositivity, Scratch );                        break;
 
       case INT_CQUAR : 
          Int_CQuartic  ( CData, CSize, CStart, CRange, FData, FSize, FStart, NComp,
-                         UnwrapPhase, EnsurePositivity );                                 break;
+                         UnwrapPhase, EnsurePositivity, Scratch );                        break;
 
       case INT_QUAR : 
          Int_Quartic   ( CData, CSize, CStart, CRange, FData, FSize, FStart, NComp,
-                         UnwrapPhase, EnsurePositivity );                                 break;
+                         UnwrapPhase, EnsurePositivity, Scratch );                        break;
 
       default :
          Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "IntScheme", IntScheme );
    }
 
 } // FUNCTION : Interpolate
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Int_ScratchSize
+// Description :  Return the number of elements required by the temporary array "Scratch" of the function
+//                "Interpolate"
+//
+// Note        :  1. Only the quadratic and quartic schemes require the temporary array
+//                   --> Return 0 for the other schemes
+//                2. The returned size is independent of NComp since the temporary array is reused by all
+//                   components
+//
+// Parameter   :  IntScheme : Interpolation scheme
+//                CRange    : Number of grids in each direction to perform interpolation
+//-------------------------------------------------------------------------------------------------------
+int Int_ScratchSize( const IntScheme_t IntScheme, const int CRange[3] )
+{
+
+   if ( IntScheme != INT_CQUAD  &&  IntScheme != INT_QUAD  &&  IntScheme != INT_CQUAR  &&  IntScheme != INT_QUAR )
+      return 0;
+
+   int NSide, CGhost;
+   Int_Table( IntScheme, NSide, CGhost );
+
+   const int TdzX = 2*CRange[0]*( CRange[1] + 2*CGhost );   // stride along z after the x interpolation
+   const int TdzY = 2*CRange[0]*( 2*CRange[1]          );   // stride along z after the y interpolation
+
+   return ( CRange[2] + 2*CGhost )*( TdzX + TdzY );
+
+} // FUNCTION : Int_ScratchSize
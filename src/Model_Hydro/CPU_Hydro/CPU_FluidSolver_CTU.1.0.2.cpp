@@ -7,23 +7,16 @@
 
 
 extern void CPU_DataReconstruction( const real PriVar[][5], real FC_Var[][6][5], const int NIn, const int NGhost,
-                                    const real Gamma, const LR_Limiter_t LR_Limiter, const real MinMod_Coeff, 
-                                    const real EP_Coeff, const real dt, const real dh );
+                                    const real Gamma, const int LR_Scheme, const LR_Limiter_t LR_Limiter, 
+                                    const real MinMod_Coeff, const real EP_Coeff, const real dt, const real dh );
 extern void CPU_Con2Pri( const real In[], real Out[], const real  Gamma_m1 );
 extern void CPU_Pri2Con( const real In[], real Out[], const real _Gamma_m1 );
 extern void CPU_ComputeFlux( const real FC_Var[][6][5], real FC_Flux[][3][5], const int NFlux, const int Gap,
-                             const real Gamma );
+                             const real Gamma, const int RSolver );
 extern void CPU_FullStepUpdate( const real Input[][ FLU_NXT*FLU_NXT*FLU_NXT ], real Output[][ PS2*PS2*PS2 ], 
                                 const real Flux[][3][5], const real dt, const real dh, 
                                 const real Gamma );
 extern void CPU_StoreFlux( real Flux_Array[][5][ PS2*PS2 ], const real FC_Flux[][3][5] );
-#if   ( RSOLVER == EXACT )
-extern void CPU_RiemannSolver_Exact( const int XYZ, real eival_out[], real L_star_out[], real R_star_out[], 
-                                     real Flux_Out[], const real L_In[], const real R_In[], const real Gamma ); 
-#elif ( RSOLVER == ROE )
-extern void CPU_RiemannSolver_Roe( const int XYZ, real Flux_Out[], const real L_In[], const real R_In[], 
-                                   const real Gamma );
-#endif
 
 static void TGradient_Correction( real FC_Var[][6][5], const real FC_Flux[][3][5], const real dt, const real dh );
 
@@ -34,7 +27,12 @@ static void TGradient_Correction( real FC_Var[][6][5], const real FC_Flux[][3][5
 // Function    :  CPU_FluidSolver_CTU
 // Description :  CPU fluid solver based on the Corner-Transport-Upwind (CTU) scheme
 //
-// Note        :  Ref : Stone et al., ApJS, 178, 137 (2008)
+// Note        :  1. Ref : Stone et al., ApJS, 178, 137 (2008)
+//                2. The data reconstruction and Riemann solver are selected at runtime by "LR_Scheme" and
+//                   "RSolver" (which can differ between levels) if RUNTIME_FLU_SCHEME is on
+//                   --> Otherwise they are always LR_SCHEME and RSOLVER
+//                   --> The reference states adopted in the characteristic tracing are still determined by the
+//                       compile-time RSOLVER (see "HLL_NO_REF_STATE" in "CUFLU.h")
 //
 // Parameter   :  Flu_Array_In   : Array storing the input fluid variables
 //                Flu_Array_Out  : Array to store the output fluid variables
@@ -44,18 +42,23 @@ static void TGradient_Correction( real FC_Var[][6][5], const real FC_Flux[][3][5
 //                dh             : Grid size
 //                Gamma          : Ratio of specific heats
 //                StoreFlux      : true --> store the coarse-fine fluxes
+//                LR_Scheme      : Data reconstruction scheme (PLM/PPM)
+//                RSolver        : Riemann solver (EXACT/ROE/HLLE/HLLC/HYBRID)
 //                LR_Limiter     : Slope limiter for the data reconstruction in the MHM/MHM_RP/CTU schemes
 //                                 (0/1/2/3/4) = (vanLeer/generalized MinMod/vanAlbada/
 //                                                vanLeer + generalized MinMod/extrema-preserving) limiter
 //                MinMod_Coeff   : Coefficient of the generalized MinMod limiter
 //                EP_Coeff       : Coefficient of the extrema-preserving limiter
+//                Cost           : Array to store the cost (in CPU cycles) of each patch group
+//                                 --> for the option "TIMING_PATCH" only (NULL --> off)
 //-------------------------------------------------------------------------------------------------------
 void CPU_FluidSolver_CTU( const real Flu_Array_In[][5][ FLU_NXT*FLU_NXT*FLU_NXT ], 
                           real Flu_Array_Out[][5][ PS2*PS2*PS2 ], 
                           real Flux_Array[][9][5][ PS2*PS2 ], 
                           const int NPatchGroup, const real dt, const real dh, const real Gamma, 
-                          const bool StoreFlux, const LR_Limiter_t LR_Limiter, const real MinMod_Coeff, 
-                          const real EP_Coeff )
+                          const bool StoreFlux, const int LR_Scheme, const int RSolver, 
+                          const LR_Limiter_t LR_Limiter, const real MinMod_Coeff, const real EP_Coeff,
+                          double Cost[] )
 {
 
 // check
@@ -63,6 +66,12 @@ void CPU_FluidSolver_CTU( const real Flu_Array_In[][5][ FLU_NXT*FLU_NXT*FLU_NXT
    if ( LR_Limiter != VANLEER  &&  LR_Limiter != GMINMOD  &&  LR_Limiter != ALBADA  &&  LR_Limiter != EXTPRE  &&
         LR_Limiter != VL_GMINMOD )
       Aux_Error( ERROR_INFO, "unsupported reconstruction limiter (%d) !!\n", LR_Limiter );
+
+   if ( LR_Scheme != PLM  &&  LR_Scheme != PPM )
+      Aux_Error( ERROR_INFO, "unsupported data reconstruction scheme (%d) !!\n", LR_Scheme );
+
+   if ( RSolver != EXACT  &&  RSolver != ROE  &&  RSolver != HLLE  &&  RSolver != HLLC  &&  RSolver != HYBRID )
+      Aux_Error( ERROR_INFO, "unsupported Riemann solver (%d) !!\n", RSolver );
 #  endif
 
 
@@ -84,6 +93,9 @@ void CPU_FluidSolver_CTU( const real Flu_Array_In[][5][ FLU_NXT*FLU_NXT*FLU_NXT
 #     pragma omp for
       for (int P=0; P<NPatchGroup; P++)
       {
+#        ifdef TIMING_PATCH
+         const double Cycle0 = TIMER_CYCLE();
+#        endif
 
 //       1. conserved variables --> primitive variables
          for (int k=0; k<FLU_NXT; k++)
@@ -99,7 +111,7 @@ void CPU_FluidSolver_CTU( const real Flu_Array_In[][5][ FLU_NXT*FLU_NXT*FLU_NXT
 
 
 //       2. evaluate the face-centered values at the half time-step
-         CPU_DataReconstruction( PriVar, FC_Var, FLU_NXT, FLU_GHOST_SIZE-1, Gamma, LR_Limiter, 
+         CPU_DataReconstruction( PriVar, FC_Var, FLU_NXT, FLU_GHOST_SIZE-1, Gamma, LR_Scheme, LR_Limiter, 
                                  MinMod_Coeff, EP_Coeff, dt, dh );
 
 
@@ -120,7 +132,7 @@ void CPU_FluidSolver_CTU( const real Flu_Array_In[][5][ FLU_NXT*FLU_NXT*FLU_NXT
 
 
 //       4. evaluate the face-centered half-step fluxes by solving the Riemann problem
-         CPU_ComputeFlux( FC_Var, FC_Flux, N_HF_FLUX, 0, Gamma );
+         CPU_ComputeFlux( FC_Var, FC_Flux, N_HF_FLUX, 0, Gamma, RSolver );
 
 
 //       5. correct the face-centered variables by the transverse flux gradients
@@ -128,7 +140,7 @@ void CPU_FluidSolver_CTU( const real Flu_Array_In[][5][ FLU_NXT*FLU_NXT*FLU_NXT
 
 
 //       6. evaluate the face-centered full-step fluxes by solving the Riemann problem with the corrected data
-         CPU_ComputeFlux( FC_Var, FC_Flux, N_FL_FLUX, 1, Gamma );
+         CPU_ComputeFlux( FC_Var, FC_Flux, N_FL_FLUX, 1, Gamma, RSolver );
 
 
 //       7. full-step evolution
@@ -139,6 +151,10 @@ void CPU_FluidSolver_CTU( const real Flu_Array_In[][5][ FLU_NXT*FLU_NXT*FLU_NXT
          if ( StoreFlux )
          CPU_StoreFlux( Flux_Array[P], FC_Flux );
 
+#        ifdef TIMING_PATCH
+         if ( Cost != NULL )  Cost[P] = TIMER_CYCLE() - Cycle0;
+#        endif
+
       } // for (int P=0; P<NPatchGroup; P++)
 
 
@@ -7,29 +7,28 @@
 
 
 extern void CPU_DataReconstruction( const real PriVar[][5], real FC_Var[][6][5], const int NIn, const int NGhost,
-                                    const real Gamma, const LR_Limiter_t LR_Limiter, const real MinMod_Coeff, 
-                                    const real EP_Coeff, const real dt, const real dh );
+                                    const real Gamma, const int LR_Scheme, const LR_Limiter_t LR_Limiter, 
+                                    const real MinMod_Coeff, const real EP_Coeff, const real dt, const real dh );
 extern void CPU_Con2Flux( const int XYZ, real Flux[], const real Input[], const real Gamma );
 extern void CPU_Con2Pri( const real In[], real Out[], const real  Gamma_m1 );
 extern void CPU_Pri2Con( const real In[], real Out[], const real _Gamma_m1 );
 extern void CPU_ComputeFlux( const real FC_Var[][6][5], real FC_Flux[][3][5], const int NFlux, const int Gap,
-                             const real Gamma );
+                             const real Gamma, const int RSolver );
 extern void CPU_FullStepUpdate( const real Input[][ FLU_NXT*FLU_NXT*FLU_NXT ], real Output[][ PS2*PS2*PS2 ], 
                                 const real Flux[][3][5], const real dt, const real dh, 
                                 const real Gamma );
 extern void CPU_StoreFlux( real Flux_Array[][5][ PS2*PS2 ], const real FC_Flux[][3][5] );
-#if   ( RSOLVER == EXACT )
+#if ( FLU_SCHEME == MHM_RP )
 extern void CPU_RiemannSolver_Exact( const int XYZ, real eival_out[], real L_star_out[], real R_star_out[], 
                                      real Flux_Out[], const real L_In[], const real R_In[], const real Gamma ); 
-#elif ( RSOLVER == ROE )
 extern void CPU_RiemannSolver_Roe( const int XYZ, real Flux_Out[], const real L_In[], const real R_In[], 
                                    const real Gamma );
-#elif ( RSOLVER == HLLE )
 extern void CPU_RiemannSolver_HLLE( const int XYZ, real Flux_Out[], const real L_In[], const real R_In[], 
                                     const real Gamma );
-#elif ( RSOLVER == HLLC )
 extern void CPU_RiemannSolver_HLLC( const int XYZ, real Flux_Out[], const real L_In[], const real R_In[], 
                                     const real Gamma );
+extern void CPU_RiemannSolver_Hybrid( const int XYZ, real Flux_Out[], const real L_In[], const real R_In[],
+                                      const real Gamma, long Counter[] );
 #endif
 
 #if   ( FLU_SCHEME == MHM_RP )
@@ -37,7 +36,7 @@ static void CPU_RiemannPredict( const real Flu_Array_In[][ FLU_NXT*FLU_NXT*FLU_N
                                 const real Half_Flux[][3][5], real Half_Var[][5], const real dt, 
                                 const real dh, const real Gamma );
 static void CPU_RiemannPredict_Flux( const real Flu_Array_In[][ FLU_NXT*FLU_NXT*FLU_NXT ], 
-                                     real Half_Flux[][3][5], const real Gamma );
+                                     real Half_Flux[][3][5], const real Gamma, const int RSolver );
 #elif ( FLU_SCHEME == MHM )
 static void CPU_HancockPredict( real FC_Var[][6][5], const real dt, const real dh, const real Gamma,
                                 const real C_Var[][ FLU_NXT*FLU_NXT*FLU_NXT ] );
@@ -58,6 +57,9 @@ static void CPU_HancockPredict( real FC_Var[][6][5], const real dt, const real d
 //                   MHM    : "Riemann Solvers and Numerical Methods for Fluid Dynamics 
 //                             - A Practical Introduction ~ by Eleuterio F. Toro"
 //                   MHM_RP : Stone & Gardiner, NewA, 14, 139 (2009)
+//                4. The data reconstruction and Riemann solver are selected at runtime by "LR_Scheme" and
+//                   "RSolver" (which can differ between levels) if RUNTIME_FLU_SCHEME is on
+//                   --> Otherwise they are always LR_SCHEME and RSOLVER
 //
 // Parameter   :  Flu_Array_In   : Array storing the input fluid variables
 //                Flu_Array_Out  : Array to store the output fluid variables
@@ -67,18 +69,23 @@ static void CPU_HancockPredict( real FC_Var[][6][5], const real dt, const real d
 //                dh             : Grid size
 //                Gamma          : Ratio of specific heats
 //                StoreFlux      : true --> store the coarse-fine fluxes
+//                LR_Scheme      : Data reconstruction scheme (PLM/PPM)
+//                RSolver        : Riemann solver (EXACT/ROE/HLLE/HLLC/HYBRID)
 //                LR_Limiter     : Slope limiter for the data reconstruction in the MHM/MHM_RP/CTU schemes
 //                                 (0/1/2/3/4) = (vanLeer/generalized MinMod/vanAlbada/
 //                                                vanLeer + generalized MinMod/extrema-preserving) limiter
 //                MinMod_Coeff   : Coefficient of the generalized MinMod limiter
 //                EP_Coeff       : Coefficient of the extrema-preserving limiter
+//                Cost           : Array to store the cost (in CPU cycles) of each patch group
+//                                 --> for the option "TIMING_PATCH" only (NULL --> off)
 //-------------------------------------------------------------------------------------------------------
 void CPU_FluidSolver_MHM( const real Flu_Array_In[][5][ FLU_NXT*FLU_NXT*FLU_NXT ], 
                           real Flu_Array_Out[][5][ PS2*PS2*PS2 ], 
                           real Flux_Array[][9][5][ PS2*PS2 ], 
                           const int NPatchGroup, const real dt, const real dh, const real Gamma, 
-                          const bool StoreFlux, const LR_Limiter_t LR_Limiter, const real MinMod_Coeff, 
-                          const real EP_Coeff )
+                          const bool StoreFlux, const int LR_Scheme, const int RSolver, 
+                          const LR_Limiter_t LR_Limiter, const real MinMod_Coeff, const real EP_Coeff,
+                          double Cost[] )
                               
 {
 
@@ -87,6 +94,12 @@ void CPU_FluidSolver_MHM( const real Flu_Array_In[][5][ FLU_NXT*FLU_NXT*FLU_NXT
    if ( LR_Limiter != VANLEER  &&  LR_Limiter != GMINMOD  &&  LR_Limiter != ALBADA  &&  LR_Limiter != EXTPRE  &&
         LR_Limiter != VL_GMINMOD )
       Aux_Error( ERROR_INFO, "unsupported reconstruction limiter (%d) !!\n", LR_Limiter );
+
+   if ( LR_Scheme != PLM  &&  LR_Scheme != PPM )
+      Aux_Error( ERROR_INFO, "unsupported data reconstruction scheme (%d) !!\n", LR_Scheme );
+
+   if ( RSolver != EXACT  &&  RSolver != ROE  &&  RSolver != HLLE  &&  RSolver != HLLC  &&  RSolver != HYBRID )
+      Aux_Error( ERROR_INFO, "unsupported Riemann solver (%d) !!\n", RSolver );
 #  endif
 
 
@@ -113,12 +126,15 @@ void CPU_FluidSolver_MHM( const real Flu_Array_In[][5][ FLU_NXT*FLU_NXT*FLU_NXT
 #     pragma omp for
       for (int P=0; P<NPatchGroup; P++)
       {
+#        ifdef TIMING_PATCH
+         const double Cycle0 = TIMER_CYCLE();
+#        endif
 
 //       1. half-step prediction
 #        if ( FLU_SCHEME == MHM_RP ) // a. use Riemann solver to calculate the half-step fluxes
 
 //       (1.a-1) evaluate the half-step first-order fluxes by Riemann solver
-         CPU_RiemannPredict_Flux( Flu_Array_In[P], Half_Flux, Gamma );
+         CPU_RiemannPredict_Flux( Flu_Array_In[P], Half_Flux, Gamma, RSolver );
 
 
 //       (1.a-2) evaluate the half-step solutions
@@ -139,7 +155,7 @@ void CPU_FluidSolver_MHM( const real Flu_Array_In[][5][ FLU_NXT*FLU_NXT*FLU_NXT
 
 
 //       (1.a-4) evaluate the face-centered values by data reconstruction 
-         CPU_DataReconstruction( Half_Var, FC_Var, N_HF_VAR, FLU_GHOST_SIZE-2, Gamma, LR_Limiter, 
+         CPU_DataReconstruction( Half_Var, FC_Var, N_HF_VAR, FLU_GHOST_SIZE-2, Gamma, LR_Scheme, LR_Limiter, 
                                  MinMod_Coeff, EP_Coeff, NULL_REAL, NULL_INT );
 
 
@@ -174,7 +190,7 @@ void CPU_FluidSolver_MHM( const real Flu_Array_In[][5][ FLU_NXT*FLU_NXT*FLU_NXT
 
 
 //       (1.b-2) evaluate the face-centered values by data reconstruction 
-         CPU_DataReconstruction( PriVar, FC_Var, FLU_NXT, FLU_GHOST_SIZE-1, Gamma, LR_Limiter, 
+         CPU_DataReconstruction( PriVar, FC_Var, FLU_NXT, FLU_GHOST_SIZE-1, Gamma, LR_Scheme, LR_Limiter, 
                                  MinMod_Coeff, EP_Coeff, NULL_REAL, NULL_INT );
 
 
@@ -201,7 +217,7 @@ void CPU_FluidSolver_MHM( const real Flu_Array_In[][5][ FLU_NXT*FLU_NXT*FLU_NXT
 
 
 //       2. evaluate the full-step fluxes
-         CPU_ComputeFlux( FC_Var, FC_Flux, N_FL_FLUX, 1, Gamma );
+         CPU_ComputeFlux( FC_Var, FC_Flux, N_FL_FLUX, 1, Gamma, RSolver );
 
 
 //       3. full-step evolution
@@ -212,6 +228,10 @@ void CPU_FluidSolver_MHM( const real Flu_Array_In[][5][ FLU_NXT*FLU_NXT*FLU_NXT
          if ( StoreFlux )
          CPU_StoreFlux( Flux_Array[P], FC_Flux );
 
+#        ifdef TIMING_PATCH
+         if ( Cost != NULL )  Cost[P] = TIMER_CYCLE() - Cycle0;
+#        endif
+
       } // for (int P=0; P<NPatchGroup; P++)
 
 
@@ -231,26 +251,32 @@ void CPU_FluidSolver_MHM( const real Flu_Array_In[][5][ FLU_NXT*FLU_NXT*FLU_NXT
 // Description :  Evaluate the half-step face-centered fluxes by Riemann solver 
 //
 // Note        :  1. Work for the MUSCL-Hancock method + Riemann-prediction (MHM_RP)
-//                2. Currently support the exact, Roe, HLLE, and HLLC solvers
+//                2. Currently support the exact, Roe, HLLE, HLLC, and hybrid solvers
+//                3. "RSolver" is useless (RSOLVER is adopted) if RUNTIME_FLU_SCHEME is off
 //
 // Parameter   :  Flu_Array_In   : Array storing the input conserved variables
 //                Half_Flux      : Array to store the output face-centered fluxes
 //                                 --> The size is assumed to be N_HF_FLUX^3
 //                Gamma          : Ratio of specific heats
+//                RSolver        : Riemann solver (EXACT/ROE/HLLE/HLLC/HYBRID)
 //-------------------------------------------------------------------------------------------------------
 void CPU_RiemannPredict_Flux( const real Flu_Array_In[][ FLU_NXT*FLU_NXT*FLU_NXT ], real Half_Flux[][3][5], 
-                              const real Gamma )
+                              const real Gamma, const int RSolver )
 {
 
    const int dr[3] = { 1, FLU_NXT, FLU_NXT*FLU_NXT };
    int ID1, ID2, dN[3]={ 0 };
    real ConVar_L[5], ConVar_R[5];
 
-#  if ( RSOLVER == EXACT )
+#  if ( RSOLVER == EXACT  ||  defined RUNTIME_FLU_SCHEME )
    const real Gamma_m1 = Gamma - (real)1.0;
    real PriVar_L[5], PriVar_R[5];
 #  endif
 
+#  if ( RSOLVER == HYBRID  ||  defined RUNTIME_FLU_SCHEME )
+   long HybridCounter[3] = { 0, 0, 0 };
+#  endif
+
 
 // loop over different spatial directions
    for (int d=0; d<3; d++)
@@ -277,7 +303,34 @@ void CPU_RiemannPredict_Flux( const real Flu_Array_In[][ FLU_NXT*FLU_NXT*FLU_NXT
          }
 
 //       invoke the Riemann solver
-#        if   ( RSOLVER == EXACT )
+#        ifdef RUNTIME_FLU_SCHEME
+         switch ( RSolver )
+         {
+            case EXACT :
+               CPU_Con2Pri( ConVar_L, PriVar_L, Gamma_m1 );
+               CPU_Con2Pri( ConVar_R, PriVar_R, Gamma_m1 );
+
+               CPU_RiemannSolver_Exact( d, NULL, NULL, NULL, Half_Flux[ID1][d], PriVar_L, PriVar_R, Gamma );
+               break;
+
+            case ROE :
+               CPU_RiemannSolver_Roe   ( d, Half_Flux[ID1][d], ConVar_L, ConVar_R, Gamma );
+               break;
+
+            case HLLE :
+               CPU_RiemannSolver_HLLE  ( d, Half_Flux[ID1][d], ConVar_L, ConVar_R, Gamma );
+               break;
+
+            case HLLC :
+               CPU_RiemannSolver_HLLC  ( d, Half_Flux[ID1][d], ConVar_L, ConVar_R, Gamma );
+               break;
+
+            case HYBRID :
+               CPU_RiemannSolver_Hybrid( d, Half_Flux[ID1][d], ConVar_L, ConVar_R, Gamma, HybridCounter );
+               break;
+         }
+
+#        elif ( RSOLVER == EXACT )
          CPU_Con2Pri( ConVar_L, PriVar_L, Gamma_m1 );
          CPU_Con2Pri( ConVar_R, PriVar_R, Gamma_m1 );
 
@@ -288,13 +341,26 @@ void CPU_RiemannPredict_Flux( const real Flu_Array_In[][ FLU_NXT*FLU_NXT*FLU_NXT
          CPU_RiemannSolver_HLLE( d, Half_Flux[ID1][d], ConVar_L, ConVar_R, Gamma );
 #        elif ( RSOLVER == HLLC )
          CPU_RiemannSolver_HLLC( d, Half_Flux[ID1][d], ConVar_L, ConVar_R, Gamma );
+#        elif ( RSOLVER == HYBRID )
+         CPU_RiemannSolver_Hybrid( d, Half_Flux[ID1][d], ConVar_L, ConVar_R, Gamma, HybridCounter );
 #        else
-#        error : ERROR : unsupported Riemann solver (EXACT/ROE) !!
-#        endif
+#        error : ERROR : unsupported Riemann solver (EXACT/ROE/HLLE/HLLC/HYBRID) !!
+#        endif // #ifdef RUNTIME_FLU_SCHEME ... elif RSOLVER ...
 
       }
    } // for (int d=0; d<3; d++)
 
+
+// accumulate the number of interfaces evaluated by each solver in the hybrid Riemann solver
+#  if ( RSOLVER == HYBRID  ||  defined RUNTIME_FLU_SCHEME )
+   if ( RSolver == HYBRID )
+   for (int t=0; t<3; t++)
+   {
+#     pragma omp atomic
+      RSolver_HybridCounter[t] += HybridCounter[t];
+   }
+#  endif
+
 } // FUNCTION : CPU_RiemannPredict_Flux
 
 
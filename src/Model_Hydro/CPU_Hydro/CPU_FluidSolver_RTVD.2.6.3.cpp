@@ -33,12 +33,14 @@ static void TransposeXZ( real u[][ FLU_NXT*FLU_NXT*FLU_NXT ] );
 //                StoreFlux      : true --> store the coarse-fine fluxes
 //                XYZ            : true  : x->y->z ( forward sweep)
 //                                 false : z->y->x (backward sweep)
+//                Cost           : Array to store the cost (in CPU cycles) of each patch group
+//                                 --> for the option "TIMING_PATCH" only (NULL --> off)
 //-------------------------------------------------------------------------------------------------------
 void CPU_FluidSolver_RTVD( real Flu_Array_In [][5][ FLU_NXT*FLU_NXT*FLU_NXT ], 
                            real Flu_Array_Out[][5][ PS2*PS2*PS2 ], 
                            real Flux_Array[][9][5][ PS2*PS2 ], 
                            const int NPatchGroup, const real dt, const real dh, const real Gamma, 
-                           const bool StoreFlux, const bool XYZ )
+                           const bool StoreFlux, const bool XYZ, double Cost[] )
 {
 
    if ( XYZ )
@@ -46,6 +48,10 @@ void CPU_FluidSolver_RTVD( real Flu_Array_In [][5][ FLU_NXT*FLU_NXT*FLU_NXT ],
 #     pragma omp parallel for
       for (int P=0; P<NPatchGroup; P++)
       {
+#        ifdef TIMING_PATCH
+         const double Cycle0 = TIMER_CYCLE();
+#        endif
+
          CPU_AdvanceX( Flu_Array_In[P], dt, dh, Gamma, StoreFlux,              0,              0 );
    
          TransposeXY ( Flu_Array_In[P] );
@@ -58,6 +64,10 @@ void CPU_FluidSolver_RTVD( real Flu_Array_In [][5][ FLU_NXT*FLU_NXT*FLU_NXT ],
    
          TransposeXZ ( Flu_Array_In[P] );
          TransposeXY ( Flu_Array_In[P] );
+
+#        ifdef TIMING_PATCH
+         if ( Cost != NULL )  Cost[P] = TIMER_CYCLE() - Cycle0;
+#        endif
       }
    }
 
@@ -66,6 +76,10 @@ void CPU_FluidSolver_RTVD( real Flu_Array_In [][5][ FLU_NXT*FLU_NXT*FLU_NXT ],
 #     pragma omp parallel for
       for (int P=0; P<NPatchGroup; P++)
       {
+#        ifdef TIMING_PATCH
+         const double Cycle0 = TIMER_CYCLE();
+#        endif
+
          TransposeXY ( Flu_Array_In[P] );
          TransposeXZ ( Flu_Array_In[P] );
 
@@ -78,6 +92,10 @@ void CPU_FluidSolver_RTVD( real Flu_Array_In [][5][ FLU_NXT*FLU_NXT*FLU_NXT ],
          TransposeXY ( Flu_Array_In[P] );
 
          CPU_AdvanceX( Flu_Array_In[P], dt, dh, Gamma, StoreFlux, FLU_GHOST_SIZE, FLU_GHOST_SIZE );
+
+#        ifdef TIMING_PATCH
+         if ( Cost != NULL )  Cost[P] = TIMER_CYCLE() - Cycle0;
+#        endif
       }
    }
 
@@ -64,12 +64,15 @@ static void Solve_StarRoe( real eival[5], real L_star[5], real R_star[5], const
 //                                    1 : van-Leer
 //                                    2 : van-Albada
 //                                    3 : minbee
+//                Cost           : Array to store the cost (in CPU cycles) of each patch group
+//                                 --> for the option "TIMING_PATCH" only (NULL --> off)
 //-------------------------------------------------------------------------------------------------------
 void CPU_FluidSolver_WAF( real Flu_Array_In [][5][ FLU_NXT*FLU_NXT*FLU_NXT ], 
                           real Flu_Array_Out[][5][ PS2*PS2*PS2 ], 
                           real Flux_Array[][9][5][ PS2*PS2 ], 
                           const int NPatchGroup, const real dt, const real dh, const real Gamma,
-                          const bool StoreFlux, const bool XYZ, const WAF_Limiter_t WAF_Limiter )
+                          const bool StoreFlux, const bool XYZ, const WAF_Limiter_t WAF_Limiter,
+                          double Cost[] )
 {
 
 #  pragma omp parallel
@@ -82,6 +85,10 @@ void CPU_FluidSolver_WAF( real Flu_Array_In [][5][ FLU_NXT*FLU_NXT*FLU_NXT ],
 #        pragma omp for
          for (int P=0; P<NPatchGroup; P++)
          {
+#           ifdef TIMING_PATCH
+            const double Cycle0 = TIMER_CYCLE();
+#           endif
+
 //          solve the x direction
             CPU_AdvanceX( Flu_Array_In[P], FC, dt, dh, Gamma,              0,              0, WAF_Limiter ); 
       
@@ -120,6 +127,10 @@ void CPU_FluidSolver_WAF( real Flu_Array_In [][5][ FLU_NXT*FLU_NXT*FLU_NXT ],
             TransposeXZ ( Flu_Array_In[P] );
             TransposeXY ( Flu_Array_In[P] );
 
+#           ifdef TIMING_PATCH
+            if ( Cost != NULL )  Cost[P] = TIMER_CYCLE() - Cycle0;
+#           endif
+
          } // for (int P=0; P<NPatchGroup; P++)
       } // if ( XYZ )
 
@@ -129,6 +140,10 @@ void CPU_FluidSolver_WAF( real Flu_Array_In [][5][ FLU_NXT*FLU_NXT*FLU_NXT ],
 #        pragma omp for
          for (int P=0; P<NPatchGroup; P++)
          {
+#           ifdef TIMING_PATCH
+            const double Cycle0 = TIMER_CYCLE();
+#           endif
+
 //          x-y-z --> z-x-y for conservative variables         
             TransposeXY ( Flu_Array_In[P] );
             TransposeXZ ( Flu_Array_In[P] );
@@ -167,6 +182,10 @@ void CPU_FluidSolver_WAF( real Flu_Array_In [][5][ FLU_NXT*FLU_NXT*FLU_NXT ],
             if ( StoreFlux )
             Store_flux( Flux_Array[P][0], Flux_Array[P][1], Flux_Array[P][2], FC );
 
+#           ifdef TIMING_PATCH
+            if ( Cost != NULL )  Cost[P] = TIMER_CYCLE() - Cycle0;
+#           endif
+
          } // for (int P=0; P<NPatchGroup; P++)
       } // if ( XYZ ) ... else ...
 
@@ -6,20 +6,17 @@
 
 
 
-#if   ( RSOLVER == EXACT )
 extern void CPU_Con2Pri( const real In[], real Out[], const real  Gamma_m1 );
 extern void CPU_RiemannSolver_Exact( const int XYZ, real eival_out[], real L_star_out[], real R_star_out[], 
                                      real Flux_Out[], const real L_In[], const real R_In[], const real Gamma ); 
-#elif ( RSOLVER == ROE )
 extern void CPU_RiemannSolver_Roe( const int XYZ, real Flux_Out[], const real L_In[], const real R_In[], 
                                    const real Gamma );
-#elif ( RSOLVER == HLLE )
 extern void CPU_RiemannSolver_HLLE( const int XYZ, real Flux_Out[], const real L_In[], const real R_In[], 
                                     const real Gamma );
-#elif ( RSOLVER == HLLC )
 extern void CPU_RiemannSolver_HLLC( const int XYZ, real Flux_Out[], const real L_In[], const real R_In[], 
                                     const real Gamma );
-#endif
+extern void CPU_RiemannSolver_Hybrid( const int XYZ, real Flux_Out[], const real L_In[], const real R_In[],
+                                      const real Gamma, long Counter[] );
 
 
 
@@ -28,9 +25,11 @@ extern void CPU_RiemannSolver_HLLC( const int XYZ, real Flux_Out[], const real L
 // Function    :  CPU_ComputeFlux
 // Description :  Compute the face-centered fluxes by Riemann solver 
 //
-// Note        :  1. Currently support the exact and Roe solvers
+// Note        :  1. Currently support the exact, Roe, HLLE, HLLC, and hybrid solvers
 //                2. The size of the input array "FC_Var" is assumed to be N_FC_VAR^3
 //                   --> "N_FC_VAR-1" fluxes will be computed along each direction 
+//                3. All Riemann solvers are compiled in and the one adopted is selected by "RSolver" at runtime
+//                   if RUNTIME_FLU_SCHEME is on --> otherwise RSOLVER is adopted and "RSolver" is useless
 //
 // Parameter   :  FC_Var   : Array storing the input face-centered conserved variables
 //                FC_Flux  : Array to store the output face-centered flux
@@ -42,9 +41,10 @@ extern void CPU_RiemannSolver_HLLC( const int XYZ, real Flux_Out[], const real L
 //                Gap      : Number of grids to be skipped in the transverse direction
 //                           --> "(N_FC_VAR-2*Gap)^2" fluxes will be computed in each surface
 //                Gamma    : Ratio of specific heats
+//                RSolver  : Riemann solver (EXACT/ROE/HLLE/HLLC/HYBRID)
 //-------------------------------------------------------------------------------------------------------
 void CPU_ComputeFlux( const real FC_Var[][6][5], real FC_Flux[][3][5], const int NFlux, const int Gap,
-                      const real Gamma )
+                      const real Gamma, const int RSolver )
 {
 
    const int dID2[3] = { 1, N_FC_VAR, N_FC_VAR*N_FC_VAR };
@@ -52,11 +52,15 @@ void CPU_ComputeFlux( const real FC_Var[][6][5], real FC_Flux[][3][5], const int
    const real *ConVar_L=NULL, *ConVar_R=NULL;
    int ID1, ID2, dL, dR, start2[3]={0}, end1[3]={0};
 
-#  if ( RSOLVER == EXACT )
+#  if ( RSOLVER == EXACT  ||  defined RUNTIME_FLU_SCHEME )
    const real Gamma_m1 = Gamma - (real)1.0;
    real PriVar_L[5], PriVar_R[5];
 #  endif
 
+#  if ( RSOLVER == HYBRID  ||  defined RUNTIME_FLU_SCHEME )
+   long HybridCounter[3] = { 0, 0, 0 };
+#  endif
+
 
 // loop over different spatial directions
    for (int d=0; d<3; d++)
@@ -86,7 +90,34 @@ void CPU_ComputeFlux( const real FC_Var[][6][5], real FC_Flux[][3][5], const int
          ConVar_L = FC_Var[ ID2         ][dR];
          ConVar_R = FC_Var[ ID2+dID2[d] ][dL];
 
-#        if   ( RSOLVER == EXACT )
+#        ifdef RUNTIME_FLU_SCHEME
+         switch ( RSolver )
+         {
+            case EXACT :
+               CPU_Con2Pri( ConVar_L, PriVar_L, Gamma_m1 );
+               CPU_Con2Pri( ConVar_R, PriVar_R, Gamma_m1 );
+
+               CPU_RiemannSolver_Exact( d, NULL, NULL, NULL, FC_Flux[ID1][d], PriVar_L, PriVar_R, Gamma );
+               break;
+
+            case ROE :
+               CPU_RiemannSolver_Roe   ( d, FC_Flux[ID1][d], ConVar_L, ConVar_R, Gamma );
+               break;
+
+            case HLLE :
+               CPU_RiemannSolver_HLLE  ( d, FC_Flux[ID1][d], ConVar_L, ConVar_R, Gamma );
+               break;
+
+            case HLLC :
+               CPU_RiemannSolver_HLLC  ( d, FC_Flux[ID1][d], ConVar_L, ConVar_R, Gamma );
+               break;
+
+            case HYBRID :
+               CPU_RiemannSolver_Hybrid( d, FC_Flux[ID1][d], ConVar_L, ConVar_R, Gamma, HybridCounter );
+               break;
+         }
+
+#        elif ( RSOLVER == EXACT )
          CPU_Con2Pri( ConVar_L, PriVar_L, Gamma_m1 );
          CPU_Con2Pri( ConVar_R, PriVar_R, Gamma_m1 );
 
@@ -97,13 +128,26 @@ void CPU_ComputeFlux( const real FC_Var[][6][5], real FC_Flux[][3][5], const int
          CPU_RiemannSolver_HLLE( d, FC_Flux[ID1][d], ConVar_L, ConVar_R, Gamma );
 #        elif ( RSOLVER == HLLC )
          CPU_RiemannSolver_HLLC( d, FC_Flux[ID1][d], ConVar_L, ConVar_R, Gamma );
+#        elif ( RSOLVER == HYBRID )
+         CPU_RiemannSolver_Hybrid( d, FC_Flux[ID1][d], ConVar_L, ConVar_R, Gamma, HybridCounter );
 #        else
-#        error : ERROR : unsupported Riemann solver (EXACT/ROE) !!
-#        endif
+#        error : ERROR : unsupported Riemann solver (EXACT/ROE/HLLE/HLLC/HYBRID) !!
+#        endif // #ifdef RUNTIME_FLU_SCHEME ... elif RSOLVER ...
       }
 
    } // for (int d=0; d<3; d++)
 
+
+// accumulate the number of interfaces evaluated by each solver in the hybrid Riemann solver
+#  if ( RSOLVER == HYBRID  ||  defined RUNTIME_FLU_SCHEME )
+   if ( RSolver == HYBRID )
+   for (int t=0; t<3; t++)
+   {
+#     pragma omp atomic
+      RSolver_HybridCounter[t] += HybridCounter[t];
+   }
+#  endif
+
 } // FUNCTION : CPU_ComputeFlux
 
 
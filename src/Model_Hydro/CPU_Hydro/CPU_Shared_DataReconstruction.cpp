@@ -8,6 +8,15 @@
 
 extern void CPU_Rotate3D( real InOut[], const int XYZ, const bool Forward );
 
+static void CPU_DataReconstruction_PLM( const real PriVar[][5], real FC_Var[][6][5], const int NIn, const int NGhost,
+                                        const real Gamma, const LR_Limiter_t LR_Limiter, const real MinMod_Coeff, 
+                                        const real EP_Coeff, const real dt, const real dh );
+#if ( LR_SCHEME == PPM )
+static void CPU_DataReconstruction_PPM( const real PriVar[][5], real FC_Var[][6][5], const int NIn, const int NGhost,
+                                        const real Gamma, const LR_Limiter_t LR_Limiter, const real MinMod_Coeff, 
+                                        const real EP_Coeff, const real dt, const real dh );
+#endif
+
 static void Get_EigenSystem( const real CC_Var[], real EigenVal[][5], real LEigenVec[][5], real REigenVec[][5],
                              const real Gamma );
 static void LimitSlope( const real L2[], const real L1[], const real C0[], const real R1[], const real R2[],
@@ -21,14 +30,53 @@ static void Char2Pri( real Var[], const real Gamma, const real Rho, const real P
 
 
 
-#if ( LR_SCHEME == PLM )
 //-------------------------------------------------------------------------------------------------------
 // Function    :  CPU_DataReconstruction
+// Description :  Reconstruct the face-centered variables by the data reconstruction scheme "LR_Scheme"
+//
+// Note        :  1. PLM is always available while PPM is compiled in only if LR_SCHEME == PPM since it
+//                   requires more ghost zones (FLU_GHOST_SIZE)
+//                   --> PLM can be applied to any level in the PPM build, for which the outermost ghost 
+//                       zones are simply ignored
+//                2. This function is shared by MHM, MHM_RP, and CTU schemes
+//
+// Parameter   :  LR_Scheme      : Data reconstruction scheme (PLM/PPM)
+//                Others         : See the functions "CPU_DataReconstruction_PLM/PPM"
+//------------------------------------------------------------------------------------------------------
+void CPU_DataReconstruction( const real PriVar[][5], real FC_Var[][6][5], const int NIn, const int NGhost,
+                             const real Gamma, const int LR_Scheme, const LR_Limiter_t LR_Limiter, 
+                             const real MinMod_Coeff, const real EP_Coeff, const real dt, const real dh )
+{
+
+   switch ( LR_Scheme )
+   {
+      case PLM :
+         CPU_DataReconstruction_PLM( PriVar, FC_Var, NIn, NGhost, Gamma, LR_Limiter, MinMod_Coeff, EP_Coeff,
+                                     dt, dh );
+         break;
+
+#     if ( LR_SCHEME == PPM )
+      case PPM :
+         CPU_DataReconstruction_PPM( PriVar, FC_Var, NIn, NGhost, Gamma, LR_Limiter, MinMod_Coeff, EP_Coeff,
+                                     dt, dh );
+         break;
+#     endif
+
+      default :
+         Aux_Error( ERROR_INFO, "unsupported data reconstruction scheme (%d) !!\n", LR_Scheme );
+   }
+
+} // FUNCTION : CPU_DataReconstruction
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  CPU_DataReconstruction_PLM
 // Description :  Reconstruct the face-centered variables by the piecewise-linear method (PLM)
 //
 // Note        :  1. Use the parameter "LR_Limiter" to choose different slope limiters
 //                2. The input and output data should be primitive variables
-//                3. The PLM and PPM data reconstruction functions share the same function name
+//                3. Invoked by "CPU_DataReconstruction"
 //                4. The face-centered variables will be advaned by half time-step for the CTU scheme
 //                5. The data reconstruction can be applied to characteristic variables by 
 //                   defining "CHAR_RECONSTRUCTION"
@@ -51,9 +99,9 @@ static void Char2Pri( real Var[], const real Gamma, const real Rho, const real P
 //                dt             : Time interval to advance solution (for the CTU scheme)
 //                dh             : Grid size (for the CTU scheme)
 //------------------------------------------------------------------------------------------------------
-void CPU_DataReconstruction( const real PriVar[][5], real FC_Var[][6][5], const int NIn, const int NGhost,
-                             const real Gamma, const LR_Limiter_t LR_Limiter, const real MinMod_Coeff, 
-                             const real EP_Coeff, const real dt, const real dh )
+void CPU_DataReconstruction_PLM( const real PriVar[][5], real FC_Var[][6][5], const int NIn, const int NGhost,
+                                 const real Gamma, const LR_Limiter_t LR_Limiter, const real MinMod_Coeff, 
+                                 const real EP_Coeff, const real dt, const real dh )
 {
 
    const int dr1[3] = { 1, NIn, NIn*NIn };
@@ -287,19 +335,18 @@ void CPU_DataReconstruction( const real PriVar[][5], real FC_Var[][6][5], const
       } // for (int d=0; d<3; d++)
    } // k,j,i
 
-} // FUNCTION : CPU_DataReconstruction (PLM)
-#endif // #if ( LR_SCHEME == PLM )
+} // FUNCTION : CPU_DataReconstruction_PLM
 
 
 
 #if ( LR_SCHEME == PPM )
 //-------------------------------------------------------------------------------------------------------
-// Function    :  CPU_DataReconstruction
+// Function    :  CPU_DataReconstruction_PPM
 // Description :  Reconstruct the face-centered variables by the piecewise-parabolic method (PPM)
 //
 // Note        :  1. Use the parameter "LR_Limiter" to choose different slope limiters
 //                2. The input and output data should be primitive variables
-//                3. The PLM and PPM data reconstruction functions share the same function name
+//                3. Invoked by "CPU_DataReconstruction"
 //                4. The face-centered variables will be advaned by half time-step for the CTU scheme
 //                5. Currently the extrema-preserving limiter is not supported in PPM
 //                6. The data reconstruction can be applied to characteristic variables by 
@@ -323,9 +370,9 @@ void CPU_DataReconstruction( const real PriVar[][5], real FC_Var[][6][5], const
 //                dt             : Time interval to advance solution (for the CTU scheme)
 //                dh             : Grid size (for the CTU scheme)
 //------------------------------------------------------------------------------------------------------
-void CPU_DataReconstruction( const real PriVar[][5], real FC_Var[][6][5], const int NIn, const int NGhost,
-                             const real Gamma, const LR_Limiter_t LR_Limiter, const real MinMod_Coeff, 
-                             const real EP_Coeff, const real dt, const real dh )
+void CPU_DataReconstruction_PPM( const real PriVar[][5], real FC_Var[][6][5], const int NIn, const int NGhost,
+                                 const real Gamma, const LR_Limiter_t LR_Limiter, const real MinMod_Coeff, 
+                                 const real EP_Coeff, const real dt, const real dh )
 {
 
 // check
@@ -615,7 +662,7 @@ void CPU_DataReconstruction( const real PriVar[][5], real FC_Var[][6][5], const
 
    delete [] Slope_PPM;
 
-} // FUNCTION : CPU_DataReconstruction (PPM)
+} // FUNCTION : CPU_DataReconstruction_PPM
 #endif // #if ( LR_SCHEME == PPM )
 
 
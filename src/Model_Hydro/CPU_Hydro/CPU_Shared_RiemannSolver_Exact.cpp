@@ -3,14 +3,16 @@
 #include "CUFLU.h"
 
 #if (  !defined GPU  &&  MODEL == HYDRO  &&  \
-       ( RSOLVER == EXACT || CHECK_INTERMEDIATE == EXACT )  &&  \
+       ( RSOLVER == EXACT || RSOLVER == HYBRID || CHECK_INTERMEDIATE == EXACT || defined RUNTIME_FLU_SCHEME )  &&  \
        ( FLU_SCHEME == MHM || FLU_SCHEME == MHM_RP || FLU_SCHEME == CTU || FLU_SCHEME == WAF )  )
 
 
 
 extern void CPU_Rotate3D( real InOut[], const int XYZ, const bool Forward );
 
-static real Solve_f( const real rho,const real p,const real p_star,const real Gamma );
+static real Solve_f( const real rho, const real p, const real p_star, const real Gamma, real *df );
+static real Solve_PStar( const real L[], const real R[], const real Gamma );
+static real Solve_PStar_Bisection( const real L[], const real R[], const real Gamma );
 #if ( FLU_SCHEME == MHM  ||  FLU_SCHEME == MHM_RP  ||  FLU_SCHEME == CTU )
 static void Set_Flux( real flux[], const real val[], const real Gamma );
 #endif
@@ -70,88 +72,15 @@ void CPU_RiemannSolver_Exact( const int XYZ, real eival_out[], real L_star_out[]
 
 
 // solution of pressure
-   {
-      const real du = R[1] - L[1];
-
-      real f;
-      real f_L;
-      real f_R;
-      real bound[2];
-      real compare[2];
-
-      bound[0] = FMIN( L[4], R[4] );
-      bound[1] = FMAX( L[4], R[4] );
-
-      for (int i=0; i<2; i++)
-          {
-             f_L = Solve_f( L[0], L[4], bound[i], Gamma );
-             f_R = Solve_f( R[0], R[4], bound[i], Gamma );
-
-             compare[i] = f_L + f_R + du;
-          }
-
-      if( compare[0]*compare[1] > (real)0.0 )
-      {
-        if( compare[0] > (real)0.0 )
-        {
-           bound[1] = bound[0];
-           bound[0] = (real)0.0;
-        }
-        else if( compare[1] < (real)0.0 )
-        {
-           bool Continue;
-
-           bound[0] = bound[1];
-           bound[1] = (real)2.0*bound[0];
-
-           do
-           {
-              for (int i=0; i<2; i++)
-              {
-                 f_L = Solve_f( L[0], L[4], bound[i], Gamma );
-                 f_R = Solve_f( R[0], R[4], bound[i], Gamma );
-
-                 compare[i] = f_L + f_R + du;
-              }
-
-              Continue = ( compare[0]*compare[1] > (real)0.0 );
-
-              if ( Continue )
-              {
-                 bound[0] = bound[1];
-                 bound[1] = bound[0]*(real)2.0;
-              }
-           }  
-           while ( Continue );
-        }
-      }
-
-//    search p_star
-      do
-      {
-         L_star[4] = (real)0.5 * ( bound[0] + bound[1] );
-
-         if (  ( L_star[4] == bound[0] )  ||  ( L_star[4] == bound[1] )  )    break;
-         else
-         {
-            f_L = Solve_f( L[0], L[4], L_star[4], Gamma );
-            f_R = Solve_f( R[0], R[4], L_star[4], Gamma );
-            f   = f_L + f_R + du;
-
-            if ( f > (real)0.0 )    bound[1] = L_star[4];
-            else                    bound[0] = L_star[4];
-         }
-      }
-      while ( FABS(f) >= MAX_ERROR );
-   }
+   L_star[4] = Solve_PStar( L, R, Gamma );
 
    R_star[4] = L_star[4];
 
 
 // solution normal velocity
    {
-      real f_L = Solve_f( L[0], L[4], L_star[4], Gamma );
-      real f_R = Solve_f( R[0], R[4], R_star[4], Gamma );
+      real f_L = Solve_f( L[0], L[4], L_star[4], Gamma, NULL );
+      real f_R = Solve_f( R[0], R[4], R_star[4], Gamma, NULL );
 
       L_star[1] = (real)0.5*( L[1] + R[1] ) + (real)0.5*( f_R - f_L );
    }
@@ -261,16 +190,194 @@ void CPU_RiemannSolver_Exact( const int XYZ, real eival_out[], real L_star_out[]
 
 
 
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Solve_PStar
+// Description :  Solve the pressure in the star region by the Newton-Raphson iteration
+//
+// Note        :  1. Ref : E. F. Toro, "Riemann Solvers and Numerical Methods for Fluid Dynamics", Sec. 4.3 and 9.5
+//                2. The initial guess is chosen adaptively :
+//                   (a) primitive-variable (PVRS) guess if the pressure ratio is small and the PVRS pressure lies
+//                       between the left and right pressures
+//                   (b) two-rarefaction (TRRS) guess if the PVRS pressure is smaller than both pressures
+//                   (c) two-shock (TSRS) guess otherwise
+//                3. The iteration stops once the relative change of pressure is smaller than MAX_ERROR
+//                4. Fall back to the bisection method "Solve_PStar_Bisection" if the iteration does not converge
+//                   within NEWTON_MAX_ITER iterations or if the pressure becomes non-positive or non-finite
+//
+// Parameter   :  L     : Primitive variables in the left region
+//                R     : Primitive variables in the right region
+//                Gamma : Ratio of specific heats
+//
+// Return      :  Pressure in the star region
+//-------------------------------------------------------------------------------------------------------
+real Solve_PStar( const real L[], const real R[], const real Gamma )
+{
+
+   const int  NEWTON_MAX_ITER = 20;          // maximum number of Newton iterations before falling back
+   const real Q_MAX           = (real)2.0;   // maximum pressure ratio for adopting the PVRS guess
+
+   const real Gamma_m1 = Gamma - (real)1.0;
+   const real Gamma_p1 = Gamma + (real)1.0;
+   const real z        = (real)0.5*Gamma_m1/Gamma;
+   const real du       = R[1] - L[1];
+   const real a_L      = SQRT( Gamma*L[4]/L[0] );
+   const real a_R      = SQRT( Gamma*R[4]/R[0] );
+   const real p_min    = FMIN( L[4], R[4] );
+   const real p_max    = FMAX( L[4], R[4] );
+
+   real p, p_old, f_L, f_R, df_L, df_R;
+
+
+// 1. initial guess
+   const real p_pv = FMAX(  (real)0.0, (real)0.5*( L[4] + R[4] ) - (real)0.125*du*( L[0] + R[0] )*( a_L + a_R )  );
+
+   if ( p_max/p_min <= Q_MAX  &&  p_pv >= p_min  &&  p_pv <= p_max )    // PVRS
+      p = p_pv;
+
+   else if ( p_pv < p_min )                                              // TRRS
+      p = POW(  ( a_L + a_R - (real)0.5*Gamma_m1*du ) / ( a_L/POW(L[4],z) + a_R/POW(R[4],z) ), (real)1.0/z  );
+
+   else                                                                  // TSRS
+   {
+      const real g_L = SQRT(  (real)2.0/( Gamma_p1*L[0] ) / ( p_pv + Gamma_m1/Gamma_p1*L[4] )  );
+      const real g_R = SQRT(  (real)2.0/( Gamma_p1*R[0] ) / ( p_pv + Gamma_m1/Gamma_p1*R[4] )  );
+
+      p = ( g_L*L[4] + g_R*R[4] - du ) / ( g_L + g_R );
+   }
+
+
+// 2. Newton-Raphson iteration
+   for (int Iter=0; Iter<NEWTON_MAX_ITER; Iter++)
+   {
+//    the initial guess may be non-positive or non-finite (e.g., TRRS when vacuum is generated)
+      if (  !( p > (real)0.0 )  ||  !( p-p == (real)0.0 )  )    break;
+
+      f_L   = Solve_f( L[0], L[4], p, Gamma, &df_L );
+      f_R   = Solve_f( R[0], R[4], p, Gamma, &df_R );
+
+      p_old = p;
+      p     = p_old - ( f_L + f_R + du )/( df_L + df_R );
+
+      if (  p > (real)0.0  &&  (real)2.0*FABS( p - p_old ) < MAX_ERROR*( p + p_old )  )    return p;
+   }
+
+
+// 3. fall back to the bisection method
+   return Solve_PStar_Bisection( L, R, Gamma );
+
+} // FUNCTION : Solve_PStar
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Solve_PStar_Bisection
+// Description :  Solve the pressure in the star region by the bisection method
+//
+// Note        :  1. Work as the fallback of the Newton-Raphson iteration in "Solve_PStar"
+//                2. The bracket is extended by doubling the upper bound until it encloses the root
+//
+// Parameter   :  L     : Primitive variables in the left region
+//                R     : Primitive variables in the right region
+//                Gamma : Ratio of specific heats
+//
+// Return      :  Pressure in the star region
+//-------------------------------------------------------------------------------------------------------
+real Solve_PStar_Bisection( const real L[], const real R[], const real Gamma )
+{
+
+   const real du = R[1] - L[1];
+
+   real p_star;
+   real f;
+   real f_L;
+   real f_R;
+   real bound[2];
+   real compare[2];
+
+   bound[0] = FMIN( L[4], R[4] );
+   bound[1] = FMAX( L[4], R[4] );
+
+   for (int i=0; i<2; i++)
+       {
+          f_L = Solve_f( L[0], L[4], bound[i], Gamma, NULL );
+          f_R = Solve_f( R[0], R[4], bound[i], Gamma, NULL );
+
+          compare[i] = f_L + f_R + du;
+       }
+
+   if( compare[0]*compare[1] > (real)0.0 )
+   {
+     if( compare[0] > (real)0.0 )
+     {
+        bound[1] = bound[0];
+        bound[0] = (real)0.0;
+     }
+     else if( compare[1] < (real)0.0 )
+     {
+        bool Continue;
+
+        bound[0] = bound[1];
+        bound[1] = (real)2.0*bound[0];
+
+        do
+        {
+           for (int i=0; i<2; i++)
+           {
+              f_L = Solve_f( L[0], L[4], bound[i], Gamma, NULL );
+              f_R = Solve_f( R[0], R[4], bound[i], Gamma, NULL );
+
+              compare[i] = f_L + f_R + du;
+           }
+
+           Continue = ( compare[0]*compare[1] > (real)0.0 );
+
+           if ( Continue )
+           {
+              bound[0] = bound[1];
+              bound[1] = bound[0]*(real)2.0;
+           }
+        }  
+        while ( Continue );
+     }
+   }
+
+// search p_star
+   do
+   {
+      p_star = (real)0.5 * ( bound[0] + bound[1] );
+
+      if (  ( p_star == bound[0] )  ||  ( p_star == bound[1] )  )    break;
+      else
+      {
+         f_L = Solve_f( L[0], L[4], p_star, Gamma, NULL );
+         f_R = Solve_f( R[0], R[4], p_star, Gamma, NULL );
+         f   = f_L + f_R + du;
+
+         if ( f > (real)0.0 )    bound[1] = p_star;
+         else                    bound[0] = p_star;
+      }
+   }
+   while ( FABS(f) >= MAX_ERROR );
+
+   return p_star;
+
+} // FUNCTION : Solve_PStar_Bisection
+
+
+
 //-------------------------------------------------------------------------------------------------------
 // Function    :  Solve_f
 // Description :  Solve the parameter f in Godunov's method
 //
+// Note        :  The derivative df/dp_star is also evaluated if "df != NULL" (for the Newton-Raphson iteration)
+//
 // paremater   :  rho      : Density
 //                p        : Pressure
 //                p_star   : Pressure in star region
 //                Gamma    : Ratio of specific heats
+//                df       : Pointer to store the derivative df/dp_star (NULL --> do not evaluate it)
 //-------------------------------------------------------------------------------------------------------
-real Solve_f( const real rho, const real p, const real p_star, const real Gamma )
+real Solve_f( const real rho, const real p, const real p_star, const real Gamma, real *df )
 {
 
    const real Gamma_m1 = Gamma - (real)1.0;
@@ -282,14 +389,19 @@ real Solve_f( const real rho, const real p, const real p_star, const real Gamma
    {
       real A = (real)2.0/( rho*Gamma_p1 );
       real B = p*Gamma_m1/Gamma_p1;
-      f = (p_star-p)*SQRT( A/( p_star+B) );
+      real C = SQRT( A/( p_star+B) );
+      f = (p_star-p)*C;
+
+      if ( df != NULL )    *df = C*(  (real)1.0 - (real)0.5*(p_star-p)/(p_star+B)  );
    }
 
    else
    {
       real a = SQRT( Gamma*p/rho );
-      real c = p_star/p;
-      f = (real)2.0*a*(  POW( c, (real)0.5*Gamma_m1/Gamma ) - (real)1.0  ) / Gamma_m1;
+      real c = POW( p_star/p, (real)0.5*Gamma_m1/Gamma );
+      f = (real)2.0*a*( c - (real)1.0 ) / Gamma_m1;
+
+      if ( df != NULL )    *df = a*c/( Gamma*p_star );
    }
 
    return f;
@@ -325,4 +437,4 @@ void Set_Flux( real flux[], const real val[], const real Gamma )
 
 
 
-#endif // #if ( !GPU && HYDRO && ( RSOLVER == EXACT || CHECK_INTE == EXACT ) && ( SCHEME == MHM/MHM_RP/CTU/WAF ) )
+#endif // #if ( !GPU && HYDRO && ( RSOLVER == EXACT || CHECK_INTE == EXACT || RUNTIME ) && ( SCHEME == MHM/MHM_RP/CTU/WAF ) )
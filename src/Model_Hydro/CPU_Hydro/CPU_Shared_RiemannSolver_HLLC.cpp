@@ -3,7 +3,7 @@
 #include "CUFLU.h"
 
 #if (  !defined GPU  &&  MODEL == HYDRO  &&  \
-       ( RSOLVER == HLLC || CHECK_INTERMEDIATE == HLLC )  &&  \
+       ( RSOLVER == HLLC || RSOLVER == HYBRID || CHECK_INTERMEDIATE == HLLC || defined RUNTIME_FLU_SCHEME )  &&  \
        ( FLU_SCHEME == MHM || FLU_SCHEME == MHM_RP || FLU_SCHEME == CTU )  )
 
 
@@ -155,4 +155,4 @@ void CPU_RiemannSolver_HLLC( const int XYZ, real Flux_Out[], const real L_In[],
 
 
 
-#endif // #if ( !GPU && HYDRO && ( RSOLVER == HLLC || CHECK_INTER == HLLC ) && ( FLU_SCHEME==MHM/MHM_RP/CTU ) )
+#endif // #if ( !GPU && HYDRO && ( RSOLVER == HLLC || CHECK_INTER == HLLC || RUNTIME ) && ( FLU_SCHEME==MHM/MHM_RP/CTU ) )
@@ -3,7 +3,7 @@
 #include "CUFLU.h"
 
 #if (  !defined GPU  &&  MODEL == HYDRO  &&  \
-       ( RSOLVER == HLLE || CHECK_INTERMEDIATE == HLLE )  &&  \
+       ( RSOLVER == HLLE || RSOLVER == HYBRID || CHECK_INTERMEDIATE == HLLE || defined RUNTIME_FLU_SCHEME )  &&  \
        ( FLU_SCHEME == MHM || FLU_SCHEME == MHM_RP || FLU_SCHEME == CTU )  )
 
 
@@ -123,4 +123,4 @@ void CPU_RiemannSolver_HLLE( const int XYZ, real Flux_Out[], const real L_In[],
 
 
 
-#endif // #if ( !GPU && HYDRO && ( RSOLVER == HLLE || CHECK_INTER == HLLE ) && ( FLU_SCHEME==MHM/MHM_RP/CTU ) )
+#endif // #if ( !GPU && HYDRO && ( RSOLVER == HLLE || CHECK_INTER == HLLE || RUNTIME ) && ( FLU_SCHEME==MHM/MHM_RP/CTU ) )
@@ -0,0 +1,121 @@
+
+#include "DAINO.h"
+#include "CUFLU.h"
+
+#if (  !defined GPU  &&  MODEL == HYDRO  &&  ( RSOLVER == HYBRID || defined RUNTIME_FLU_SCHEME )  &&  \
+       ( FLU_SCHEME == MHM || FLU_SCHEME == MHM_RP || FLU_SCHEME == CTU )  )
+
+
+
+extern void CPU_Con2Pri( const real In[], real Out[], const real  Gamma_m1 );
+extern void CPU_RiemannSolver_Exact( const int XYZ, real eival_out[], real L_star_out[], real R_star_out[],
+                                     real Flux_Out[], const real L_In[], const real R_In[], const real Gamma );
+extern void CPU_RiemannSolver_HLLE( const int XYZ, real Flux_Out[], const real L_In[], const real R_In[],
+                                    const real Gamma );
+extern void CPU_RiemannSolver_HLLC( const int XYZ, real Flux_Out[], const real L_In[], const real R_In[],
+                                    const real Gamma );
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  CPU_RiemannSolver_Hybrid
+// Description :  Select the Riemann solver interface by interface according to a cheap shock/contact sensor
+//
+// Note        :  1. The input data should be conserved variables
+//                2. The sensor is evaluated from the relative jumps of pressure and density and the
+//                   compression of the normal velocity (in units of the smaller sound speed)
+//                   --> all jumps               <  HYBRID_SMOOTH_JUMP : HLLE  (smooth flow)
+//                       pressure or compression >= HYBRID_SHOCK_JUMP  : exact (strong shock)
+//                       otherwise                                     : HLLC  (contact or weak shock)
+//                   --> The thresholds are defined in the header "CUFLU.h"
+//                3. The exact solver is never applied to states with non-positive density/pressure (--> HLLE)
+//                   or states which would generate vacuum (--> HLLC) since the vacuum solution has not been
+//                   implemented
+//                4. The number of interfaces evaluated by each solver is accumulated in "Counter"
+//                   --> Counter[0/1/2] : HLLE/HLLC/exact
+//                5. This function is shared by MHM, MHM_RP, and CTU schemes
+//
+// Parameter   :  XYZ      : Targeted spatial direction : (0/1/2) --> (x/y/z)
+//                Flux_Out : Array to store the output flux
+//                L_In     : Input left  state (conserved variables)
+//                R_In     : Input right state (conserved variables)
+//                Gamma    : Ratio of specific heats
+//                Counter  : Number of interfaces evaluated by each Riemann solver
+//-------------------------------------------------------------------------------------------------------
+void CPU_RiemannSolver_Hybrid( const int XYZ, real Flux_Out[], const real L_In[], const real R_In[],
+                               const real Gamma, long Counter[] )
+{
+
+   const real Gamma_m1 = Gamma - (real)1.0;
+   const real _RhoL    = (real)1.0 / L_In[0];
+   const real _RhoR    = (real)1.0 / R_In[0];
+   const real P_L      = Gamma_m1*(  L_In[4] - (real)0.5*( L_In[1]*L_In[1] + L_In[2]*L_In[2] +
+                                                           L_In[3]*L_In[3] )*_RhoL  );
+   const real P_R      = Gamma_m1*(  R_In[4] - (real)0.5*( R_In[1]*R_In[1] + R_In[2]*R_In[2] +
+                                                           R_In[3]*R_In[3] )*_RhoR  );
+
+
+// 1. states with non-positive density or pressure --> HLLE
+   if ( L_In[0] <= (real)0.0  ||  R_In[0] <= (real)0.0  ||  P_L <= (real)0.0  ||  P_R <= (real)0.0 )
+   {
+      CPU_RiemannSolver_HLLE( XYZ, Flux_Out, L_In, R_In, Gamma );
+      Counter[0] ++;
+
+      return;
+   }
+
+
+// 2. evaluate the shock/contact sensor
+// --> all comparisons are done without division and square root so that the smooth path remains cheap
+   const real dVel       = R_In[1+XYZ]*_RhoR - L_In[1+XYZ]*_RhoL;
+   const real dPres      = FABS( P_R - P_L );
+   const real dDens      = FABS( R_In[0] - L_In[0] );
+   const real MinPres    = FMIN( P_L, P_R );
+   const real MinDens    = FMIN( L_In[0], R_In[0] );
+   const real MinCs2     = Gamma*FMIN( P_L*_RhoL, P_R*_RhoR );
+   const real Compress2  = ( dVel < (real)0.0 ) ? dVel*dVel : (real)0.0;
+   const real SmoothJump = (real)HYBRID_SMOOTH_JUMP;
+   const real ShockJump  = (real)HYBRID_SHOCK_JUMP;
+
+
+// 3. invoke the selected Riemann solver
+// 3-1. smooth flow --> HLLE
+   if ( dPres < SmoothJump*MinPres  &&  dDens < SmoothJump*MinDens  &&
+        Compress2 < SmoothJump*SmoothJump*MinCs2 )
+   {
+      CPU_RiemannSolver_HLLE( XYZ, Flux_Out, L_In, R_In, Gamma );
+      Counter[0] ++;
+
+      return;
+   }
+
+// 3-2. strong shock --> exact (provided that no vacuum is generated)
+   if ( dPres >= ShockJump*MinPres  ||  Compress2 >= ShockJump*ShockJump*MinCs2 )
+   {
+      real PriVar_L[5], PriVar_R[5];
+
+      CPU_Con2Pri( L_In, PriVar_L, Gamma_m1 );
+      CPU_Con2Pri( R_In, PriVar_R, Gamma_m1 );
+
+      const real Cs_L = SQRT( Gamma*PriVar_L[4]/PriVar_L[0] );
+      const real Cs_R = SQRT( Gamma*PriVar_R[4]/PriVar_R[0] );
+
+      if ( dVel < (real)2.0*( Cs_L + Cs_R )/Gamma_m1 )
+      {
+         CPU_RiemannSolver_Exact( XYZ, NULL, NULL, NULL, Flux_Out, PriVar_L, PriVar_R, Gamma );
+         Counter[2] ++;
+
+         return;
+      }
+   }
+
+// 3-3. contact discontinuity, weak shock, or strong rarefaction --> HLLC
+   CPU_RiemannSolver_HLLC( XYZ, Flux_Out, L_In, R_In, Gamma );
+   Counter[1] ++;
+
+} // FUNCTION : CPU_RiemannSolver_Hybrid
+
+
+
+#endif // #if ( !GPU && HYDRO && ( RSOLVER == HYBRID || RUNTIME ) && ( FLU_SCHEME==MHM/MHM_RP/CTU ) )
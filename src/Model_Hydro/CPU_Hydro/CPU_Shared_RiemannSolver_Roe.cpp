@@ -2,8 +2,8 @@
 #include "DAINO.h"
 #include "CUFLU.h"
 
-#if (  !defined GPU  &&  MODEL == HYDRO  &&  \
-       ( RSOLVER == ROE )  &&  ( FLU_SCHEME == MHM || FLU_SCHEME == MHM_RP || FLU_SCHEME == CTU )  )
+#if (  !defined GPU  &&  MODEL == HYDRO  &&  ( RSOLVER == ROE || defined RUNTIME_FLU_SCHEME )  &&  \
+       ( FLU_SCHEME == MHM || FLU_SCHEME == MHM_RP || FLU_SCHEME == CTU )  )
 
 
 
@@ -206,4 +206,4 @@ void CPU_RiemannSolver_Roe( const int XYZ, real Flux_Out[], const real L_In[], c
 
 
 
-#endif // #if (  !defined GPU  &&  MODEL == HYDRO  &&  ( RSOLVER == ROE )  &&  ( FLU_SCHEME == MHM/MHM_RP/CTU )  )
+#endif // #if ( !GPU && HYDRO && ( RSOLVER == ROE || RUNTIME ) && ( FLU_SCHEME == MHM/MHM_RP/CTU ) )
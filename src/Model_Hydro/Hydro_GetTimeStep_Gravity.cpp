@@ -10,8 +10,15 @@
 // Function    :  Hydro_GetTimeStep_Gravity
 // Description :  Estimate the evolution time-step and physical time interval by gravity
 //
-// Note        :  Physical coordinates : dTime == dt
-//                Comoving coordinates : dTime == dt*(Hubble parameter)*(scale factor)^3 == delta(scale factor)
+// Note        :  1. Physical coordinates : dTime == dt
+//                   Comoving coordinates : dTime == dt*(Hubble parameter)*(scale factor)^3 == delta(scale factor)
+//                2. For the CPU solvers, the maximum gravitational acceleration at each level is recorded by
+//                   "CPU_HydroGravitySolver" as a by-product since the last invocation of this function
+//                   --> "MinDtInfo_Gravity" is reset to __FLT_MIN__ after use
+//                   --> "Refine" also resets it to __FLT_MIN__ whenever new patches are created at that level
+//                   --> "Hydro_GetMaxAcc" is invoked during the initialization and for any level still holding
+//                       __FLT_MIN__ (i.e., not updated by the gravity solver since the last time-step estimation
+//                       or since new patches were created at that level)
 // 
 // Parameter   :  dt       : Time interval to advance solution
 //                dTime    : Time interval to update physical time 
@@ -30,7 +37,16 @@ void Hydro_GetTimeStep_Gravity( double &dt, double &dTime, int &MinDtLv, real &M
 
 
 // get the maximum gravitational acceleration
-   if ( !OPT__ADAPTIVE_DT )   Hydro_GetMaxAcc( MaxAcc );
+#  ifdef GPU
+   if ( !OPT__ADAPTIVE_DT )
+      for (int lv=0; lv<NLEVEL; lv++)  Hydro_GetMaxAcc( lv, MaxAcc );
+
+// evaluate the levels not recorded by the CPU gravity solver since the last invocation of this function or since
+// new patches were created by regrid, so that the gravity constraint is never skipped
+#  else
+   for (int lv=0; lv<NLEVEL; lv++)
+      if ( MaxAcc[lv] == __FLT_MIN__  &&  patch->NPatchComma[lv][1] > 0 )  Hydro_GetMaxAcc( lv, MaxAcc );
+#  endif
 
 
 // get the time-step in one rank
@@ -54,6 +70,12 @@ void Hydro_GetTimeStep_Gravity( double &dt, double &dTime, int &MinDtLv, real &M
    }
 
 
+// reset the maximum gravitational acceleration to be recorded by the CPU gravity solver in the next step
+#  ifndef GPU
+   for (int lv=0; lv<NLEVEL; lv++)  MaxAcc[lv] = __FLT_MIN__;
+#  endif
+
+
 // get the minimum time-step from all ranks
    MPI_Allreduce( &dt_local, &dt_min, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD );
 
@@ -108,13 +130,19 @@ void Hydro_GetTimeStep_Gravity( double &dt, double &dTime, int &MinDtLv, real &M
 
 //-------------------------------------------------------------------------------------------------------
 // Function    :  Hydro_GetMaxAcc
-// Description :  Evaluate the maximum gravitational acceleration for the time-step estimation
+// Description :  Evaluate the maximum gravitational acceleration at the targeted level for the time-step
+//                estimation
 //
-// Note        :  This function is also invoked in "Init_DAINO"
+// Note        :  1. This function is also invoked in "Init_DAINO"
+//                2. For the CPU solvers, this function is invoked after the initialization only for levels
+//                   which have not been updated by the gravity solver since the last time-step estimation
+//                   (e.g., levels newly created by the last regrid)
 // 
-// Parameter   :  MaxAcc   : Array to store the maximum gravitational acceleration at each level
+// Parameter   :  lv       : Targeted refinement level
+//                MaxAcc   : Array to store the maximum gravitational acceleration at each level
+//                           --> only MaxAcc[lv] is updated
 //-------------------------------------------------------------------------------------------------------
-void Hydro_GetMaxAcc( real MaxAcc[] )
+void Hydro_GetMaxAcc( const int lv, real MaxAcc[] )
 {
 
    const bool IntPhase_No = false;
@@ -132,92 +160,88 @@ void Hydro_GetMaxAcc( real MaxAcc[] )
    int  TID = 0;  // thread ID
 
 
-// loop over all levels   
-   for (int lv=0; lv<NLEVEL; lv++)
-   {
-//    initialize the arrays MaxAcc and MaxAcc_OMP as an extremely small number
-      MaxAcc[lv] = __FLT_MIN__;
-      for (int t=0; t<NT; t++)   MaxAcc_OMP[t] = __FLT_MIN__;
+// initialize the arrays MaxAcc and MaxAcc_OMP as an extremely small number
+   MaxAcc[lv] = __FLT_MIN__;
+   for (int t=0; t<NT; t++)   MaxAcc_OMP[t] = __FLT_MIN__;
 
-//    set the constant coefficient
-      if ( OPT__GRA_P5_GRADIENT )   Coeff = 1.0/(12.0*patch->dh[lv]);
-      else                          Coeff = 1.0/( 2.0*patch->dh[lv]);
+// set the constant coefficient
+   if ( OPT__GRA_P5_GRADIENT )   Coeff = 1.0/(12.0*patch->dh[lv]);
+   else                          Coeff = 1.0/( 2.0*patch->dh[lv]);
 
 #ifndef OOC
 
-#     pragma omp parallel private( Acc_Array, Acc, TID )
-      {
-         Acc_Array = new real [NP][GRA_NXT][GRA_NXT][GRA_NXT];
+#  pragma omp parallel private( Acc_Array, Acc, TID )
+   {
+      Acc_Array = new real [NP][GRA_NXT][GRA_NXT][GRA_NXT];
 
-#        ifdef OPENMP
-         TID = omp_get_thread_num();
-#        endif
+#     ifdef OPENMP
+      TID = omp_get_thread_num();
+#     endif
 
-//       loop over all patches
-#        pragma omp for
-         for (int PID0=0; PID0<patch->NPatchComma[lv][1]; PID0+=NP)
-         {
-//          prepare the potential data with ghost zone
-            Prepare_PatchGroupData( lv, Time[lv], &Acc_Array[0][0][0][0], GRA_GHOST_SIZE, NPG, &PID0, _POTE,
-                                    OPT__GRA_INT_SCHEME, UNIT_PATCH, NSIDE_06, IntPhase_No );
+//    loop over all patches
+#     pragma omp for
+      for (int PID0=0; PID0<patch->NPatchComma[lv][1]; PID0+=NP)
+      {
+//       prepare the potential data with ghost zone
+         Prepare_PatchGroupData( lv, Time[lv], &Acc_Array[0][0][0][0], GRA_GHOST_SIZE, NPG, &PID0, _POTE,
+                                 OPT__GRA_INT_SCHEME, UNIT_PATCH, NSIDE_06, IntPhase_No );
 
 
-//          loop over eight patches within the same patch group
-            for (int ID=0; ID<NP; ID++)
+//       loop over eight patches within the same patch group
+         for (int ID=0; ID<NP; ID++)
+         {
+            for (int k=GRA_GHOST_SIZE; k<GRA_NXT-GRA_GHOST_SIZE; k++)
+            for (int j=GRA_GHOST_SIZE; j<GRA_NXT-GRA_GHOST_SIZE; j++)
+            for (int i=GRA_GHOST_SIZE; i<GRA_NXT-GRA_GHOST_SIZE; i++)
             {
-               for (int k=GRA_GHOST_SIZE; k<GRA_NXT-GRA_GHOST_SIZE; k++)
-               for (int j=GRA_GHOST_SIZE; j<GRA_NXT-GRA_GHOST_SIZE; j++)
-               for (int i=GRA_GHOST_SIZE; i<GRA_NXT-GRA_GHOST_SIZE; i++)
+//             evaluate the gravitational acceleration
+               if ( OPT__GRA_P5_GRADIENT )
                {
-//                evaluate the gravitational acceleration
-                  if ( OPT__GRA_P5_GRADIENT )
-                  {
-                     Acc[0] = Coeff * ( -     Acc_Array[ID][k  ][j  ][i+2] +     Acc_Array[ID][k  ][j  ][i-2]
-                                        + 8.0*Acc_Array[ID][k  ][j  ][i+1] - 8.0*Acc_Array[ID][k  ][j  ][i-1] );
-                     Acc[1] = Coeff * ( -     Acc_Array[ID][k  ][j+2][i  ] +     Acc_Array[ID][k  ][j-2][i  ]
-                                        + 8.0*Acc_Array[ID][k  ][j+1][i  ] - 8.0*Acc_Array[ID][k  ][j-1][i  ] );
-                     Acc[2] = Coeff * ( -     Acc_Array[ID][k+2][j  ][i  ] +     Acc_Array[ID][k-2][j  ][i  ]
-                                        + 8.0*Acc_Array[ID][k+1][j  ][i  ] - 8.0*Acc_Array[ID][k-1][j  ][i  ] );
-                  }
-
-                  else
-                  {
-                     Acc[0] = Coeff * ( Acc_Array[ID][k  ][j  ][i+1] - Acc_Array[ID][k  ][j  ][i-1] );
-                     Acc[1] = Coeff * ( Acc_Array[ID][k  ][j+1][i  ] - Acc_Array[ID][k  ][j-1][i  ] );
-                     Acc[2] = Coeff * ( Acc_Array[ID][k+1][j  ][i  ] - Acc_Array[ID][k-1][j  ][i  ] );
-                  }
+                  Acc[0] = Coeff * ( -     Acc_Array[ID][k  ][j  ][i+2] +     Acc_Array[ID][k  ][j  ][i-2]
+                                     + 8.0*Acc_Array[ID][k  ][j  ][i+1] - 8.0*Acc_Array[ID][k  ][j  ][i-1] );
+                  Acc[1] = Coeff * ( -     Acc_Array[ID][k  ][j+2][i  ] +     Acc_Array[ID][k  ][j-2][i  ]
+                                     + 8.0*Acc_Array[ID][k  ][j+1][i  ] - 8.0*Acc_Array[ID][k  ][j-1][i  ] );
+                  Acc[2] = Coeff * ( -     Acc_Array[ID][k+2][j  ][i  ] +     Acc_Array[ID][k-2][j  ][i  ]
+                                     + 8.0*Acc_Array[ID][k+1][j  ][i  ] - 8.0*Acc_Array[ID][k-1][j  ][i  ] );
+               }
+
+               else
+               {
+                  Acc[0] = Coeff * ( Acc_Array[ID][k  ][j  ][i+1] - Acc_Array[ID][k  ][j  ][i-1] );
+                  Acc[1] = Coeff * ( Acc_Array[ID][k  ][j+1][i  ] - Acc_Array[ID][k  ][j-1][i  ] );
+                  Acc[2] = Coeff * ( Acc_Array[ID][k+1][j  ][i  ] - Acc_Array[ID][k-1][j  ][i  ] );
+               }
 
 
-//                record the maximum acceleration
-                  for (int d=0; d<3; d++)
-                  {
-                     Acc[d]          = fabs( Acc[d] );
-                     MaxAcc_OMP[TID] = ( Acc[d] > MaxAcc_OMP[TID] ) ? Acc[d] : MaxAcc_OMP[TID];
-                  }
+//             record the maximum acceleration
+               for (int d=0; d<3; d++)
+               {
+                  Acc[d]          = fabs( Acc[d] );
+                  MaxAcc_OMP[TID] = ( Acc[d] > MaxAcc_OMP[TID] ) ? Acc[d] : MaxAcc_OMP[TID];
+               }
 
-               } // i,j,k
-            } // for (int ID=0; ID<NP; ID++)
-         } // for (int PID0=0; PID0<patch->NPatchComma[lv][1]; PID0+=NP)
+            } // i,j,k
+         } // for (int ID=0; ID<NP; ID++)
+      } // for (int PID0=0; PID0<patch->NPatchComma[lv][1]; PID0+=NP)
 
-         delete [] Acc_Array;
+      delete [] Acc_Array;
 
-      } // OpenMP parallel region
+   } // OpenMP parallel region
 
 
-//    compare the maximum acceleration evaluated by different OMP threads
-      for (int t=0; t<NT; t++)   MaxAcc[lv] = ( MaxAcc_OMP[t] > MaxAcc[lv] ) ? MaxAcc_OMP[t] : MaxAcc[lv];
+// compare the maximum acceleration evaluated by different OMP threads
+   for (int t=0; t<NT; t++)   MaxAcc[lv] = ( MaxAcc_OMP[t] > MaxAcc[lv] ) ? MaxAcc_OMP[t] : MaxAcc[lv];
 
 
 #else // OOC
 
-      Acc_Array = new real [NP][GRA_NXT][GRA_NXT][GRA_NXT];
+   Acc_Array = new real [NP][GRA_NXT][GRA_NXT][GRA_NXT];
 
-      OOC_Mis_GetMaxAcc( lv, Coeff, Acc_Array, MaxAcc );
+   OOC_Mis_GetMaxAcc( lv, Coeff, Acc_Array, MaxAcc );
 
-      delete [] Acc_Array;
+   delete [] Acc_Array;
 
 #endif
-   } // for (int lv=0; lv<NLEVEL; lv++)
 
 
    delete [] MaxAcc_OMP;
@@ -0,0 +1,61 @@
+#include "DAINO.h"
+
+#if ( MODEL == HYDRO  &&  ( RSOLVER == HYBRID || defined RUNTIME_FLU_SCHEME ) )
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Hydro_Record_RSolverHybrid
+// Description :  Record the number of cell interfaces evaluated by each Riemann solver in the hybrid
+//                Riemann solver
+//
+// Note        :  1. Do nothing if the hybrid Riemann solver is not adopted at any level
+//                2. The counters "RSolver_HybridCounter" are accumulated by all OpenMP threads in
+//                   "CPU_ComputeFlux" and "CPU_RiemannPredict_Flux" and are summed over all ranks here
+//                3. The results are appended to the file "Record__Note"
+//-------------------------------------------------------------------------------------------------------
+void Hydro_Record_RSolverHybrid()
+{
+
+   const char *SolverName[3] = { "HLLE", "HLLC", "Exact" };
+
+   long int Counter_AllRank[3] = { 0, 0, 0 }, Counter_Sum = 0;
+   bool     HybridInUse        = false;
+
+#  ifdef RUNTIME_FLU_SCHEME
+   for (int lv=0; lv<NLEVEL; lv++)
+      if ( FluSchemeTable_RSolver[lv] == HYBRID )  HybridInUse = true;
+#  else
+   HybridInUse = true;     // RSOLVER == HYBRID
+#  endif
+
+   if ( !HybridInUse )  return;
+
+   MPI_Reduce( RSolver_HybridCounter, Counter_AllRank, 3, MPI_LONG, MPI_SUM, 0, MPI_COMM_WORLD );
+
+
+   if ( MPI_Rank == 0 )
+   {
+      for (int t=0; t<3; t++)    Counter_Sum += Counter_AllRank[t];
+
+      FILE *Note = fopen( "Record__Note", "a" );
+      fprintf( Note, "Hybrid Riemann Solver\n" );
+      fprintf( Note, "***********************************************************************************\n" );
+      fprintf( Note, "%8s%22s%14s\n", "Solver", "NInterface", "Fraction" );
+
+      for (int t=0; t<3; t++)
+      fprintf( Note, "%8s%22ld%14.6f\n", SolverName[t], Counter_AllRank[t],
+               ( Counter_Sum > 0 ) ? (double)Counter_AllRank[t]/Counter_Sum : 0.0 );
+
+      fprintf( Note, "%8s%22ld\n", "Total", Counter_Sum );
+      fprintf( Note, "***********************************************************************************\n" );
+      fprintf( Note, "\n\n" );
+      fclose( Note );
+   }
+
+} // FUNCTION : Hydro_Record_RSolverHybrid
+
+
+
+#endif // #if ( MODEL == HYDRO  &&  ( RSOLVER == HYBRID || defined RUNTIME_FLU_SCHEME ) )
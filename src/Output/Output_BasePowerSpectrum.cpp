@@ -12,7 +12,11 @@
 //#define DIMENSIONLESS_FORM
 
 
+static void ComputeBasePowerSpectrum( real *PS_total );
 extern void GetBasePowerSpectrum( real *RhoK, const int j_start, const int dj, const int RhoK_Size, real *PS_total );
+static void BinBasePowerSpectrum( const real *RhoK, const int j_start, const int dj, real *PS_local,
+                                  long *Count_local );
+static void SumBasePowerSpectrum( const real *PS_local, const long *Count_local, real *PS_total );
 
 #ifdef SERIAL
 extern rfftwnd_plan     FFTW_Plan, FFTW_Plan_Inv;
@@ -21,12 +25,24 @@ extern rfftwnd_mpi_plan FFTW_Plan, FFTW_Plan_Inv;
 #endif
 
 
+// local power spectrum binned from the k-space density of the latest base-level Poisson solve
+static real   *BasePS_Local = NULL;
+static long   *BasePS_Count = NULL;
+static double  BasePS_Time  = -__DBL_MAX__;   // physical time of the binned density
+static bool    BasePS_Final = false;          // true --> the density is not modified afterwards by Flu_FixUp
+
+
 
 
 //-------------------------------------------------------------------------------------------------------
 // Function    :  Output_BasePowerSpectrum 
 // Description :  Evaluate and output the base-level power spectrum by FFT 
 //
+// Note        :  The spectrum binned by the base-level Poisson solver is adopted directly if it was evaluated
+//                at the current time and the base-level density has not been corrected by any finer level
+//                since then (see "StoreBasePowerSpectrum")
+//                --> Otherwise the spectrum is re-evaluated by an extra forward FFT
+//
 // Parameter   :  FileName : Name of the output file 
 //-------------------------------------------------------------------------------------------------------
 void Output_BasePowerSpectrum( const char *FileName )
@@ -35,14 +51,224 @@ void Output_BasePowerSpectrum( const char *FileName )
    if ( MPI_Rank == 0 )    Aux_Message( stdout, "%s (DumpID = %d) ...\n", __FUNCTION__, DumpID );
 
 
-// 1. get the array indices using by FFTW
    const int Nx_Padded = NX0_TOT[0]/2+1;
+   real *PS_total = ( MPI_Rank == 0 ) ? new real [Nx_Padded] : NULL;
+
+
+// 1. evaluate the power spectrum (all ranks must take the same branch)
+   if (  BasePS_Final  &&  Mis_Check_Synchronization( Time[0], BasePS_Time, NULL, false )  )
+      SumBasePowerSpectrum( BasePS_Local, BasePS_Count, PS_total );
+   else
+      ComputeBasePowerSpectrum( PS_total );
+
+
+// 2. output the power spectrum
+   if ( MPI_Rank == 0 )
+   {
+//    check if the targeted file already exists
+      FILE *File_Check = fopen( FileName, "r" );
+      if ( File_Check != NULL )
+      {
+         Aux_Message( stderr, "WARNING : the file \"%s\" already exists and will be overwritten !!\n", FileName );
+         fclose( File_Check );
+      }
+
+
+//    output the power spectrum
+      const real WaveK0 = 2.0*M_PI/patch->BoxSize[0];
+      FILE *File = fopen( FileName, "w" );
+
+      fprintf( File, "%13s%4s%13s\n", "k", "", "Power" );
+
+      for (int b=0; b<Nx_Padded; b++)     fprintf( File, "%13.6e%4s%13.6e\n", WaveK0*b, "", PS_total[b] );
+
+      fclose( File );
+
+      delete [] PS_total; 
+   } // if ( MPI_Rank == 0 )
+
+
+   if ( MPI_Rank == 0 )    Aux_Message( stdout, "%s (DumpID = %d) ... done\n", __FUNCTION__, DumpID );
+
+} // FUNCTION : Output_BasePowerSpectrum
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Output_RecordBasePowerSpectrum
+// Description :  Record the base-level power spectrum in-situ
+//
+// Note        :  1. Invoked every OPT__RECORD_BASEPS step
+//                2. The spectrum binned by the base-level Poisson solver of the current step is adopted
+//                   whenever it is available, in which case no extra FFT is required
+//                   --> If the base level is refined, it corresponds to the base-level density before being
+//                       corrected by the finer levels
+//                3. The results are appended to the file "Record__BasePowerSpectrum"
+//-------------------------------------------------------------------------------------------------------
+void Output_RecordBasePowerSpectrum()
+{
+
+   const char FileName[] = "Record__BasePowerSpectrum";
+   static bool FirstTime = true;
+
+   if ( MPI_Rank == 0  &&  FirstTime )
+   {
+      FILE *File_Check = fopen( FileName, "r" );
+      if ( File_Check != NULL )  
+      {
+         Aux_Message( stderr, "WARNING : the file \"%s\" already exists !!\n", FileName );
+         fclose( File_Check );
+      }
+      FirstTime = false;
+   }
+
+
+   const int Nx_Padded = NX0_TOT[0]/2+1;
+   real *PS_total = ( MPI_Rank == 0 ) ? new real [Nx_Padded] : NULL;
+
+   if (  Mis_Check_Synchronization( Time[0], BasePS_Time, NULL, false )  )
+      SumBasePowerSpectrum( BasePS_Local, BasePS_Count, PS_total );
+   else
+      ComputeBasePowerSpectrum( PS_total );
+
+
+   if ( MPI_Rank == 0 )
+   {
+      const real WaveK0 = 2.0*M_PI/patch->BoxSize[0];
+      FILE *File = fopen( FileName, "a" );
+
+      fprintf( File, "# Time = %13.7e, Step = %7ld\n", Time[0], Step );
+      fprintf( File, "%13s%4s%13s\n", "k", "", "Power" );
+
+      for (int b=0; b<Nx_Padded; b++)     fprintf( File, "%13.6e%4s%13.6e\n", WaveK0*b, "", PS_total[b] );
+
+      fprintf( File, "\n\n" );
+      fclose( File );
+
+      delete [] PS_total;
+   }
+
+} // FUNCTION : Output_RecordBasePowerSpectrum
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  StoreBasePowerSpectrum
+// Description :  Bin the k-space density of the base-level Poisson solver into the local power spectrum
+//                so that the base-level power spectrum can be output without an extra FFT
+//
+// Note        :  1. Invoked by the base-level Poisson solver "CPU_PoissonSolver_FFT" right after the forward FFT
+//                   if either OPT__OUTPUT_BASEPS or OPT__RECORD_BASEPS is on
+//                2. The spectrum is binned only if it will be adopted by the next call to either
+//                   "Output_BasePowerSpectrum" or "Output_RecordBasePowerSpectrum"
+//                   --> Output_BasePowerSpectrum : a data dump is scheduled at "PrepTime" and there are no
+//                                                  patches above the base level, in which case the base-level
+//                                                  density will not be corrected by Flu_FixUp before the dump
+//                       Output_RecordBasePowerSpectrum : a record is scheduled at the same step
+//                   --> The first invocation (from Init_DAINO) always bins the spectrum since the initial
+//                       dump time has not been set yet
+//                   --> Dumps triggered at runtime by the file "DUMP_DAINO_DUMP" cannot be predicted, for
+//                       which the spectrum is re-evaluated by an extra FFT
+//                3. The solver is invoked before "Time[0]" and "Step" are updated in the main loop, but after
+//                   that when invoked from Init_DAINO or in the debug mode
+//                   --> In the main loop, only the solver invoked in the last sub-step of the individual
+//                       time-step scheme can provide the spectrum for output
+//
+// Parameter   :  RhoK     : Array storing the k-space density
+//                j_start  : Starting j index
+//                dj       : Size of array in the j (y) direction after the forward FFT
+//                PrepTime : Physical time of the input density
+//-------------------------------------------------------------------------------------------------------
+void StoreBasePowerSpectrum( const real *RhoK, const int j_start, const int dj, const double PrepTime )
+{
+
+   static bool FirstTime = true;
+
+   const bool InMainLoop = ( PrepTime != Time[0] );
+   const long OutStep    = ( InMainLoop ) ? Step+1 : Step;
+   bool       Refined    = false;
+   bool       DumpDue    = false;
+   bool       RecordDue;
+
+   for (int lv=1; lv<NLEVEL; lv++)
+      if ( NPatchTotal[lv] != 0 )   Refined = true;
+
+
+// 1. check whether or not the binned spectrum will be adopted (all ranks must reach the same decision)
+// 1-1. the density of the first sub-step of the individual time-step scheme is never output
+//      --> AdvanceCounter[0] is even at the beginning of each main step and is updated after the solver
+#  ifdef INDIVIDUAL_TIMESTEP
+   const bool LastSubStep = ( !InMainLoop  ||  AdvanceCounter[0]%2 == 1 );
+#  else
+   const bool LastSubStep = true;
+#  endif
+
+// 1-2. data dump and in-situ record
+   if ( OPT__OUTPUT_BASEPS  &&  !Refined  &&  LastSubStep )
+   {
+      switch ( OPT__OUTPUT_MODE )
+      {
+         case OUTPUT_CONST_STEP :   DumpDue = ( OutStep%OUTPUT_STEP == 0 );
+                                    break;
+
+         case OUTPUT_CONST_DT :
+         case OUTPUT_USE_TABLE :    DumpDue = (  ( PrepTime != 0.0 && fabs( (PrepTime-DumpTime)/PrepTime ) < 1.0e-8  )
+                                              || ( PrepTime == 0.0 && fabs(  PrepTime-DumpTime           ) < 1.0e-12 )  );
+                                    break;
+      }
+
+//    the final dump at the end of the simulation
+      if ( PrepTime-END_T >= -1.e-10  ||  OutStep >= END_STEP )   DumpDue = true;
+   }
+
+   RecordDue = ( OPT__RECORD_BASEPS > 0  &&  LastSubStep  &&  OutStep%OPT__RECORD_BASEPS == 0 );
+
+   if ( !FirstTime  &&  !DumpDue  &&  !RecordDue )
+   {
+//    invalidate the previously binned spectrum since the base-level density has been updated
+      BasePS_Time = -__DBL_MAX__;
+      return;
+   }
+
+   FirstTime = false;
+
+
+// 2. bin the spectrum
+   const int Nx_Padded = NX0_TOT[0]/2 + 1;
+
+   if ( BasePS_Local == NULL )
+   {
+      BasePS_Local = new real [Nx_Padded];
+      BasePS_Count = new long [Nx_Padded];
+   }
+
+   BinBasePowerSpectrum( RhoK, j_start, dj, BasePS_Local, BasePS_Count );
+
+   BasePS_Time  = PrepTime;
+   BasePS_Final = !Refined;
+
+} // FUNCTION : StoreBasePowerSpectrum
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  ComputeBasePowerSpectrum
+// Description :  Evaluate the base-level power spectrum from the current base-level density by an extra FFT 
+//
+// Parameter   :  PS_total : Power spectrum summed over all MPI ranks (only useful in the root rank)
+//
+// Return      :  PS_total
+//-------------------------------------------------------------------------------------------------------
+void ComputeBasePowerSpectrum( real *PS_total )
+{
+
+// 1. get the array indices using by FFTW
    int local_nz, local_z_start, local_ny_after_transpose, local_y_start_after_transpose, total_local_size;
 
 #  ifdef SERIAL
    local_ny_after_transpose      = NULL_INT;
    local_y_start_after_transpose = NULL_INT;
-   total_local_size              = 2*Nx_Padded*NX0_TOT[1]*NX0_TOT[2];
+   total_local_size              = 2*(NX0_TOT[0]/2+1)*NX0_TOT[1]*NX0_TOT[2];
 #  else
    rfftwnd_mpi_local_sizes( FFTW_Plan, &local_nz, &local_z_start, &local_ny_after_transpose,
                             &local_y_start_after_transpose, &total_local_size);
@@ -50,7 +276,6 @@ void Output_BasePowerSpectrum( const char *FileName )
 
 
 // 2. allocate memory
-   real *PS_total = NULL;
    real *RhoK     = new real [ total_local_size ];
    real *SendBuf  = new real [ patch->NPatchComma[0][1]*PS1*PS1*PS1 ];
 #  ifdef SERIAL
@@ -79,8 +304,6 @@ void Output_BasePowerSpectrum( const char *FileName )
                  MPI_NRank, List_z_start[MPI_NRank],  NX0_TOT[2] );
 #  endif // #ifdef LOAD_BALANCE
 
-   if ( MPI_Rank == 0 )    PS_total = new real [Nx_Padded];
-
 
 // 3. rearrange data from cube to slice (or space-filling curve decomposition if load-balance is enabled)
 #  ifdef LOAD_BALANCE 
@@ -95,31 +318,7 @@ void Output_BasePowerSpectrum( const char *FileName )
    GetBasePowerSpectrum( RhoK, local_y_start_after_transpose, local_ny_after_transpose, total_local_size, PS_total );
 
 
-// 5. output the power spectrum
-   if ( MPI_Rank == 0 )
-   {
-//    check if the targeted file already exists
-      FILE *File_Check = fopen( FileName, "r" );
-      if ( File_Check != NULL )
-      {
-         Aux_Message( stderr, "WARNING : the file \"%s\" already exists and will be overwritten !!\n", FileName );
-         fclose( File_Check );
-      }
-
-
-//    output the power spectrum
-      const real WaveK0 = 2.0*M_PI/patch->BoxSize[0];
-      FILE *File = fopen( FileName, "w" );
-
-      fprintf( File, "%13s%4s%13s\n", "k", "", "Power" );
-
-      for (int b=0; b<Nx_Padded; b++)     fprintf( File, "%13.6e%4s%13.6e\n", WaveK0*b, "", PS_total[b] );
-
-      fclose( File );
-   } // if ( MPI_Rank == 0 )
-
-
-// 6. free memory
+// 5. free memory
    delete [] RhoK;
    delete [] SendBuf;
 #  ifndef SERIAL
@@ -129,12 +328,8 @@ void Output_BasePowerSpectrum( const char *FileName )
    delete [] SendBuf_SIdx;
    delete [] RecvBuf_SIdx;
 #  endif
-   if ( MPI_Rank == 0 )    delete [] PS_total; 
 
-
-   if ( MPI_Rank == 0 )    Aux_Message( stdout, "%s (DumpID = %d) ... done\n", __FUNCTION__, DumpID );
-
-} // FUNCTION : Output_BasePowerSpectrum
+} // FUNCTION : ComputeBasePowerSpectrum
 
 
 
@@ -142,7 +337,7 @@ void Output_BasePowerSpectrum( const char *FileName )
 // Function    :  GetBasePowerSpectrum
 // Description :  Evaluate and base-level power spectrum by FFT 
 //
-// Note        :  Invoked by the function "Output_BasePowerSpectrum"
+// Note        :  Invoked by the function "ComputeBasePowerSpectrum"
 //
 // Parameter   :  RhoK        : Array storing the input density and output potential
 //                j_start     : Starting j index
@@ -155,19 +350,10 @@ void Output_BasePowerSpectrum( const char *FileName )
 void GetBasePowerSpectrum( real *RhoK, const int j_start, const int dj, const int RhoK_Size, real *PS_total )
 {
 
-// check
-   if ( MPI_Rank == 0  &&  PS_total == NULL )   Aux_Error( ERROR_INFO, "PS_total == NULL at the root rank !!\n" );
-
-
-   const int Nx        = NX0_TOT[0];
-   const int Ny        = NX0_TOT[1];
-   const int Nz        = NX0_TOT[2];
-   const int Nx_Padded = Nx/2 + 1;
+   const int Nx_Padded = NX0_TOT[0]/2 + 1;
 
-   fftw_complex *cdata=NULL;
    real PS_local[Nx_Padded];
-   long Count_local[Nx_Padded], Count_total[Nx_Padded];
-   int  bin, bin_i[Nx_Padded], bin_j[Ny], bin_k[Nz]; 
+   long Count_local[Nx_Padded];
    
 
 // forward FFT
@@ -178,68 +364,163 @@ void GetBasePowerSpectrum( real *RhoK, const int j_start, const int dj, const in
 #  endif
 
 
-// the data are now complex, so typecast a pointer
-   cdata = (fftw_complex*) RhoK;
+// estimate the power spectrum
+   BinBasePowerSpectrum( RhoK, j_start, dj, PS_local, Count_local );
 
+   SumBasePowerSpectrum( PS_local, Count_local, PS_total );
 
-// set up the dimensionless wave number coefficients according to the FFTW data format
-   for (int i=0; i<Nx_Padded; i++)     bin_i[i] = i;
-   for (int j=0; j<Ny;        j++)     bin_j[j] = ( j <= Ny/2 ) ? j : j-Ny;
-   for (int k=0; k<Nz;        k++)     bin_k[k] = ( k <= Nz/2 ) ? k : k-Nz;
+} // FUNCTION : GetBasePowerSpectrum
 
 
-// estimate the power spectrum
-   int Idx;
 
-   for (int b=0; b<Nx_Padded; b++)  
+//-------------------------------------------------------------------------------------------------------
+// Function    :  BinBasePowerSpectrum
+// Description :  Bin |Rho_k|^2 of the local k-space density into the local power spectrum
+//
+// Note        :  1. Each OpenMP thread accumulates its own histogram, and the histograms are summed in the
+//                   order of thread ID to keep the results independent of the thread scheduling
+//                2. The input array must be in the FFTW format after the forward real-to-complex FFT
+//
+// Parameter   :  RhoK        : Array storing the k-space density
+//                j_start     : Starting j index
+//                dj          : Size of array in the j (y) direction after the forward FFT
+//                PS_local    : Local sum of |Rho_k|^2 in each bin
+//                Count_local : Local number of modes in each bin
+//
+// Return      :  PS_local, Count_local
+//-------------------------------------------------------------------------------------------------------
+void BinBasePowerSpectrum( const real *RhoK, const int j_start, const int dj, real *PS_local, long *Count_local )
+{
+
+   const int Nx        = NX0_TOT[0];
+   const int Ny        = NX0_TOT[1];
+   const int Nz        = NX0_TOT[2];
+   const int Nx_Padded = Nx/2 + 1;
+
+   const fftw_complex *cdata = (const fftw_complex*) RhoK;
+   int  bin_j[Ny], bin_k[Nz]; 
+
+// per-thread histograms are allocated only once since neither NX0_TOT nor OMP_NTHREAD changes during the run
+   static real *PS_TH    = NULL;
+   static long *Count_TH = NULL;
+
+   if ( PS_TH == NULL )
    {
-      PS_local   [b] = (real)0.0;
-      Count_local[b] = 0;
+      PS_TH    = new real [ OMP_NTHREAD*Nx_Padded ];
+      Count_TH = new long [ OMP_NTHREAD*Nx_Padded ];
    }
 
-#  ifdef SERIAL // serial mode
 
-   for (int k=0; k<Nz; k++)
+// set up the dimensionless wave number coefficients according to the FFTW data format
+   for (int j=0; j<Ny;        j++)     bin_j[j] = ( j <= Ny/2 ) ? j : j-Ny;
+   for (int k=0; k<Nz;        k++)     bin_k[k] = ( k <= Nz/2 ) ? k : k-Nz;
+
+
+// estimate the power spectrum with one histogram per thread
+#  pragma omp parallel
    {
-      for (int j=0; j<Ny; j++)   
-      for (int i=0; i<Nx_Padded; i++)
+#     ifdef OPENMP
+      const int TID = omp_get_thread_num();
+#     else
+      const int TID = 0;
+#     endif
+
+      real *PS    = PS_TH    + TID*Nx_Padded;
+      long *Count = Count_TH + TID*Nx_Padded;
+      int   bin, jk2, Idx0;
+
+      for (int b=0; b<Nx_Padded; b++)  
       {
-         Idx = (k*Ny + j)*Nx_Padded + i;
+         PS   [b] = (real)0.0;
+         Count[b] = 0;
+      }
 
-#  else // parallel mode
-   int j;
+#     ifdef SERIAL // serial mode
 
-   for (int jj=0; jj<dj; jj++)   
-   {  
-      j = j_start + jj;
+#     pragma omp for schedule( static )
+      for (int k=0; k<Nz; k++)
+      for (int j=0; j<Ny; j++)
+      {
+         Idx0 = (k*Ny + j)*Nx_Padded;
 
+#     else // parallel mode
+
+#     pragma omp for schedule( static )
+      for (int jj=0; jj<dj; jj++)   
       for (int k=0; k<Nz; k++)
-      for (int i=0; i<Nx_Padded; i++)
       {
-         Idx = (jj*Nz + k)*Nx_Padded + i;
+         const int j = j_start + jj;
+
+         Idx0 = (jj*Nz + k)*Nx_Padded;
 
-#  endif // #ifdef SERIAL ... else ...
+#     endif // #ifdef SERIAL ... else ...
 
-         bin = int(   SQRT(   real( SQR(bin_i[i]) + SQR(bin_j[j]) + SQR(bin_k[k]) )  )   );
+         jk2 = SQR( bin_j[j] ) + SQR( bin_k[k] );
 
-         if ( bin < Nx_Padded )
+         for (int i=0; i<Nx_Padded; i++)
          {
-            PS_local   [bin] += SQR( cdata[Idx].re ) + SQR( cdata[Idx].im );
-            Count_local[bin] ++;
+            bin = int(   SQRT(  real( SQR(i) + jk2 )  )   );
+
+            if ( bin < Nx_Padded )
+            {
+               PS   [bin] += SQR( cdata[Idx0+i].re ) + SQR( cdata[Idx0+i].im );
+               Count[bin] ++;
+            }
          }
-      
-      } // i,j,k
-   } // i,j,k
+      } // j,k
+   } // OpenMP parallel region
+
+
+// sum over all threads
+   for (int b=0; b<Nx_Padded; b++)
+   {
+      PS_local   [b] = (real)0.0;
+      Count_local[b] = 0;
+
+      for (int t=0; t<OMP_NTHREAD; t++)
+      {
+         PS_local   [b] += PS_TH   [ t*Nx_Padded + b ];
+         Count_local[b] += Count_TH[ t*Nx_Padded + b ];
+      }
+   }
+
+} // FUNCTION : BinBasePowerSpectrum
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  SumBasePowerSpectrum
+// Description :  Sum the local power spectrum over all ranks and normalize the result
+//
+// Parameter   :  PS_local    : Local sum of |Rho_k|^2 in each bin
+//                Count_local : Local number of modes in each bin
+//                PS_total    : Power spectrum summed over all MPI ranks
+//
+// Return      :  PS_total (in the root rank only)
+//-------------------------------------------------------------------------------------------------------
+void SumBasePowerSpectrum( const real *PS_local, const long *Count_local, real *PS_total )
+{
+
+// check
+   if ( MPI_Rank == 0  &&  PS_total == NULL )   Aux_Error( ERROR_INFO, "PS_total == NULL at the root rank !!\n" );
+
+
+   const int Nx        = NX0_TOT[0];
+   const int Ny        = NX0_TOT[1];
+   const int Nz        = NX0_TOT[2];
+   const int Nx_Padded = Nx/2 + 1;
+
+   long Count_total[Nx_Padded];
 
 
 // sum over all ranks
 #  ifdef FLOAT8
-   MPI_Reduce( PS_local,    PS_total,    Nx_Padded, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
+   MPI_Reduce( (real*)PS_local,    PS_total,    Nx_Padded, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
 #  else
-   MPI_Reduce( PS_local,    PS_total,    Nx_Padded, MPI_FLOAT,  MPI_SUM, 0, MPI_COMM_WORLD );
+   MPI_Reduce( (real*)PS_local,    PS_total,    Nx_Padded, MPI_FLOAT,  MPI_SUM, 0, MPI_COMM_WORLD );
 #  endif
 
-   MPI_Reduce( Count_local, Count_total, Nx_Padded, MPI_LONG,   MPI_SUM, 0, MPI_COMM_WORLD );
+   MPI_Reduce( (long*)Count_local, Count_total, Nx_Padded, MPI_LONG,   MPI_SUM, 0, MPI_COMM_WORLD );
 
 
 // normalization: SQR(AveRho) accounts for Delta=Rho/AveRho
@@ -269,7 +550,7 @@ void GetBasePowerSpectrum( real *RhoK, const int j_start, const int dj, const in
       }
    }
 
-} // FUNCTION : GetBasePowerSpectrum
+} // FUNCTION : SumBasePowerSpectrum
 
 
 
@@ -79,8 +79,12 @@ void Output_DumpData( const int Stage )
    if ( OPT__INIT == INIT_RESTART  &&  Stage == 0 )     return;
 
 
-// set the file names for the functions "Output_DumpData_Total", "Output_DumpData_Part", and "Output_BasePowerSpectrum"
+// set the file names for the functions "Output_DumpData_Total", "Output_DumpData_Part", "Output_BasePowerSpectrum",
+// and "Output_PatchCost"
    char FileName_Total[50], FileName_Part[50], FileName_Temp[50], FileName_PS[50];
+#  ifdef TIMING_PATCH
+   char FileName_Cost[50];
+#  endif
    int ID[6];
 
    ID[0] = DumpID/100000;
@@ -125,6 +129,18 @@ void Output_DumpData( const int Stage )
                                       ID[0], ID[1], ID[2], ID[3], ID[4], ID[5] );
                              break;
 
+         case OUTPUT_PROJ_X : sprintf( FileName_Temp, "Xproj_%d%d%d%d%d%d", 
+                                       ID[0], ID[1], ID[2], ID[3], ID[4], ID[5] );
+                             break;
+
+         case OUTPUT_PROJ_Y : sprintf( FileName_Temp, "Yproj_%d%d%d%d%d%d", 
+                                       ID[0], ID[1], ID[2], ID[3], ID[4], ID[5] );
+                             break;
+
+         case OUTPUT_PROJ_Z : sprintf( FileName_Temp, "Zproj_%d%d%d%d%d%d", 
+                                       ID[0], ID[1], ID[2], ID[3], ID[4], ID[5] );
+                             break;
+
          default :
                              Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", 
                                         "OPT__OUTPUT_PART", OPT__OUTPUT_PART );
@@ -139,11 +155,17 @@ void Output_DumpData( const int Stage )
       else
          strcpy( FileName_Part, FileName_Temp );
 
+      if ( OPT__OUTPUT_PART_BIN )   strcat( FileName_Part, "_bin" );
+
    } // if ( OPT__OUTPUT_PART )
 
    if ( OPT__OUTPUT_BASEPS )
       sprintf( FileName_PS, "PowerSpec_%d%d%d%d%d%d", ID[0], ID[1], ID[2], ID[3], ID[4], ID[5] );
 
+#  ifdef TIMING_PATCH
+   sprintf( FileName_Cost, "PatchCost_%d%d%d%d%d%d", ID[0], ID[1], ID[2], ID[3], ID[4], ID[5] );
+#  endif
+
 
 // determine whether or not to output data during the simulation
    static int PreviousDumpStep   = -999;
@@ -183,12 +205,22 @@ void Output_DumpData( const int Stage )
    if ( OutputData || OutputData_RunTime )
    {
       if ( OPT__OUTPUT_TOTAL )   Output_DumpData_Total( FileName_Total );
-      if ( OPT__OUTPUT_PART  )   Output_DumpData_Part( OPT__OUTPUT_PART, OPT__OUTPUT_BASE, OUTPUT_PART_X, 
+      if ( OPT__OUTPUT_PART  )
+      {
+         if ( OPT__OUTPUT_PART_BIN )
+                                 Output_DumpData_PartBin( OPT__OUTPUT_PART, OPT__OUTPUT_BASE, OUTPUT_PART_LV, 
+                                                          OUTPUT_PART_X, OUTPUT_PART_Y, OUTPUT_PART_Z, FileName_Part );
+         else
+                                 Output_DumpData_Part( OPT__OUTPUT_PART, OPT__OUTPUT_BASE, OUTPUT_PART_X, 
                                                        OUTPUT_PART_Y, OUTPUT_PART_Z, FileName_Part );
+      }
       if ( OPT__OUTPUT_ERROR )   Output_TestProbErr( OPT__OUTPUT_BASE );
 #     ifdef GRAVITY
       if ( OPT__OUTPUT_BASEPS )  Output_BasePowerSpectrum( FileName_PS );
 #     endif
+#     ifdef TIMING_PATCH
+                                 Output_PatchCost( FileName_Cost );
+#     endif
 
       Write_DumpRecord();
 
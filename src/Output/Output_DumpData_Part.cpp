@@ -91,6 +91,10 @@ void Output_DumpData_Part( const OptOutputPart_t Part, const bool BaseOnly, cons
       case OUTPUT_X  :                    Check_y = true;   Check_z = true;   break;
       case OUTPUT_Y  :  Check_x = true;                     Check_z = true;   break;
       case OUTPUT_Z  :  Check_x = true;   Check_y = true;                     break;
+
+//    OUTPUT_DIAG does not check the coordinates, and the other options have been rejected above
+      case OUTPUT_DIAG   :  case OUTPUT_NONE   :
+      case OUTPUT_PROJ_X :  case OUTPUT_PROJ_Y :  case OUTPUT_PROJ_Z :                      break;
    }
 
 
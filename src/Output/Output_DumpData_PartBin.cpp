@@ -0,0 +1,299 @@
+
+#include "DAINO.h"
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Output_DumpData_PartBin
+// Description :  Output part of data (slice, line, or projection) in the binary form
+//
+// Note        :  1. Data of all leaf patches are resampled to the uniform grid with the cell size of the level
+//                   "TargetLv"
+//                   --> Coarser cells are duplicated and finer cells are averaged (weighted by the overlapped
+//                       area/length)
+//                2. Only the patches whose corner bounds intersect the targeted slice/line are visited
+//                3. OUTPUT_PROJ_X/Y/Z output the line-of-sight integrals (e.g., column density) along x/y/z
+//                4. Data of all MPI ranks are summed up at rank 0, which then writes a single file
+//                5. File format :
+//                      char     Magic[8]      : "DAINOPRT"
+//                      int      FormatVersion
+//                      int      sizeof(real), Model, Part, TargetLv, NVar, NX, NY
+//                      long     Step
+//                      double   Time, dh (cell size of the uniform grid), x, y, z (targeted coordinates)
+//                      char     VarName[NVar][16]
+//                      real     Data[NVar][NY][NX]  (NY = 1 for lines)
+//
+// Parameter   :  Part     : OUTPUT_XY     : xy plane
+//                           OUTPUT_YZ     : yz plane
+//                           OUTPUT_XZ     : xz plane
+//                           OUTPUT_X      : x  line
+//                           OUTPUT_Y      : y  line
+//                           OUTPUT_Z      : z  line
+//                           OUTPUT_DIAG   : diagonal along (+1,+1,+1)
+//                           OUTPUT_PROJ_X : projection along x
+//                           OUTPUT_PROJ_Y : projection along y
+//                           OUTPUT_PROJ_Z : projection along z
+//
+//                BaseOnly : Only output the base-level data
+//
+//                TargetLv : Refinement level of the uniform output grid
+//
+//                x        : x coordinate
+//                y        : y coordinate
+//                z        : z coordinate
+//
+//                FileName : Name of the output file
+//-------------------------------------------------------------------------------------------------------
+void Output_DumpData_PartBin( const OptOutputPart_t Part, const bool BaseOnly, const int TargetLv, const real x,
+                              const real y, const real z, const char *FileName )
+{
+
+   if ( MPI_Rank == 0 )    Aux_Message( stdout, "%s (DumpID = %d) ...\n", __FUNCTION__, DumpID );
+
+
+// check the input parameters
+   if ( Part != OUTPUT_XY  &&  Part != OUTPUT_YZ  &&  Part != OUTPUT_XZ  &&
+        Part != OUTPUT_X   &&  Part != OUTPUT_Y   &&  Part != OUTPUT_Z   &&  Part != OUTPUT_DIAG  &&
+        Part != OUTPUT_PROJ_X  &&  Part != OUTPUT_PROJ_Y  &&  Part != OUTPUT_PROJ_Z )
+      Aux_Error( ERROR_INFO, "unsupported option \"Part = %d\" [1 ~ 10] !!\n", Part );
+
+   if ( TargetLv < 0  ||  TargetLv >= NLEVEL )
+      Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "TargetLv", TargetLv );
+
+   if (  ( Part == OUTPUT_YZ  ||  Part == OUTPUT_Y  ||  Part == OUTPUT_Z )  &&
+         ( x < 0.0  ||  x >= patch->BoxSize[0] )  )
+      Aux_Error( ERROR_INFO, "incorrect x (out of range [0<=X<%f]) !!\n", patch->BoxSize[0] );
+
+   if (  ( Part == OUTPUT_XZ  ||  Part == OUTPUT_X  ||  Part == OUTPUT_Z )  &&
+         ( y < 0.0  ||  y >= patch->BoxSize[1] )  )
+      Aux_Error( ERROR_INFO, "incorrect y (out of range [0<=Y<%f]) !!\n", patch->BoxSize[1] );
+
+   if (  ( Part == OUTPUT_XY  ||  Part == OUTPUT_X  ||  Part == OUTPUT_Y )  &&
+         ( z < 0.0  ||  z >= patch->BoxSize[2] )  )
+      Aux_Error( ERROR_INFO, "incorrect z (out of range [0<=Z<%f]) !!\n", patch->BoxSize[2] );
+
+#  ifdef OOC
+   Aux_Error( ERROR_INFO, "%s does not support OOC yet !!\n", __FUNCTION__ );
+#  endif
+
+
+// check the synchronization
+   for (int lv=1; lv<NLEVEL; lv++)
+      if ( NPatchTotal[lv] != 0 )   Mis_Check_Synchronization( Time[0], Time[lv], __FUNCTION__, true );
+
+
+// check if the file already exists
+   if ( MPI_Rank == 0 )
+   {
+      FILE *File_Check = fopen( FileName, "r" );
+      if ( File_Check != NULL )
+      {
+         Aux_Message( stderr, "WARNING : the file \"%s\" already exists and will be overwritten !!\n", FileName );
+         fclose( File_Check );
+      }
+   }
+
+
+// 1. set the output variables
+// ===========================================================================================
+#  if   ( MODEL == HYDRO )
+   const char VarName_Flu[NCOMP+1][16] = { "Dens", "MomX", "MomY", "MomZ", "Engy", "Pres" };
+   const int  NVar_Flu                 = NCOMP + 1;
+
+#  elif ( MODEL == MHD )
+#  warning : WAIT MHD !!!
+
+#  elif ( MODEL == ELBDM )
+   const char VarName_Flu[NCOMP][16]   = { "Dens", "Real", "Imag" };
+   const int  NVar_Flu                 = NCOMP;
+
+#  else
+#  error : ERROR : unsupported MODEL !!
+#  endif // MODEL
+
+#  ifdef GRAVITY
+   const int  NVar                     = ( OPT__OUTPUT_POT ) ? NVar_Flu + 1 : NVar_Flu;
+#  else
+   const int  NVar                     = NVar_Flu;
+#  endif
+
+
+// 2. set the geometry of the uniform output grid (in the unit of the finest-level cells)
+// ===========================================================================================
+   const bool Proj     = ( Part == OUTPUT_PROJ_X  ||  Part == OUTPUT_PROJ_Y  ||  Part == OUTPUT_PROJ_Z );
+   const int  NLv      = ( BaseOnly ) ? 1 : NLEVEL;
+   const int  ScaleT   = patch->scale[TargetLv];
+   const int  NT[3]    = { patch->BoxScale[0]/ScaleT, patch->BoxScale[1]/ScaleT, patch->BoxScale[2]/ScaleT };
+   const real Coord[3] = { x, y, z };
+
+   int  Dim[2] = { -1, -1 };     // the two output directions (Dim[1] = -1 for lines)
+   bool Fixed[3];                // whether or not the coordinate along each direction is fixed
+   int  FixedScale[3];           // fixed coordinates in the unit of the finest-level cells
+
+   switch ( Part )
+   {
+      case OUTPUT_XY     :  case OUTPUT_PROJ_Z :    Dim[0] = 0;    Dim[1] = 1;    break;
+      case OUTPUT_YZ     :  case OUTPUT_PROJ_X :    Dim[0] = 1;    Dim[1] = 2;    break;
+      case OUTPUT_XZ     :  case OUTPUT_PROJ_Y :    Dim[0] = 0;    Dim[1] = 2;    break;
+      case OUTPUT_X      :  case OUTPUT_DIAG   :    Dim[0] = 0;                   break;
+      case OUTPUT_Y      :                          Dim[0] = 1;                   break;
+      case OUTPUT_Z      :                          Dim[0] = 2;                   break;
+      default            :  break;
+   }
+
+   for (int d=0; d<3; d++)
+   {
+      Fixed     [d] = ( !Proj  &&  Part != OUTPUT_DIAG  &&  d != Dim[0]  &&  d != Dim[1] );
+      FixedScale[d] = ( Fixed[d] ) ? (int)floor( Coord[d]/patch->dh[NLEVEL-1] ) : NULL_INT;
+   }
+
+   const int  NX       = NT[ Dim[0] ];
+   const int  NY       = ( Dim[1] == -1 ) ? 1 : NT[ Dim[1] ];
+   const long NOut     = (long)NVar*NX*NY;
+
+   real *Out_Local = new real [NOut];
+   real *Out_Total = ( MPI_Rank == 0 ) ? new real [NOut] : NULL;
+
+   for (long t=0; t<NOut; t++)   Out_Local[t] = (real)0.0;
+
+
+// 3. resample the leaf data to the uniform grid
+// ===========================================================================================
+   for (int lv=0; lv<NLv; lv++)
+   {
+      const int  Scale  = patch->scale[lv];
+      const int  PScale = PATCH_SIZE*Scale;
+      const int  FluSg  = patch->FluSg[lv];
+#     ifdef GRAVITY
+      const int  PotSg  = patch->PotSg[lv];
+#     endif
+      const int  NCover = ( Scale >= ScaleT ) ? Scale/ScaleT : 1;    // number of output cells covered by one cell
+      const int  NDimT  = ( Dim[1] == -1 ) ? 1 : 2;
+
+//    weighting of each cell : (overlapped area/length) / (area/length of the output cell) [ x depth for projection ]
+      real Weight = (real)1.0;
+
+      for (int d=0; d<NDimT; d++)   Weight *= (real)MIN( Scale, ScaleT ) / (real)ScaleT;
+
+      if ( Proj )    Weight *= (real)patch->dh[lv];
+
+
+#     pragma omp parallel for schedule( dynamic )
+      for (int PID=0; PID<patch->NPatchComma[lv][1]; PID++)
+      {
+//       output the leaf patches only (unless the option "BaseOnly" is turned on)
+         if ( patch->ptr[0][lv][PID]->son != -1  &&  !BaseOnly )  continue;
+
+         const int *Corner = patch->ptr[0][lv][PID]->corner;
+
+//       skip the patches not intersecting the targeted slice/line
+         bool Skip = false;
+
+         if ( Part == OUTPUT_DIAG )    Skip = ( Corner[0] != Corner[1]  ||  Corner[0] != Corner[2] );
+         else
+         {
+            for (int d=0; d<3; d++)
+               if (  Fixed[d]  &&  ( FixedScale[d] < Corner[d]  ||  FixedScale[d] >= Corner[d]+PScale )  )
+                  Skip = true;
+         }
+
+         if ( Skip )    continue;
+
+
+         int  Idx[3], Cell[3];
+         real u[NCOMP+2];
+
+         for (Idx[2]=0; Idx[2]<PS1; Idx[2]++)
+         for (Idx[1]=0; Idx[1]<PS1; Idx[1]++)
+         for (Idx[0]=0; Idx[0]<PS1; Idx[0]++)
+         {
+//          select the cells on the targeted slice/line
+            if ( Part == OUTPUT_DIAG  &&  ( Idx[0] != Idx[1]  ||  Idx[0] != Idx[2] ) )   continue;
+
+            for (int d=0; d<3; d++)    Cell[d] = Corner[d] + Idx[d]*Scale;
+
+            Skip = false;
+            for (int d=0; d<3; d++)
+               if (  Fixed[d]  &&  ( FixedScale[d] < Cell[d]  ||  FixedScale[d] >= Cell[d]+Scale )  )
+                  Skip = true;
+
+            if ( Skip )    continue;
+
+
+//          collect the output variables
+            for (int v=0; v<NCOMP; v++)   u[v] = patch->ptr[FluSg][lv][PID]->fluid[v][ Idx[2] ][ Idx[1] ][ Idx[0] ];
+
+#           if   ( MODEL == HYDRO )
+            u[NCOMP] = ( u[ENGY] - (real)0.5*( u[MOMX]*u[MOMX] + u[MOMY]*u[MOMY] + u[MOMZ]*u[MOMZ] )/u[DENS] )
+                       *( GAMMA - (real)1.0 );
+#           elif ( MODEL == MHD )
+#           warning : WAIT MHD !!!
+#           endif // MODEL
+
+#           ifdef GRAVITY
+            if ( OPT__OUTPUT_POT )  u[NVar_Flu] = patch->ptr[PotSg][lv][PID]->pot[ Idx[2] ][ Idx[1] ][ Idx[0] ];
+#           endif
+
+
+//          deposit the cell into all overlapped output cells
+            const int X0 = Cell[ Dim[0] ] / ScaleT;
+            const int Y0 = ( Dim[1] == -1 ) ? 0 : Cell[ Dim[1] ] / ScaleT;
+            const int NY_Cover = ( Dim[1] == -1 ) ? 1 : NCover;
+
+            for (int TY=Y0; TY<Y0+NY_Cover; TY++)
+            for (int TX=X0; TX<X0+NCover;   TX++)
+            for (int v=0; v<NVar; v++)
+            {
+               const long Out_Idx = ( (long)v*NY + TY )*NX + TX;
+
+#              pragma omp atomic
+               Out_Local[Out_Idx] += Weight*u[v];
+            }
+         } // i,j,k
+      } // for (int PID=0; PID<patch->NPatchComma[lv][1]; PID++)
+   } // for (int lv=0; lv<NLv; lv++)
+
+
+// 4. collect data from all ranks
+// ===========================================================================================
+#  ifdef FLOAT8
+   MPI_Reduce( Out_Local, Out_Total, (int)NOut, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
+#  else
+   MPI_Reduce( Out_Local, Out_Total, (int)NOut, MPI_FLOAT,  MPI_SUM, 0, MPI_COMM_WORLD );
+#  endif
+
+
+// 5. output data
+// ===========================================================================================
+   if ( MPI_Rank == 0 )
+   {
+      const char   Magic[8]      = { 'D', 'A', 'I', 'N', 'O', 'P', 'R', 'T' };
+      const int    FormatVersion = 1;
+      const int    Header_Int[7] = { (int)sizeof(real), MODEL, (int)Part, TargetLv, NVar, NX, NY };
+      const double Header_Dbl[5] = { Time[0], patch->dh[TargetLv], x, y, z };
+      const char   VarName_Pot[16] = "Pote";
+
+      FILE *File = fopen( FileName, "wb" );
+
+      fwrite( Magic,            sizeof(char),   8,             File );
+      fwrite( &FormatVersion,   sizeof(int),    1,             File );
+      fwrite( Header_Int,       sizeof(int),    7,             File );
+      fwrite( &Step,            sizeof(long),   1,             File );
+      fwrite( Header_Dbl,       sizeof(double), 5,             File );
+      fwrite( VarName_Flu,      sizeof(char),   NVar_Flu*16,   File );
+      if ( NVar > NVar_Flu )
+      fwrite( VarName_Pot,      sizeof(char),   16,            File );
+      fwrite( Out_Total,        sizeof(real),   NOut,          File );
+
+      fclose( File );
+   }
+
+
+   delete [] Out_Local;
+   if ( MPI_Rank == 0 )    delete [] Out_Total;
+
+
+   if ( MPI_Rank == 0 )    Aux_Message( stdout, "%s (DumpID = %d) ... done\n", __FUNCTION__, DumpID );
+
+} // FUNCTION : Output_DumpData_PartBin
@@ -5,6 +5,12 @@
 #include "CUPOT.h"
 #endif
 
+#ifndef OOC
+static void SetDumpDataID( const bool Delta );
+static ulong PatchHash( const real *Data, const int Size, ulong Hash );
+static void Write( const void *Data, const size_t Size, const size_t Count, FILE *File, uint *Block );
+#endif
+
 
 
 
@@ -12,12 +18,38 @@
 // Function    :  Output_DumpData_Total
 // Description :  Output all simulation data in the binary form, which can be used as a restart file
 //
+// Note        :  1. If "OPT__OUTPUT_DELTA > 0", a full dump is followed by OPT__OUTPUT_DELTA delta dumps,
+//                   which store the data of only the leaf patches whose data have changed since the last dump
+//                   --> The tree structure is always fully recorded, and each patch record is followed by the
+//                       ID of the dump storing its data ("DumpDataID")
+//                   --> Each delta dump records the IDs of its parent dump (the last dump) and its base dump
+//                       (the last full dump) so that "Init_Reload" can rebuild the data from the dump chain
+//                   --> Delta dumps have the format version 1202, while full dumps keep the version 1201
+//                2. The first dump of each run is always a full dump
+//                3. If "OPT__OUTPUT_CRC > 0", the size and CRC32C checksum of the header, the simulation
+//                   information, and each patch record are stored in the file "FileName.crc"
+//                   --> The checksums of the patch records are computed from the output buffers while writing
+//                   --> "OPT__OUTPUT_CRC == 2" further verifies the dump right after writing
+//                       (see "Aux_Check_DumpChecksum")
+//
 // Parameter   :  FileName : Name of the output file
 //-------------------------------------------------------------------------------------------------------
 void Output_DumpData_Total( const char *FileName )
 {  
 
-   if ( MPI_Rank == 0 )    Aux_Message( stdout, "%s (DumpID = %d) ...\n", __FUNCTION__, DumpID );
+// determine whether to output a full dump or a delta dump
+   static int ParentDumpID = -1;
+   static int BaseDumpID   = -1;
+   static int NDelta       = 0;
+
+   const bool Delta = ( OPT__OUTPUT_DELTA > 0  &&  ParentDumpID >= 0  &&  NDelta < OPT__OUTPUT_DELTA );
+
+   if ( MPI_Rank == 0 )    
+   {
+      if ( Delta )   Aux_Message( stdout, "%s (DumpID = %d, delta dump of %d) ...\n", __FUNCTION__, DumpID,
+                                  ParentDumpID );
+      else           Aux_Message( stdout, "%s (DumpID = %d) ...\n", __FUNCTION__, DumpID );
+   }
 
 
 // check the synchronization
@@ -37,7 +69,13 @@ void Output_DumpData_Total( const char *FileName )
    }
 
 
-// get the total number of patches that have no son
+// set the ID of the dump storing the data of each leaf patch (for the delta dumps)
+#  ifndef OOC
+   if ( OPT__OUTPUT_DELTA > 0 )  SetDumpDataID( Delta );
+#  endif
+
+
+// get the total number of patches that have no son (and whose data are stored in this dump)
    int NDataPatch_Local[NLEVEL] = { 0 };
    int NDataPatch_Total[NLEVEL];
 
@@ -48,14 +86,18 @@ void Output_DumpData_Total( const char *FileName )
    for (int lv=0; lv<NLEVEL; lv++)    
    for (int PID=0; PID<patch->NPatchComma[lv][1]; PID++) 
    {
-      if ( patch->ptr[0][lv][PID]->son == -1 )  NDataPatch_Local[lv] ++;
+      if (  patch->ptr[0][lv][PID]->son == -1  &&  ( !Delta || patch->ptr[0][lv][PID]->DumpDataID == DumpID )  )
+         NDataPatch_Local[lv] ++;
    }
 #  endif 
 
    MPI_Reduce( NDataPatch_Local, NDataPatch_Total, NLEVEL, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD );
 
 
-   FILE *File;
+   FILE *File, *File_CRC;
+   char CRCName[100];
+
+   sprintf( CRCName, "%s.crc", FileName );
 
    if ( MPI_Rank == 0 )
    {
@@ -91,7 +133,8 @@ void Output_DumpData_Total( const char *FileName )
       const int NBuf_Makefile  =  256 - 15*size_bool -  8*size_int -  0*size_long -  0*size_real -  0*size_double;
       const int NBuf_Constant  =  256 -  6*size_bool - 11*size_int -  0*size_long -  2*size_real -  0*size_double;
       const int NBuf_Parameter = 1024 - 18*size_bool - 35*size_int -  1*size_long - 12*size_real -  8*size_double;
-      const int NBuf_Info      = 1024 -  0*size_bool - (1+3*NLEVEL)*size_int - 2*size_long 
+      const int NDeltaInfo     = ( Delta ) ? 2 : 0;    // ParentDumpID and BaseDumpID of the delta dumps
+      const int NBuf_Info      = 1024 -  0*size_bool - (1+3*NLEVEL+NDeltaInfo)*size_int - 2*size_long 
                                       -  0*size_real - (1+NLEVEL)*size_double; // one size_long is for CheckCode
 
       if ( NBuf_Format    < 0 )  Aux_Error( ERROR_INFO, "%s = %d < 0 !!\n", "NBuf_Format",   NBuf_Format   );
@@ -113,7 +156,7 @@ void Output_DumpData_Total( const char *FileName )
 
 //    a. output the information of data format
 //    =================================================================================================
-      const long FormatVersion = 1201;
+      const long FormatVersion = ( Delta ) ? 1202 : 1201;
       const long HeaderSize    = 2048;          // it must be larger than output a+b+c+d
       const long CheckCode     = 123456789;
 
@@ -259,7 +302,10 @@ void Output_DumpData_Total( const char *FileName )
 #     endif
 
       const int nlevel               = NLEVEL;
-      const int max_patch            = MAX_PATCH;
+
+//    the patch tables grow on demand --> record the maximum number of patches in one level instead
+      int max_patch = 0;
+      for (int lv=0; lv<NLEVEL; lv++)  max_patch = MAX( max_patch, NPatchTotal[lv] );
 
       fwrite( &model,                     sizeof(int),                     1,             File );
       fwrite( &gravity,                   sizeof(bool),                    1,             File );
@@ -565,15 +611,49 @@ void Output_DumpData_Total( const char *FileName )
       fwrite( NDataPatch_Total,           sizeof(int),                NLEVEL,             File );
       fwrite( AdvanceCounter,             sizeof(uint),               NLEVEL,             File );
       fwrite( &AveDensity,                sizeof(double),                  1,             File );
+      if ( Delta )
+      {
+         fwrite( &ParentDumpID,           sizeof(int),                     1,             File );
+         fwrite( &BaseDumpID,             sizeof(int),                     1,             File );
+      }
 
 //    buffer space reserved for future usuage
       fwrite( OutputBuf,                  sizeof(char),            NBuf_Info,             File );
 
 
+      const long InfoSize = ftell( File ) - HeaderSize;
+
       delete [] OutputBuf;
 
       fclose( File );
 
+
+//    record the checksums of the header and the simulation information (read back from the file since the
+//    header contains the unwritten gap before "HeaderSize")
+//    =================================================================================================
+      if ( OPT__OUTPUT_CRC > 0 )
+      {
+         uint  Block[2][2] = { { (uint)HeaderSize, 0 }, { (uint)InfoSize, 0 } };    // [size, checksum]
+         char *HeaderBuf   = new char [ HeaderSize + InfoSize ];
+
+         File = fopen( FileName, "rb" );
+         fread( HeaderBuf, sizeof(char), HeaderSize+InfoSize, File );
+         fclose( File );
+
+         Block[0][1] = Aux_CRC32C( 0, HeaderBuf,            HeaderSize );
+         Block[1][1] = Aux_CRC32C( 0, HeaderBuf+HeaderSize, InfoSize   );
+
+         File_CRC = fopen( CRCName, "wb" );
+         fwrite( Block, sizeof(uint), 4, File_CRC );
+         fclose( File_CRC );
+
+         delete [] HeaderBuf;
+      }
+
+//    remove the checksum file left by a previous run
+      else
+         remove( CRCName );
+
    } // if ( MPI_Rank == 0 )
 
 
@@ -593,16 +673,23 @@ void Output_DumpData_Total( const char *FileName )
 
 #ifndef OOC
 
+            File_CRC = ( OPT__OUTPUT_CRC > 0 ) ? fopen( CRCName, "ab" ) : NULL;
+
             for (int PID=0; PID<patch->NPatchComma[lv][1]; PID++)
             {
+//             size and checksum of this patch record
+               uint  Block[2] = { 0, 0 };
+               uint *BlockPtr = ( File_CRC == NULL ) ? NULL : Block;
+
 //             f1. output the patch information 
 //             (the father <-> son information will be re-constructed during the restart)
-               fwrite(  patch->ptr[0][lv][PID]->corner, sizeof(int), 3, File );
-               fwrite( &patch->ptr[0][lv][PID]->son,    sizeof(int), 1, File );
+               Write(  patch->ptr[0][lv][PID]->corner, sizeof(int), 3, File, BlockPtr );
+               Write( &patch->ptr[0][lv][PID]->son,    sizeof(int), 1, File, BlockPtr );
+               if ( Delta )   Write( &patch->ptr[0][lv][PID]->DumpDataID, sizeof(int), 1, File, BlockPtr );
 
 
-//             f2. output the patch data only if it has no son
-               if ( patch->ptr[0][lv][PID]->son == -1 )
+//             f2. output the patch data only if it has no son (and its data have changed for the delta dump)
+               if (  patch->ptr[0][lv][PID]->son == -1  &&  ( !Delta || patch->ptr[0][lv][PID]->DumpDataID == DumpID )  )
                {
 
 //                f2-1. output the fluid variables
@@ -614,22 +701,28 @@ void Output_DumpData_Total( const char *FileName )
                      for (int i=0; i<PATCH_SIZE; i++)    
                         InvData_Flu[k][j][i][v] = patch->ptr[ patch->FluSg[lv] ][lv][PID]->fluid[v][k][j][i];
 
-                     fwrite( InvData_Flu, sizeof(real), PATCH_SIZE*PATCH_SIZE*PATCH_SIZE*NCOMP, File );
+                     Write( InvData_Flu, sizeof(real), PATCH_SIZE*PATCH_SIZE*PATCH_SIZE*NCOMP, File, BlockPtr );
                   }
                   else
-                     fwrite( patch->ptr[ patch->FluSg[lv] ][lv][PID]->fluid, sizeof(real), 
-                             PATCH_SIZE*PATCH_SIZE*PATCH_SIZE*NCOMP, File );
+                     Write( patch->ptr[ patch->FluSg[lv] ][lv][PID]->fluid, sizeof(real), 
+                            PATCH_SIZE*PATCH_SIZE*PATCH_SIZE*NCOMP, File, BlockPtr );
 
 #                 ifdef GRAVITY
 //                f2-2. output the gravitational potential
                   if ( OPT__OUTPUT_POT )
-                     fwrite( patch->ptr[ patch->PotSg[lv] ][lv][PID]->pot,   sizeof(real), 
-                             PATCH_SIZE*PATCH_SIZE*PATCH_SIZE,       File );
+                     Write( patch->ptr[ patch->PotSg[lv] ][lv][PID]->pot,   sizeof(real), 
+                            PATCH_SIZE*PATCH_SIZE*PATCH_SIZE,       File, BlockPtr );
 #                 endif 
 
-               } // if ( patch->ptr[0][lv][PID]->son == -1 )
+               } // if ( patch->ptr[0][lv][PID]->son == -1  && ... )
+
+//             f3. record the size and checksum of this patch record
+               if ( File_CRC != NULL )    fwrite( Block, sizeof(uint), 2, File_CRC );
+
             } // for (int PID=0; PID<patch->NPatchComma[lv][1]; PID++)
 
+            if ( File_CRC != NULL )    fclose( File_CRC );
+
 #else // OOC
 
             OOC_Output_DumpData_Total( lv, File, InvData_Flu );
@@ -649,8 +742,155 @@ void Output_DumpData_Total( const char *FileName )
    if ( OPT__OUTPUT_TOTAL == 1 )    delete [] InvData_Flu;
 
 
-   if ( MPI_Rank == 0 )    Aux_Message( stdout, "%s (DumpID = %d) ... done\n", __FUNCTION__, DumpID );
+// verify the checksums right after writing
+   if ( OPT__OUTPUT_CRC == 2 )
+   {
+      if ( Aux_Check_DumpChecksum( FileName, CRCName ) != 0  &&  MPI_Rank == 0 )
+         Aux_Message( stderr, "WARNING : verification of the file \"%s\" failed !!\n", FileName );
+   }
+
+
+// record the dump chain for the next delta dump
+   ParentDumpID = DumpID;
+
+   if ( Delta )   NDelta ++;
+   else
+   {
+      BaseDumpID = DumpID;
+      NDelta     = 0;
+   }
+
+
+   if ( MPI_Rank == 0 )
+   {
+      if ( Delta )
+      {
+         int NPatchAll = 0, NDataAll = 0;
+         for (int lv=0; lv<NLEVEL; lv++)  
+         {
+            NPatchAll += NPatchTotal     [lv];
+            NDataAll  += NDataPatch_Total[lv];
+         }
+
+         Aux_Message( stdout, "   %d of %d patches are stored (base dump = %d)\n", NDataAll, NPatchAll, BaseDumpID );
+      }
+
+      Aux_Message( stdout, "%s (DumpID = %d) ... done\n", __FUNCTION__, DumpID );
+   }
 
 } // FUNCTION : Output_DumpData_Total
 
 
+
+#ifndef OOC
+//-------------------------------------------------------------------------------------------------------
+// Function    :  SetDumpDataID
+// Description :  Set the ID of the dump storing the data of each real patch (for the option "OPT__OUTPUT_DELTA")
+//
+// Note        :  1. Leaf patches are stored in the current dump (DumpDataID = DumpID) if
+//                   (a) it is a full dump, or
+//                   (b) the patch was not a leaf patch in the last dump (including the newly-allocated patches), or
+//                   (c) the hash of its data differs from the hash recorded in the last dump
+//                   --> otherwise DumpDataID is unchanged and the data are taken from the older dump
+//                2. Patches with sons are reset to "DumpDataID = -1"
+//                3. The potential is included in the hash if "OPT__OUTPUT_POT" is on
+//
+// Parameter   :  Delta : true --> delta dump
+//                        false --> full dump
+//-------------------------------------------------------------------------------------------------------
+void SetDumpDataID( const bool Delta )
+{
+
+   const int FluSize = NCOMP*PATCH_SIZE*PATCH_SIZE*PATCH_SIZE;
+#  ifdef GRAVITY
+   const int PotSize =       PATCH_SIZE*PATCH_SIZE*PATCH_SIZE;
+#  endif
+
+   for (int lv=0; lv<NLEVEL; lv++)
+   {
+      const int FluSg = patch->FluSg[lv];
+#     ifdef GRAVITY
+      const int PotSg = patch->PotSg[lv];
+#     endif
+
+#     pragma omp parallel for
+      for (int PID=0; PID<patch->NPatchComma[lv][1]; PID++)
+      {
+         patch_t *Patch = patch->ptr[0][lv][PID];
+
+         if ( Patch->son != -1 )
+         {
+            Patch->DumpDataID = -1;
+            continue;
+         }
+
+         ulong Hash = PatchHash( patch->ptr[FluSg][lv][PID]->fluid[0][0][0], FluSize, 14695981039346656037UL );
+#        ifdef GRAVITY
+         if ( OPT__OUTPUT_POT )
+         Hash       = PatchHash( patch->ptr[PotSg][lv][PID]->pot[0][0],        PotSize, Hash );
+#        endif
+
+         if ( !Delta  ||  Patch->DumpDataID < 0  ||  Hash != Patch->DumpHash )
+         {
+            Patch->DumpDataID = DumpID;
+            Patch->DumpHash   = Hash;
+         }
+      } // for (int PID=0; PID<patch->NPatchComma[lv][1]; PID++)
+   } // for (int lv=0; lv<NLEVEL; lv++)
+
+} // FUNCTION : SetDumpDataID
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  PatchHash
+// Description :  Accumulate the 64-bit FNV-1a hash of the input array
+//
+// Note        :  The hash is computed word by word (4 bytes) on the bit pattern of the data, and hence any 
+//                change of the output data is detected
+//
+// Parameter   :  Data : Input array
+//                Size : Number of elements in "Data"
+//                Hash : Hash to be accumulated
+//-------------------------------------------------------------------------------------------------------
+ulong PatchHash( const real *Data, const int Size, ulong Hash )
+{
+
+   const uint *Word  = (const uint*)Data;
+   const int   NWord = Size*sizeof(real)/sizeof(uint);
+
+   for (int t=0; t<NWord; t++)
+   {
+      Hash ^= Word[t];
+      Hash *= 1099511628211UL;
+   }
+
+   return Hash;
+
+} // FUNCTION : PatchHash
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Write
+// Description :  Write data to the dump file and update the size and checksum of the current block
+//
+// Parameter   :  Data  : Output data
+//                Size  : Size of each element
+//                Count : Number of elements
+//                File  : Output file
+//                Block : [size, CRC32C] of the current block (NULL --> no checksum)
+//-------------------------------------------------------------------------------------------------------
+void Write( const void *Data, const size_t Size, const size_t Count, FILE *File, uint *Block )
+{
+
+   fwrite( Data, Size, Count, File );
+
+   if ( Block != NULL )
+   {
+      Block[0] += Size*Count;
+      Block[1]  = Aux_CRC32C( Block[1], Data, Size*Count );
+   }
+
+} // FUNCTION : Write
+#endif // #ifndef OOC
@@ -20,8 +20,8 @@ void Output_Flux( const int lv, const int PID, const int Sib, const char *commen
    if ( lv < 0  ||  lv >= NLEVEL )     
       Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "lv", lv );
 
-   if ( PID < 0  ||  PID >= MAX_PATCH )
-      Aux_Error( ERROR_INFO, "incorrect parameter %s = %d (MAX_PATCH = %d) !!\n", "PID", PID, MAX_PATCH );
+   if ( PID < 0  ||  PID >= patch->num[lv] )
+      Aux_Error( ERROR_INFO, "incorrect parameter %s = %d (NPatch = %d) !!\n", "PID", PID, patch->num[lv] );
 
    if ( !patch->WithFlux )
       Aux_Message( stderr, "WARNING : invoking %s is useless since no flux is required !!\n", __FUNCTION__ );
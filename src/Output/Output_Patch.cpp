@@ -25,8 +25,8 @@ void Output_Patch( const int lv, const int PID, const int FluSg, const int PotSg
    if ( lv < 0  ||  lv >= NLEVEL )
       Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "lv", lv );
 
-   if ( PID < 0  ||  PID >= MAX_PATCH )
-      Aux_Error( ERROR_INFO, "incorrect parameter %s = %d (MAX_PATCH = %d) !!\n", "PID", PID, MAX_PATCH );
+   if ( PID < 0  ||  PID >= patch->num[lv] )
+      Aux_Error( ERROR_INFO, "incorrect parameter %s = %d (NPatch = %d) !!\n", "PID", PID, patch->num[lv] );
 
    if ( FluSg < 0  ||  FluSg >= 2 )
       Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "FluSg", FluSg );
@@ -0,0 +1,240 @@
+#include "DAINO.h"
+
+#ifdef TIMING_PATCH
+
+static void RecordCostHistogram();
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Output_PatchCost
+// Description :  Output the cost of all real patches measured by the option "TIMING_PATCH" and record the
+//                cost histograms in the file "Record__Timing"
+//
+// Note        :  1. Invoked by "Output_DumpData" alongside the data dump
+//                2. The cost is measured in CPU cycles (or microseconds for non-x86 processors) and includes
+//                   COST_FLU : fluid solver (cost of each patch group is evenly distributed to eight patches)
+//                   COST_POI : Poisson solver
+//                   COST_REF : constructing the child patches in "Refine" (recorded in the father patch)
+//                3. The cost is accumulated since the last data dump and is reset after output
+//                4. File format (binary) :
+//                   [int] NLEVEL, NCOST, PATCH_SIZE, DumpID, [long] Step, [double] Time[0], [int] NPatchTotal[NLEVEL]
+//                   --> followed by the records of all real patches ordered by level and MPI rank
+//                       [int] corner[3], son, [double] cost[NCOST]
+//
+// Parameter   :  FileName : Name of the output file
+//-------------------------------------------------------------------------------------------------------
+void Output_PatchCost( const char *FileName )
+{
+
+   if ( MPI_Rank == 0 )    Aux_Message( stdout, "%s (DumpID = %d) ...\n", __FUNCTION__, DumpID );
+
+
+// 1. record the cost histograms before the cost is reset
+   RecordCostHistogram();
+
+
+// 2. output the header
+   if ( MPI_Rank == 0 )
+   {
+      FILE *File_Check = fopen( FileName, "r" );
+      if ( File_Check != NULL )
+      {
+         Aux_Message( stderr, "WARNING : the file \"%s\" already exists and will be overwritten !!\n", FileName );
+         fclose( File_Check );
+      }
+
+      const int NLv = NLEVEL, NCost = NCOST, PSize = PATCH_SIZE;
+
+      FILE *File = fopen( FileName, "wb" );
+
+      fwrite( &NLv,        sizeof(int),    1,      File );
+      fwrite( &NCost,      sizeof(int),    1,      File );
+      fwrite( &PSize,      sizeof(int),    1,      File );
+      fwrite( &DumpID,     sizeof(int),    1,      File );
+      fwrite( &Step,       sizeof(long),   1,      File );
+      fwrite( &Time[0],    sizeof(double), 1,      File );
+      fwrite( NPatchTotal, sizeof(int),    NLEVEL, File );
+
+      fclose( File );
+   }
+
+
+// 3. output the cost of each patch and reset it
+   for (int lv=0; lv<NLEVEL; lv++)
+   {
+      for (int TargetMPIRank=0; TargetMPIRank<MPI_NRank; TargetMPIRank++)
+      {
+         if ( MPI_Rank == TargetMPIRank )
+         {
+            FILE *File = fopen( FileName, "ab" );
+
+            for (int PID=0; PID<patch->NPatchComma[lv][1]; PID++)
+            {
+               patch_t *Relation = patch->ptr[0][lv][PID];
+
+               fwrite(  Relation->corner, sizeof(int),    3,     File );
+               fwrite( &Relation->son,    sizeof(int),    1,     File );
+               fwrite(  Relation->cost,   sizeof(double), NCOST, File );
+
+               for (int c=0; c<NCOST; c++)   Relation->cost[c] = 0.0;
+            }
+
+            fclose( File );
+         }
+
+         MPI_Barrier( MPI_COMM_WORLD );
+
+      } // for (int TargetMPIRank=0; TargetMPIRank<MPI_NRank; TargetMPIRank++)
+   } // for (int lv=0; lv<NLEVEL; lv++)
+
+
+   if ( MPI_Rank == 0 )    Aux_Message( stdout, "%s (DumpID = %d) ... done\n", __FUNCTION__, DumpID );
+
+} // FUNCTION : Output_PatchCost
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  RecordCostHistogram
+// Description :  Record the cost fraction of each level and the histogram of the per-patch cost of each stage
+//                in the file "Record__Timing"
+//
+// Note        :  1. Only patches with non-zero cost in the targeted stage are counted
+//                2. The histogram bins are in units of the average cost per patch of each stage
+//                   --> bin edges = 1/8, 1/4, 1/2, 1, 2, 4, 8
+//-------------------------------------------------------------------------------------------------------
+void RecordCostHistogram()
+{
+
+   const int   NBin                 = 8;
+   const char *StageName[NCOST]     = { "Fluid", "Poisson", "Refine" };
+
+   double Sum_Local[NLEVEL][NCOST], Sum_Total[NLEVEL][NCOST], Max_Local[NCOST], Max_Total[NCOST];
+   double Ave[NCOST], StageSum[NCOST];
+   long   Count_Local[NLEVEL][NCOST], Count_Total[NLEVEL][NCOST], StageCount[NCOST];
+   long   Hist_Local[NCOST][NBin], Hist_Total[NCOST][NBin];
+
+
+// 1. total and maximum cost
+   for (int c=0; c<NCOST; c++)
+   {
+      Max_Local[c] = 0.0;
+
+      for (int lv=0; lv<NLEVEL; lv++)
+      {
+         Sum_Local  [lv][c] = 0.0;
+         Count_Local[lv][c] = 0;
+      }
+   }
+
+   for (int lv=0; lv<NLEVEL; lv++)
+   for (int PID=0; PID<patch->NPatchComma[lv][1]; PID++)
+   {
+      const double *Cost = patch->ptr[0][lv][PID]->cost;
+
+      for (int c=0; c<NCOST; c++)
+      {
+         if ( Cost[c] <= 0.0 )   continue;
+
+         Sum_Local  [lv][c] += Cost[c];
+         Count_Local[lv][c] ++;
+         Max_Local      [c]  = MAX( Max_Local[c], Cost[c] );
+      }
+   }
+
+// --> pass the pointers to the entire 2D arrays since the serial MPI macros access the arrays element by element
+   MPI_Allreduce( (double*)Sum_Local,   (double*)Sum_Total,   NLEVEL*NCOST, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+   MPI_Allreduce( (long*  )Count_Local, (long*  )Count_Total, NLEVEL*NCOST, MPI_LONG,   MPI_SUM, MPI_COMM_WORLD );
+   MPI_Reduce   ( Max_Local,      Max_Total,      NCOST,        MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD );
+
+   for (int c=0; c<NCOST; c++)
+   {
+      StageSum  [c] = 0.0;
+      StageCount[c] = 0;
+
+      for (int lv=0; lv<NLEVEL; lv++)
+      {
+         StageSum  [c] += Sum_Total  [lv][c];
+         StageCount[c] += Count_Total[lv][c];
+      }
+
+      Ave[c] = ( StageCount[c] > 0 ) ? StageSum[c]/StageCount[c] : 0.0;
+   }
+
+
+// 2. histogram of the per-patch cost normalized to the average cost
+   for (int c=0; c<NCOST; c++)
+   for (int b=0; b<NBin; b++)    Hist_Local[c][b] = 0;
+
+   for (int lv=0; lv<NLEVEL; lv++)
+   for (int PID=0; PID<patch->NPatchComma[lv][1]; PID++)
+   {
+      const double *Cost = patch->ptr[0][lv][PID]->cost;
+
+      for (int c=0; c<NCOST; c++)
+      {
+         if ( Cost[c] <= 0.0 )   continue;
+
+         const double Ratio = Cost[c] / Ave[c];
+         int b = 0;
+
+         for (double Edge=0.125; b<NBin-1  &&  Ratio >= Edge; Edge*=2.0)  b++;
+
+         Hist_Local[c][b] ++;
+      }
+   }
+
+   MPI_Reduce( (long*)Hist_Local, (long*)Hist_Total, NCOST*NBin, MPI_LONG, MPI_SUM, 0, MPI_COMM_WORLD );
+
+
+// 3. record the results
+   if ( MPI_Rank == 0 )
+   {
+      FILE *File = fopen( "Record__Timing", "a" );
+
+      fprintf( File, "Patch Cost (DumpID = %d, Time = %13.7e, Step = %ld)\n", DumpID, Time[0], Step );
+      fprintf( File, "-------------------------------------------------------------------------------------------\n" );
+
+//    3-1. cost fraction of each level
+      fprintf( File, "%5s", "Level" );
+      for (int c=0; c<NCOST; c++)   fprintf( File, "%12s%10s", StageName[c], "Frac(%)" );
+      fprintf( File, "\n" );
+
+      for (int lv=0; lv<NLEVEL; lv++)
+      {
+         fprintf( File, "%5d", lv );
+         for (int c=0; c<NCOST; c++)
+         fprintf( File, "%12ld%10.3f", Count_Total[lv][c],
+                  ( StageSum[c] > 0.0 ) ? 100.0*Sum_Total[lv][c]/StageSum[c] : 0.0 );
+         fprintf( File, "\n" );
+      }
+      fprintf( File, "\n" );
+
+//    3-2. histogram of each stage
+      fprintf( File, "%8s%12s%14s%10s |%7s%7s%7s%7s%7s%7s%7s%7s  (%% of patches vs. cost/average)\n",
+               "Stage", "NPatch", "Average", "Max/Ave", "<1/8", "<1/4", "<1/2", "<1", "<2", "<4", "<8", ">=8" );
+
+      for (int c=0; c<NCOST; c++)
+      {
+         fprintf( File, "%8s%12ld%14.4e%10.3f |", StageName[c], StageCount[c], Ave[c],
+                  ( Ave[c] > 0.0 ) ? Max_Total[c]/Ave[c] : 0.0 );
+
+         for (int b=0; b<NBin; b++)
+         fprintf( File, "%7.2f", ( StageCount[c] > 0 ) ? 100.0*Hist_Total[c][b]/StageCount[c] : 0.0 );
+
+         fprintf( File, "\n" );
+      }
+
+      fprintf( File, "-------------------------------------------------------------------------------------------\n" );
+      fprintf( File, "\n\n" );
+
+      fclose( File );
+   } // if ( MPI_Rank == 0 )
+
+} // FUNCTION : RecordCostHistogram
+
+
+
+#endif // #ifdef TIMING_PATCH
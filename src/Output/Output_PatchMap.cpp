@@ -26,6 +26,12 @@ void Output_PatchMap( const int lv, const int PID, const int TSg, const int Comp
    if ( Comp > NCOMP-1 ||  Comp < 0 )  Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "Comp", Comp );
 #  endif
 
+   if ( PID < 0  ||  PID >= patch->num[lv] )
+   {
+      Aux_Message( stderr, "WARNING : lv %d, PID %d does NOT exist (NPatch = %d) !!\n", lv, PID, patch->num[lv] );
+      return;
+   }
+
    if ( patch->ptr[0][lv][PID] == NULL )
    {
       Aux_Message( stderr, "WARNING : lv %d, PID %d does NOT exist !!\n", lv, PID );
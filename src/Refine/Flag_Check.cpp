@@ -1,55 +1,81 @@
 
 #include "DAINO.h"
 
-static bool Check_Gradient( const int i, const int j, const int k, const real Input[], const double Threshold );
+#if ( PS1 > 32 )
+#  error : ERROR : Flag_Check assumes PATCH_SIZE <= 32 (one 32-bit mask per row of cells) !!
+#endif
+
+static void Check_Gradient( const real Input[][PS1][PS1], const double Threshold, bool Flag[][PS1][PS1] );
+static bool Flag_AnyCell( const bool Flag[][PS1][PS1] );
 
 
 
 
 //-------------------------------------------------------------------------------------------------------
 // Function    :  Flag_Check
-// Description :  Check if the targeted cell (i,j,k) satisfies the refinement criteria
+// Description :  Check which cells in the targeted patch satisfy the refinement criteria
 //
-// Note        :  Useless input arrays are set to NULL 
-//                (e.g, Pot if GRAVITY is off, Pres if OPT__FLAG_PRES_GRADIENT is off)
+// Note        :  1. Useless input arrays are set to NULL
+//                   (e.g, Pot if GRAVITY is off, Pres if OPT__FLAG_PRES_GRADIENT is off)
+//                2. Each criterion is evaluated over the entire patch at once in order to make the loops
+//                   vectorizable. The result of all criteria is stored in the bitmask "FlagMask", in which the
+//                   i-th bit of FlagMask[k][j] is set if the cell (i,j,k) is flagged.
+//                3. If FLAG_BUFFER_SIZE >= PATCH_SIZE, a single flagged cell is enough to flag all 26 siblings
+//                   --> the remaining criteria are skipped once any cell is flagged
+//                4. Pressure is evaluated here (and stored in "Pres") only if it is required
+//                5. To add new refinement criteria, please edit this function
 //
-// Parameter   :  lv             : Targeted refinement level 
+// Parameter   :  lv             : Targeted refinement level
 //                PID            : Targeted patch ID
-//                i,j,k          : Indices of the targeted cell
 //                Fluid          : Input fluid array (with NCOMP components)
 //                Pot            : Input potential array
-//                Pres           : Input pressure array
+//                Pres           : Array to store the pressure
 //                Lohner_Var     : Input array storing the variables for the Lohner error estimator
 //                Lohner_Slope   : Input array storing the slopes of Lohner_Var for the Lohner error estimator
 //                Lohner_NCell   : Size of the arrays Lohner_Var and Lohner_Slope along one direction
 //                Lohner_NVar    : Number of variables stored in Lohner_Var and Lohner_Slope
+//                FlagMask       : Output bitmask of the flagged cells
 //
-// Return      :  "true"  if any  of the refinement criteria is satisfied
-//                "false" if none of the refinement criteria is satisfied
+// Return      :  "true"  if any  cell in the patch satisfies the refinement criteria
+//                "false" if none of the cells satisfies the refinement criteria
 //-------------------------------------------------------------------------------------------------------
-bool Flag_Check( const int lv, const int PID, const int i, const int j, const int k, 
-                 const real Fluid[][PS1][PS1][PS1], const real Pot[][PS1][PS1], const real Pres[][PS1][PS1],
-                 const real *Lohner_Var, const real *Lohner_Slope, const int Lohner_NCell, const int Lohner_NVar )
+bool Flag_Check( const int lv, const int PID, const real Fluid[][PS1][PS1][PS1], const real Pot[][PS1][PS1],
+                 real Pres[][PS1][PS1], const real *Lohner_Var, const real *Lohner_Slope, const int Lohner_NCell,
+                 const int Lohner_NVar, uint FlagMask[][PS1] )
 {
-   
-   bool Flag = false;
+
+   const bool AnyCellIsEnough = ( FLAG_BUFFER_SIZE >= PS1 );
+
+   bool Flag[PS1][PS1][PS1];
+   bool Done = false;
+
+   for (int k=0; k<PS1; k++)
+   for (int j=0; j<PS1; j++)
+   for (int i=0; i<PS1; i++)  Flag[k][j][i] = false;
+
 
 #  ifdef DENS
 // 1. check density magnitude
 // ===========================================================================================
    if ( OPT__FLAG_RHO )
    {
-      Flag |= ( Fluid[DENS][k][j][i] > FlagTable_Rho[lv] );
-      if ( Flag )    return Flag;
+      const double Threshold = FlagTable_Rho[lv];
+
+      for (int k=0; k<PS1; k++)
+      for (int j=0; j<PS1; j++)
+      for (int i=0; i<PS1; i++)  Flag[k][j][i] |= ( Fluid[DENS][k][j][i] > Threshold );
+
+      if ( AnyCellIsEnough )  Done = Flag_AnyCell( Flag );
    }
 
 
 // 2. check density gradient
 // ===========================================================================================
-   if ( OPT__FLAG_RHO_GRADIENT )
+   if ( OPT__FLAG_RHO_GRADIENT  &&  !Done )
    {
-      Flag |= Check_Gradient( i, j, k, &Fluid[DENS][0][0][0], FlagTable_RhoGradient[lv] );
-      if ( Flag )    return Flag;
+      Check_Gradient( Fluid[DENS], FlagTable_RhoGradient[lv], Flag );
+
+      if ( AnyCellIsEnough )  Done = Flag_AnyCell( Flag );
    }
 #  endif
 
@@ -57,10 +83,25 @@ bool Flag_Check( const int lv, const int PID, const int i, const int j, const in
 // 3. check pressure gradient
 // ===========================================================================================
 #  if   ( MODEL == HYDRO )
-   if ( OPT__FLAG_PRES_GRADIENT )
+   if ( OPT__FLAG_PRES_GRADIENT  &&  !Done )
    {
-      Flag |= Check_Gradient( i, j, k, &Pres[0][0][0], FlagTable_PresGradient[lv] );
-      if ( Flag )    return Flag;
+      const real Gamma_m1 = GAMMA - (real)1.0;
+      real Ek;
+
+      for (int k=0; k<PS1; k++)
+      for (int j=0; j<PS1; j++)
+      for (int i=0; i<PS1; i++)
+      {
+         Ek = (real)0.5*( Fluid[MOMX][k][j][i]*Fluid[MOMX][k][j][i] +
+                          Fluid[MOMY][k][j][i]*Fluid[MOMY][k][j][i] +
+                          Fluid[MOMZ][k][j][i]*Fluid[MOMZ][k][j][i] ) / Fluid[DENS][k][j][i];
+
+         Pres[k][j][i] = Gamma_m1 * ( Fluid[ENGY][k][j][i] - Ek );
+      }
+
+      Check_Gradient( Pres, FlagTable_PresGradient[lv], Flag );
+
+      if ( AnyCellIsEnough )  Done = Flag_AnyCell( Flag );
    }
 #  elif ( MODEL == MHD )
 #  warning : WAIT MHD !!!
@@ -70,35 +111,57 @@ bool Flag_Check( const int lv, const int PID, const int i, const int j, const in
 // 4. check ELBDM energy density
 // ===========================================================================================
 #  if ( MODEL == ELBDM )
-   if ( OPT__FLAG_ENGY_DENSITY )
+   if ( OPT__FLAG_ENGY_DENSITY  &&  !Done )
    {
-      Flag |= ELBDM_Flag_EngyDensity( i, j, k, &Fluid[REAL][0][0][0], &Fluid[IMAG][0][0][0], 
-                                      FlagTable_EngyDensity[lv][0], FlagTable_EngyDensity[lv][1] );
-      if ( Flag )    return Flag;
+      for (int k=0; k<PS1; k++)
+      for (int j=0; j<PS1; j++)
+      for (int i=0; i<PS1; i++)
+         Flag[k][j][i] |= ELBDM_Flag_EngyDensity( i, j, k, &Fluid[REAL][0][0][0], &Fluid[IMAG][0][0][0],
+                                                  FlagTable_EngyDensity[lv][0], FlagTable_EngyDensity[lv][1] );
+
+      if ( AnyCellIsEnough )  Done = Flag_AnyCell( Flag );
    }
 #  endif
 
 
 // 5. check Lohner's error estimator
 // ===========================================================================================
-   if ( OPT__FLAG_LOHNER )
+   if ( OPT__FLAG_LOHNER  &&  !Done )
    {
-      Flag |= Flag_Lohner( i+2, j+2, k+2, Lohner_Var, Lohner_Slope, Lohner_NCell, Lohner_NVar,
-                           FlagTable_Lohner[lv][0], FlagTable_Lohner[lv][1], FlagTable_Lohner[lv][2] );
-      if ( Flag )    return Flag;
+      Flag_Lohner( Lohner_Var, Lohner_Slope, Lohner_NCell, Lohner_NVar, FlagTable_Lohner[lv][0],
+                   FlagTable_Lohner[lv][1], FlagTable_Lohner[lv][2], Flag );
+
+      if ( AnyCellIsEnough )  Done = Flag_AnyCell( Flag );
    }
 
 
 // 6. check user-defined criteria
 // ===========================================================================================
-   if ( OPT__FLAG_USER )
+   if ( OPT__FLAG_USER  &&  !Done )
    {
-      Flag |= Flag_UserCriteria( i, j, k, lv, PID, FlagTable_User[lv] );
-      if ( Flag )    return Flag;
+      for (int k=0; k<PS1; k++)
+      for (int j=0; j<PS1; j++)
+      for (int i=0; i<PS1; i++)
+         if ( !Flag[k][j][i] )   Flag[k][j][i] = Flag_UserCriteria( i, j, k, lv, PID, FlagTable_User[lv] );
    }
 
 
-   return Flag;
+// 7. convert the cell flags to the bitmask
+// ===========================================================================================
+   uint AnyFlag = 0;
+
+   for (int k=0; k<PS1; k++)
+   for (int j=0; j<PS1; j++)
+   {
+      uint Mask = 0;
+
+      for (int i=0; i<PS1; i++)  Mask |= (uint)Flag[k][j][i] << i;
+
+      FlagMask[k][j]  = Mask;
+      AnyFlag        |= Mask;
+   }
+
+   return ( AnyFlag != 0 );
 
 } // FUNCTION : Flag_Check
 
@@ -106,54 +169,73 @@ bool Flag_Check( const int lv, const int PID, const int i, const int j, const in
 
 //-------------------------------------------------------------------------------------------------------
 // Function    :  Check_Gradient
-// Description :  Check if the gradient of the input data at the cell (i,j,k) exceeds the given threshold
+// Description :  Flag the cells in which the gradient of the input data exceeds the given threshold
 //
-// Note        :  1. Size of the array "Input" should be PATCH_SIZE^3 
-//                2. For cells adjacent to the patch boundary, only first-order approximation is adopted 
+// Note        :  1. Size of the array "Input" should be PATCH_SIZE^3
+//                2. For cells adjacent to the patch boundary, only first-order approximation is adopted
 //                   to estimate gradient. Otherwise, second-order approximation is adopted.
 //                   --> Do NOT need to prepare the ghost-zone data for the targeted patch
+//                3. The boundary cells along x are processed separately so that the inner loops have no branch
+//                4. The flag array is updated by the "OR" operation
 //
-// Parameter   :  i,j,k       : Indices of the targeted cell in the array "Input"
-//                Input       : Input array
+// Parameter   :  Input       : Input array
 //                Threshold   : Threshold for the flag operation
-//
-// Return      :  "true"  if the gradient is larger           than the given threshold
-//                "false" if the gradient is equal or smaller than the given threshold
+//                Flag        : Flag array to be updated
 //-------------------------------------------------------------------------------------------------------
-bool Check_Gradient( const int i, const int j, const int k, const real Input[], const double Threshold )
+void Check_Gradient( const real Input[][PS1][PS1], const double Threshold, bool Flag[][PS1][PS1] )
 {
 
-// check
-#  ifdef DAINO_DEBUG
-   if (  i < 0  ||  i >= PS1  ||  j < 0 ||  j >= PS1  ||  k < 0  ||  k >= PS1   )
-      Aux_Error( ERROR_INFO, "incorrect index (i,j,k) = (%d,%d,%d) !!\n", i, j, k );
-#  endif
-
+   int  km, kp, jm, jp;
+   real _dh_y, _dh_z;
 
-   const int ijk[3]  = { i, j, k };
-   const int Idx     = k*PS1*PS1 + j*PS1 + i;
-   const int dIdx[3] = { 1, PS1, PS1*PS1 };
-
-   int  Idx_p, Idx_m;
-   real _dh, Self, Gradient;
-   bool Flag = false;
-
-   for (int d=0; d<3; d++)
+   for (int k=0; k<PS1; k++)
    {
-      switch ( ijk[d] )
+      km    = ( k == 0     ) ? k : k-1;
+      kp    = ( k == PS1-1 ) ? k : k+1;
+      _dh_z = ( k == 0  ||  k == PS1-1 ) ? (real)1.0 : (real)0.5;
+
+      for (int j=0; j<PS1; j++)
       {
-         case 0     : Idx_m = Idx;           Idx_p = Idx+dIdx[d];    _dh = (real)1.0;  break;
-         case PS1-1 : Idx_m = Idx-dIdx[d];   Idx_p = Idx;            _dh = (real)1.0;  break;
-         default    : Idx_m = Idx-dIdx[d];   Idx_p = Idx+dIdx[d];    _dh = (real)0.5;  break;
-      } 
+         jm    = ( j == 0     ) ? j : j-1;
+         jp    = ( j == PS1-1 ) ? j : j+1;
+         _dh_y = ( j == 0  ||  j == PS1-1 ) ? (real)1.0 : (real)0.5;
 
-      Self     = Input[Idx];
-      Gradient = _dh*( Input[Idx_p] - Input[Idx_m] );
-      Flag    |= (  fabs( Gradient/Self ) > Threshold  );
+         const real *Row   = Input[k][j];
+         bool       *FRow  = Flag [k][j];
 
-      if ( Flag )    return Flag;
-   } // for (int d=0; d<3; d++)
+//       x direction
+         FRow[0    ] |= (  FABS( (real)1.0*( Row[1    ] - Row[0    ] ) / Row[0    ] ) > Threshold  );
+         FRow[PS1-1] |= (  FABS( (real)1.0*( Row[PS1-1] - Row[PS1-2] ) / Row[PS1-1] ) > Threshold  );
 
-   return Flag;
+         for (int i=1; i<PS1-1; i++)
+            FRow[i] |= (  FABS( (real)0.5*( Row[i+1] - Row[i-1] ) / Row[i] ) > Threshold  );
+
+//       y and z directions
+         for (int i=0; i<PS1; i++)
+         {
+            FRow[i] |= (  FABS( _dh_y*( Input[k][jp][i] - Input[k][jm][i] ) / Row[i] ) > Threshold  );
+            FRow[i] |= (  FABS( _dh_z*( Input[kp][j][i] - Input[km][j][i] ) / Row[i] ) > Threshold  );
+         }
+      } // for (int j=0; j<PS1; j++)
+   } // for (int k=0; k<PS1; k++)
 
 } // FUNCTION : Check_Gradient
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Flag_AnyCell
+// Description :  Return true if any cell in the input flag array is flagged
+//-------------------------------------------------------------------------------------------------------
+bool Flag_AnyCell( const bool Flag[][PS1][PS1] )
+{
+
+   bool Any = false;
+
+   for (int k=0; k<PS1; k++)
+   for (int j=0; j<PS1; j++)
+   for (int i=0; i<PS1; i++)  Any |= Flag[k][j][i];
+
+   return Any;
+
+} // FUNCTION : Flag_AnyCell
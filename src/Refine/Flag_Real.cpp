@@ -22,6 +22,8 @@ void GetSlope_for_Lohner( const real *Var1D, real *Slope1D, const int NCell, con
 //                                          Init_Start
 //                4. To add new refinement criteria, please edit the function "Flag_Check"
 //                5. Definition of the function "GetSlope_for_Lohner" is put in the file "Flag_Lohner"
+//                6. "Flag_Check" evaluates all cells of a patch at once and returns a bitmask of the flagged
+//                   cells. The FLAG_BUFFER_SIZE extension is then applied to the bitmask by bit operations.
 //
 // Parameter   :  lv          : Targeted refinement level to be flagged
 //                UseLBFunc   : Use the load-balance alternative functions for the grandson check and exchanging
@@ -71,6 +73,22 @@ void Flag_Real( const int lv, const UseLBFunc_t UseLBFunc )
    const int  Lohner_Stride           = Lohner_NVar*Lohner_NCell*Lohner_NCell*Lohner_NCell;  // stride of array for one patch
       
 
+   const int  FlagBuf                 = FLAG_BUFFER_SIZE;
+   const int  NRealPatch              = ( lv < MAX_LEVEL ) ? patch->NPatchComma[lv][1] : 0; // no flag at MAX_LEVEL
+
+// bitmasks of the cells within FLAG_BUFFER_SIZE from the -x/+x patch boundaries (and of all cells) 
+// --> MaskX[0/1/2] <--> [ -x / all / +x ], which correspond to the index "ii" in SibID_Array
+   uint MaskX[3] = { 0U, 0U, 0U };
+
+   for (int i=0; i<PS1; i++)
+   {
+      MaskX[1] |= 1U << i;
+
+      if ( i - FlagBuf < 0    )   MaskX[0] |= 1U << i;
+      if ( i + FlagBuf >= PS1 )   MaskX[2] |= 1U << i;
+   }
+
+
 #  pragma omp parallel
    {
       const real (*Fluid)[PS1][PS1][PS1] = NULL;
@@ -78,8 +96,10 @@ void Flag_Real( const int lv, const UseLBFunc_t UseLBFunc )
       real (*Pot )[PS1][PS1]             = NULL;
       real (*Lohner_Var)                 = NULL;   // array storing the variables for Lohner
       real (*Lohner_Slope)               = NULL;   // array storing the slopes of Lohner_Var for Lohner
-      int  i_start, i_end, j_start, j_end, k_start, k_end, SibID, PID;
-      bool ProperNesting, NextPatch;
+      uint FlagMask[PS1][PS1];                     // bitmask of the flagged cells: [k][j] --> bit i
+      uint RowOr[3][3];                            // "OR" of FlagMask over the [-z/all/+z][-y/all/+y] cells
+      int  SibID, PID;
+      bool ProperNesting, Lower_y, Upper_y, Lower_z, Upper_z;
 
 #     if   ( MODEL == HYDRO )
       if ( OPT__FLAG_PRES_GRADIENT )   Pres = new real [PS1][PS1][PS1];
@@ -97,7 +117,7 @@ void Flag_Real( const int lv, const UseLBFunc_t UseLBFunc )
 //    loop over all REAL patches (the buffer patches will be flagged only due to the FLAG_BUFFER_SIZE
 //    extension or the grandson check )
 #     pragma omp for
-      for (int PID0=0; PID0<patch->NPatchComma[lv][1]; PID0+=8)
+      for (int PID0=0; PID0<NRealPatch; PID0+=8)
       {
 //       prepare the ghost-zone data for Lohner
          if ( OPT__FLAG_LOHNER )    
@@ -123,84 +143,74 @@ void Flag_Real( const int lv, const UseLBFunc_t UseLBFunc )
 
 
 //          do flag check only if 26 siblings all exist (proper-nesting constraint)
-            if ( ProperNesting )
-            {
-               NextPatch = false;
-               Fluid     = patch->ptr[ patch->FluSg[lv] ][lv][PID]->fluid;
-#              ifdef GRAVITY
-               Pot       = patch->ptr[ patch->PotSg[lv] ][lv][PID]->pot;
-#              endif
+            if ( !ProperNesting )   continue;
 
+            Fluid = patch->ptr[ patch->FluSg[lv] ][lv][PID]->fluid;
+#           ifdef GRAVITY
+            Pot   = patch->ptr[ patch->PotSg[lv] ][lv][PID]->pot;
+#           endif
 
-//             evaluate pressure
-#              if   ( MODEL == HYDRO )
-               if ( OPT__FLAG_PRES_GRADIENT )
-               {
-                  const real Gamma_m1 = GAMMA - (real)1.0;
-                  real (*FluData)[PS1][PS1][PS1] = patch->ptr[ patch->FluSg[lv] ][lv][PID]->fluid;
-                  real Ek; 
 
-                  for (int k=0; k<PS1; k++)
-                  for (int j=0; j<PS1; j++)
-                  for (int i=0; i<PS1; i++)
-                  {
-                     Ek = (real)0.5*( FluData[MOMX][k][j][i]*FluData[MOMX][k][j][i] + 
-                                      FluData[MOMY][k][j][i]*FluData[MOMY][k][j][i] +
-                                      FluData[MOMZ][k][j][i]*FluData[MOMZ][k][j][i] ) / FluData[DENS][k][j][i];
+//          evaluate the slopes along x/y/z for Lohner
+            if ( OPT__FLAG_LOHNER )    GetSlope_for_Lohner( Lohner_Var+LocalID*Lohner_Stride, Lohner_Slope, Lohner_NCell, 
+                                                            Lohner_NVar );
+
+
+//          check all cells within the target patch at once (useless pointers are always == NULL)
+            if (  !Flag_Check( lv, PID, Fluid, Pot, Pres, Lohner_Var+LocalID*Lohner_Stride, Lohner_Slope, 
+                               Lohner_NCell, Lohner_NVar, FlagMask )  )
+               continue;
 
-                     Pres[k][j][i] = Gamma_m1 * ( FluData[ENGY][k][j][i] - Ek );
-                  }
-               }
 
-#              elif ( MODEL == MHD )
-#              warning : WAIT MHD !!!
-#              endif // MODEL
+//          flag itself
+            patch->ptr[0][lv][PID]->flag = true;
 
 
-//             evaluate the slopes along x/y/z for Lohner
-               if ( OPT__FLAG_LOHNER )    GetSlope_for_Lohner( Lohner_Var+LocalID*Lohner_Stride, Lohner_Slope, Lohner_NCell, 
-                                                               Lohner_NVar );
+//          flag sibling patches according to the size of FLAG_BUFFER_SIZE
+//          --> RowOr[kk][jj] collects the flagged cells whose (j,k) lie in the [-/all/+] buffer regions, and the
+//              sibling (ii,jj,kk) is flagged if any of these cells lies in the buffer region "ii" along x
+            for (int kk=0; kk<3; kk++)
+            for (int jj=0; jj<3; jj++)    RowOr[kk][jj] = 0U;
 
+            for (int k=0; k<PS1; k++)
+            {
+               Lower_z = ( k - FlagBuf < 0    );
+               Upper_z = ( k + FlagBuf >= PS1 );
 
-//             loop over all cells within the target patch
-               for (int k=0; k<PS1; k++)  {  if ( NextPatch )  break;
-                                             k_start = ( k - FLAG_BUFFER_SIZE < 0    ) ? 0 : 1;
-                                             k_end   = ( k + FLAG_BUFFER_SIZE >= PS1 ) ? 2 : 1;
+               for (int j=0; j<PS1; j++)
+               {
+                  const uint Mask = FlagMask[k][j];
 
-               for (int j=0; j<PS1; j++)  {  if ( NextPatch )  break; 
-                                             j_start = ( j - FLAG_BUFFER_SIZE < 0    ) ? 0 : 1;
-                                             j_end   = ( j + FLAG_BUFFER_SIZE >= PS1 ) ? 2 : 1;
+                  if ( Mask == 0U )  continue;
 
-               for (int i=0; i<PS1; i++)  {  if ( NextPatch )  break;
-                                             i_start = ( i - FLAG_BUFFER_SIZE < 0    ) ? 0 : 1;
-                                             i_end   = ( i + FLAG_BUFFER_SIZE >= PS1 ) ? 2 : 1;
+                  Lower_y = ( j - FlagBuf < 0    );
+                  Upper_y = ( j + FlagBuf >= PS1 );
 
-//                check if the targeted cell satisfies the refinement criteria (useless pointers are always == NULL)
-                  if (  lv < MAX_LEVEL  &&  Flag_Check( lv, PID, i, j, k, Fluid, Pot, Pres, Lohner_Var+LocalID*Lohner_Stride, 
-                                                        Lohner_Slope, Lohner_NCell, Lohner_NVar )  )
+                  for (int kk=0; kk<3; kk++)
                   {
-//                   flag itself
-                     patch->ptr[0][lv][PID]->flag = true;
+                     if (  ( kk == 0 && !Lower_z )  ||  ( kk == 2 && !Upper_z )  )   continue;
 
-//                   flag sibling patches according to the size of FLAG_BUFFER_SIZE
-                     for (int kk=k_start; kk<=k_end; kk++)
-                     for (int jj=j_start; jj<=j_end; jj++)
-                     for (int ii=i_start; ii<=i_end; ii++)
+                     for (int jj=0; jj<3; jj++)
                      {
-                        SibID = SibID_Array[kk][jj][ii];
+                        if (  ( jj == 0 && !Lower_y )  ||  ( jj == 2 && !Upper_y )  )   continue;
 
-                        if ( SibID != 999 )  
-                           patch->ptr[0][lv][ patch->ptr[0][lv][PID]->sibling[SibID] ]->flag = true;
+                        RowOr[kk][jj] |= Mask;
                      }
-
-//                   for FLAG_BUFFER_SIZE == PATCH_SIZE, once an cell is flagged, all 26 siblings will be flagged
-                     if ( FLAG_BUFFER_SIZE == PS1 )   NextPatch = true;
                   }
+               }
+            }
 
-               }}} // k, j, i
-            } // if ( ProperNesting )
+            for (int kk=0; kk<3; kk++)
+            for (int jj=0; jj<3; jj++)
+            for (int ii=0; ii<3; ii++)
+            {
+               SibID = SibID_Array[kk][jj][ii];
+
+               if ( SibID != 999  &&  ( RowOr[kk][jj] & MaskX[ii] ) )
+                  patch->ptr[0][lv][ patch->ptr[0][lv][PID]->sibling[SibID] ]->flag = true;
+            }
          } // for (int LocalID=0; LocalID<8; LocalID++)
-      } // for (int PID0=0; PID0<patch->NPatchComma[lv][1]; PID0+=8)
+      } // for (int PID0=0; PID0<NRealPatch; PID0+=8)
 
 
 #     if   ( MODEL == HYDRO )
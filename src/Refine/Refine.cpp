@@ -17,6 +17,10 @@ void ELBDM_GetPhase_DebugOnly( real *CData, const int CSize );
 //                2. Data of all sibling-buffer patches must be prepared in advance for creating new 
 //                   fine-grid patches by spatial interpolation
 //                3. If LOAD_BALANCE is turned on, this function will invoke "LB_Refine" and then return
+//                4. The patch IDs of all new child patches are determined in advance, and the new child patches
+//                   are then allocated and filled by spatial interpolation concurrently with OpenMP
+//                   --> The resulting patch order is the same as the serial version and is independent of the
+//                       number of OpenMP threads
 //
 // Parameter   :  lv : Targeted refinement level to be refined
 //-------------------------------------------------------------------------------------------------------
@@ -26,6 +30,14 @@ void Refine( const int lv )
 // invoke the load-balance refine function
 #  ifdef LOAD_BALANCE
    LB_Refine( lv );
+
+// invalidate the maximum gravitational acceleration recorded at level "lv+1" since new patches may be created
+#  if ( MODEL == HYDRO  &&  defined GRAVITY  &&  !defined GPU )
+   MinDtInfo_Gravity[lv+1] = __FLT_MIN__;
+#  endif
+
+   if ( OPT__NUMA_FIRST_TOUCH )  Aux_NUMA_FirstTouch( lv+1 );
+
    return;
 #  endif
 
@@ -56,10 +68,8 @@ void Refine( const int lv )
 #  endif
    const int Width  = PATCH_SIZE * patch->scale[lv+1];   // scale of a single patch at level "lv+1"
 
-   int *Cr            = NULL;    // corner coordinates
    int *BufGrandTable = NULL;    // table recording the patch IDs of grandson buffer patches
    int *BufSonTable   = NULL;    // table recording the linking index of each buffer father patch to BufGrandTable
-   patch_t *Pedigree  = NULL;    // pointer storing the relation of the targeted patch at level "lv"
 
 
 // parameters for spatial interpolation
@@ -73,18 +83,18 @@ void Refine( const int lv )
    const int CSize_Flu     = PATCH_SIZE + 2*CGhost_Flu;
    const int CStart_Flu[3] = { CGhost_Flu, CGhost_Flu, CGhost_Flu }; 
 
-   real Flu_CData[NCOMP][CSize_Flu][CSize_Flu][CSize_Flu];  // coarse-grid fluid array for interpolation
-   real Flu_FData[NCOMP][FSize][FSize][FSize];  // fine-grid fluid array storing the interpolation result
-
 #  ifdef GRAVITY
    int NSide_Pot, CGhost_Pot;
    Int_Table( OPT__REF_POT_INT_SCHEME, NSide_Pot, CGhost_Pot );
 
    const int CSize_Pot     = PATCH_SIZE + 2*CGhost_Pot;
    const int CStart_Pot[3] = { CGhost_Pot, CGhost_Pot, CGhost_Pot }; 
+#  endif
 
-   real Pot_CData[CSize_Pot][CSize_Pot][CSize_Pot];         // coarse-grid potential array for interpolation
-   real Pot_FData[FSize][FSize][FSize];         // fine-grid potential array storing the interpolation result
+// size of the temporary array reused by all interpolations of each thread
+   int IntScratchSize = Int_ScratchSize( OPT__REF_FLU_INT_SCHEME, CRange );
+#  ifdef GRAVITY
+   IntScratchSize     = MAX( IntScratchSize, Int_ScratchSize(OPT__REF_POT_INT_SCHEME, CRange) );
 #  endif
 
 
@@ -143,35 +153,174 @@ void Refine( const int lv )
 
 // c. check the refinement flags for all real patches at level "lv"
 // ------------------------------------------------------------------------------------------------
-//#  pragma omp parallel for private( ??? )
+// (c1) determine the final position of each child patch group at level "lv+1"
+// *** this serial pass only manipulates the patch group indices and reproduces exactly the patch order of
+//     the original one-by-one algorithm, in which a newly born patch group is appended to the end of the
+//     patch list and a removed patch group is replaced by the last patch group
+// *** the patch IDs of all new child patches are therefore known in advance so that they can be constructed
+//     concurrently, and the results are independent of the number of OpenMP threads
+// ================================================================================================
+   const int NGroupOld = patch->num[lv+1] / 8;  // number of existing patch groups at level "lv+1"
+   int NNewGroup = 0;                            // number of newly born patch groups
+   int NDelGroup = 0;                            // number of removed patch groups
+   int NGroup    = NGroupOld;                    // number of patch groups during and after the refinement
+
    for (int PID=0; PID<patch->NPatchComma[lv][1]; PID++)
    {
-      Pedigree = patch->ptr[0][lv][PID];
+      const patch_t *Pedigree = patch->ptr[0][lv][PID];
 
-//    (c1) construct new child patches if they are newly born (one patch group is allocated at a time)
-// ================================================================================================
+      if      (  Pedigree->flag  &&  Pedigree->son == -1 )    NNewGroup ++;
+      else if ( !Pedigree->flag  &&  Pedigree->son != -1 )    NDelGroup ++;
+   }
+
+   int *GroupSrc = new int [ NGroupOld + NNewGroup ]; // source of each patch group (old group ID or -1-FaPID)
+   int *GroupPos = new int [ NGroupOld ];             // current position of each existing patch group
+   int *DelFaPID = new int [ NDelGroup ];             // father patch IDs of the removed patch groups
+   int *NewGroup = new int [ NNewGroup ];             // positions of the newly born patch groups
+
+   for (int g=0; g<NGroupOld; g++)
+   {
+      GroupSrc[g] = g;
+      GroupPos[g] = g;
+   }
+
+   NDelGroup = 0;
+
+   for (int PID=0; PID<patch->NPatchComma[lv][1]; PID++)
+   {
+      const patch_t *Pedigree = patch->ptr[0][lv][PID];
+
+//    newly born patch group --> append to the end of the patch list
       if ( Pedigree->flag  &&  Pedigree->son == -1 )
+         GroupSrc[ NGroup ++ ] = -1 - PID;
+
+//    removed patch group --> replaced by the last patch group
+      else if ( !Pedigree->flag  &&  Pedigree->son != -1 )
+      {
+         const int Hole = GroupPos[ Pedigree->son/8 ];
+         const int Last = NGroup - 1;
+
+         if ( Hole != Last )
+         {
+            GroupSrc[Hole] = GroupSrc[Last];
+
+            if ( GroupSrc[Hole] >= 0 )    GroupPos[ GroupSrc[Hole] ] = Hole;
+         }
+
+         DelFaPID[ NDelGroup ++ ] = PID;
+         NGroup --;
+      }
+   } // for (int PID=0; PID<patch->NPatchComma[lv][1]; PID++)
+
+   NNewGroup = 0;
+
+   for (int g=0; g<NGroup; g++)
+      if ( GroupSrc[g] < 0 )  NewGroup[ NNewGroup ++ ] = g;
+
+// reserve the patch tables at level "lv+1" for all newly born child patches
+   patch->Reserve( lv+1, 8*( NGroupOld + NNewGroup ) );
+
+
+// (c2) remove unflagged child patches if they originally existed
+// ================================================================================================
+   for (int t=0; t<NDelGroup; t++)
+   {
+      patch_t *Pedigree = patch->ptr[0][lv][ DelFaPID[t] ];
+
+//    (c2.1) deallocate the unflagged child patches
+      for (int SonPID=Pedigree->son; SonPID<Pedigree->son+8; SonPID++)   patch->pdelete( lv+1, SonPID );
+
+//    (c2.2) construct relation : father -> son
+      Pedigree->son = -1;
+   }
+
+
+// (c3) relink the remaining child patch pointers so that no patch indices are skipped
+// *** a patch group is only moved toward the head of the patch list, and the patch group originally stored
+//     in the targeted slot has been either removed or moved before --> must be done in ascending order
+// ================================================================================================
+   for (int g=0; g<NGroup; g++)
+   {
+      if ( GroupSrc[g] < 0  ||  GroupSrc[g] == g )    continue;
+
+      const int NewPID0 = 8*g;
+      const int OldPID0 = 8*GroupSrc[g];
+      int NewPID, OldPID, GrandPID0, FaPID;
+
+      for (int t=0; t<8; t++)
       {
+         NewPID = NewPID0 + t;
+         OldPID = OldPID0 + t;
+
+//       relink pointers
+         patch->ptr[0][lv+1][NewPID] = patch->ptr[0][lv+1][OldPID];
+         patch->ptr[1][lv+1][NewPID] = patch->ptr[1][lv+1][OldPID];
+
+//       set redundant patch pointers as NULL
+         patch->ptr[0][lv+1][OldPID] = NULL; 
+         patch->ptr[1][lv+1][OldPID] = NULL; 
+
+//       re-construct relation : grandson -> son
+         GrandPID0 = patch->ptr[0][lv+1][NewPID]->son;
+         if ( GrandPID0 != -1 )
+         {
+            for (int GrandPID=GrandPID0; GrandPID<GrandPID0+8; GrandPID++)
+               patch->ptr[0][lv+2][GrandPID]->father = NewPID;
+         }
+      }
+
+//    re-construct relation : father -> son
+      FaPID = patch->ptr[0][lv+1][NewPID0]->father;
+      patch->ptr[0][lv][FaPID]->son = NewPID0;
+
+   } // for (int g=0; g<NGroup; g++)
+
+
+// (c4) construct new child patches concurrently (one patch group is allocated by one thread at a time)
+// ================================================================================================
+#  pragma omp parallel
+   {
+      real Flu_CData[NCOMP][CSize_Flu][CSize_Flu][CSize_Flu];  // coarse-grid fluid array for interpolation
+      real Flu_FData[NCOMP][FSize][FSize][FSize];  // fine-grid fluid array storing the interpolation result
+
+#     ifdef GRAVITY
+      real Pot_CData[CSize_Pot][CSize_Pot][CSize_Pot];         // coarse-grid potential array for interpolation
+      real Pot_FData[FSize][FSize][FSize];         // fine-grid potential array storing the interpolation result
+#     endif
+
+//    temporary array reused by all interpolations of this thread
+      real *IntScratch = new real [IntScratchSize];
+
+#     pragma omp for schedule( dynamic )
+      for (int t=0; t<NNewGroup; t++)
+      {
+#        ifdef TIMING_PATCH
+         const double Cycle0 = TIMER_CYCLE();
+#        endif
 
-//       (c1.1) construct relation : father -> child
-         Pedigree->son = patch->num[lv+1];
+         const int  PID      = -1 - GroupSrc[ NewGroup[t] ];    // father patch ID
+         const int  SonPID0  = 8*NewGroup[t];                    // ID of the first child patch
+         patch_t   *Pedigree = patch->ptr[0][lv][PID];
+         const int *Cr       = Pedigree->corner;                 // corner coordinates
 
 
-//       (c1.2) allocate child patches and construct relation : child -> father
-         Cr = Pedigree->corner;
+//       (c4.1) construct relation : father -> child
+         Pedigree->son = SonPID0;
 
-         patch->pnew( lv+1, Cr[0],       Cr[1],       Cr[2],       PID, true, true );
-         patch->pnew( lv+1, Cr[0]+Width, Cr[1],       Cr[2],       PID, true, true );
-         patch->pnew( lv+1, Cr[0],       Cr[1]+Width, Cr[2],       PID, true, true );
-         patch->pnew( lv+1, Cr[0],       Cr[1],       Cr[2]+Width, PID, true, true );
-         patch->pnew( lv+1, Cr[0]+Width, Cr[1]+Width, Cr[2],       PID, true, true );
-         patch->pnew( lv+1, Cr[0],       Cr[1]+Width, Cr[2]+Width, PID, true, true );
-         patch->pnew( lv+1, Cr[0]+Width, Cr[1],       Cr[2]+Width, PID, true, true );
-         patch->pnew( lv+1, Cr[0]+Width, Cr[1]+Width, Cr[2]+Width, PID, true, true );
 
+//       (c4.2) allocate child patches and construct relation : child -> father
+         patch->pnew( lv+1, Cr[0],       Cr[1],       Cr[2],       PID, true, true, SonPID0+0 );
+         patch->pnew( lv+1, Cr[0]+Width, Cr[1],       Cr[2],       PID, true, true, SonPID0+1 );
+         patch->pnew( lv+1, Cr[0],       Cr[1]+Width, Cr[2],       PID, true, true, SonPID0+2 );
+         patch->pnew( lv+1, Cr[0],       Cr[1],       Cr[2]+Width, PID, true, true, SonPID0+3 );
+         patch->pnew( lv+1, Cr[0]+Width, Cr[1]+Width, Cr[2],       PID, true, true, SonPID0+4 );
+         patch->pnew( lv+1, Cr[0],       Cr[1]+Width, Cr[2]+Width, PID, true, true, SonPID0+5 );
+         patch->pnew( lv+1, Cr[0]+Width, Cr[1],       Cr[2]+Width, PID, true, true, SonPID0+6 );
+         patch->pnew( lv+1, Cr[0]+Width, Cr[1]+Width, Cr[2]+Width, PID, true, true, SonPID0+7 );
 
-//       (c1.3) assign data to child patches by spatial interpolation
-//       (c1.3.1) fill up the central region of CData
+
+//       (c4.3) assign data to child patches by spatial interpolation
+//       (c4.3.1) fill up the central region of CData
          int I, J, K;
 
          for (int v=0; v<NCOMP; v++)         {
@@ -194,7 +343,7 @@ void Refine( const int lv )
 #        endif
 
 
-//       (c1.3.2) fill up the ghost zone of CData (no interpolation is required)
+//       (c4.3.2) fill up the ghost zone of CData (no interpolation is required)
          int Loop_i, Loop_j, Loop_k, Disp_i, Disp_j, Disp_k, Disp_i2, Disp_j2, Disp_k2, I2, J2, K2;
          int SibPID;
 
@@ -265,7 +414,7 @@ void Refine( const int lv )
 #        endif // #ifdef GRAVITY
 
 
-//       (c1.3.3) perform spatial interpolation
+//       (c4.3.3) perform spatial interpolation
          const int  CSize_Flu_Temp[3]    = { CSize_Flu, CSize_Flu, CSize_Flu };
          const int  FSize_Temp    [3]    = { FSize, FSize, FSize };
          const bool PhaseUnwrapping_Yes  = true;
@@ -273,7 +422,7 @@ void Refine( const int lv )
          const bool EnsurePositivity_Yes = true;
          const bool EnsurePositivity_No  = false;
 
-//       (c1.3.3.1) determine the variables which must be positive
+//       (c4.3.3.1) determine the variables which must be positive
          bool Positivity[NCOMP];
 
          for (int v=0; v<NCOMP; v++)
@@ -294,7 +443,7 @@ void Refine( const int lv )
 #           endif // MODEL
          }
 
-//       (c1.3.2.2) interpolation
+//       (c4.3.2.2) interpolation
 #        if ( MODEL == ELBDM )
          if ( OPT__INT_PHASE )
          {
@@ -311,20 +460,19 @@ void Refine( const int lv )
 //          interpolate density 
             Interpolate( &Flu_CData[DENS][0][0][0], CSize_Flu_Temp, CStart_Flu, CRange, &Flu_FData[DENS][0][0][0],
                          FSize_Temp, FStart, 1, OPT__REF_FLU_INT_SCHEME, PhaseUnwrapping_No, 
-                         EnsurePositivity_Yes );
+                         &EnsurePositivity_Yes, IntScratch );
 
 //          interpolate phase
             Interpolate( &Flu_CData[REAL][0][0][0], CSize_Flu_Temp, CStart_Flu, CRange, &Flu_FData[REAL][0][0][0],
                          FSize_Temp, FStart, 1, OPT__REF_FLU_INT_SCHEME, PhaseUnwrapping_Yes,
-                         EnsurePositivity_No );
+                         &EnsurePositivity_No, IntScratch );
          }
 
          else // if ( OPT__INT_PHASE )
          {
-            for (int v=0; v<NCOMP; v++)
-            Interpolate( &Flu_CData[v][0][0][0], CSize_Flu_Temp, CStart_Flu, CRange, &Flu_FData[v][0][0][0], 
-                         FSize_Temp, FStart, 1, OPT__REF_FLU_INT_SCHEME, PhaseUnwrapping_No, 
-                         Positivity[v] );
+            Interpolate( &Flu_CData[0][0][0][0], CSize_Flu_Temp, CStart_Flu, CRange, &Flu_FData[0][0][0][0], 
+                         FSize_Temp, FStart, NCOMP, OPT__REF_FLU_INT_SCHEME, PhaseUnwrapping_No, 
+                         Positivity, IntScratch );
          }
 
          if ( OPT__INT_PHASE )
@@ -350,10 +498,9 @@ void Refine( const int lv )
 
 #        else // #if ( MODEL == ELBDM )
 
-         for (int v=0; v<NCOMP; v++)
-         Interpolate( &Flu_CData[v][0][0][0], CSize_Flu_Temp, CStart_Flu, CRange, &Flu_FData[v][0][0][0], 
-                      FSize_Temp, FStart, 1, OPT__REF_FLU_INT_SCHEME, PhaseUnwrapping_No, 
-                      Positivity[v] );
+         Interpolate( &Flu_CData[0][0][0][0], CSize_Flu_Temp, CStart_Flu, CRange, &Flu_FData[0][0][0][0], 
+                      FSize_Temp, FStart, NCOMP, OPT__REF_FLU_INT_SCHEME, PhaseUnwrapping_No, 
+                      Positivity, IntScratch );
 
 #        endif // #if ( MODEL == ELBDM ) ... else 
 
@@ -363,16 +510,16 @@ void Refine( const int lv )
 
          Interpolate( &Pot_CData[0][0][0], CSize_Pot_Temp, CStart_Pot, CRange, &Pot_FData[0][0][0],
                       FSize_Temp, FStart, 1, OPT__REF_POT_INT_SCHEME, PhaseUnwrapping_No,
-                      EnsurePositivity_No );
+                      &EnsurePositivity_No, IntScratch );
 #        endif
 
 
-//       (c1.3.4) copy data from IntData to patch pointers
+//       (c4.3.4) copy data from IntData to patch pointers
          int SonPID;
 
          for (int LocalID=0; LocalID<8; LocalID++)
          {
-            SonPID = patch->num[lv+1] - 8 + LocalID;
+            SonPID = SonPID0 + LocalID;
             Disp_i = TABLE_02( LocalID, 'x', 0, PATCH_SIZE ); 
             Disp_j = TABLE_02( LocalID, 'y', 0, PATCH_SIZE ); 
             Disp_k = TABLE_02( LocalID, 'z', 0, PATCH_SIZE ); 
@@ -426,61 +573,31 @@ void Refine( const int lv )
 #           endif
          }
 
-      } // if ( Pedigree->flag  &&  Pedigree->son == -1 )
-
-
-//    (c2) remove unflagged child patches if they originally existed (one patch group is removed at a time)
-// ================================================================================================
-      else if ( !Pedigree->flag  &&  Pedigree->son != -1 )
-      {
-
-//       (c2.1) deallocate the unflagged child patches
-         const int SonPID0 = Pedigree->son;
-         const int NewPID0 = SonPID0;
-         const int OldPID0 = patch->num[lv+1] - 8;
+#        ifdef TIMING_PATCH
+         Pedigree->cost[COST_REF] += TIMER_CYCLE() - Cycle0;
+#        endif
 
-         for (int SonPID=SonPID0; SonPID<SonPID0+8; SonPID++)     patch->pdelete( lv+1, SonPID );
+      } // for (int t=0; t<NNewGroup; t++)
 
+      delete [] IntScratch;
 
-//       (c2.2) construct relation : father -> son
-         Pedigree->son = -1;
+   } // OpenMP parallel region
 
+   patch->num[lv+1] = 8*NGroup;
 
-//       (c2.3) relink the child patch pointers so that no patch indices are skipped
-         if ( NewPID0 != OldPID0 )  
-         {
-            int NewPID, OldPID, GrandPID0, FaPID;
 
-            for (int t=0; t<8; t++)
-            {
-               NewPID = NewPID0 + t;
-               OldPID = OldPID0 + t;
-
-//             relink pointers
-               patch->ptr[0][lv+1][NewPID] = patch->ptr[0][lv+1][OldPID];
-               patch->ptr[1][lv+1][NewPID] = patch->ptr[1][lv+1][OldPID];
-
-///            set redundant patch pointers as NULL
-               patch->ptr[0][lv+1][OldPID] = NULL; 
-               patch->ptr[1][lv+1][OldPID] = NULL; 
-
-//             re-construct relation : grandson -> son
-               GrandPID0 = patch->ptr[0][lv+1][NewPID]->son;
-               if ( GrandPID0 != -1 )
-               {
-                  for (int GrandPID=GrandPID0; GrandPID<GrandPID0+8; GrandPID++)
-                     patch->ptr[0][lv+2][GrandPID]->father = NewPID;
-               }
-            }
-
-//          re-construct relation : father -> son
-            FaPID = patch->ptr[0][lv+1][NewPID0]->father;
-            patch->ptr[0][lv][FaPID]->son = NewPID0;
+// invalidate the maximum gravitational acceleration recorded at level "lv+1" if new patches are created
+// --> "Hydro_GetTimeStep_Gravity" will re-evaluate it unless the gravity solver updates all patches at level
+//     "lv+1" (including the new ones) before the next time-step estimation
+#  if ( MODEL == HYDRO  &&  defined GRAVITY  &&  !defined GPU )
+   if ( NNewGroup > 0 )    MinDtInfo_Gravity[lv+1] = __FLT_MIN__;
+#  endif
 
-         } // if ( NewPID0 != OldPID0 )
+   delete [] GroupSrc;
+   delete [] GroupPos;
+   delete [] DelFaPID;
+   delete [] NewGroup;
 
-      } // else if ( !Pedigree->flag  &&  Pedigree->son != -1 )
-   } // for (int PID=0; PID<patch->NPatchComma[lv][1]; PID++)
 
 
 // initialize the patch->NPatchComma list for the buffer patches
@@ -545,6 +662,15 @@ void Refine( const int lv )
    Mis_GetTotalPatchNumber( lv+1 );
 #  endif
 
+
+// f. sort the patches at level "lv+1" along the space-filling curve
+// ------------------------------------------------------------------------------------------------
+   if ( OPT__PATCH_ORDER != PATCH_ORDER_NONE )  SortPatch( lv+1 );
+
+
+// place the data of the new patches on the NUMA nodes of the threads which will process them
+   if ( OPT__NUMA_FIRST_TOUCH )  Aux_NUMA_FirstTouch( lv+1 );
+
 } // FUNCTION : Refine
 
 
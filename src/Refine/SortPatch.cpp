@@ -0,0 +1,226 @@
+
+#include "DAINO.h"
+
+static long SFC_Morton ( const int Idx[], const int NBit );
+static long SFC_Hilbert( const int Idx[], const int NBit );
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  SortPatch
+// Description :  Sort all patch groups at level "lv" along the space-filling curve (Morton or Hilbert)
+//                so that spatially adjacent patch groups are also adjacent in memory
+//
+// Note        :  1. Work only if OPT__PATCH_ORDER != PATCH_ORDER_NONE
+//                2. Patches are sorted one patch group (8 patches) at a time so that the local order within
+//                   each patch group (and hence the relation assumed by "SiblingSearch") is preserved
+//                3. The relations "father(lv+1) -> lv", "son(lv-1) -> lv", and "sibling(lv) -> lv" are
+//                   remapped to the new patch IDs. Patch data, flags, and flux arrays are owned by each patch
+//                   and hence move together with the patch pointers.
+//                4. For the base level, the BaseP table is reconstructed as well
+//                5. Only the SERIAL mode is supported since the buffer patches and the MPI exchange lists
+//                   are not remapped
+//
+// Parameter   :  lv : Targeted refinement level
+//-------------------------------------------------------------------------------------------------------
+void SortPatch( const int lv )
+{
+
+   if ( OPT__PATCH_ORDER == PATCH_ORDER_NONE )  return;
+
+
+// check
+   if ( lv < 0  ||  lv >= NLEVEL )
+      Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "lv", lv );
+
+   if ( patch->NPatchComma[lv][1] != patch->num[lv] )
+      Aux_Error( ERROR_INFO, "%s does not support buffer patches (lv %d, NReal %d, NTotal %d) !!\n",
+                 __FUNCTION__, lv, patch->NPatchComma[lv][1], patch->num[lv] );
+
+
+   const int NPatch = patch->num[lv];
+   const int NGroup = NPatch / 8;
+
+   if ( NGroup <= 1 )   return;
+
+
+// 1. get the space-filling-curve index of each patch group
+// ===========================================================================================
+   const int GroupWidth = 2*PATCH_SIZE*patch->scale[lv];    // width of one patch group at level "lv"
+
+   int NGroup1D_Max = 1, NBit = 1, Idx[3];
+
+   for (int d=0; d<3; d++)    NGroup1D_Max = MAX( NGroup1D_Max, patch->BoxScale[d]/GroupWidth );
+
+   while ( (1<<NBit) < NGroup1D_Max )  NBit ++;
+
+   if ( 3*NBit > 8*(int)sizeof(long)-1 )
+      Aux_Error( ERROR_INFO, "number of bits of the space-filling-curve index (%d) exceeds the limit (%d) !!\n",
+                 3*NBit, 8*(int)sizeof(long)-1 );
+
+   long *SFC_Idx  = new long [NGroup];
+   int  *IdxTable = new int  [NGroup];
+   int  *NewPID   = new int  [NPatch];
+
+   for (int t=0; t<NGroup; t++)
+   {
+      for (int d=0; d<3; d++)    Idx[d] = patch->ptr[0][lv][8*t]->corner[d] / GroupWidth;
+
+      switch ( OPT__PATCH_ORDER )
+      {
+         case PATCH_ORDER_MORTON  :  SFC_Idx[t] = SFC_Morton ( Idx, NBit );   break;
+         case PATCH_ORDER_HILBERT :  SFC_Idx[t] = SFC_Hilbert( Idx, NBit );   break;
+
+         default : Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "OPT__PATCH_ORDER",
+                              OPT__PATCH_ORDER );
+      }
+   }
+
+
+// 2. sort the patch groups --> IdxTable[NewGroupID] = OldGroupID
+// ===========================================================================================
+   Mis_Heapsort( NGroup, SFC_Idx, IdxTable );
+
+   for (int t=0; t<NGroup; t++)
+   for (int LocalID=0; LocalID<8; LocalID++)
+      NewPID[ 8*IdxTable[t] + LocalID ] = 8*t + LocalID;
+
+
+// 3. relink the patch pointers
+// ===========================================================================================
+   patch_t **OldPtr = new patch_t* [NPatch];
+
+   for (int Sg=0; Sg<2; Sg++)
+   {
+      for (int PID=0; PID<NPatch; PID++)  OldPtr[PID] = patch->ptr[Sg][lv][PID];
+      for (int PID=0; PID<NPatch; PID++)  patch->ptr[Sg][lv][ NewPID[PID] ] = OldPtr[PID];
+   }
+
+   delete [] OldPtr;
+
+
+// 4. remap the patch relations
+// ===========================================================================================
+// 4-1. sibling at level "lv"
+#  pragma omp parallel for
+   for (int PID=0; PID<NPatch; PID++)
+   for (int s=0; s<26; s++)
+   {
+      const int SibPID = patch->ptr[0][lv][PID]->sibling[s];
+
+      if ( SibPID >= 0 )   patch->ptr[0][lv][PID]->sibling[s] = NewPID[SibPID];
+   }
+
+// 4-2. son at level "lv-1"
+   if ( lv > 0 )
+   {
+#     pragma omp parallel for
+      for (int FaPID=0; FaPID<patch->num[lv-1]; FaPID++)
+      {
+         const int SonPID = patch->ptr[0][lv-1][FaPID]->son;
+
+         if ( SonPID >= 0 )   patch->ptr[0][lv-1][FaPID]->son = NewPID[SonPID];
+      }
+   }
+
+// 4-3. father at level "lv+1"
+   if ( lv < NLEVEL-1 )
+   {
+#     pragma omp parallel for
+      for (int SonPID=0; SonPID<patch->num[lv+1]; SonPID++)
+      {
+         const int FaPID = patch->ptr[0][lv+1][SonPID]->father;
+
+         if ( FaPID >= 0 )    patch->ptr[0][lv+1][SonPID]->father = NewPID[FaPID];
+      }
+   }
+
+// 4-4. reconstruct the BaseP table for the base level
+   if ( lv == 0 )    Init_RecordBasePatch();
+
+
+   delete [] SFC_Idx;
+   delete [] IdxTable;
+   delete [] NewPID;
+
+} // FUNCTION : SortPatch
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  SFC_Morton
+// Description :  Return the Morton (Z-order) index of the input 3D integer coordinates
+//
+// Parameter   :  Idx  : Input 3D integer coordinates
+//                NBit : Number of bits in each coordinate
+//-------------------------------------------------------------------------------------------------------
+long SFC_Morton( const int Idx[], const int NBit )
+{
+
+   long Key = 0;
+
+   for (int b=NBit-1; b>=0; b--)
+   for (int d=2; d>=0; d--)
+      Key = ( Key << 1 ) | (long)( ( Idx[d] >> b ) & 1 );
+
+   return Key;
+
+} // FUNCTION : SFC_Morton
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  SFC_Hilbert
+// Description :  Return the Hilbert index of the input 3D integer coordinates
+//
+// Note        :  Ref : J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc. 707, 381 (2004)
+//                --> Convert the coordinates to the "transposed" Hilbert index and then interleave the bits
+//
+// Parameter   :  Idx  : Input 3D integer coordinates
+//                NBit : Number of bits in each coordinate
+//-------------------------------------------------------------------------------------------------------
+long SFC_Hilbert( const int Idx[], const int NBit )
+{
+
+   const uint M = 1U << ( NBit - 1 );
+
+   uint X[3] = { (uint)Idx[0], (uint)Idx[1], (uint)Idx[2] };
+   uint P, t;
+
+// inverse undo
+   for (uint Q=M; Q>1; Q>>=1)
+   {
+      P = Q - 1;
+
+      for (int d=0; d<3; d++)
+      {
+         if ( X[d] & Q )   X[0] ^= P;
+         else
+         {
+            t     = ( X[0] ^ X[d] ) & P;
+            X[0] ^= t;
+            X[d] ^= t;
+         }
+      }
+   }
+
+// Gray encode
+   for (int d=1; d<3; d++)    X[d] ^= X[d-1];
+
+   t = 0;
+   for (uint Q=M; Q>1; Q>>=1)
+      if ( X[2] & Q )   t ^= Q - 1;
+
+   for (int d=0; d<3; d++)    X[d] ^= t;
+
+// interleave the transposed index
+   long Key = 0;
+
+   for (int b=NBit-1; b>=0; b--)
+   for (int d=0; d<3; d++)
+      Key = ( Key << 1 ) | (long)( ( X[d] >> b ) & 1 );
+
+   return Key;
+
+} // FUNCTION : SFC_Hilbert
@@ -11,7 +11,9 @@ void CPU_PoissonSolver_SOR( const real Rho_Array    [][RHO_NXT][RHO_NXT][RHO_NXT
                             const real Pot_Array_In [][POT_NXT][POT_NXT][POT_NXT], 
                                   real Pot_Array_Out[][GRA_NXT][GRA_NXT][GRA_NXT], 
                             const int NPatchGroup, const real dh, const int Min_Iter, const int Max_Iter, 
-                            const real Omega, const real Poi_Coeff, const IntScheme_t IntScheme );
+                            const real Omega, const real Tolerated_Error, const real Poi_Coeff,
+                            const IntScheme_t IntScheme, const bool WarmStart, long IterCounter[],
+                            double Cost[] );
 
 #elif ( POT_SCHEME == MG  )
 void CPU_PoissonSolver_MG( const real Rho_Array    [][RHO_NXT][RHO_NXT][RHO_NXT],
@@ -19,7 +21,8 @@ void CPU_PoissonSolver_MG( const real Rho_Array    [][RHO_NXT][RHO_NXT][RHO_NXT]
                                  real Pot_Array_Out[][GRA_NXT][GRA_NXT][GRA_NXT],
                            const int NPatchGroup, const real dh_Min, const int Max_Iter, const int NPre_Smooth,
                            const int NPost_Smooth, const real Tolerated_Error, const real Poi_Coeff, 
-                           const IntScheme_t IntScheme );
+                           const IntScheme_t IntScheme, const bool WarmStart, long IterCounter[],
+                           double Cost[] );
 #endif // POT_SCHEME
 
 
@@ -27,7 +30,8 @@ void CPU_PoissonSolver_MG( const real Rho_Array    [][RHO_NXT][RHO_NXT][RHO_NXT]
 #if   ( MODEL == HYDRO )
 void CPU_HydroGravitySolver(       real Flu_Array[][GRA_NIN][PATCH_SIZE][PATCH_SIZE][PATCH_SIZE], 
                              const real Pot_Array[][GRA_NXT][GRA_NXT][GRA_NXT],
-                             const int NPatchGroup, const real dt, const real dh, const bool P5_Gradient );
+                             const int NPatchGroup, const real dt, const real dh, const bool P5_Gradient,
+                             real *MaxAcc );
 
 #elif ( MODEL == MHD )
 #warning : WAIT MHD !!!
@@ -59,6 +63,7 @@ void CPU_ELBDMGravitySolver(       real Flu_Array[][GRA_NIN][PATCH_SIZE][PATCH_S
 //                SOR_Min_Iter         : Minimum number of iterations for SOR
 //                SOR_Max_Iter         : Maximum number of iterations for SOR
 //                SOR_Omega            : Over-relaxation parameter
+//                SOR_Tolerated_Error  : Relative residual to terminate the SOR iteration (<= 0 --> disabled)
 //                MG_Max_Iter          : Maximum number of iterations for multigrid
 //                MG_NPre_Smooth       : Number of pre-smoothing steps for multigrid
 //                MG_NPos_tSmooth      : Number of post-smoothing steps for multigrid
@@ -73,6 +78,13 @@ void CPU_ELBDMGravitySolver(       real Flu_Array[][GRA_NIN][PATCH_SIZE][PATCH_S
 //                Eta                  : Particle mass / Planck constant
 //                Poisson              : true --> invoke the Poisson solver
 //                GraAcc               : true --> invoke the Gravity solver
+//                Poi_WarmStart        : true --> use the initial guess of potential stored in h_Pot_Array_Out
+//                Poi_IterCounter      : Number of patches [0] and total number of iterations [1] of the
+//                                       Poisson solver
+//                Poi_Cost             : Array to store the cost (in CPU cycles) of each patch in the Poisson
+//                                       solver --> for the option "TIMING_PATCH" only (NULL --> off)
+//                Gra_MaxAcc           : Maximum gravitational acceleration to be updated by the gravity solver
+//                                       --> for the time-step estimation of the HYDRO model (NULL --> off)
 //
 // Useless parameters in HYDRO : Eta
 // Useless parameters in ELBDM : P5_Gradient
@@ -82,10 +94,12 @@ void CPU_PoissonGravitySolver( const real h_Rho_Array    [][RHO_NXT][RHO_NXT][RH
                                      real h_Pot_Array_Out[][GRA_NXT][GRA_NXT][GRA_NXT],
                                      real h_Flu_Array    [][GRA_NIN][PATCH_SIZE][PATCH_SIZE][PATCH_SIZE], 
                                const int NPatchGroup, const real dt, const real dh, const int SOR_Min_Iter, 
-                               const int SOR_Max_Iter, const real SOR_Omega, const int MG_Max_Iter,
-                               const int MG_NPre_Smooth, const int MG_NPost_Smooth, const real MG_Tolerated_Error,
-                               const real Poi_Coeff, const IntScheme_t IntScheme, const bool P5_Gradient,
-                               const real Eta, const bool Poisson, const bool GraAcc )
+                               const int SOR_Max_Iter, const real SOR_Omega, const real SOR_Tolerated_Error,
+                               const int MG_Max_Iter, const int MG_NPre_Smooth, const int MG_NPost_Smooth,
+                               const real MG_Tolerated_Error, const real Poi_Coeff, const IntScheme_t IntScheme,
+                               const bool P5_Gradient, const real Eta, const bool Poisson, const bool GraAcc,
+                               const bool Poi_WarmStart, long Poi_IterCounter[], double Poi_Cost[],
+                               real *Gra_MaxAcc )
 {
 
 // check
@@ -99,14 +113,14 @@ void CPU_PoissonGravitySolver( const real h_Rho_Array    [][RHO_NXT][RHO_NXT][RH
 #     if   ( POT_SCHEME == SOR )
 
       CPU_PoissonSolver_SOR( h_Rho_Array, h_Pot_Array_In, h_Pot_Array_Out, NPatchGroup, dh, 
-                             SOR_Min_Iter, SOR_Max_Iter, SOR_Omega, 
-                             Poi_Coeff, IntScheme );
+                             SOR_Min_Iter, SOR_Max_Iter, SOR_Omega, SOR_Tolerated_Error,
+                             Poi_Coeff, IntScheme, Poi_WarmStart, Poi_IterCounter, Poi_Cost );
 
 #     elif ( POT_SCHEME == MG  )
 
       CPU_PoissonSolver_MG ( h_Rho_Array, h_Pot_Array_In, h_Pot_Array_Out, NPatchGroup, dh, 
                              MG_Max_Iter, MG_NPre_Smooth, MG_NPost_Smooth, MG_Tolerated_Error, 
-                             Poi_Coeff, IntScheme );
+                             Poi_Coeff, IntScheme, Poi_WarmStart, Poi_IterCounter, Poi_Cost );
 
 #     else
 
@@ -120,7 +134,7 @@ void CPU_PoissonGravitySolver( const real h_Rho_Array    [][RHO_NXT][RHO_NXT][RH
    if ( GraAcc )
    {
 #     if   ( MODEL == HYDRO )
-      CPU_HydroGravitySolver( h_Flu_Array, h_Pot_Array_Out, NPatchGroup, dt, dh, P5_Gradient );
+      CPU_HydroGravitySolver( h_Flu_Array, h_Pot_Array_Out, NPatchGroup, dt, dh, P5_Gradient, Gra_MaxAcc );
 
 #     elif ( MODEL == MHD )
 #     error : WAIT MHD !!!
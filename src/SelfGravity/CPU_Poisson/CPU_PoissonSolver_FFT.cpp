@@ -9,7 +9,8 @@
 
 
 
-static void FFT( real *RhoK, const real Poi_Coeff, const int j_start, const int dj, const int RhoK_Size );
+static void FFT( real *RhoK, const real Poi_Coeff, const int j_start, const int dj, const int RhoK_Size,
+                 const double PrepTime );
 
 #ifdef SERIAL
 extern rfftwnd_plan     FFTW_Plan, FFTW_Plan_Inv;
@@ -216,15 +217,20 @@ void Slice_to_Cube( real *RhoK, real *SendBuf, real *RecvBuf, const int SaveSg )
 // Function    :  FFT
 // Description :  Evaluate the gravitational potential by FFT 
 //
-// Note        :  Work with the periodic B.C.
+// Note        :  1. Work with the periodic B.C.
+//                2. The base-level power spectrum is binned from the k-space density right after the forward
+//                   FFT if either OPT__OUTPUT_BASEPS or OPT__RECORD_BASEPS is on
+//                   --> It is skipped if it will not be adopted by the next output (see "StoreBasePowerSpectrum")
 //
 // Parameter   :  RhoK        : Array storing the input density and output potential
 //                Poi_Coeff   : Poi_Coefficient in front of density in the Poisson equation (4*Pi*Newton_G*a)   
 //                j_start     : Starting j index
 //                dj          : Size of array in the j (y) direction after the forward FFT
 //                RhoK_Size   : Size of the array "RhoK"
+//                PrepTime    : Physical time of the input density
 //-------------------------------------------------------------------------------------------------------
-void FFT( real *RhoK, const real Poi_Coeff, const int j_start, const int dj, const int RhoK_Size )
+void FFT( real *RhoK, const real Poi_Coeff, const int j_start, const int dj, const int RhoK_Size,
+          const double PrepTime )
 {
 
    const int Nx        = NX0_TOT[0];
@@ -248,6 +254,11 @@ void FFT( real *RhoK, const real Poi_Coeff, const int j_start, const int dj, con
    cdata = (fftw_complex*) RhoK;
 
 
+// record the power spectrum of the base-level density
+   if ( OPT__OUTPUT_BASEPS  ||  OPT__RECORD_BASEPS > 0 )
+      StoreBasePowerSpectrum( RhoK, j_start, dj, PrepTime );
+
+
 // set up the dimensionless wave number and the corresponding sin(k)^2 function
    real kx[Nx_Padded], ky[Ny], kz[Nz];
    real sinkx2[Nx_Padded], sinky2[Ny], sinkz2[Nz];
@@ -330,8 +341,9 @@ void FFT( real *RhoK, const real Poi_Coeff, const int j_start, const int dj, con
 //
 // Parameter   :  Poi_Coeff   : Coefficient in front of the RHS in the Poisson eq.
 //                SaveSg      : Sandglass to store the updated data 
+//                PrepTime    : Physical time of the base-level density
 //-------------------------------------------------------------------------------------------------------
-void CPU_PoissonSolver_FFT( const real Poi_Coeff, const int SaveSg )
+void CPU_PoissonSolver_FFT( const real Poi_Coeff, const int SaveSg, const double PrepTime )
 {
 
 // get the array indices using by FFTW
@@ -392,7 +404,7 @@ void CPU_PoissonSolver_FFT( const real Poi_Coeff, const int SaveSg )
    Timer_Gra_Advance[0]->Start();
 #  endif
 
-   FFT( RhoK, Poi_Coeff, local_y_start_after_transpose, local_ny_after_transpose, total_local_size );
+   FFT( RhoK, Poi_Coeff, local_y_start_after_transpose, local_ny_after_transpose, total_local_size, PrepTime );
 
 #  if ( defined OOC  &&  defined TIMING )
    MPI_Barrier( MPI_COMM_WORLD );
@@ -24,11 +24,17 @@ static void Prolongate_and_Correct( const real *CData_1D, real *FData_1D, const
 // Function    :  CPU_PoissonSolver_MG
 // Description :  Use CPU to solve the Poisson equation by the multigrid scheme
 //
-// Note        :  Reference : Numerical Recipes, Chapter 20.6
+// Note        :  1. Reference : Numerical Recipes, Chapter 20.6
+//                2. WarmStart == true : the interior potential of each patch is replaced by the initial guess
+//                   stored in the central PATCH_SIZE^3 cells of "Pot_Array_Out" (prepared by the function
+//                   "Poi_Prepare_PotGuess") after interpolating the coarse-grid potential
+//                   --> the error is evaluated before the first V-cycle so that no V-cycle is performed if
+//                       the initial guess already satisfies "Tolerated_Error"
+//                3. The number of patches and the total number of V-cycles are accumulated in "IterCounter"
 //
 // Parameter   :  Rho_Array         : Array to store the input density 
 //                Pot_Array_In      : Array to store the input "coarse-grid" potential for interpolation
-//                Pot_Array_Out     : Array to store the output potential
+//                Pot_Array_Out     : Array to store the output potential (and the input initial guess if WarmStart)
 //                NPatchGroup       : Number of patch groups evaluated at a time
 //                dh_Min            : Grid size of the input data
 //                Max_Iter          : Maximum number of iterations for multigrid
@@ -41,13 +47,18 @@ static void Prolongate_and_Correct( const real *CData_1D, real *FData_1D, const
 //                                        INT_CENTRAL : central interpolation
 //                                        INT_CQUAD   : conservative quadratic interpolation 
 //                                        INT_QUAD    : quadratic interpolation 
+//                WarmStart         : Use the initial guess stored in Pot_Array_Out
+//                IterCounter       : Number of patches [0] and total number of V-cycles [1]
+//                Cost              : Array to store the cost (in CPU cycles) of each patch
+//                                    --> for the option "TIMING_PATCH" only (NULL --> off)
 //-------------------------------------------------------------------------------------------------------
 void CPU_PoissonSolver_MG( const real Rho_Array    [][RHO_NXT][RHO_NXT][RHO_NXT],
                            const real Pot_Array_In [][POT_NXT][POT_NXT][POT_NXT],
                                  real Pot_Array_Out[][GRA_NXT][GRA_NXT][GRA_NXT],
                            const int NPatchGroup, const real dh_Min, const int Max_Iter, const int NPre_Smooth,
                            const int NPost_Smooth, const real Tolerated_Error, const real Poi_Coeff,
-                           const IntScheme_t IntScheme )
+                           const IntScheme_t IntScheme, const bool WarmStart, long IterCounter[],
+                           double Cost[] )
 {
 
    const int  NPatch    = NPatchGroup*8;
@@ -90,6 +101,7 @@ void CPU_PoissonSolver_MG( const real Rho_Array    [][RHO_NXT][RHO_NXT][RHO_NXT]
    {
       int ip, jp, kp, im, jm, km, I, J, K, Ip, Jp, Kp, ii, jj, kk, Iter, x, y, z, Count, Idx;
       real Slope_x, Slope_y, Slope_z, C2_Slope[13], Error;
+      long NIter = 0;
 
 //    multigrid arrays
       real (**Sol) = new real* [BottomLv+1];    // solution
@@ -118,6 +130,9 @@ void CPU_PoissonSolver_MG( const real Rho_Array    [][RHO_NXT][RHO_NXT][RHO_NXT]
 #     pragma omp for
       for (int P=0; P<NPatch; P++)
       {
+#        ifdef TIMING_PATCH
+         const double Cycle0 = TIMER_CYCLE();
+#        endif
 
 //       a. interpolation : Pot_Array_In --> Pot_Array_Int
 // ------------------------------------------------------------------------------------------------------------
@@ -270,6 +285,20 @@ void CPU_PoissonSolver_MG( const real Rho_Array    [][RHO_NXT][RHO_NXT][RHO_NXT]
 
          }}}
 
+//       replace the interior potential by the input initial guess
+         if ( WarmStart )
+         {
+            real (*Sol_3D)[RHO_NXT+2][RHO_NXT+2] = ( real(*)[RHO_NXT+2][RHO_NXT+2] )Sol[0];
+
+            for (int k=0; k<PATCH_SIZE; k++)    {  K = k + POT_GHOST_SIZE;   kk = k + GRA_GHOST_SIZE;
+            for (int j=0; j<PATCH_SIZE; j++)    {  J = j + POT_GHOST_SIZE;   jj = j + GRA_GHOST_SIZE;
+            for (int i=0; i<PATCH_SIZE; i++)    {  I = i + POT_GHOST_SIZE;   ii = i + GRA_GHOST_SIZE;
+
+               Sol_3D[K][J][I] = Pot_Array_Out[P][kk][jj][ii];
+
+            }}}
+         }
+
 
 
 //       c. use the MG scheme to evaluate potential
@@ -277,6 +306,8 @@ void CPU_PoissonSolver_MG( const real Rho_Array    [][RHO_NXT][RHO_NXT][RHO_NXT]
          Iter  = 0;
          Error = __FLT_MAX__;
 
+         if ( WarmStart )  ComputeDefect( Sol[0], RHS[0], Def[0], dh[0], NGrid[0], true, Error );
+
          while ( Iter < Max_Iter  &&  Error > Tolerated_Error )
          {
 //          V-cycle : finer --> coarser grids
@@ -324,6 +355,8 @@ void CPU_PoissonSolver_MG( const real Rho_Array    [][RHO_NXT][RHO_NXT][RHO_NXT]
 
 //       Aux_Message( stdout, "Patch %3d : number of iterations = %3d\n", P, Iter );
 
+         NIter += Iter;
+
          if ( Error > Tolerated_Error )
          {
             Aux_Message( stderr, "WARNING : Rank = %2d, Patch %6d exceeds the maximum tolerated error ",
@@ -344,6 +377,10 @@ void CPU_PoissonSolver_MG( const real Rho_Array    [][RHO_NXT][RHO_NXT][RHO_NXT]
 
          }}}
 
+#        ifdef TIMING_PATCH
+         if ( Cost != NULL )  Cost[P] = TIMER_CYCLE() - Cycle0;
+#        endif
+
       } // for (int P=0; P<NPatch; P++)
 
 
@@ -359,8 +396,14 @@ void CPU_PoissonSolver_MG( const real Rho_Array    [][RHO_NXT][RHO_NXT][RHO_NXT]
       delete [] RHS;
       delete [] Def;
 
+#     pragma omp atomic
+      IterCounter[1] += NIter;
+
    } // OpenMP parallel region
 
+
+   IterCounter[0] += NPatch;
+
 } // FUNCTION : CPU_PoissonSolver_MG
 
 
@@ -16,28 +16,46 @@
 // Function    :  CPU_PoissonSolver_SOR
 // Description :  Use CPU to solve the Poisson equation by the SOR scheme
 //
-// Note        :  Reference : Numerical Recipes, Chapter 20.5
-
+// Note        :  1. Reference : Numerical Recipes, Chapter 20.5
+//                2. The iteration is terminated if
+//                   (a) the relative residual sum(|residual|)/sum(|potential|) drops below "Tolerated_Error"
+//                       (which is checked in every iteration and is disabled if Tolerated_Error <= 0), or
+//                   (b) the total residual begins to grow after "Min_Iter" iterations, or
+//                   (c) the number of iterations reaches "Max_Iter"
+//                3. WarmStart == true : the interior potential of each patch is replaced by the initial guess
+//                   stored in the central PATCH_SIZE^3 cells of "Pot_Array_Out" (prepared by the function
+//                   "Poi_Prepare_PotGuess") after interpolating the coarse-grid potential
+//                   --> the coarse-grid potential is still used as the B.C. and as the initial guess of the
+//                       ghost zones
+//                4. The number of patches and the total number of iterations are accumulated in "IterCounter"
+//
 // Parameter   :  Rho_Array      : Array to store the input density 
 //                Pot_Array_In   : Array to store the input "coarse-grid" potential for interpolation
-//                Pot_Array_Out  : Array to store the output potential
+//                Pot_Array_Out  : Array to store the output potential (and the input initial guess if WarmStart)
 //                NPatchGroup    : Number of patch groups evaluated at a time
 //                dh             : Grid size
 //                Min_Iter       : Minimum # of iterations for SOR
 //                Max_Iter       : Maximum # of iterations for SOR
 //                Omega          : Over-relaxation parameter
+//                Tolerated_Error: Relative residual to terminate the SOR iteration (<= 0 --> disabled)
 //                Poi_Coeff      : Coefficient in front of the RHS in the Poisson eq.
 //                IntScheme      : Interpolation scheme for potential
 //                                 --> currently supported schemes include
 //                                     INT_CENTRAL : central interpolation
 //                                     INT_CQUAD   : conservative quadratic interpolation 
 //                                     INT_QUAD    : quadratic interpolation 
+//                WarmStart      : Use the initial guess stored in Pot_Array_Out
+//                IterCounter    : Number of patches [0] and total number of iterations [1]
+//                Cost           : Array to store the cost (in CPU cycles) of each patch
+//                                 --> for the option "TIMING_PATCH" only (NULL --> off)
 //-------------------------------------------------------------------------------------------------------
 void CPU_PoissonSolver_SOR( const real Rho_Array    [][RHO_NXT][RHO_NXT][RHO_NXT], 
                             const real Pot_Array_In [][POT_NXT][POT_NXT][POT_NXT], 
                                   real Pot_Array_Out[][GRA_NXT][GRA_NXT][GRA_NXT], 
                             const int NPatchGroup, const real dh, const int Min_Iter, const int Max_Iter, 
-                            const real Omega, const real Poi_Coeff, const IntScheme_t IntScheme )
+                            const real Omega, const real Tolerated_Error, const real Poi_Coeff,
+                            const IntScheme_t IntScheme, const bool WarmStart, long IterCounter[],
+                            double Cost[] )
 {
 
    const int  NPatch    = NPatchGroup*8;
@@ -53,7 +71,8 @@ void CPU_PoissonSolver_SOR( const real Rho_Array    [][RHO_NXT][RHO_NXT][RHO_NXT
    {
       int i_start, i_start_pass, i_start_k;     // i_start_(pass,k) : record the i_start in the (pass,k) loop
       int ip, jp, kp, im, jm, km, I, J, K, Ip, Jp, Kp, ii, jj, kk, Iter, x, y, z;
-      real Slope_x, Slope_y, Slope_z, C2_Slope[13], Residual_Total_Old, Residual_Total, Residual;
+      real Slope_x, Slope_y, Slope_z, C2_Slope[13], Residual_Total_Old, Residual_Total, Residual, Pot_Total;
+      long NIter = 0;
 
 //    array to store the interpolated "fine-grid" potential (as the initial guess and the B.C.)
       real (*Pot_Array_Int)[POT_NXT_INT][POT_NXT_INT] = new real [POT_NXT_INT][POT_NXT_INT][POT_NXT_INT];
@@ -63,6 +82,9 @@ void CPU_PoissonSolver_SOR( const real Rho_Array    [][RHO_NXT][RHO_NXT][RHO_NXT
 #     pragma omp for
       for (int P=0; P<NPatch; P++)
       {
+#        ifdef TIMING_PATCH
+         const double Cycle0 = TIMER_CYCLE();
+#        endif
 
 //       a. interpolation : Pot_Array_In --> Pot_Array_Int
 // ------------------------------------------------------------------------------------------------------------
@@ -194,6 +216,19 @@ void CPU_PoissonSolver_SOR( const real Rho_Array    [][RHO_NXT][RHO_NXT][RHO_NXT
          } // switch ( IntScheme )
 
 
+//       a2. replace the interior potential by the input initial guess
+         if ( WarmStart )
+         {
+            for (int k=0; k<PATCH_SIZE; k++)    {  K = k + POT_GHOST_SIZE + POT_USELESS;   kk = k + GRA_GHOST_SIZE;
+            for (int j=0; j<PATCH_SIZE; j++)    {  J = j + POT_GHOST_SIZE + POT_USELESS;   jj = j + GRA_GHOST_SIZE;
+            for (int i=0; i<PATCH_SIZE; i++)    {  I = i + POT_GHOST_SIZE + POT_USELESS;   ii = i + GRA_GHOST_SIZE;
+
+               Pot_Array_Int[K][J][I] = Pot_Array_Out[P][kk][jj][ii];
+
+            }}}
+         }
+
+
 
 //       b. use the SOR scheme to evaluate potential (store in the Pot_Array_Int array)
 // ------------------------------------------------------------------------------------------------------------
@@ -202,6 +237,7 @@ void CPU_PoissonSolver_SOR( const real Rho_Array    [][RHO_NXT][RHO_NXT][RHO_NXT
          for (Iter=0; Iter<Max_Iter; Iter++)
          {
             Residual_Total = (real)0.0;
+            Pot_Total      = (real)0.0;
             i_start_pass   = 1 + POT_USELESS;
 
 //          odd-even ordering
@@ -237,8 +273,9 @@ void CPU_PoissonSolver_SOR( const real Rho_Array    [][RHO_NXT][RHO_NXT][RHO_NXT
 //                      update potential
                         Pot_Array_Int[k][j][i] += Omega_6*Residual;
 
-//                      sum up the 1-norm of all residuals
+//                      sum up the 1-norm of all residuals and potential
                         Residual_Total += FABS( Residual );
+                        Pot_Total      += FABS( Pot_Array_Int[k][j][i] );
 
                      } // i
 
@@ -255,6 +292,13 @@ void CPU_PoissonSolver_SOR( const real Rho_Array    [][RHO_NXT][RHO_NXT][RHO_NXT
             } // for (int pass=0; pass<2; pass++)
 
 
+//          terminate the SOR iteration if the relative residual is small enough
+            if ( Tolerated_Error > (real)0.0  &&  Residual_Total <= Tolerated_Error*Pot_Total )
+            {
+               Iter++;
+               break;
+            }
+
 //          terminate the SOR iteration if the total residual begins to grow  
 //          we set the minimum number of iterations because usually the total residual will grow at the first step
             if (  Iter+1 >= Min_Iter  &&  Residual_Total > Residual_Total_Old )
@@ -272,6 +316,8 @@ void CPU_PoissonSolver_SOR( const real Rho_Array    [][RHO_NXT][RHO_NXT][RHO_NXT
             Aux_Message( stderr, "WARNING : Rank = %2d, Patch %6d exceeds Max_Iter in the SOR iteration !!\n", 
                          DAINO_RANK, P );      
 
+         NIter += Iter;
+
 
 //       c. copy data : Pot_Array_Int --> Pot_Array_Out
 // ------------------------------------------------------------------------------------------------------------
@@ -283,13 +329,23 @@ void CPU_PoissonSolver_SOR( const real Rho_Array    [][RHO_NXT][RHO_NXT][RHO_NXT
 
          }}}
 
+#        ifdef TIMING_PATCH
+         if ( Cost != NULL )  Cost[P] = TIMER_CYCLE() - Cycle0;
+#        endif
+
       } // for (int P=0; P<NPatch; P++)
 
 
       delete [] Pot_Array_Int;
 
+#     pragma omp atomic
+      IterCounter[1] += NIter;
+
    } // OpenMP parallel region
 
+
+   IterCounter[0] += NPatch;
+
 } // FUNCTION : CPU_PoissonSolver_SOR
 
 
@@ -21,11 +21,17 @@ void End_MemFree_PoissonGravity()
       if ( h_Pot_Array_P_In [t] != NULL )    delete [] h_Pot_Array_P_In [t];
       if ( h_Pot_Array_P_Out[t] != NULL )    delete [] h_Pot_Array_P_Out[t];
       if ( h_Flu_Array_G    [t] != NULL )    delete [] h_Flu_Array_G    [t];
+#     ifdef TIMING_PATCH
+      if ( h_Pot_Cost_Array [t] != NULL )    delete [] h_Pot_Cost_Array [t];
+#     endif
 
       h_Rho_Array_P    [t] = NULL; 
       h_Pot_Array_P_In [t] = NULL;
       h_Pot_Array_P_Out[t] = NULL;
       h_Flu_Array_G    [t] = NULL;
+#     ifdef TIMING_PATCH
+      h_Pot_Cost_Array [t] = NULL;
+#     endif
    }
 
 } // FUNCTION : End_MemFree_PoissonGravity
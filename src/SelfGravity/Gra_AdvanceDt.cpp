@@ -46,9 +46,9 @@ void Gra_AdvanceDt( const int lv, const double PrepTime, const double dt, const
    if ( lv == 0 )    
    {
 #     ifdef OOC
-                     CPU_PoissonSolver_FFT( Poi_Coeff, SaveSg );
+                     CPU_PoissonSolver_FFT( Poi_Coeff, SaveSg, PrepTime );
 #     else
-      TIMING_FUNC(   CPU_PoissonSolver_FFT( Poi_Coeff, SaveSg ),   Timer_Gra_Advance[lv],   false   );   
+      TIMING_FUNC(   CPU_PoissonSolver_FFT( Poi_Coeff, SaveSg, PrepTime ),   Timer_Gra_Advance[lv],   false   );   
 #     endif
 
       patch    ->PotSg[0] = SaveSg;
@@ -25,6 +25,26 @@ void Init_MemAllocate_PoissonGravity( const int Pot_NPatchGroup )
       h_Pot_Array_P_In [t] = new real [Pot_NPatch][POT_NXT][POT_NXT][POT_NXT];
       h_Pot_Array_P_Out[t] = new real [Pot_NPatch][GRA_NXT][GRA_NXT][GRA_NXT];
       h_Flu_Array_G    [t] = new real [Pot_NPatch][GRA_NIN][PATCH_SIZE][PATCH_SIZE][PATCH_SIZE];
+#     ifdef TIMING_PATCH
+      h_Pot_Cost_Array [t] = new double [Pot_NPatch];
+#     endif
+   }
+
+
+// first touch the arrays of each patch group by the thread which will prepare and solve it
+// --> the same (default) loop schedule as the preparation and closing steps must be adopted
+   if ( OPT__NUMA_FIRST_TOUCH )
+   {
+#     pragma omp parallel for
+      for (int TID=0; TID<Pot_NPatchGroup; TID++)
+      for (int t=0; t<2; t++)
+      for (int P=8*TID; P<8*TID+8; P++)
+      {
+         memset( h_Rho_Array_P    [t][P], 0, sizeof(h_Rho_Array_P    [t][P]) );
+         memset( h_Pot_Array_P_In [t][P], 0, sizeof(h_Pot_Array_P_In [t][P]) );
+         memset( h_Pot_Array_P_Out[t][P], 0, sizeof(h_Pot_Array_P_Out[t][P]) );
+         memset( h_Flu_Array_G    [t][P], 0, sizeof(h_Flu_Array_G    [t][P]) );
+      }
    }
 
 } // FUNCTION : Init_MemAllocate_PoissonGravity
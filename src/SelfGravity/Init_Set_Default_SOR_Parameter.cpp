@@ -12,6 +12,10 @@
 //
 // Note        :  a. Work only when the corresponding input parameters are negative
 //                b. The default values are determined empirically from the cosmological simulations
+//                c. For PATCH_SIZE != 8, the default over-relaxation parameter is set to the optimal value
+//                   of the model problem, 2/(1+sin(pi/(RHO_NXT+1))), which reproduces the empirical values
+//                   for PATCH_SIZE == 8, and the default maximum number of iterations is scaled by
+//                   PATCH_SIZE/8 since the number of SOR iterations grows linearly with the grid size
 //
 // Parameter   :  SOR_Omega      : Over-relaxation parameter for SOR
 //                SOR_Max_Iter   : Maximum number of iterations for SOR
@@ -21,26 +25,31 @@ void Init_Set_Default_SOR_Parameter( real &SOR_Omega, int &SOR_Max_Iter, int &SO
 {
 
 // check
-#  if ( defined GRAVITY  &&  POT_GHOST_SIZE > 5 )
+#  if ( defined GRAVITY  &&  POT_GHOST_SIZE > 5  &&  PATCH_SIZE == 8 )
    if ( SOR_Omega < 0.0 )
       Aux_Error( ERROR_INFO, "function \"%s\" does not work for POT_GHOST_SIZE > 5 !!\n", __FUNCTION__ );
 #  endif
 
 
-   const real Default_Omega[5] = { 1.49, 1.57, 1.62, 1.65, 1.69 };  // for POT_GHOST_SIZE = [1,2,3,4,5]
+#  if ( PATCH_SIZE == 8 )
+   const real Default_Omega_PS8[5] = { 1.49, 1.57, 1.62, 1.65, 1.69 };  // for POT_GHOST_SIZE = [1,2,3,4,5]
+   const real Default_Omega        = Default_Omega_PS8[POT_GHOST_SIZE-1];
+#  else
+   const real Default_Omega        = 2.0/( 1.0 + sin(M_PI/(RHO_NXT+1)) );
+#  endif
 #  ifdef FLOAT8
-   const int  Default_MaxIter  = 100;
+   const int  Default_MaxIter      = 100*PATCH_SIZE/8;
 #  else
-   const int  Default_MaxIter  = 60;
+   const int  Default_MaxIter      =  60*PATCH_SIZE/8;
 #  endif
-   const int  Default_MinIter  = 10;
+   const int  Default_MinIter      = 10;
 
    if ( SOR_Omega < 0.0 )     
    {
-      SOR_Omega = Default_Omega[POT_GHOST_SIZE-1];
+      SOR_Omega = Default_Omega;
 
       if ( MPI_Rank == 0 )  Aux_Message( stdout, "NOTE : parameter \"%s\" is set to the default value = %13.7e\n",
-                                         "SOR_OMEGA",  Default_Omega[POT_GHOST_SIZE-1] );
+                                         "SOR_OMEGA",  Default_Omega );
    }
 
    if ( SOR_Max_Iter < 0 )     
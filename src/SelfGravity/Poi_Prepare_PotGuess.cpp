@@ -0,0 +1,161 @@
+
+#include "DAINO.h"
+
+#ifdef GRAVITY
+
+
+
+static real CoarseTimeWeighting( const int lv, const double TargetTime );
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Poi_Prepare_PotGuess
+// Description :  Fill up the central PATCH_SIZE^3 cells of the h_Pot_Array_P_Out array with the initial guess
+//                of the fine-grid potential for the Poisson solver
+//
+// Note        :  1. Invoked only if the option "OPT__POT_WARM_START" is on
+//                2. Initial guess = fine-grid potential at the previous time Time[lv] (stored in PotSg[lv])
+//                                 + change of the coarse-grid potential between Time[lv] and PrepTime
+//                   --> The coarse-grid potential at Time[lv] is prepared by "Poi_Prepare_Pot" in the same way
+//                       as the coarse-grid potential at PrepTime (stored in h_Pot_Array_P_In)
+//                   --> The change is spatially interpolated by the same scheme (OPT__POT_INT_SCHEME) adopted by
+//                       the Poisson solver for the coarse-grid potential, so that no discontinuity is introduced
+//                       between the fine-grid cells within the same coarse-grid cell
+//                3. The ghost zones of h_Pot_Array_P_Out are not filled up here since the Poisson solver
+//                   always takes the interpolated coarse-grid potential as the initial guess in the ghost zones
+//                4. h_Pot_Array_P_In must be prepared by "Poi_Prepare_Pot" in advance
+//
+// Parameter   :  lv                : Targeted refinement level
+//                PrepTime          : Targeted physical time to solve the Poisson equation
+//                h_Pot_Array_P_In  : Host array storing the prepared coarse-grid potential at PrepTime
+//                h_Pot_Array_P_Out : Host array to store the prepared initial guess of the fine-grid potential
+//                NPG               : Number of patch groups prepared at a time
+//                PID0_List         : List recording the patch indicies with LocalID==0 to be udpated
+//-------------------------------------------------------------------------------------------------------
+void Poi_Prepare_PotGuess( const int lv, const double PrepTime,
+                           const real h_Pot_Array_P_In[][POT_NXT][POT_NXT][POT_NXT],
+                           real h_Pot_Array_P_Out[][GRA_NXT][GRA_NXT][GRA_NXT], const int NPG,
+                           const int *PID0_List )
+{
+
+// check
+   if ( lv == 0 )    Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "lv", lv );
+
+
+   const int  FPotSg      = patch->PotSg[lv];
+   const bool AddCorr     = ( CoarseTimeWeighting( lv, PrepTime ) != CoarseTimeWeighting( lv, Time[lv] ) );
+   const int  CGhost      = ( POT_NXT - PATCH_SIZE/2 )/2;     // ghost zone of h_Pot_Array_P_In (coarse grid)
+   const int  CSize [3]   = { POT_NXT, POT_NXT, POT_NXT };
+   const int  CStart[3]   = { CGhost, CGhost, CGhost };
+   const int  CRange[3]   = { PATCH_SIZE/2, PATCH_SIZE/2, PATCH_SIZE/2 };
+   const int  FSize [3]   = { PATCH_SIZE, PATCH_SIZE, PATCH_SIZE };
+   const int  FStart[3]   = { 0, 0, 0 };
+   const bool Positive[1] = { false };
+
+   int IntNSide, IntNGhost;
+   Int_Table( OPT__POT_INT_SCHEME, IntNSide, IntNGhost );
+
+   if ( AddCorr  &&  IntNGhost > CGhost )
+      Aux_Error( ERROR_INFO, "interpolation ghost zone (%d) > coarse-grid ghost zone (%d) !!\n", IntNGhost, CGhost );
+
+
+// prepare the coarse-grid potential at Time[lv]
+   real (*CPot_Old)[POT_NXT][POT_NXT][POT_NXT] = NULL;
+
+   if ( AddCorr )
+   {
+      CPot_Old = new real [8*NPG][POT_NXT][POT_NXT][POT_NXT];
+
+      Poi_Prepare_Pot( lv, Time[lv], CPot_Old, NPG, PID0_List );
+   }
+
+
+#  pragma omp parallel
+   {
+      int  N, I, J, K;
+      real (*FPot)[PATCH_SIZE][PATCH_SIZE] = NULL;
+
+//    CCorr/FCorr : change of the coarse-grid potential on the coarse/fine grids
+      real (*CCorr)[POT_NXT][POT_NXT]       = ( AddCorr ) ? new real [POT_NXT][POT_NXT][POT_NXT]          : NULL;
+      real (*FCorr)[PATCH_SIZE][PATCH_SIZE] = ( AddCorr ) ? new real [PATCH_SIZE][PATCH_SIZE][PATCH_SIZE] : NULL;
+      real  *Scratch                        = ( AddCorr ) ? new real [ Int_ScratchSize(OPT__POT_INT_SCHEME,
+                                                                                       CRange) ]          : NULL;
+
+
+#     pragma omp for
+      for (int TID=0; TID<NPG; TID++)
+      {
+         for (int LocalID=0; LocalID<8; LocalID++)
+         {
+            N    = 8*TID + LocalID;
+            FPot = patch->ptr[FPotSg][lv][ PID0_List[TID] + LocalID ]->pot;
+
+//          a. fine-grid potential at the previous time
+            for (int k=0; k<PATCH_SIZE; k++)    {  K = k + GRA_GHOST_SIZE;
+            for (int j=0; j<PATCH_SIZE; j++)    {  J = j + GRA_GHOST_SIZE;
+            for (int i=0; i<PATCH_SIZE; i++)    {  I = i + GRA_GHOST_SIZE;
+
+               h_Pot_Array_P_Out[N][K][J][I] = FPot[k][j][i];
+
+            }}}
+
+//          b. add the interpolated change of the coarse-grid potential
+            if ( AddCorr )
+            {
+               for (int k=0; k<POT_NXT; k++)
+               for (int j=0; j<POT_NXT; j++)
+               for (int i=0; i<POT_NXT; i++)
+                  CCorr[k][j][i] = h_Pot_Array_P_In[N][k][j][i] - CPot_Old[N][k][j][i];
+
+               Interpolate( &CCorr[0][0][0], CSize, CStart, CRange, &FCorr[0][0][0], FSize, FStart, 1,
+                            OPT__POT_INT_SCHEME, false, Positive, Scratch );
+
+               for (int k=0; k<PATCH_SIZE; k++)    {  K = k + GRA_GHOST_SIZE;
+               for (int j=0; j<PATCH_SIZE; j++)    {  J = j + GRA_GHOST_SIZE;
+               for (int i=0; i<PATCH_SIZE; i++)    {  I = i + GRA_GHOST_SIZE;
+
+                  h_Pot_Array_P_Out[N][K][J][I] += FCorr[k][j][i];
+
+               }}}
+            }
+         } // for (int LocalID=0; LocalID<8; LocalID++)
+      } // for (int TID=0; TID<NPG; TID++)
+
+      delete [] CCorr;
+      delete [] FCorr;
+      delete [] Scratch;
+
+   } // OpenMP parallel region
+
+   delete [] CPot_Old;
+
+} // FUNCTION : Poi_Prepare_PotGuess
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  CoarseTimeWeighting
+// Description :  Return the weighting "w" of the coarse-grid potential used by the Poisson solver at level "lv"
+//                at the targeted time, for which the adopted coarse-grid potential = w*New + (1-w)*Old
+//
+// Note        :  1. New/Old = potential stored in the sandglass PotSg[lv-1]/1-PotSg[lv-1], which corresponds
+//                   to the physical time Time[lv-1]/Time_Prev[lv-1]
+//                2. Must be consistent with the temporal interpolation adopted in the function "Poi_Prepare_Pot"
+//
+// Parameter   :  lv          : Targeted refinement level
+//                TargetTime  : Targeted physical time
+//-------------------------------------------------------------------------------------------------------
+real CoarseTimeWeighting( const int lv, const double TargetTime )
+{
+
+   if      (  Mis_Check_Synchronization( TargetTime,      Time[lv-1], NULL, false )  )  return (real)1.0;
+   else if (  Mis_Check_Synchronization( TargetTime, Time_Prev[lv-1], NULL, false )  )  return (real)0.0;
+   else                                            return ( OPT__INT_TIME ) ? (real)0.5 : (real)0.0;
+
+} // FUNCTION : CoarseTimeWeighting
+
+
+
+#endif // #ifdef GRAVITY
@@ -0,0 +1,46 @@
+#include "DAINO.h"
+
+#if ( defined GRAVITY  &&  !defined GPU )
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Poi_Record_Iteration
+// Description :  Record the average number of iterations taken by the CPU Poisson solver at each level
+//
+// Note        :  1. The counters "Poi_IterCounter[lv][0/1]" record the number of patches/iterations and are
+//                   accumulated by all OpenMP threads in the CPU Poisson solvers
+//                   --> They are summed over all ranks here
+//                2. Useful for evaluating the options "OPT__POT_WARM_START" and "SOR_TOLERATED_ERROR"
+//                3. The results are appended to the file "Record__Note"
+//-------------------------------------------------------------------------------------------------------
+void Poi_Record_Iteration()
+{
+
+   long int Counter_AllRank[NLEVEL][2];
+
+   MPI_Reduce( (long*)Poi_IterCounter, (long*)Counter_AllRank, NLEVEL*2, MPI_LONG, MPI_SUM, 0, MPI_COMM_WORLD );
+
+
+   if ( MPI_Rank == 0 )
+   {
+      FILE *Note = fopen( "Record__Note", "a" );
+      fprintf( Note, "Poisson Solver Iterations\n" );
+      fprintf( Note, "***********************************************************************************\n" );
+      fprintf( Note, "%5s%22s%22s%14s\n", "Level", "NPatch", "NIteration", "Average" );
+
+      for (int lv=0; lv<NLEVEL; lv++)
+      fprintf( Note, "%5d%22ld%22ld%14.4f\n", lv, Counter_AllRank[lv][0], Counter_AllRank[lv][1],
+               ( Counter_AllRank[lv][0] > 0 ) ? (double)Counter_AllRank[lv][1]/Counter_AllRank[lv][0] : 0.0 );
+
+      fprintf( Note, "***********************************************************************************\n" );
+      fprintf( Note, "\n\n" );
+      fclose( Note );
+   }
+
+} // FUNCTION : Poi_Record_Iteration
+
+
+
+#endif // #if ( defined GRAVITY  &&  !defined GPU )
@@ -7,6 +7,11 @@
 // Function    :  Flu_Restrict
 // Description :  Replace the fluid data at level "lv" by the average fluid data at level "lv+1" 
 //
+// Note        :  1. Only leaf patches are stored in the DAINO output files, and hence this function must be 
+//                   applied from the finest level upward after loading data
+//                2. Father patches are restricted in parallel with OpenMP (dynamic schedule since leaf patches
+//                   at level "lv" have nothing to do)
+//
 // Parameter   :  lv          : Targeted refinement level at which the data are going to be replaced
 //                GetAvePot   : Get the average potential field
 //-------------------------------------------------------------------------------------------------------
@@ -24,10 +29,11 @@ void Flu_Restrict( const int lv, const bool GetAvePot )
       return;
 
 
-   int SonPID0, SonPID, ii0, jj0, kk0, ii, jj, kk, I, J, K, Ip, Jp, Kp; 
-
+#  pragma omp parallel for schedule( dynamic )
    for (int PID=0; PID<NPatchComma[lv][1]; PID++)
    {
+      int SonPID0, SonPID, ii0, jj0, kk0, ii, jj, kk, I, J, K, Ip, Jp, Kp; 
+
       SonPID0 = patch.ptr[lv][PID]->son;
 
       if ( SonPID0 != -1 )
@@ -92,6 +92,12 @@ void LoadData( const char *FileName )
       MPI_Exit();
    }
 
+   if ( FormatVersion == 1202 )
+   {
+      fprintf( stderr, "ERROR : delta dumps (format version 1202) are not supported --> please use a full dump !!\n" );
+      MPI_Exit();
+   }
+
 
 // check if the size of different data types are consistent (only for version >= 1200)
    if ( FormatVersion >= 1200 )
@@ -283,106 +289,135 @@ void LoadData( const char *FileName )
 
 // e. load the simulation data
 // =================================================================================================
-   long int Offset = HeaderSize+InfoSize;
-   int LoadCorner[3], LoadSon, PID;
+// e1. scan the patch headers once and record the file offset of the data of each leaf patch
+// --> only the root rank reads the headers, which are then broadcast to all ranks
+   long  Offset = HeaderSize+InfoSize;
+   int  (*LoadHeader[NLEVEL])[4];      // corner(3) + son(1) of all patches
+   long  *LoadOffset[NLEVEL];          // file offset of the patch data (-1 for non-leaf patches)
+
+   for (int lv=0; lv<NLEVEL; lv++)
+   {
+      LoadHeader[lv] = new int  [ NPatchTotal[lv] ][4];
+      LoadOffset[lv] = new long [ NPatchTotal[lv] ];
+
+      if ( MyRank == 0 )
+      {
+         fprintf( stdout, "   Scanning patch headers: level %2d ... ", lv ); 
+         fflush( stdout );
+
+         File = fopen( FileName, "rb" );
+         fseek( File, Offset, SEEK_SET );
+
+         for (int LoadPID=0; LoadPID<NPatchTotal[lv]; LoadPID++)
+         {
+            fread( LoadHeader[lv][LoadPID], sizeof(int), 4, File );
+
+            if ( LoadHeader[lv][LoadPID][3] == -1 )
+            {
+               LoadOffset[lv][LoadPID] = ftell( File );
+               fseek( File, PatchDataSize, SEEK_CUR );
+            }
+            else
+               LoadOffset[lv][LoadPID] = -1;
+         }
+
+         fclose( File );
+
+         fprintf( stdout, "done\n" ); 
+         fflush( stdout );
+      }
+
+      MPI_Bcast( LoadHeader[lv], 4*NPatchTotal[lv], MPI_INT,  0, MPI_COMM_WORLD );
+      MPI_Bcast( LoadOffset[lv],   NPatchTotal[lv], MPI_LONG, 0, MPI_COMM_WORLD );
+
+      Offset += DataSize[lv];
+   } // for (int lv=0; lv<NLEVEL; lv++)
+
+
+// e2. allocate patches within the targeted sub-domain and load the data of the leaf patches within the
+//     candidate box
+// --> all ranks read the file concurrently, and only the data blocks intersecting the candidate box are read
+   const int *LoadCorner;
+   int  LoadSon, PID;
+   long NLoadPatch = 0, NLoadPatch_Sum = 0, NLeafPatch = 0;
    bool GotYou;
 
 // array for re-ordering the fluid data from "xyzv" to "vxyz"
    real (*InvData_Flu)[PATCH_SIZE][PATCH_SIZE][NCOMP] = NULL;
    if ( DataOrder_xyzv )   InvData_Flu = new real [PATCH_SIZE][PATCH_SIZE][PATCH_SIZE][NCOMP];
 
+   if ( MyRank == 0 )
+   {
+      fprintf( stdout, "   Loading data ... " ); 
+      fflush( stdout );
+   }
+
+   File = fopen( FileName, "rb" );
 
    for (int lv=0; lv<NLEVEL; lv++)
    {
-      for (int TargetRank=0; TargetRank<NGPU; TargetRank++)
+      for (int LoadPID=0; LoadPID<NPatchTotal[lv]; LoadPID++)
       {
-         if ( MyRank == 0 )
-         {
-            fprintf( stdout, "   Loading data: level %2d, MPI_Rank %3d ... ", lv, TargetRank ); 
-            fflush( stdout );
-         }
+         LoadCorner = LoadHeader[lv][LoadPID];
+         LoadSon    = LoadHeader[lv][LoadPID][3];
+
+         if ( LoadSon == -1 )    NLeafPatch ++;
 
-         if ( MyRank == TargetRank )
+//       verify that the loaded patch is within the targeted range
+         if (  LoadCorner[0] >= TargetRange_Min[0]  &&  LoadCorner[0] < TargetRange_Max[0]  &&
+               LoadCorner[1] >= TargetRange_Min[1]  &&  LoadCorner[1] < TargetRange_Max[1]  &&
+               LoadCorner[2] >= TargetRange_Min[2]  &&  LoadCorner[2] < TargetRange_Max[2]     ) 
          {
 
-            File = fopen( FileName, "rb" );
-            fseek( File, Offset, SEEK_SET );
+//          verify that the loaded patch is within the candidate box
+            GotYou = WithinCandidateBox( LoadCorner, PATCH_SIZE*patch.scale[lv], CanBuf );
 
-            for (int LoadPID=0; LoadPID<NPatchTotal[lv]; LoadPID++)
-            {
+            patch.pnew( lv, LoadCorner[0], LoadCorner[1], LoadCorner[2], -1, GotYou );
 
-//             e1. load the patch information
-               fread(  LoadCorner, sizeof(int), 3, File );
-               fread( &LoadSon,    sizeof(int), 1, File );
+//          load the physical data if it is a leaf patch
+            if ( LoadSon == -1  &&  GotYou )
+            {
+               PID = patch.num[lv] - 1;
 
+               fseek( File, LoadOffset[lv][LoadPID], SEEK_SET );
 
-//             verify that the loaded patch is within the targeted range
-               if (  LoadCorner[0] >= TargetRange_Min[0]  &&  LoadCorner[0] < TargetRange_Max[0]  &&
-                     LoadCorner[1] >= TargetRange_Min[1]  &&  LoadCorner[1] < TargetRange_Max[1]  &&
-                     LoadCorner[2] >= TargetRange_Min[2]  &&  LoadCorner[2] < TargetRange_Max[2]     ) 
+//             load the fluid variables
+               if ( DataOrder_xyzv )
                {
+                  fread( InvData_Flu, sizeof(real), PATCH_SIZE*PATCH_SIZE*PATCH_SIZE*NCOMP, File );
 
-//                verify that the loaded patch is within the candidate box
-                  GotYou = WithinCandidateBox( LoadCorner, PATCH_SIZE*patch.scale[lv], CanBuf );
-
-                  patch.pnew( lv, LoadCorner[0], LoadCorner[1], LoadCorner[2], -1, GotYou );
-
-//                e2. load the physical data if it is a leaf patch
-                  if ( LoadSon == -1 )
-                  {
-                     if ( GotYou )
-                     {
-                        PID = patch.num[lv] - 1;
-
-//                      e2-1. load the fluid variables
-                        if ( DataOrder_xyzv )
-                        {
-                           fread( InvData_Flu, sizeof(real), PATCH_SIZE*PATCH_SIZE*PATCH_SIZE*NCOMP, File );
-
-                           for (int v=0; v<NCOMP; v++)
-                           for (int k=0; k<PATCH_SIZE; k++)
-                           for (int j=0; j<PATCH_SIZE; j++)
-                           for (int i=0; i<PATCH_SIZE; i++)    
-                              patch.ptr[lv][PID]->fluid[v][k][j][i] = InvData_Flu[k][j][i][v];
-                        }
-
-                        else
-                           fread( patch.ptr[lv][PID]->fluid, sizeof(real), 
-                                  PATCH_SIZE*PATCH_SIZE*PATCH_SIZE*NCOMP, File );
-
-//                      e2-2. load the gravitational potential
-                        if ( OutputPot )
-                           fread( patch.ptr[lv][PID]->pot, sizeof(real), PATCH_SIZE*PATCH_SIZE*PATCH_SIZE, File );
-                     }
-
-                     else
-                        fseek( File, PatchDataSize, SEEK_CUR );
-                  }
+                  for (int v=0; v<NCOMP; v++)
+                  for (int k=0; k<PATCH_SIZE; k++)
+                  for (int j=0; j<PATCH_SIZE; j++)
+                  for (int i=0; i<PATCH_SIZE; i++)    
+                     patch.ptr[lv][PID]->fluid[v][k][j][i] = InvData_Flu[k][j][i][v];
                }
 
                else
-               {
-                  if ( LoadSon == -1 )    fseek( File, PatchDataSize, SEEK_CUR );
-               }
-
-            } // for (int LoadPID=0; LoadPID<NPatchTotal[lv]; LoadPID++)
+                  fread( patch.ptr[lv][PID]->fluid, sizeof(real), PATCH_SIZE*PATCH_SIZE*PATCH_SIZE*NCOMP, File );
 
-            fclose( File );
+//             load the gravitational potential
+               if ( OutputPot )
+                  fread( patch.ptr[lv][PID]->pot, sizeof(real), PATCH_SIZE*PATCH_SIZE*PATCH_SIZE, File );
 
-            Offset += DataSize[lv];
+               NLoadPatch ++;
+            }
+         } // if ( within the targeted range )
+      } // for (int LoadPID=0; LoadPID<NPatchTotal[lv]; LoadPID++)
 
-         } // if ( MyRank == TargetRank )
+      delete [] LoadHeader[lv];
+      delete [] LoadOffset[lv];
+   } // for (int lv=0; lv<NLEVEL; lv++)
 
-         MPI_Barrier( MPI_COMM_WORLD );
+   fclose( File );
 
-         if ( MyRank == 0 )
-         {
-            fprintf( stdout, "done\n" ); 
-            fflush( stdout );
-         }
+   MPI_Reduce( &NLoadPatch, &NLoadPatch_Sum, 1, MPI_LONG, MPI_SUM, 0, MPI_COMM_WORLD );
 
-      } // for (int TargetRank=0; TargetRank<NGPU; TargetRank++)
-   } // for (int lv=0; lv<NLEVEL; lv++)
+   if ( MyRank == 0 )
+   {
+      fprintf( stdout, "done (%ld of %ld leaf patches loaded)\n", NLoadPatch_Sum, NLeafPatch ); 
+      fflush( stdout );
+   }
 
 
    if ( DataOrder_xyzv )  delete [] InvData_Flu;
@@ -11,6 +11,8 @@ void TakeNote();
 void Refine2TargetLevel();
 void PreparePatch( const int lv, const int PID, const int Buffer, real FData[], const real CData[] );
 void Interpolation( const int CSize, const real CData[], const int FSize, real FData[] );
+void InterpolateCell( const real CData[], const long CID, const long Cdi, const long Cdj, const long Cdk,
+                      real FData[], const long FID, const long Fdi, const long Fdj, const long Fdk );
 void AllocateOutputArray();
 void StoreData( const int lv, const int PID, real FData[], const int Buffer, real *Out );
 void Output();
@@ -22,7 +22,10 @@ typedef float  real;
 
 
 // patch size (number of cells of a single patch in the x/y/z directions)
-#define PATCH_SIZE         8
+// --> can be set in the Makefile and must be the same as the simulation
+#ifndef PATCH_SIZE
+#  define PATCH_SIZE       8
+#endif
 #define PS1                (1*PATCH_SIZE)
 #define PS2                (2*PATCH_SIZE)
 
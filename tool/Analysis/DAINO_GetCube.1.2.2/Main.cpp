@@ -4,7 +4,7 @@
 #define PS    PATCH_SIZE
 
 int       OutputXYZ         = WRONG;                     // output option (x,y,z,x-proj,y-proj,z-proj,3D)
-int       InterScheme       = 0;                         // interpolation scheme (0/1:MinMod/Central)
+int       InterScheme       = 0;                         // interpolation scheme (0/1/2:MinMod/Central/Quadratic)
 char     *FileName_In       = NULL;                      // name of the input file
 char     *Suffix            = NULL;                      // suffix attached to the output file name
 //bool    OldDataFormat     = false;                     // true --> load the old-format data (no longer supported)
@@ -101,7 +101,7 @@ void ReadOption( int argc, char **argv )
          case '?': cerr << endl << "usage: " << argv[0] 
                         << " [-h (for help)] [-i input fileName] [-o suffix to the output file [none]]" 
                         << endl << "                      "
-                        << " [-l targeted level [0]] [-I interpolation scheme (0/1: MinMod/central) [0]]"
+                        << " [-l targeted level [0]] [-I interpolation scheme (0/1/2: MinMod/central/quadratic) [0]]"
                         << endl << "                      "
                         << " [-n output option (1~7 : X-slice, Y-slice, Z-slice, X-proj, Y-proj, Z-proj, 3D)" 
                         << endl << "                      "
@@ -216,12 +216,6 @@ void ReadOption( int argc, char **argv )
       exit( 1 );
    }
 
-   if (  OutputBinary  &&  ( NGPU_X[0] != 1 || NGPU_X[1] != 1 )  )
-   {
-      cerr << "ERROR : only slab decomposition is allowed (-p 1 -q 1 -r NP) for binary output !!" << endl;
-      exit( 1 );
-   }
-
 } // FUNCTION : ReadOption
 
 
@@ -398,6 +392,7 @@ void Output()
 
 
 // clean the existing files
+// --> for the binary output, all files are created here since different ranks will write to them concurrently
    if ( OutputBinary ) // binary files
    {
       if ( MyRank == 0  )
@@ -405,13 +400,11 @@ void Output()
          for (int v=0; v<NOut; v++)
          {
             if ( NULL != fopen(FileName_Out_Binary[v],"r") )  
-            {
                fprintf( stderr, "Warning : the file \"%s\" already exists and will be overwritten !!\n", 
                         FileName_Out_Binary[v] );
 
-               FILE *TempFile = fopen( FileName_Out_Binary[v], "w" );
-               fclose( TempFile );
-            }
+            FILE *TempFile = fopen( FileName_Out_Binary[v], "wb" );
+            fclose( TempFile );
          }
       }
    }
@@ -431,35 +424,67 @@ void Output()
 
 
 // output data
-   int  ii, jj, kk, NextIdx;
-   long ID;
-   real x, y, z, u[NOut];
-
-   for (int TargetRank=0; TargetRank<NGPU; TargetRank++)
+// --> for the output-slice operation, the useless rank will NOT output any data because one of the Idx_MySize[x]
+//     will be equal to zero
+   const bool OutputRank = (      OutputXYZ  < 4  
+                             ||   OutputXYZ == 7
+                             || ( OutputXYZ == 4 && MyRank_X[0] == 0 )
+                             || ( OutputXYZ == 5 && MyRank_X[1] == 0 ) 
+                             || ( OutputXYZ == 6 && MyRank_X[2] == 0 )  );
+
+// a. output the binary files (different components will be outputted to different files)
+// --> the position of each row in the global array is known in advance, so all ranks write their own rows
+//     concurrently and any domain decomposition is supported
+   if ( OutputBinary )
    {
-//    for the output-slice operation, the useless rank will NOT output any data because one of the Idx_MySize[x]
-//    will be equal to zero
-      if (   MyRank == TargetRank  &&  (      OutputXYZ  < 4  
-                                         ||   OutputXYZ == 7
-                                         || ( OutputXYZ == 4 && MyRank_X[0] == 0 )
-                                         || ( OutputXYZ == 5 && MyRank_X[1] == 0 ) 
-                                         || ( OutputXYZ == 6 && MyRank_X[2] == 0 )  )   )
+      if ( OutputRank )
       {
-//       output the binary file (different components will be outputted to different files)
-         if ( OutputBinary )
+         long GSize[3], GStart[3], Offset, NextOffset;
+
+         for (int d=0; d<3; d++)
+         {
+            GSize [d] = ( OutputXYZ == d+4 ) ? 1 : Idx_Size[d];
+            GStart[d] = ( OutputXYZ == d+4 ) ? 0 : Idx_MyStart[d] - Idx_Start[d];
+         }
+
+         for (int v=0; v<NOut; v++)    
          {
-            for (int v=0; v<NOut; v++)    
+            FILE *File = fopen( FileName_Out_Binary[v], "r+b" );
+
+            NextOffset = -1;
+
+            for (int k=0; k<Idx_MySize[2]; k++)
+            for (int j=0; j<Idx_MySize[1]; j++)
             {
-               FILE *File = fopen( FileName_Out_Binary[v], "ab" );
+               Offset = (  ( (GStart[2]+k)*GSize[1] + GStart[1]+j )*GSize[0] + GStart[0]  )*sizeof(real);
+
+               if ( Offset != NextOffset )   fseek( File, Offset, SEEK_SET );
 
-               fwrite( OutputArray+(long)v*Size1v, sizeof(real), Size1v, File );
+               fwrite( OutputArray + (long)v*Size1v + ( (long)k*Idx_MySize[1] + j )*Idx_MySize[0], 
+                       sizeof(real), Idx_MySize[0], File );
 
-               fclose( File );
+               NextOffset = Offset + Idx_MySize[0]*sizeof(real);
             }
+
+            fclose( File );
          }
+      } // if ( OutputRank )
 
-//       output the text file (all components will be outputted to the same file)
-         else
+      MPI_Barrier( MPI_COMM_WORLD );
+   } // if ( OutputBinary )
+
+
+// b. output the text file (all components will be outputted to the same file)
+// --> the length of each line is not fixed, so different ranks still output data in order
+   else
+   {
+      int  ii, jj, kk, NextIdx;
+      long ID;
+      real x, y, z, u[NOut];
+
+      for (int TargetRank=0; TargetRank<NGPU; TargetRank++)
+      {
+         if ( MyRank == TargetRank  &&  OutputRank )
          {
             FILE *File = fopen( FileName_Out, "a" );
 
@@ -532,12 +557,12 @@ void Output()
 
             fclose( File );
 
-         } // if ( OutputBinary ) ... else ...
-      } // ( MyRank == TargetRank  &&  ... )
+         } // ( MyRank == TargetRank  &&  ... )
 
-      MPI_Barrier( MPI_COMM_WORLD );
+         MPI_Barrier( MPI_COMM_WORLD );
 
-   } // for (int TargetRank=0; TargetRank<NGPU; TargetRank++
+      } // for (int TargetRank=0; TargetRank<NGPU; TargetRank++
+   } // if ( OutputBinary ) ... else ...
 
 
    if ( MyRank == 0 )   cout << "Output ... done" << endl;
@@ -1001,7 +1026,6 @@ void PreparePatch( const int lv, const int PID, const int Buffer, real FData[],
    int  i0, j0, k0, ii0, jj0, kk0, i_loop, j_loop, k_loop;
    int  SibPID, LocalID;
    long ID, ID2;
-   real Slope[3]={0,0,0}, LSlope[3], RSlope[3];
 
 // prepare the central data
    if ( patch.ptr[lv][PID]->fluid == NULL )
@@ -1113,61 +1137,7 @@ void PreparePatch( const int lv, const int PID, const int Buffer, real FData[],
             ID  = (long)v*dvv +  k*dkk +  j*djj +  i; 
             ID2 = (long)v*dvv + kk*dkk + jj*djj + ii; 
 
-            switch ( InterScheme )
-            {
-               case 0 : // MinMod limiter
-               {
-                  LSlope[0] = CData[ID    ] - CData[ID-dii];
-                  RSlope[0] = CData[ID+dii] - CData[ID    ];
-                  if ( LSlope[0]*RSlope[0] <= 0.0 )  
-                     Slope[0] = 0.0;
-                  else                            
-                     Slope[0] = 0.25*(  fabs( LSlope[0] ) < fabs( RSlope[0] ) ? LSlope[0] : RSlope[0]  );
-                  
-                  LSlope[1] = CData[ID    ] - CData[ID-djj];
-                  RSlope[1] = CData[ID+djj] - CData[ID    ];
-                  if ( LSlope[1]*RSlope[1] <= 0.0 )  
-                     Slope[1] = 0.0;
-                  else                            
-                     Slope[1] = 0.25*(  fabs( LSlope[1] ) < fabs( RSlope[1] ) ? LSlope[1] : RSlope[1]  );
-
-
-                  LSlope[2] = CData[ID    ] - CData[ID-dkk];
-                  RSlope[2] = CData[ID+dkk] - CData[ID    ];
-                  if ( LSlope[2]*RSlope[2] <= 0.0 )  
-                     Slope[2] = 0.0;
-                  else                            
-                     Slope[2] = 0.25*(  fabs( LSlope[2] ) < fabs( RSlope[2] ) ? LSlope[2] : RSlope[2]  );
-               }
-               break;
-
-
-               case 1 : // central interpolation
-               {
-                  Slope[0] = 0.125 * ( CData[ID+dii] - CData[ID-dii] );
-                  Slope[1] = 0.125 * ( CData[ID+djj] - CData[ID-djj] );
-                  Slope[2] = 0.125 * ( CData[ID+dkk] - CData[ID-dkk] );
-               }
-               break;
-
-
-               default :
-               {
-                  cerr << "ERROR : unsupported interpolation scheme !!" << endl;
-                  MPI_Exit();
-               }
-
-            } // switch ( InterScheme );
-
-
-            FData[ID2            ] = CData[ID] - Slope[0] - Slope[1] - Slope[2];
-            FData[ID2+dii        ] = CData[ID] + Slope[0] - Slope[1] - Slope[2];
-            FData[ID2    +djj    ] = CData[ID] - Slope[0] + Slope[1] - Slope[2];
-            FData[ID2        +dkk] = CData[ID] - Slope[0] - Slope[1] + Slope[2];
-            FData[ID2+dii+djj    ] = CData[ID] + Slope[0] + Slope[1] - Slope[2];
-            FData[ID2    +djj+dkk] = CData[ID] - Slope[0] + Slope[1] + Slope[2];
-            FData[ID2+dii    +dkk] = CData[ID] + Slope[0] - Slope[1] + Slope[2];
-            FData[ID2+dii+djj+dkk] = CData[ID] + Slope[0] + Slope[1] + Slope[2];
+            InterpolateCell( CData, ID, dii, djj, dkk, FData, ID2, dii, djj, dkk );
 
          } // i,j,k,v
 
@@ -1201,7 +1171,6 @@ void Interpolation( const int CSize, const real CData[], const int FSize, real F
 
    int  ii, jj, kk;
    long CID, FID;
-   real Slope[3]={0,0,0}, LSlope[3], RSlope[3];
 
 
    for (int v=0; v<NLoad; v++)
@@ -1212,65 +1181,116 @@ void Interpolation( const int CSize, const real CData[], const int FSize, real F
       CID = (long)v*Cdv +  k*Cdk +  j*Cdj +  i;
       FID = (long)v*Fdv + kk*Fdk + jj*Fdj + ii;
 
-      switch ( InterScheme )
+      InterpolateCell( CData, CID, Cdi, Cdj, Cdk, FData, FID, Fdi, Fdj, Fdk );
+
+   } // i,j,k,v
+
+} // FUNCTION : Interpolation
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  InterpolateCell
+// Description :  Interpolate a single coarse cell to its eight fine cells
+//
+// Note        :  1. Shared by the functions "PreparePatch" and "Interpolation"
+//                2. InterScheme == 2 adopts the conservative tri-quadratic interpolation
+//                   --> The quadratic terms have zero average over each fine cell, and hence only the central
+//                       slopes and the cross terms (xy, yz, xz, xyz) remain
+//                3. All schemes only use the 3^3 coarse cells centered at the targeted cell
+//
+// Parameter   :  CData       : Array for interpolation
+//                CID         : Index of the targeted coarse cell in CData
+//                Cdi/Cdj/Cdk : Index displacements of CData in the x/y/z directions
+//                FData       : Array to store the interpolated data
+//                FID         : Index of the fine cell at the lower-left corner in FData
+//                Fdi/Fdj/Fdk : Index displacements of FData in the x/y/z directions
+//-------------------------------------------------------------------------------------------------------
+void InterpolateCell( const real CData[], const long CID, const long Cdi, const long Cdj, const long Cdk,
+                      real FData[], const long FID, const long Fdi, const long Fdj, const long Fdk )
+{
+
+   real Slope[3]={0,0,0}, LSlope[3], RSlope[3], Cross[4];
+
+   switch ( InterScheme )
+   {
+      case 0 : // MinMod limiter
       {
-         case 0 : // MinMod limiter
-         {
-            LSlope[0] = CData[CID    ] - CData[CID-Cdi];
-            RSlope[0] = CData[CID+Cdi] - CData[CID    ];
-            if ( LSlope[0]*RSlope[0] <= 0.0 )  
-               Slope[0] = 0.0;
-            else
-               Slope[0] = 0.25*(  fabs( LSlope[0] ) < fabs( RSlope[0] ) ? LSlope[0] : RSlope[0]  );
-            
-            LSlope[1] = CData[CID    ] - CData[CID-Cdj];
-            RSlope[1] = CData[CID+Cdj] - CData[CID    ];
-            if ( LSlope[1]*RSlope[1] <= 0.0 )  
-               Slope[1] = 0.0;
-            else                                  
-               Slope[1] = 0.25*(  fabs( LSlope[1] ) < fabs( RSlope[1] ) ? LSlope[1] : RSlope[1]  );
-
-
-            LSlope[2] = CData[CID    ] - CData[CID-Cdk];
-            RSlope[2] = CData[CID+Cdk] - CData[CID    ];
-            if ( LSlope[2]*RSlope[2] <= 0.0 )  
-               Slope[2] = 0.0;
-            else                                  
-               Slope[2] = 0.25*(  fabs( LSlope[2] ) < fabs( RSlope[2] ) ? LSlope[2] : RSlope[2]  );
-         }
-         break;
+         LSlope[0] = CData[CID    ] - CData[CID-Cdi];
+         RSlope[0] = CData[CID+Cdi] - CData[CID    ];
+         if ( LSlope[0]*RSlope[0] <= 0.0 )  
+            Slope[0] = 0.0;
+         else
+            Slope[0] = 0.25*(  fabs( LSlope[0] ) < fabs( RSlope[0] ) ? LSlope[0] : RSlope[0]  );
+         
+         LSlope[1] = CData[CID    ] - CData[CID-Cdj];
+         RSlope[1] = CData[CID+Cdj] - CData[CID    ];
+         if ( LSlope[1]*RSlope[1] <= 0.0 )  
+            Slope[1] = 0.0;
+         else                                  
+            Slope[1] = 0.25*(  fabs( LSlope[1] ) < fabs( RSlope[1] ) ? LSlope[1] : RSlope[1]  );
+
+
+         LSlope[2] = CData[CID    ] - CData[CID-Cdk];
+         RSlope[2] = CData[CID+Cdk] - CData[CID    ];
+         if ( LSlope[2]*RSlope[2] <= 0.0 )  
+            Slope[2] = 0.0;
+         else                                  
+            Slope[2] = 0.25*(  fabs( LSlope[2] ) < fabs( RSlope[2] ) ? LSlope[2] : RSlope[2]  );
+      }
+      break;
 
 
-         case 1 : // central interpolation
-         {
-            Slope[0] = 0.125 * ( CData[CID+Cdi] - CData[CID-Cdi] );
-            Slope[1] = 0.125 * ( CData[CID+Cdj] - CData[CID-Cdj] );
-            Slope[2] = 0.125 * ( CData[CID+Cdk] - CData[CID-Cdk] );
-         }
-         break;
+      case 1 : // central interpolation
+      case 2 : // conservative tri-quadratic interpolation (the cross terms are added below)
+      {
+         Slope[0] = 0.125 * ( CData[CID+Cdi] - CData[CID-Cdi] );
+         Slope[1] = 0.125 * ( CData[CID+Cdj] - CData[CID-Cdj] );
+         Slope[2] = 0.125 * ( CData[CID+Cdk] - CData[CID-Cdk] );
+      }
+      break;
 
 
-         default :
-         {
-            cerr << "ERROR : unsupported interpolation scheme !!" << endl;
-            MPI_Exit();
-         }
+      default :
+      {
+         cerr << "ERROR : unsupported interpolation scheme !!" << endl;
+         MPI_Exit();
+      }
 
-      } // switch ( InterScheme )
+   } // switch ( InterScheme )
 
 
-      FData[FID            ] = CData[CID] - Slope[0] - Slope[1] - Slope[2];
-      FData[FID+Fdi        ] = CData[CID] + Slope[0] - Slope[1] - Slope[2];
-      FData[FID    +Fdj    ] = CData[CID] - Slope[0] + Slope[1] - Slope[2];
-      FData[FID        +Fdk] = CData[CID] - Slope[0] - Slope[1] + Slope[2];
-      FData[FID+Fdi+Fdj    ] = CData[CID] + Slope[0] + Slope[1] - Slope[2];
-      FData[FID    +Fdj+Fdk] = CData[CID] - Slope[0] + Slope[1] + Slope[2];
-      FData[FID+Fdi    +Fdk] = CData[CID] + Slope[0] - Slope[1] + Slope[2];
-      FData[FID+Fdi+Fdj+Fdk] = CData[CID] + Slope[0] + Slope[1] + Slope[2];
+   FData[FID            ] = CData[CID] - Slope[0] - Slope[1] - Slope[2];
+   FData[FID+Fdi        ] = CData[CID] + Slope[0] - Slope[1] - Slope[2];
+   FData[FID    +Fdj    ] = CData[CID] - Slope[0] + Slope[1] - Slope[2];
+   FData[FID        +Fdk] = CData[CID] - Slope[0] - Slope[1] + Slope[2];
+   FData[FID+Fdi+Fdj    ] = CData[CID] + Slope[0] + Slope[1] - Slope[2];
+   FData[FID    +Fdj+Fdk] = CData[CID] - Slope[0] + Slope[1] + Slope[2];
+   FData[FID+Fdi    +Fdk] = CData[CID] + Slope[0] - Slope[1] + Slope[2];
+   FData[FID+Fdi+Fdj+Fdk] = CData[CID] + Slope[0] + Slope[1] + Slope[2];
 
-   } // i,j,k,v
 
-} // FUNCTION : Interpolation
+// add the cross terms of the tri-quadratic interpolation (xy, yz, xz, xyz)
+   if ( InterScheme == 2 )
+   {
+      Cross[0] = (  CData[CID+Cdi+Cdj] - CData[CID+Cdi-Cdj] - CData[CID-Cdi+Cdj] + CData[CID-Cdi-Cdj]  ) / 64.0;
+      Cross[1] = (  CData[CID+Cdj+Cdk] - CData[CID+Cdj-Cdk] - CData[CID-Cdj+Cdk] + CData[CID-Cdj-Cdk]  ) / 64.0;
+      Cross[2] = (  CData[CID+Cdi+Cdk] - CData[CID+Cdi-Cdk] - CData[CID-Cdi+Cdk] + CData[CID-Cdi-Cdk]  ) / 64.0;
+      Cross[3] = (  CData[CID+Cdi+Cdj+Cdk] - CData[CID+Cdi+Cdj-Cdk] - CData[CID+Cdi-Cdj+Cdk] 
+                  + CData[CID+Cdi-Cdj-Cdk] - CData[CID-Cdi+Cdj+Cdk] + CData[CID-Cdi+Cdj-Cdk] 
+                  + CData[CID-Cdi-Cdj+Cdk] - CData[CID-Cdi-Cdj-Cdk]                            ) / 512.0;
+
+      FData[FID            ] += + Cross[0] + Cross[1] + Cross[2] - Cross[3];
+      FData[FID+Fdi        ] += - Cross[0] + Cross[1] - Cross[2] + Cross[3];
+      FData[FID    +Fdj    ] += - Cross[0] - Cross[1] + Cross[2] + Cross[3];
+      FData[FID        +Fdk] += + Cross[0] - Cross[1] - Cross[2] + Cross[3];
+      FData[FID+Fdi+Fdj    ] += + Cross[0] - Cross[1] - Cross[2] - Cross[3];
+      FData[FID    +Fdj+Fdk] += - Cross[0] + Cross[1] - Cross[2] - Cross[3];
+      FData[FID+Fdi    +Fdk] += - Cross[0] - Cross[1] + Cross[2] - Cross[3];
+      FData[FID+Fdi+Fdj+Fdk] += + Cross[0] + Cross[1] + Cross[2] + Cross[3];
+   }
+
+} // FUNCTION : InterpolateCell
 
 
 
@@ -1536,6 +1556,14 @@ void Refine2TargetLevel()
          for (long i=0; i<OutSize; i++)   OutputArray_OMP[t][i] = 0.0;
       }
    }
+
+// the cost of different patches varies greatly (patches at lower levels must be refined several times)
+// --> adopt the dynamic scheduling, except for projections which keep the static scheduling so that the
+//     summation order in each thread (and hence the result) is reproducible
+   if ( OutputXYZ == 4  ||  OutputXYZ == 5  ||  OutputXYZ == 6 )
+      omp_set_schedule( omp_sched_static,  0 );
+   else
+      omp_set_schedule( omp_sched_dynamic, 1 );
 #  endif // #ifdef OPENMP
 
 
@@ -1549,7 +1577,7 @@ void Refine2TargetLevel()
          TID = omp_get_thread_num();
 #        endif
 
-#        pragma omp for
+#        pragma omp for schedule( runtime )
          for (int PID=0; PID<NPatchComma[lv][1]; PID++)
          {
 
@@ -5,6 +5,10 @@
 #include <iostream>
 #include "TypeDef.h"
 
+#ifdef OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 
 #define WRONG -999999
@@ -21,6 +25,7 @@ void ShellAverage();
 void GetRMS();
 void GetMaxRho();
 real GetMinShellWidth( const real TCen[], const real TCen_Map[] );
+bool OutsideSphere( const int lv, const int PID );
 void Load_Parameter_Before_1200( FILE *File, const int FormatVersion, bool &DataOrder_xyzv, 
                                  bool &LoadPot, int *NX0_Tot, double &BoxSize, real &Gamma );
 void Load_Parameter_After_1200( FILE *File, const int FormatVersion, bool &DataOrder_xyzv,
@@ -196,6 +201,8 @@ void GetMaxRho()
 //-------------------------------------------------------------------------------------------------------
 // Function    :  GetRMS
 // Description :  Evaluate the standard deviations from the average values 
+//
+// Note        :  Parallelized in the same way as "ShellAverage"
 //-------------------------------------------------------------------------------------------------------
 void GetRMS()
 {
@@ -203,99 +210,120 @@ void GetRMS()
    cout << "Evaluating the RMS ..." << endl;
 
 
-   int  ShellID;
-   real Radius, scale, dv;
-   real x, x1, x2, y, y1, y2, z, z1, z2;     // (x,y,z) : relative coordinates to the vector "Center"
-
-#  if   ( MODEL == HYDRO )
-   real rho, vx, vy, vz, vr, vt, egy, pres;
-
-#  elif ( MODEL == MHD )
-#  warning : WAIT MHD !!!
+#  ifdef OPENMP
+   const int NThread = omp_get_max_threads();
+#  else
+   const int NThread = 1;
+#  endif
 
-#  elif ( MODEL == ELBDM )
-   real Dens, Real, Imag;
+// per-thread accumulators
+   double (*RMS_TH)[NCOMP] = new double [NThread*NShell][NCOMP];
 
-#  else
-#  error : ERROR : unsupported MODEL !!
-#  endif // MODEL
+   for (int t=0; t<NThread*NShell; t++)
+   for (int v=0; v<NCOMP; v++)      RMS_TH[t][v] = 0.0;
 
 
    for (int lv=0; lv<NLEVEL; lv++)              
    {  
-      scale = (real)patch.scale[lv];
-      dv    = scale*scale*scale;
+      const real scale = (real)patch.scale[lv];
+      const real dv    = scale*scale*scale;
 
       cout << "   Level " << lv << " ... ";
 
-      for (int PID=0; PID<patch.num[lv]; PID++) 
+#     pragma omp parallel
       {
-         for (int k=0; k<PATCH_SIZE; k++) {  z1 = patch.ptr[lv][PID]->corner[2] + (k+0.5)*scale - Center    [2];
-                                             z2 = patch.ptr[lv][PID]->corner[2] + (k+0.5)*scale - Center_Map[2];
-                                             z  = ( fabs(z1) <= fabs(z2) ) ? z1 : z2;
-         for (int j=0; j<PATCH_SIZE; j++) {  y1 = patch.ptr[lv][PID]->corner[1] + (j+0.5)*scale - Center    [1];
-                                             y2 = patch.ptr[lv][PID]->corner[1] + (j+0.5)*scale - Center_Map[1];
-                                             y  = ( fabs(y1) <= fabs(y2) ) ? y1 : y2;
-         for (int i=0; i<PATCH_SIZE; i++) {  x1 = patch.ptr[lv][PID]->corner[0] + (i+0.5)*scale - Center    [0];
-                                             x2 = patch.ptr[lv][PID]->corner[0] + (i+0.5)*scale - Center_Map[0];
-                                             x  = ( fabs(x1) <= fabs(x2) ) ? x1 : x2;
-
-            Radius = sqrt( x*x + y*y + z*z );
-
-            if ( Radius < MaxRadius )
-            {
-               ShellID = int( Radius / ShellWidth );
-
-               if ( ShellID >= NShell )
+#        ifdef OPENMP
+         const int TID = omp_get_thread_num();
+#        else
+         const int TID = 0;
+#        endif
+
+         double (*RMS_Local)[NCOMP] = RMS_TH + TID*NShell;
+
+         int  ShellID;
+         real Radius, Var[NCOMP];
+         real x, x1, x2, y, y1, y2, z, z1, z2;     // (x,y,z) : relative coordinates to the vector "Center"
+
+#        if   ( MODEL == HYDRO )
+         real rho, vx, vy, vz, egy;
+#        elif ( MODEL == MHD )
+#        warning : WAIT MHD !!!
+#        endif
+
+#        pragma omp for schedule( dynamic )
+         for (int PID=0; PID<patch.num[lv]; PID++) 
+         {
+//          skip the patches entirely outside the targeted sphere
+            if ( OutsideSphere( lv, PID ) )  continue;
+
+            for (int k=0; k<PATCH_SIZE; k++) {  z1 = patch.ptr[lv][PID]->corner[2] + (k+0.5)*scale - Center    [2];
+                                                z2 = patch.ptr[lv][PID]->corner[2] + (k+0.5)*scale - Center_Map[2];
+                                                z  = ( fabs(z1) <= fabs(z2) ) ? z1 : z2;
+            for (int j=0; j<PATCH_SIZE; j++) {  y1 = patch.ptr[lv][PID]->corner[1] + (j+0.5)*scale - Center    [1];
+                                                y2 = patch.ptr[lv][PID]->corner[1] + (j+0.5)*scale - Center_Map[1];
+                                                y  = ( fabs(y1) <= fabs(y2) ) ? y1 : y2;
+            for (int i=0; i<PATCH_SIZE; i++) {  x1 = patch.ptr[lv][PID]->corner[0] + (i+0.5)*scale - Center    [0];
+                                                x2 = patch.ptr[lv][PID]->corner[0] + (i+0.5)*scale - Center_Map[0];
+                                                x  = ( fabs(x1) <= fabs(x2) ) ? x1 : x2;
+
+               Radius = sqrt( x*x + y*y + z*z );
+
+               if ( Radius < MaxRadius )
                {
-                  cerr << "ERROR : ShellID >= NShell !!" << endl;
-                  exit( 1 );
-               }
+                  ShellID = int( Radius / ShellWidth );
 
-#              if   ( MODEL == HYDRO )
-//             evaluate the values on the shell
-               rho  = patch.ptr[lv][PID]->fluid[DENS][k][j][i];
-               vx   = patch.ptr[lv][PID]->fluid[MOMX][k][j][i] / rho;
-               vy   = patch.ptr[lv][PID]->fluid[MOMY][k][j][i] / rho;
-               vz   = patch.ptr[lv][PID]->fluid[MOMZ][k][j][i] / rho;
-               egy  = patch.ptr[lv][PID]->fluid[ENGY][k][j][i];
-
-               pres = (GAMMA-1.0) * ( egy - 0.5*rho*(vx*vx + vy*vy + vz*vz) ); 
-               vr   = ( x*vx + y*vy + z*vz ) / Radius;
-               vt   = sqrt( fabs(vx*vx + vy*vy + vz*vz - vr*vr) );
-
-
-//             evalute the square of deviation on the shell
-               RMS[ShellID][0] += dv*pow( double(rho )-Average[ShellID][0], 2.0 );
-               RMS[ShellID][1] += dv*pow( double(vr  )-Average[ShellID][1], 2.0 );
-               RMS[ShellID][2] += dv*pow( double(vt  )-Average[ShellID][2], 2.0 );
-               RMS[ShellID][3] += dv*pow( double(egy )-Average[ShellID][3], 2.0 );
-               RMS[ShellID][4] += dv*pow( double(pres)-Average[ShellID][4], 2.0 );
-
-#              elif ( MODEL == MHD )
-#              warning : WAIT MHD !!!
+                  if ( ShellID >= NShell )
+                  {
+                     cerr << "ERROR : ShellID >= NShell !!" << endl;
+                     exit( 1 );
+                  }
+
+#                 if   ( MODEL == HYDRO )
+//                evaluate the values on the shell
+                  rho    = patch.ptr[lv][PID]->fluid[DENS][k][j][i];
+                  vx     = patch.ptr[lv][PID]->fluid[MOMX][k][j][i] / rho;
+                  vy     = patch.ptr[lv][PID]->fluid[MOMY][k][j][i] / rho;
+                  vz     = patch.ptr[lv][PID]->fluid[MOMZ][k][j][i] / rho;
+                  egy    = patch.ptr[lv][PID]->fluid[ENGY][k][j][i];
+
+                  Var[0] = rho;
+                  Var[1] = ( x*vx + y*vy + z*vz ) / Radius;
+                  Var[2] = sqrt( fabs(vx*vx + vy*vy + vz*vz - Var[1]*Var[1]) );
+                  Var[3] = egy;
+                  Var[4] = (GAMMA-1.0) * ( egy - 0.5*rho*(vx*vx + vy*vy + vz*vz) ); 
+
+#                 elif ( MODEL == MHD )
+#                 warning : WAIT MHD !!!
+
+#                 elif ( MODEL == ELBDM )
+                  Var[0] = patch.ptr[lv][PID]->fluid[DENS][k][j][i];
+                  Var[1] = patch.ptr[lv][PID]->fluid[REAL][k][j][i];
+                  Var[2] = patch.ptr[lv][PID]->fluid[IMAG][k][j][i];
+
+#                 else
+#                 error : ERROR : unsupported MODEL !!
+#                 endif // MODEL
+
+//                evalute the square of deviation on the shell
+                  for (int v=0; v<NCOMP; v++)
+                     RMS_Local[ShellID][v] += dv*pow( double(Var[v])-Average[ShellID][v], 2.0 );
 
-#              elif ( MODEL == ELBDM )
-               Dens = patch.ptr[lv][PID]->fluid[DENS][k][j][i];
-               Real = patch.ptr[lv][PID]->fluid[REAL][k][j][i];
-               Imag = patch.ptr[lv][PID]->fluid[IMAG][k][j][i];
+               } // if ( Radius < MaxRadius )
+            }}} // k, j, i
+         } // for (int PID=0; PID<patch.num[lv]; PID++)
+      } // OpenMP parallel region
 
-//             evalute the square of deviation on the shell
-               RMS[ShellID][0] += dv*pow( double(Dens)-Average[ShellID][0], 2.0 );
-               RMS[ShellID][1] += dv*pow( double(Real)-Average[ShellID][1], 2.0 );
-               RMS[ShellID][2] += dv*pow( double(Imag)-Average[ShellID][2], 2.0 );
+      cout << "done" << endl;
 
-#              else
-#              error : ERROR : unsupported MODEL !!
-#              endif // MODEL
+   } // for (int lv=0; lv<NLEVEL; lv++)
 
-            } // if ( Radius < MaxRadius )
-         }}} // k, j, i
-      } // for (int PID=0; PID<patch.num[lv]; PID++)
 
-      cout << "done" << endl;
+// sum over all threads
+   for (int t=0; t<NThread; t++)
+   for (int n=0; n<NShell; n++)
+   for (int v=0; v<NCOMP; v++)      RMS[n][v] += RMS_TH[ t*NShell + n ][v];
 
-   } // for (int lv=0; lv<NLEVEL; lv++)
+   delete [] RMS_TH;
 
 
 // get the root-mean-square at each level
@@ -309,6 +337,12 @@ void GetRMS()
 //-------------------------------------------------------------------------------------------------------
 // Function    :  ShellAverage
 // Description :  Get the shell average of all variables 
+//
+// Note        :  1. Parallelized over patches by OpenMP. Each thread accumulates its own shell arrays, which
+//                   are summed up after all levels are processed.
+//                2. Patches entirely outside the targeted sphere are skipped before visiting their cells
+//                   (see "OutsideSphere")
+//                3. Only leaf patches are loaded in "LoadData" --> covered cells are never counted
 //-------------------------------------------------------------------------------------------------------
 void ShellAverage()
 {
@@ -316,128 +350,168 @@ void ShellAverage()
    cout << "Evaluating the shell average ..." << endl;
 
 
-   int  ShellID;
-   real Radius, scale, dv;
-   real x, x1, x2, y, y1, y2, z, z1, z2;     // (x,y,z) : relative coordinates to the vector "Center"
-
-#  if   ( MODEL == HYDRO )
-   real px, py, pz, pr, pt, vr, vt, pres, rho, egy;
+#  ifdef OPENMP
+   const int NThread = omp_get_max_threads();
+#  else
+   const int NThread = 1;
+#  endif
 
-#  elif ( MODEL == MHD )
-#  warning : WAIT MHD !!!
+// per-thread accumulators
+   double  (*Average_TH)[NCOMP] = new double   [NThread*NShell][NCOMP];
+   real    (*Max_TH    )[NCOMP] = new real     [NThread*NShell][NCOMP];
+   real    (*Min_TH    )[NCOMP] = new real     [NThread*NShell][NCOMP];
+   double   *Volume_TH          = new double   [NThread*NShell];
+   long int *NCount_TH          = new long int [NThread*NShell];
 
-#  elif ( MODEL == ELBDM )
-   real Dens, Real, Imag;
+   for (int t=0; t<NThread*NShell; t++)
+   {
+      for (int v=0; v<NCOMP; v++)
+      {
+         Average_TH[t][v] = 0.0;
+         Max_TH    [t][v] = -__FLT_MAX__;
+         Min_TH    [t][v] = +__FLT_MAX__;
+      }
 
-#  else
-#  error : ERROR : unsupported MODEL !!
-#  endif // MODEL
+      Volume_TH[t] = 0.0;
+      NCount_TH[t] = 0;
+   }
 
 
    for (int lv=0; lv<NLEVEL; lv++)              
    { 
-      scale = (real)patch.scale[lv];
-      dv    = scale*scale*scale;
+      const real scale = (real)patch.scale[lv];
+      const real dv    = scale*scale*scale;
 
       cout << "   Level " << lv << " ... ";
 
-      for (int PID=0; PID<patch.num[lv]; PID++) 
+#     pragma omp parallel
       {
-         for (int k=0; k<PATCH_SIZE; k++) {  z1 = patch.ptr[lv][PID]->corner[2] + (k+0.5)*scale - Center    [2];
-                                             z2 = patch.ptr[lv][PID]->corner[2] + (k+0.5)*scale - Center_Map[2];
-                                             z  = ( fabs(z1) <= fabs(z2) ) ? z1 : z2;
-         for (int j=0; j<PATCH_SIZE; j++) {  y1 = patch.ptr[lv][PID]->corner[1] + (j+0.5)*scale - Center    [1];
-                                             y2 = patch.ptr[lv][PID]->corner[1] + (j+0.5)*scale - Center_Map[1];
-                                             y  = ( fabs(y1) <= fabs(y2) ) ? y1 : y2;
-         for (int i=0; i<PATCH_SIZE; i++) {  x1 = patch.ptr[lv][PID]->corner[0] + (i+0.5)*scale - Center    [0];
-                                             x2 = patch.ptr[lv][PID]->corner[0] + (i+0.5)*scale - Center_Map[0];
-                                             x  = ( fabs(x1) <= fabs(x2) ) ? x1 : x2;
-
-            Radius = sqrt( x*x + y*y + z*z );
-
-            if ( Radius < MaxRadius )
-            {
-               ShellID = int( Radius / ShellWidth );
-
-               if ( ShellID >= NShell )
+#        ifdef OPENMP
+         const int TID = omp_get_thread_num();
+#        else
+         const int TID = 0;
+#        endif
+
+         double   (*Average_Local)[NCOMP] = Average_TH + TID*NShell;
+         real     (*Max_Local    )[NCOMP] = Max_TH     + TID*NShell;
+         real     (*Min_Local    )[NCOMP] = Min_TH     + TID*NShell;
+         double    *Volume_Local          = Volume_TH  + TID*NShell;
+         long int  *NCount_Local          = NCount_TH  + TID*NShell;
+
+         int  ShellID;
+         real Radius, Sum[NCOMP], Var[NCOMP];
+         real x, x1, x2, y, y1, y2, z, z1, z2;     // (x,y,z) : relative coordinates to the vector "Center"
+
+#        if   ( MODEL == HYDRO )
+         real px, py, pz, pr, pt, pres, rho, egy;
+#        elif ( MODEL == MHD )
+#        warning : WAIT MHD !!!
+#        endif
+
+#        pragma omp for schedule( dynamic )
+         for (int PID=0; PID<patch.num[lv]; PID++) 
+         {
+//          skip the patches entirely outside the targeted sphere
+            if ( OutsideSphere( lv, PID ) )  continue;
+
+            for (int k=0; k<PATCH_SIZE; k++) {  z1 = patch.ptr[lv][PID]->corner[2] + (k+0.5)*scale - Center    [2];
+                                                z2 = patch.ptr[lv][PID]->corner[2] + (k+0.5)*scale - Center_Map[2];
+                                                z  = ( fabs(z1) <= fabs(z2) ) ? z1 : z2;
+            for (int j=0; j<PATCH_SIZE; j++) {  y1 = patch.ptr[lv][PID]->corner[1] + (j+0.5)*scale - Center    [1];
+                                                y2 = patch.ptr[lv][PID]->corner[1] + (j+0.5)*scale - Center_Map[1];
+                                                y  = ( fabs(y1) <= fabs(y2) ) ? y1 : y2;
+            for (int i=0; i<PATCH_SIZE; i++) {  x1 = patch.ptr[lv][PID]->corner[0] + (i+0.5)*scale - Center    [0];
+                                                x2 = patch.ptr[lv][PID]->corner[0] + (i+0.5)*scale - Center_Map[0];
+                                                x  = ( fabs(x1) <= fabs(x2) ) ? x1 : x2;
+
+               Radius = sqrt( x*x + y*y + z*z );
+
+               if ( Radius < MaxRadius )
                {
-                  cerr << "ERROR : ShellID >= NShell !!" << endl;
-                  exit( 1 );
-               }
+                  ShellID = int( Radius / ShellWidth );
 
-#              if   ( MODEL == HYDRO )
-//             evaluate the values on the shell
-               rho  = patch.ptr[lv][PID]->fluid[DENS][k][j][i];
-               px   = patch.ptr[lv][PID]->fluid[MOMX][k][j][i];
-               py   = patch.ptr[lv][PID]->fluid[MOMY][k][j][i];
-               pz   = patch.ptr[lv][PID]->fluid[MOMZ][k][j][i];
-               egy  = patch.ptr[lv][PID]->fluid[ENGY][k][j][i];
-
-               pr   = ( x*px + y*py + z*pz ) / Radius;
-               pt   = sqrt( fabs(px*px + py*py + pz*pz - pr*pr) );
-               pres = (GAMMA-1.0) * ( egy - 0.5*(px*px + py*py + pz*pz)/rho ); 
-               vr   = pr/rho;
-               vt   = pt/rho;
-
-
-//             add up the values
-               Average[ShellID][0] += (double)(dv*rho );
-               Average[ShellID][1] += (double)(dv*pr  );
-               Average[ShellID][2] += (double)(dv*pt  );
-               Average[ShellID][3] += (double)(dv*egy );
-               Average[ShellID][4] += (double)(dv*pres);
-
-
-//             store the maximum and minimum values
-               if ( rho  > Max[ShellID][0] )    Max[ShellID][0] = rho;
-               if ( vr   > Max[ShellID][1] )    Max[ShellID][1] = vr;
-               if ( vt   > Max[ShellID][2] )    Max[ShellID][2] = vt;
-               if ( egy  > Max[ShellID][3] )    Max[ShellID][3] = egy;
-               if ( pres > Max[ShellID][4] )    Max[ShellID][4] = pres;
-
-               if ( rho  < Min[ShellID][0] )    Min[ShellID][0] = rho;
-               if ( vr   < Min[ShellID][1] )    Min[ShellID][1] = vr;
-               if ( vt   < Min[ShellID][2] )    Min[ShellID][2] = vt;
-               if ( egy  < Min[ShellID][3] )    Min[ShellID][3] = egy;
-               if ( pres < Min[ShellID][4] )    Min[ShellID][4] = pres;
+                  if ( ShellID >= NShell )
+                  {
+                     cerr << "ERROR : ShellID >= NShell !!" << endl;
+                     exit( 1 );
+                  }
+
+#                 if   ( MODEL == HYDRO )
+//                evaluate the values on the shell
+                  rho    = patch.ptr[lv][PID]->fluid[DENS][k][j][i];
+                  px     = patch.ptr[lv][PID]->fluid[MOMX][k][j][i];
+                  py     = patch.ptr[lv][PID]->fluid[MOMY][k][j][i];
+                  pz     = patch.ptr[lv][PID]->fluid[MOMZ][k][j][i];
+                  egy    = patch.ptr[lv][PID]->fluid[ENGY][k][j][i];
+
+                  pr     = ( x*px + y*py + z*pz ) / Radius;
+                  pt     = sqrt( fabs(px*px + py*py + pz*pz - pr*pr) );
+                  pres   = (GAMMA-1.0) * ( egy - 0.5*(px*px + py*py + pz*pz)/rho ); 
+
+//                values to be summed up (momenta) and to be compared (velocities)
+                  Sum[0] = rho;     Var[0] = rho;
+                  Sum[1] = pr;      Var[1] = pr/rho;
+                  Sum[2] = pt;      Var[2] = pt/rho;
+                  Sum[3] = egy;     Var[3] = egy;
+                  Sum[4] = pres;    Var[4] = pres;
+
+#                 elif ( MODEL == MHD )
+#                 warning : WAIT MHD !!!
+
+#                 elif ( MODEL == ELBDM )
+                  Sum[0] = Var[0] = patch.ptr[lv][PID]->fluid[DENS][k][j][i];
+                  Sum[1] = Var[1] = patch.ptr[lv][PID]->fluid[REAL][k][j][i];
+                  Sum[2] = Var[2] = patch.ptr[lv][PID]->fluid[IMAG][k][j][i];
+
+#                 else
+#                 error : ERROR : unsupported MODEL !!
+#                 endif // MODEL
+
+//                add up the values and store the maximum and minimum values
+                  for (int v=0; v<NCOMP; v++)
+                  {
+                     Average_Local[ShellID][v] += (double)(dv*Sum[v]);
 
-#              elif ( MODEL == MHD )
-#              warning : WAIT MHD !!!
+                     if ( Var[v] > Max_Local[ShellID][v] )  Max_Local[ShellID][v] = Var[v];
+                     if ( Var[v] < Min_Local[ShellID][v] )  Min_Local[ShellID][v] = Var[v];
+                  }
 
-#              elif ( MODEL == ELBDM )
-               Dens = patch.ptr[lv][PID]->fluid[DENS][k][j][i];
-               Real = patch.ptr[lv][PID]->fluid[REAL][k][j][i];
-               Imag = patch.ptr[lv][PID]->fluid[IMAG][k][j][i];
+                  Volume_Local[ShellID] += dv;
+                  NCount_Local[ShellID] ++;
 
-//             add up the values
-               Average[ShellID][0] += (double)(dv*Dens);
-               Average[ShellID][1] += (double)(dv*Real);
-               Average[ShellID][2] += (double)(dv*Imag);
+               } // if ( Radius < MaxRadius )
+            }}} // k, j, i
+         } // for (int PID=0; PID<patch.num[lv]; PID++)
+      } // OpenMP parallel region
 
+      cout << "done" << endl;
 
-//             store the maximum and minimum values
-               if ( Dens > Max[ShellID][0] )    Max[ShellID][0] = Dens;
-               if ( Real > Max[ShellID][1] )    Max[ShellID][1] = Real;
-               if ( Imag > Max[ShellID][2] )    Max[ShellID][2] = Imag;
+   } // for (int lv=0; lv<NLEVEL; lv++)
 
-               if ( Dens < Min[ShellID][0] )    Min[ShellID][0] = Dens;
-               if ( Real < Min[ShellID][1] )    Min[ShellID][1] = Real;
-               if ( Imag < Min[ShellID][2] )    Min[ShellID][2] = Imag;
 
-#              else
-#              error : ERROR : unsupported MODEL !!
-#              endif // MODEL
+// sum over all threads
+   for (int t=0; t<NThread; t++)
+   for (int n=0; n<NShell; n++)
+   {
+      const int Idx = t*NShell + n;
 
-               Volume[ShellID] += dv;
-               NCount[ShellID] ++;
+      for (int v=0; v<NCOMP; v++)
+      {
+         Average[n][v] += Average_TH[Idx][v];
 
-            } // if ( Radius < MaxRadius )
-         }}} // k, j, i
-      } // for (int PID=0; PID<patch.num[lv]; PID++)
+         if ( Max_TH[Idx][v] > Max[n][v] )   Max[n][v] = Max_TH[Idx][v];
+         if ( Min_TH[Idx][v] < Min[n][v] )   Min[n][v] = Min_TH[Idx][v];
+      }
 
-      cout << "done" << endl;
+      Volume[n] += Volume_TH[Idx];
+      NCount[n] += NCount_TH[Idx];
+   }
 
-   } // for (int lv=0; lv<NLEVEL; lv++)
+   delete [] Average_TH;
+   delete [] Max_TH;
+   delete [] Min_TH;
+   delete [] Volume_TH;
+   delete [] NCount_TH;
 
 
 // get the average values
@@ -461,6 +535,44 @@ void ShellAverage()
 
 
 
+//-------------------------------------------------------------------------------------------------------
+// Function    :  OutsideSphere
+// Description :  Return true if the targeted patch lies entirely outside the targeted sphere
+//
+// Note        :  1. The minimum distance between the patch bounding box and the sphere center is compared with
+//                   "MaxRadius". Both "Center" and "Center_Map" are checked for the periodic B.C. (the same rule
+//                   as the per-cell distance adopted in "ShellAverage").
+//                2. All coordinates are in the unit of the finest-level cell size
+//
+// Parameter   :  lv  : Targeted refinement level
+//                PID : Targeted patch ID
+//-------------------------------------------------------------------------------------------------------
+bool OutsideSphere( const int lv, const int PID )
+{
+
+   const int PScale = PATCH_SIZE*patch.scale[lv];
+
+   double Left, Right, Dist, Dist_Map, Dist2 = 0.0;
+
+   for (int d=0; d<3; d++)
+   {
+      Left     = patch.ptr[lv][PID]->corner[d];
+      Right    = Left + PScale;
+
+      Dist     = ( Center    [d] < Left ) ? Left-Center    [d] : ( Center    [d] > Right ) ? Center    [d]-Right : 0.0;
+      Dist_Map = ( Center_Map[d] < Left ) ? Left-Center_Map[d] : ( Center_Map[d] > Right ) ? Center_Map[d]-Right : 0.0;
+
+      if ( Dist_Map < Dist )  Dist = Dist_Map;
+
+      Dist2 += Dist*Dist;
+   }
+
+   return ( Dist2 >= (double)MaxRadius*MaxRadius );
+
+} // FUNCTION : OutsideSphere
+
+
+
 //-------------------------------------------------------------------------------------------------------
 // Function    :  LoadData
 // Description :  Load data from the input file 
@@ -531,6 +643,12 @@ void LoadData()
       exit( 1 );
    }
 
+   if ( FormatVersion == 1202 )
+   {
+      fprintf( stderr, "ERROR : delta dumps (format version 1202) are not supported --> please use a full dump !!\n" );
+      exit( 1 );
+   }
+
 
 // check if the size of different data types are consistent (only for version >= 1200)
    if ( FormatVersion >= 1200 )
@@ -32,7 +32,10 @@ typedef float  real;
 
 
 // patch size (number of cells of a single patch in the x/y/z directions)
-#define PATCH_SIZE         8
+// --> can be set in the Makefile and must be the same as the simulation
+#ifndef PATCH_SIZE
+#  define PATCH_SIZE       8
+#endif
 
 
 // number of components in each cell and the variable indices in the array "fluid"